@@ -4,8 +4,9 @@
 // 单一头文件入口，include 即用
 // ============================================================
 
-// 核心层：类型、内存抽象、进程操作、PE 段缓存、全局上下文
+// 核心层：类型、UTF-16 转码、内存抽象、进程操作、PE 段缓存、全局上下文
 #include "xrd/core/types.hpp"
+#include "xrd/core/utf.hpp"
 #include "xrd/memory/memory.hpp"
 #include "xrd/memory/memory_driver.hpp"
 #include "xrd/memory/memory_shmem.hpp"
@@ -36,9 +37,11 @@
 
 // 引擎封装层
 #include "xrd/engine/names.hpp"
+#include "xrd/engine/names_batch.hpp"
 // objects: UObject/UStruct/UClass/FProperty
 #include "xrd/engine/objects/objects.hpp"
 #include "xrd/engine/objects/objects_search.hpp"
+#include "xrd/engine/objects/objects_mirror.hpp"
 // world: UWorld/Actor/Pawn
 #include "xrd/engine/world/world.hpp"
 #include "xrd/engine/world/world_access.hpp"
@@ -72,12 +75,16 @@
 #include "xrd/runtime/scene_watch.hpp"
 #include "xrd/runtime/actor_tracker.hpp"
 #include "xrd/runtime/bone_runtime.hpp"
-// dump: SDK 导出、类型解析、枚举收集
+// dump: SDK 导出、类型解析、枚举收集、反射模型文件
 #include "xrd/helpers/dump/dump_type_resolve.hpp"
 #include "xrd/helpers/dump/dump_enum.hpp"
 #include "xrd/helpers/dump/dump_collect.hpp"
 #include "xrd/helpers/dump/dump_sdk.hpp"
 #include "xrd/helpers/dump/dump_extra.hpp"
+#include "xrd/helpers/dump/dump_offsets_sdk.hpp"
+#include "xrd/helpers/dump/dump_json.hpp"
+#include "xrd/helpers/dump/dump_model.hpp"
+#include "xrd/helpers/dump/dump_diff_report.hpp"
 
 // AutoInit 放最后，因为它依赖上面所有模块
 #include "xrd/init/auto_init.hpp"
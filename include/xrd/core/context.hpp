@@ -1,11 +1,13 @@
 #pragma once
-// Xrd-eXternalrEsolve - 全局上下文
-// 保存运行时状态：进程句柄、偏移表、内存访问器
+// Xrd-eXternalrEsolve - 上下文
+// 保存运行时状态：进程句柄、偏移表、内存访问器与解析缓存；默认全局，可按线程绑定独立实例
 
 #include "types.hpp"
 #include "../memory/memory.hpp"
+#include "../memory/memory_regions.hpp"
 #include "process.hpp"
 #include "process_sections.hpp"
+#include "context_cache.hpp"
 #include "../chaos/chaos_types.hpp"
 #include <memory>
 #include <iostream>
@@ -89,6 +91,8 @@ struct UEOffsets
     i32  ChunkSize          = 64 * 1024;
     i32  FUObjectItemSize   = 0x18;
     i32  FUObjectItemInitialOffset = 0x00;
+    // SerialNumber 相对 Object 指针的偏移：UE4 ~ UE5.4 为 0x10，UE5.5+ FlagsAndRefCount 扩为 64 位后为 0x14
+    i32  FUObjectItemSerialNumberOffset = 0x10;
 
     // GNames 布局
     bool bUseNamePool       = true;
@@ -146,7 +150,10 @@ struct UEOffsets
     uptr ChaosPhysScene  = 0;   // FPhysScene_Chaos* 地址
 };
 
-// ─── 全局上下文 ───
+// ─── 上下文 ───
+// 一个 Context 对应一个目标进程：句柄、偏移表、访问器以及全部解析缓存（caches）
+// 默认使用进程级全局上下文；同一进程处理多个目标时为每个目标创建独立实例，
+// 在处理它的线程上用 BindThreadContext / ScopedContext 绑定，Ctx() / Mem() / Off() 与各缓存随之切换
 struct Context
 {
     u32    pid     = 0;
@@ -159,19 +166,209 @@ struct Context
     ChaosOffsets chaosOff;
 
     std::unique_ptr<IMemoryAccessor> mem;
+    ReadableRegionMap regions; // mem 目标进程的可读区域（RefreshReadableRegions 填充）
+    ContextCacheStore caches;  // 名称 / 对象 / 属性 / 函数等缓存，随上下文销毁
 
     bool inited = false;
 
     std::mutex mtx;
+
+    Context() = default;
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    ~Context()
+    {
+        if (process)
+        {
+            CloseHandle(process);
+        }
+    }
 };
 
-// 全局单例
-inline Context& Ctx()
+// 线程局部覆盖（上下文绑定 / 访问器绑定）
+// 注意：不使用 thread_local 关键字，因为手动映射注入时 TLS 目录未被 loader 处理，
+// 访问 thread_local 会导致 ACCESS_VIOLATION。改用 TlsAlloc API。
+namespace detail
+{
+    inline DWORD LazyTlsIndex(DWORD& index, LONG& initState)
+    {
+        DWORD idx = index;
+        if (idx != TLS_OUT_OF_INDEXES)
+        {
+            return idx;
+        }
+
+        if (InterlockedCompareExchange(&initState, 1, 0) == 0)
+        {
+            idx = TlsAlloc();
+            index = idx;
+        }
+        else
+        {
+            while ((idx = index) == TLS_OUT_OF_INDEXES)
+            {
+                SwitchToThread();
+            }
+        }
+
+        return idx;
+    }
+} // namespace detail
+
+inline DWORD g_contextTlsIndex = TLS_OUT_OF_INDEXES;
+inline LONG  g_contextTlsInitState = 0;
+
+// 进程级全局上下文（未绑定线程上下文时使用）
+inline Context& GlobalCtx()
 {
     static Context ctx;
     return ctx;
 }
 
+// 当前线程绑定的上下文；未绑定返回 nullptr
+inline Context* ThreadBoundContext()
+{
+    DWORD idx = g_contextTlsIndex;
+    if (idx == TLS_OUT_OF_INDEXES)
+    {
+        return nullptr;
+    }
+    return static_cast<Context*>(TlsGetValue(idx));
+}
+
+// 将当前线程绑定到 ctx（nullptr = 解除绑定，回到全局上下文）
+inline void BindThreadContext(Context* ctx)
+{
+    DWORD idx = ctx ? detail::LazyTlsIndex(g_contextTlsIndex, g_contextTlsInitState) : g_contextTlsIndex;
+    if (idx != TLS_OUT_OF_INDEXES)
+    {
+        TlsSetValue(idx, ctx);
+    }
+}
+
+// 当前线程的上下文：已绑定的实例，否则为全局上下文
+inline Context& Ctx()
+{
+    Context* bound = ThreadBoundContext();
+    return bound ? *bound : GlobalCtx();
+}
+
+// 作用域内将当前线程绑定到指定上下文，析构时恢复之前的绑定
+// 传入 nullptr 时保持当前绑定不变（便于把调用方的绑定原样转交给工作线程）
+class ScopedContext
+{
+public:
+    explicit ScopedContext(Context* ctx)
+        : m_prev(ThreadBoundContext()), m_active(ctx != nullptr)
+    {
+        if (m_active)
+        {
+            BindThreadContext(ctx);
+        }
+    }
+
+    explicit ScopedContext(Context& ctx) : ScopedContext(&ctx) {}
+
+    ~ScopedContext()
+    {
+        if (m_active)
+        {
+            BindThreadContext(m_prev);
+        }
+    }
+
+    ScopedContext(const ScopedContext&) = delete;
+    ScopedContext& operator=(const ScopedContext&) = delete;
+
+private:
+    Context* m_prev;
+    bool m_active;
+};
+
+// 当前上下文中类型 T 的缓存槽
+template<typename T>
+inline T& ContextLocal()
+{
+    return Ctx().caches.Get<T>();
+}
+
+// ─── 会话缓存 ───
+// 有明确生命周期的工作（如一次 SDK 导出，见 DumpSession）可把一组缓存槽绑定到线程：
+// SessionLocal 优先取绑定的会话槽，未绑定时回退到上下文槽；会话结束即释放，并发会话互不影响
+inline DWORD g_sessionCachesTlsIndex = TLS_OUT_OF_INDEXES;
+inline LONG  g_sessionCachesTlsInitState = 0;
+
+inline ContextCacheStore* ThreadSessionCaches()
+{
+    DWORD idx = g_sessionCachesTlsIndex;
+    if (idx == TLS_OUT_OF_INDEXES)
+    {
+        return nullptr;
+    }
+    return static_cast<ContextCacheStore*>(TlsGetValue(idx));
+}
+
+inline void BindThreadSessionCaches(ContextCacheStore* caches)
+{
+    DWORD idx = caches
+        ? detail::LazyTlsIndex(g_sessionCachesTlsIndex, g_sessionCachesTlsInitState)
+        : g_sessionCachesTlsIndex;
+    if (idx != TLS_OUT_OF_INDEXES)
+    {
+        TlsSetValue(idx, caches);
+    }
+}
+
+template<typename T>
+inline T& SessionLocal()
+{
+    ContextCacheStore* session = ThreadSessionCaches();
+    return session ? session->Get<T>() : ContextLocal<T>();
+}
+
+// 线程绑定快照：调用线程的上下文与会话，交给工作线程原样继承
+struct ThreadBinding
+{
+    Context* context = nullptr;
+    ContextCacheStore* session = nullptr;
+};
+
+inline ThreadBinding CaptureThreadBinding()
+{
+    return ThreadBinding{ThreadBoundContext(), ThreadSessionCaches()};
+}
+
+// 工作线程入口处使用：作用域内继承给定的绑定，结束时恢复
+class ScopedThreadBinding
+{
+public:
+    explicit ScopedThreadBinding(const ThreadBinding& binding)
+        : m_context(binding.context), m_prevSession(ThreadSessionCaches()), m_session(binding.session)
+    {
+        if (m_session)
+        {
+            BindThreadSessionCaches(m_session);
+        }
+    }
+
+    ~ScopedThreadBinding()
+    {
+        if (m_session)
+        {
+            BindThreadSessionCaches(m_prevSession);
+        }
+    }
+
+    ScopedThreadBinding(const ScopedThreadBinding&) = delete;
+    ScopedThreadBinding& operator=(const ScopedThreadBinding&) = delete;
+
+private:
+    ScopedContext m_context;
+    ContextCacheStore* m_prevSession;
+    ContextCacheStore* m_session;
+};
+
 inline void ResetContext()
 {
     auto& ctx = Ctx();
@@ -186,6 +383,7 @@ inline void ResetContext()
     ctx.off = UEOffsets{};
     ctx.chaosOff = ChaosOffsets{};
     ctx.mem.reset();
+    ctx.regions.Clear();
     ctx.inited = false;
 }
 
@@ -194,35 +392,14 @@ inline bool IsInited()
     return Ctx().inited;
 }
 
-// 线程局部内存访问器覆盖：设置后该线程的 Mem() 返回此指针而非全局通道
+// 线程局部内存访问器覆盖：设置后该线程的 Mem() 返回此指针而非上下文通道
 // 用于多通道共享内存场景，每个工作线程绑定独立 slot 消除 mutex 争抢
-// 注意：不使用 thread_local 关键字，因为手动映射注入时 TLS 目录未被 loader 处理，
-// 访问 thread_local 会导致 ACCESS_VIOLATION。改用 TlsAlloc API。
 inline DWORD g_memOverrideTlsIndex = TLS_OUT_OF_INDEXES;
 inline LONG  g_memOverrideTlsInitState = 0;
 
 inline DWORD GetMemOverrideTlsIndex()
 {
-    DWORD idx = g_memOverrideTlsIndex;
-    if (idx != TLS_OUT_OF_INDEXES)
-    {
-        return idx;
-    }
-
-    if (InterlockedCompareExchange(&g_memOverrideTlsInitState, 1, 0) == 0)
-    {
-        idx = TlsAlloc();
-        g_memOverrideTlsIndex = idx;
-    }
-    else
-    {
-        while ((idx = g_memOverrideTlsIndex) == TLS_OUT_OF_INDEXES)
-        {
-            SwitchToThread();
-        }
-    }
-
-    return idx;
+    return detail::LazyTlsIndex(g_memOverrideTlsIndex, g_memOverrideTlsInitState);
 }
 
 inline void SetThreadMemAccessor(IMemoryAccessor* accessor)
@@ -262,6 +439,54 @@ inline const UEOffsets& Off()
     return Ctx().off;
 }
 
+// ─── 可读区域表 ───
+
+// 可读区域表的过期时间：拒绝一个指针时若表已超过此时长未刷新，先重建再判断
+constexpr u32 kReadableRegionRefreshMs = 2000;
+
+// 以全局访问器重建可读区域表；访问器不支持 QueryRegions 时返回 false（校验退化为地址范围检查）
+inline bool RefreshReadableRegions()
+{
+    auto& ctx = Ctx();
+    if (!ctx.mem)
+    {
+        ctx.regions.Clear();
+        return false;
+    }
+    bool ok = ctx.regions.Refresh(*ctx.mem);
+    if (ok)
+    {
+        std::cerr << "[xrd] 可读区域: " << ctx.regions.RegionCount() << " 段, "
+                  << (ctx.regions.ReadableBytes() >> 20) << " MB\n";
+    }
+    return ok;
+}
+
+// 指针校验：规范用户态地址，且 [ptr, ptr + size) 位于可读区域（区域表未就绪时只做前者）
+// 被拒绝且表已过期时重建一次再判断，避免把新提交的堆内存误判为不可读
+inline bool IsReadablePtr(uptr ptr, std::size_t size = sizeof(uptr))
+{
+    if (!IsCanonicalUserPtr(ptr))
+    {
+        return false;
+    }
+    auto& regions = Ctx().regions;
+    if (regions.MaybeReadable(ptr, size))
+    {
+        return true;
+    }
+    if (!regions.IsStale(kReadableRegionRefreshMs) || !regions.TryBeginRefresh())
+    {
+        return false;
+    }
+    if (Ctx().mem)
+    {
+        regions.Refresh(*Ctx().mem);
+    }
+    regions.EndRefresh();
+    return regions.MaybeReadable(ptr, size);
+}
+
 // ─── 便利读取封装（使用全局上下文） ───
 
 inline bool GReadPtr(uptr address, uptr& out)
@@ -315,4 +540,15 @@ inline bool GReadCString(uptr address, std::string& out, std::size_t maxLen = 25
     return ReadCString(Mem(), address, out, maxLen);
 }
 
+template<typename T>
+inline bool GReadRemoteArray(uptr arrayAddr, std::vector<T>& out)
+{
+    if (!IsInited())
+    {
+        out.clear();
+        return false;
+    }
+    return ReadRemoteArray(Mem(), arrayAddr, out);
+}
+
 } // namespace xrd
@@ -0,0 +1,133 @@
+#pragma once
+// Xrd-eXternalrEsolve - 上下文缓存槽
+// 每个 Context 持有一组按类型编号的缓存槽，名称 / 属性 / 函数 / 对象表等缓存随所属上下文创建和销毁
+// 同一进程内的多个上下文（多目标并行扫描、导出）互不共享缓存
+// 槽编号在首次访问某个类型时全局分配一次；槽内对象首次访问时构造，之后一次原子读取即可取得
+
+#include "types.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+namespace xrd
+{
+
+namespace detail
+{
+    inline std::atomic<u32>& ContextCacheSlotCounter()
+    {
+        static std::atomic<u32> counter{0};
+        return counter;
+    }
+
+    template<typename T>
+    inline u32 ContextCacheSlotIndex()
+    {
+        static const u32 index = ContextCacheSlotCounter().fetch_add(1);
+        return index;
+    }
+} // namespace detail
+
+// 缓存命中计数（放在缓存槽中，供会话结束时汇报命中率）
+struct CacheCounters
+{
+    std::atomic<u64> hits{0};
+    std::atomic<u64> misses{0};
+
+    void Hit() { hits.fetch_add(1, std::memory_order_relaxed); }
+    void Miss() { misses.fetch_add(1, std::memory_order_relaxed); }
+
+    double HitRate() const
+    {
+        u64 h = hits.load(std::memory_order_relaxed);
+        u64 total = h + misses.load(std::memory_order_relaxed);
+        return total ? static_cast<double>(h) / total : 0.0;
+    }
+};
+
+class ContextCacheStore
+{
+public:
+    static constexpr u32 kMaxSlots = 64;
+
+    ContextCacheStore() = default;
+    ContextCacheStore(const ContextCacheStore&) = delete;
+    ContextCacheStore& operator=(const ContextCacheStore&) = delete;
+
+    ~ContextCacheStore()
+    {
+        Release();
+    }
+
+    // 取得类型 T 的槽对象，不存在时默认构造
+    template<typename T>
+    T& Get()
+    {
+        u32 index = detail::ContextCacheSlotIndex<T>();
+        if (index >= kMaxSlots)
+        {
+            std::cerr << "[xrd] 上下文缓存槽不足: " << index << " >= " << kMaxSlots << "\n";
+            std::abort();
+        }
+        void* p = m_slots[index].load(std::memory_order_acquire);
+        if (p)
+        {
+            return *static_cast<T*>(p);
+        }
+        std::lock_guard<std::mutex> lock(m_mtx);
+        p = m_slots[index].load(std::memory_order_relaxed);
+        if (!p)
+        {
+            p = new T();
+            m_deleters[index] = [](void* q) { delete static_cast<T*>(q); };
+            m_slots[index].store(p, std::memory_order_release);
+        }
+        return *static_cast<T*>(p);
+    }
+
+    // 已构造的槽对象；不存在时返回 nullptr（不构造）
+    template<typename T>
+    T* Find() const
+    {
+        u32 index = detail::ContextCacheSlotIndex<T>();
+        if (index >= kMaxSlots)
+        {
+            return nullptr;
+        }
+        return static_cast<T*>(m_slots[index].load(std::memory_order_acquire));
+    }
+
+    // 销毁全部槽对象；调用方保证此时没有线程持有其中的引用
+    void Release()
+    {
+        std::lock_guard<std::mutex> lock(m_mtx);
+        for (u32 i = 0; i < kMaxSlots; ++i)
+        {
+            void* p = m_slots[i].exchange(nullptr, std::memory_order_acq_rel);
+            if (p && m_deleters[i])
+            {
+                m_deleters[i](p);
+            }
+            m_deleters[i] = nullptr;
+        }
+    }
+
+    // 已构造的槽数
+    u32 Count() const
+    {
+        u32 n = 0;
+        for (auto& s : m_slots)
+        {
+            n += s.load(std::memory_order_relaxed) != nullptr;
+        }
+        return n;
+    }
+
+private:
+    std::atomic<void*> m_slots[kMaxSlots] = {};
+    void (*m_deleters[kMaxSlots])(void*) = {};
+    std::mutex m_mtx;
+};
+
+} // namespace xrd
@@ -0,0 +1,273 @@
+#pragma once
+// Xrd-eXternalrEsolve - UTF-16LE → UTF-8 转码
+// FNamePool 宽字符条目、FString 等目标进程中的 UTF-16 文本转为 UTF-8，单次遍历，不依赖 WideCharToMultiByte
+// SSE2 路径每次处理 8 个单元：全 ASCII 直接收窄，全 2 字节 / 全 3 字节（如纯 CJK）的块整块编码，
+// 其余块（ASCII 与 CJK 混排）按通道拼好 1~3 字节序列后依次写出，含代理项的块与不足 8 个单元的尾部逐单元编码；
+// 非 x86 平台只走标量路径，结果一致
+// 代理对合成 4 字节序列；孤立代理项替换为 U+FFFD（与 WideCharToMultiByte 不带 WC_ERR_INVALID_CHARS 时一致）
+
+#include "types.hpp"
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define XRD_UTF_SSE2 1
+#else
+#define XRD_UTF_SSE2 0
+#endif
+
+namespace xrd
+{
+
+// 转码 len 个 UTF-16 单元所需的输出缓冲区大小：每个单元至多 3 字节（代理对 2 单元 → 4 字节），
+// 另加块编码可能越过末尾写入的 1 字节
+constexpr std::size_t Utf8Capacity(std::size_t units)
+{
+    return units * 3 + 4;
+}
+
+namespace detail
+{
+
+// 编码 src[i] 起的一个码点，返回消耗的单元数（代理对为 2）
+inline std::size_t EncodeUtf16Unit(
+    const u16* src, std::size_t i, std::size_t len, u8*& d, std::size_t& invalid)
+{
+    u32 c = src[i];
+    if (c < 0x80)
+    {
+        *d++ = static_cast<u8>(c);
+        return 1;
+    }
+    if (c < 0x800)
+    {
+        d[0] = static_cast<u8>(0xC0 | (c >> 6));
+        d[1] = static_cast<u8>(0x80 | (c & 0x3F));
+        d += 2;
+        return 1;
+    }
+    if (c - 0xD800 >= 0x800)
+    {
+        d[0] = static_cast<u8>(0xE0 | (c >> 12));
+        d[1] = static_cast<u8>(0x80 | ((c >> 6) & 0x3F));
+        d[2] = static_cast<u8>(0x80 | (c & 0x3F));
+        d += 3;
+        return 1;
+    }
+    if (c < 0xDC00 && i + 1 < len && static_cast<u32>(src[i + 1]) - 0xDC00 < 0x400)
+    {
+        u32 cp = 0x10000 + ((c - 0xD800) << 10) + (src[i + 1] - 0xDC00);
+        d[0] = static_cast<u8>(0xF0 | (cp >> 18));
+        d[1] = static_cast<u8>(0x80 | ((cp >> 12) & 0x3F));
+        d[2] = static_cast<u8>(0x80 | ((cp >> 6) & 0x3F));
+        d[3] = static_cast<u8>(0x80 | (cp & 0x3F));
+        d += 4;
+        return 2;
+    }
+    // 孤立代理项 → U+FFFD
+    d[0] = 0xEF;
+    d[1] = 0xBF;
+    d[2] = 0xBD;
+    d += 3;
+    ++invalid;
+    return 1;
+}
+
+// 标量实现（SSE2 路径的尾部与非 x86 平台使用，基准测试用作对照）
+inline std::size_t Utf16ToUtf8Scalar(
+    const u16* src, std::size_t len, char* out, std::size_t* invalid = nullptr)
+{
+    u8* d = reinterpret_cast<u8*>(out);
+    std::size_t bad = 0;
+    for (std::size_t i = 0; i < len;)
+    {
+        i += EncodeUtf16Unit(src, i, len, d, bad);
+    }
+    if (invalid)
+    {
+        *invalid = bad;
+    }
+    return static_cast<std::size_t>(d - reinterpret_cast<u8*>(out));
+}
+
+#if XRD_UTF_SSE2
+// 8 个非代理项单元：每个 32 位通道拼出 1~3 字节序列，
+// 依次整体写出 4 字节并只前进该通道的实际长度，ASCII 与 CJK 混排的块无需逐单元分支
+inline void EncodeUtf16Lanes(__m128i v, u8*& d)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i low6 = _mm_set1_epi32(0x3F);
+    alignas(16) u32 words[8];
+    alignas(16) i32 lens[8];
+    for (int half = 0; half < 2; ++half)
+    {
+        __m128i c = half ? _mm_unpackhi_epi16(v, zero) : _mm_unpacklo_epi16(v, zero);
+        __m128i isAscii = _mm_cmplt_epi32(c, _mm_set1_epi32(0x80));
+        __m128i isTwo = _mm_cmplt_epi32(c, _mm_set1_epi32(0x800));
+        __m128i cont1 = _mm_or_si128(_mm_and_si128(c, low6), _mm_set1_epi32(0x80));
+        __m128i two = _mm_or_si128(
+            _mm_or_si128(_mm_srli_epi32(c, 6), _mm_set1_epi32(0xC0)), _mm_slli_epi32(cont1, 8));
+        __m128i three = _mm_or_si128(
+            _mm_or_si128(_mm_srli_epi32(c, 12), _mm_set1_epi32(0x8080E0)),
+            _mm_or_si128(_mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(c, 6), low6), 8),
+                _mm_slli_epi32(_mm_and_si128(c, low6), 16)));
+        __m128i multi = _mm_or_si128(_mm_and_si128(isTwo, two), _mm_andnot_si128(isTwo, three));
+        __m128i w = _mm_or_si128(_mm_and_si128(isAscii, c), _mm_andnot_si128(isAscii, multi));
+        // 比较结果为 -1：ASCII 为 3-1-1，2 字节为 3-1
+        __m128i n = _mm_add_epi32(_mm_set1_epi32(3), _mm_add_epi32(isAscii, isTwo));
+        _mm_store_si128(reinterpret_cast<__m128i*>(words + half * 4), w);
+        _mm_store_si128(reinterpret_cast<__m128i*>(lens + half * 4), n);
+    }
+    for (int k = 0; k < 8; ++k)
+    {
+        std::memcpy(d, &words[k], 4);
+        d += lens[k];
+    }
+}
+#endif
+
+} // namespace detail
+
+// 转码 src[0, len) 到 out（至少 Utf8Capacity(len) 字节），返回写入的字节数
+// invalid 非空时写入被替换的孤立代理项个数
+inline std::size_t Utf16ToUtf8(
+    const u16* src, std::size_t len, char* out, std::size_t* invalid = nullptr)
+{
+#if XRD_UTF_SSE2
+    u8* d = reinterpret_cast<u8*>(out);
+    std::size_t bad = 0;
+    std::size_t i = 0;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maskAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i mask2 = _mm_set1_epi16(static_cast<short>(0xF800));
+    const __m128i surrogate = _mm_set1_epi16(static_cast<short>(0xD800));
+    const __m128i low6 = _mm_set1_epi16(0x3F);
+    while (i + 8 <= len)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        int ascii = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, maskAscii), zero));
+        if (ascii == 0xFFFF)
+        {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(d), _mm_packus_epi16(v, v));
+            d += 8;
+            i += 8;
+            continue;
+        }
+        __m128i high = _mm_and_si128(v, mask2);
+        int below800 = _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero));
+        if (below800 == 0xFFFF && ascii == 0)
+        {
+            // 每个 16 位通道的低字节为首字节、高字节为后续字节，按小端顺序直接写出 16 字节
+            __m128i lead = _mm_or_si128(_mm_srli_epi16(v, 6), _mm_set1_epi16(0xC0));
+            __m128i cont = _mm_or_si128(_mm_and_si128(v, low6), _mm_set1_epi16(0x80));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                _mm_or_si128(lead, _mm_slli_epi16(cont, 8)));
+            d += 16;
+            i += 8;
+            continue;
+        }
+        int surrogates = _mm_movemask_epi8(_mm_cmpeq_epi16(high, surrogate));
+        if (below800 == 0 && surrogates == 0)
+        {
+            // 每个 32 位通道拼出 3 字节序列，按 3 字节步长重叠写入（每次多写的 1 字节被下一次覆盖）
+            const __m128i low6x4 = _mm_set1_epi32(0x3F);
+            const __m128i tags = _mm_set1_epi32(0x8080E0);
+            for (int half = 0; half < 2; ++half)
+            {
+                __m128i c = half ? _mm_unpackhi_epi16(v, zero) : _mm_unpacklo_epi16(v, zero);
+                __m128i w = _mm_or_si128(
+                    _mm_or_si128(_mm_srli_epi32(c, 12),
+                        _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(c, 6), low6x4), 8)),
+                    _mm_or_si128(_mm_slli_epi32(_mm_and_si128(c, low6x4), 16), tags));
+                alignas(16) u32 lanes[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(lanes), w);
+                for (int k = 0; k < 4; ++k)
+                {
+                    std::memcpy(d + k * 3, &lanes[k], 4);
+                }
+                d += 12;
+            }
+            i += 8;
+            continue;
+        }
+        if (surrogates == 0)
+        {
+            detail::EncodeUtf16Lanes(v, d);
+            i += 8;
+            continue;
+        }
+        // 含代理项：逐单元编码到块尾（跨块的代理对多消耗一个单元）
+        for (std::size_t end = i + 8; i < end;)
+        {
+            i += detail::EncodeUtf16Unit(src, i, len, d, bad);
+        }
+    }
+    std::size_t tailInvalid = 0;
+    d += detail::Utf16ToUtf8Scalar(src + i, len - i, reinterpret_cast<char*>(d), &tailInvalid);
+    if (invalid)
+    {
+        *invalid = bad + tailInvalid;
+    }
+    return static_cast<std::size_t>(d - reinterpret_cast<u8*>(out));
+#else
+    return detail::Utf16ToUtf8Scalar(src, len, out, invalid);
+#endif
+}
+
+// 转码并替换 out 的内容；遇到孤立代理项（已替换为 U+FFFD）时返回 false
+inline bool Utf16ToUtf8(const u16* src, std::size_t len, std::string& out)
+{
+    out.resize(Utf8Capacity(len));
+    std::size_t invalid = 0;
+    out.resize(Utf16ToUtf8(src, len, out.data(), &invalid));
+    return invalid == 0;
+}
+
+// 本地宽字符串转 UTF-8：wchar_t 在 Windows 上为 UTF-16，在 Linux 上为 UTF-32
+inline std::string WideToUtf8(std::wstring_view w)
+{
+    std::string out;
+    if constexpr (sizeof(wchar_t) == sizeof(u16))
+    {
+        Utf16ToUtf8(reinterpret_cast<const u16*>(w.data()), w.size(), out);
+    }
+    else
+    {
+        out.reserve(w.size());
+        for (wchar_t wc : w)
+        {
+            u32 c = static_cast<u32>(wc);
+            if (c > 0x10FFFF || c - 0xD800 < 0x800)
+            {
+                c = 0xFFFD;
+            }
+            if (c < 0x80)
+            {
+                out += static_cast<char>(c);
+            }
+            else if (c < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (c >> 6));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else if (c < 0x10000)
+            {
+                out += static_cast<char>(0xE0 | (c >> 12));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xF0 | (c >> 18));
+                out += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (c & 0x3F));
+            }
+        }
+    }
+    return out;
+}
+
+} // namespace xrd
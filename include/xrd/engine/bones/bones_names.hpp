@@ -25,15 +25,19 @@ struct FMeshBoneInfo
 // meshComponent → skelMeshPtr 运行时不变，缓存后避免每帧 2 次 RPM
 namespace detail
 {
+    struct SkelMeshCacheSlot
+    {
+        std::unordered_map<uptr, uptr> cache;
+        std::mutex mtx;
+    };
+
     inline std::unordered_map<uptr, uptr>& SkelMeshCache()
     {
-        static std::unordered_map<uptr, uptr> c;
-        return c;
+        return ContextLocal<SkelMeshCacheSlot>().cache;
     }
     inline std::mutex& SkelMeshCacheMutex()
     {
-        static std::mutex m;
-        return m;
+        return ContextLocal<SkelMeshCacheSlot>().mtx;
     }
 } // namespace detail
 
@@ -252,16 +256,20 @@ inline std::string GetBoneName(uptr meshComponent, i32 boneIndex)
 
 namespace detail
 {
+    struct BoneNameCacheSlot
+    {
+        std::unordered_map<uptr, std::vector<std::string>> cache;
+        std::mutex mtx;
+    };
+
     inline std::unordered_map<uptr, std::vector<std::string>>& BoneNameCache()
     {
-        static std::unordered_map<uptr, std::vector<std::string>> cache;
-        return cache;
+        return ContextLocal<BoneNameCacheSlot>().cache;
     }
 
     inline std::mutex& BoneNameCacheMutex()
     {
-        static std::mutex mtx;
-        return mtx;
+        return ContextLocal<BoneNameCacheSlot>().mtx;
     }
 } // namespace detail
 
@@ -26,10 +26,14 @@ namespace detail
         }
     };
 
+    struct BoneRuntimeResolveSlot
+    {
+        std::recursive_mutex mutex;
+    };
+
     inline std::recursive_mutex& BoneRuntimeResolveMutex()
     {
-        static std::recursive_mutex mutex;
-        return mutex;
+        return ContextLocal<BoneRuntimeResolveSlot>().mutex;
     }
 
     inline bool IsOffsetInRange(i32 offset, const StructMemberRange& range)
@@ -37,12 +41,17 @@ namespace detail
         return range.IsValid() && offset >= range.begin && offset < range.end;
     }
 
+    struct SkinnedMeshRangeSlot
+    {
+        std::mutex mutex;
+        u32 cachedPid = 0;
+        StructMemberRange cachedRange{};
+        bool resolved = false;
+    };
+
     inline StructMemberRange GetSkinnedMeshComponentMemberRange()
     {
-        static std::mutex mutex;
-        static u32 cachedPid = 0;
-        static StructMemberRange cachedRange{};
-        static bool resolved = false;
+        auto& [mutex, cachedPid, cachedRange, resolved] = ContextLocal<SkinnedMeshRangeSlot>();
 
         std::lock_guard<std::mutex> lock(mutex);
         if (cachedPid != Ctx().pid)
@@ -3,6 +3,7 @@
 // 通过 GNames (FNamePool 或 TNameEntryArray) 将 FName 索引解析为字符串
 
 #include "../core/context.hpp"
+#include "../core/utf.hpp"
 #include <string>
 #include <unordered_map>
 #include <mutex>
@@ -13,23 +14,49 @@ namespace xrd
 
 namespace detail
 {
+    // 缓存槽归属当前上下文（见 ContextLocal）
+    struct NameCacheSlot
+    {
+        std::unordered_map<i32, std::string> cache;
+        std::shared_mutex mtx;
+    };
+
     inline std::unordered_map<i32, std::string>& NameCache()
     {
-        static std::unordered_map<i32, std::string> cache;
-        return cache;
+        return ContextLocal<NameCacheSlot>().cache;
     }
 
     inline std::shared_mutex& NameCacheMutex()
     {
-        static std::shared_mutex mtx;
-        return mtx;
+        return ContextLocal<NameCacheSlot>().mtx;
     }
+
+    // FNamePool 条目正文解码：窄字符原样，UTF-16 宽字符转换为 UTF-8（见 core/utf.hpp）
+    // data 指向 header 之后的字符数据，len 为字符数
+    inline void DecodeNameEntry(const void* data, u16 len, bool isWide, std::string& out)
+    {
+        if (!isWide)
+        {
+            out.assign(static_cast<const char*>(data), len);
+            return;
+        }
+        Utf16ToUtf8(static_cast<const u16*>(data), len, out);
+    }
+
+    // FNamePool 本地镜像（names_mirror.hpp）：命中时免去远程读取
+    inline bool LookupNamePoolMirror(uptr gnames, i32 compIdx, std::string& out);
+    inline void ClearNamePoolMirror();
 } // namespace detail
 
+// 丢弃全部已解析名称与名称池镜像（切换进程时调用）
+// 同一进程长时间运行时用 SyncNamePool 增量同步，无需清空
 inline void ClearResolvedNameCache()
 {
-    std::unique_lock<std::shared_mutex> wlock(detail::NameCacheMutex());
-    detail::NameCache().clear();
+    {
+        std::unique_lock<std::shared_mutex> wlock(detail::NameCacheMutex());
+        detail::NameCache().clear();
+    }
+    detail::ClearNamePoolMirror();
 }
 
 inline bool ResolveName_NamePool(
@@ -70,7 +97,8 @@ inline bool ResolveNameCached(
     bool ok = false;
     if (off.bUseNamePool)
     {
-        ok = ResolveName_NamePool(mem, off.GNames, compIdx, resolved);
+        ok = detail::LookupNamePoolMirror(off.GNames, compIdx, resolved)
+            || ResolveName_NamePool(mem, off.GNames, compIdx, resolved);
     }
     else
     {
@@ -151,34 +179,12 @@ inline bool ResolveName_NamePool(
 
     if (isWide)
     {
-        // UTF-16 宽字符串，转换为 UTF-8
-        std::vector<wchar_t> wbuf(len + 1);
+        std::vector<u16> wbuf(len);
         if (!mem.Read(entryAddr + 2, wbuf.data(), len * 2))
         {
             return false;
         }
-        wbuf[len] = L'\0';
-        // WideCharToMultiByte 转 UTF-8
-        int needed = WideCharToMultiByte(
-            CP_UTF8, 0, wbuf.data(), len, nullptr, 0, nullptr, nullptr);
-        if (needed > 0)
-        {
-            out.resize(needed);
-            WideCharToMultiByte(
-                CP_UTF8, 0, wbuf.data(), len,
-                out.data(), needed, nullptr, nullptr);
-        }
-        else
-        {
-            // 回退：有损 ASCII 转换
-            out.resize(len);
-            for (u16 i = 0; i < len; ++i)
-            {
-                out[i] = (wbuf[i] < 128)
-                    ? static_cast<char>(wbuf[i])
-                    : '?';
-            }
-        }
+        detail::DecodeNameEntry(wbuf.data(), len, true, out);
     }
     else
     {
@@ -305,3 +311,5 @@ inline std::string ReadFNameAt(uptr address)
 }
 
 } // namespace xrd
+
+#include "names_mirror.hpp"
@@ -0,0 +1,229 @@
+#pragma once
+// Xrd-eXternalrEsolve - FName 批量解析
+// 从 names.hpp 拆分：一次读锁查缓存，未命中的名称经 ReadBatch 分轮读取
+// FNamePool：块指针 / 条目头 / 正文各一轮；驱动访问器下每轮为单次 IOCTL
+
+#include "names.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace xrd
+{
+
+namespace detail
+{
+    // 批量解析 FNamePool 条目，ids 已去重；失败项为空串
+    inline void ResolveNamePoolBatch(
+        const IMemoryAccessor& mem,
+        uptr gnames,
+        const std::vector<i32>& ids,
+        std::vector<std::string>& out)
+    {
+        out.assign(ids.size(), std::string());
+
+        i32 blockBits = Ctx().off.FNamePoolBlockBits;
+        if (blockBits <= 0)
+        {
+            blockBits = 16;
+        }
+        i32 stride = Ctx().off.FNameEntryStride;
+        if (stride <= 0)
+        {
+            stride = 2;
+        }
+
+        // 第一轮：涉及到的块指针
+        std::vector<i32> blocks;
+        blocks.reserve(ids.size());
+        for (i32 id : ids)
+        {
+            blocks.push_back(id >> blockBits);
+        }
+        std::sort(blocks.begin(), blocks.end());
+        blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+
+        std::vector<uptr> blockPtrs(blocks.size(), 0);
+        std::vector<ReadBatchDesc> descs(blocks.size());
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            descs[i] = {gnames + 0x10 + blocks[i] * sizeof(uptr), &blockPtrs[i], sizeof(uptr)};
+        }
+        mem.ReadBatch(descs.data(), static_cast<u32>(descs.size()));
+
+        // 第二轮：条目头（bit[0]=宽字符标志, bit[6..15]=长度）
+        std::vector<uptr> entryAddrs(ids.size(), 0);
+        std::vector<u16> headers(ids.size(), 0);
+        descs.clear();
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            i32 b = ids[i] >> blockBits;
+            size_t bi = std::lower_bound(blocks.begin(), blocks.end(), b) - blocks.begin();
+            if (!IsCanonicalUserPtr(blockPtrs[bi]))
+            {
+                continue;
+            }
+            entryAddrs[i] = blockPtrs[bi] + (ids[i] & ((1 << blockBits) - 1)) * stride;
+            descs.push_back({entryAddrs[i], &headers[i], sizeof(u16)});
+        }
+        if (descs.empty())
+        {
+            return;
+        }
+        mem.ReadBatch(descs.data(), static_cast<u32>(descs.size()));
+
+        // 第三轮：正文
+        std::vector<std::vector<u8>> bodies(ids.size());
+        descs.clear();
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            u16 len = headers[i] >> 6;
+            if (!entryAddrs[i] || len == 0 || len > 1024)
+            {
+                continue;
+            }
+            u32 bytes = (headers[i] & 1) ? len * 2u : len;
+            bodies[i].resize(bytes);
+            descs.push_back({entryAddrs[i] + 2, bodies[i].data(), bytes});
+        }
+        if (descs.empty())
+        {
+            return;
+        }
+        if (!mem.ReadBatch(descs.data(), static_cast<u32>(descs.size())))
+        {
+            // 部分正文读取失败时无法区分是哪一项：逐个重新解析，保证结果与单个解析一致
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                if (!bodies[i].empty()
+                    && !ResolveName_NamePool(mem, gnames, ids[i], out[i]))
+                {
+                    out[i].clear();
+                }
+            }
+            return;
+        }
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            if (!bodies[i].empty())
+            {
+                DecodeNameEntry(bodies[i].data(), headers[i] >> 6,
+                    (headers[i] & 1) != 0, out[i]);
+            }
+        }
+    }
+} // namespace detail
+
+// 批量解析 FName（ComparisonIndex + Number），结果与逐个调用 GetNameFromFName 一致
+// 无法解析的项为空串；解析结果写入共享名称缓存
+inline void ResolveNamesBatch(
+    const FName* names,
+    std::size_t count,
+    std::vector<std::string>& out)
+{
+    out.assign(count, std::string());
+    if (!IsInited() || !names || count == 0 || Off().GNames == 0)
+    {
+        return;
+    }
+
+    // 一次读锁查缓存
+    std::vector<i32> missing;
+    {
+        std::shared_lock<std::shared_mutex> rlock(detail::NameCacheMutex());
+        auto& cache = detail::NameCache();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            i32 id = names[i].ComparisonIndex;
+            if (id <= 0)
+            {
+                continue;
+            }
+            auto it = cache.find(id);
+            if (it != cache.end())
+            {
+                out[i] = it->second;
+            }
+            else
+            {
+                missing.push_back(id);
+            }
+        }
+    }
+
+    if (!missing.empty())
+    {
+        std::sort(missing.begin(), missing.end());
+        missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+        std::vector<std::string> resolved;
+        if (Off().bUseNamePool)
+        {
+            // 先查名称池镜像，只有镜像未覆盖的条目走远程批量读取
+            resolved.resize(missing.size());
+            std::vector<i32> remoteIds;
+            std::vector<size_t> remoteSlots;
+            for (size_t i = 0; i < missing.size(); ++i)
+            {
+                if (!detail::LookupNamePoolMirror(Off().GNames, missing[i], resolved[i]))
+                {
+                    remoteIds.push_back(missing[i]);
+                    remoteSlots.push_back(i);
+                }
+            }
+            if (!remoteIds.empty())
+            {
+                std::vector<std::string> remote;
+                detail::ResolveNamePoolBatch(Mem(), Off().GNames, remoteIds, remote);
+                for (size_t i = 0; i < remoteIds.size(); ++i)
+                {
+                    resolved[remoteSlots[i]] = std::move(remote[i]);
+                }
+            }
+        }
+        else
+        {
+            resolved.resize(missing.size());
+            for (size_t i = 0; i < missing.size(); ++i)
+            {
+                ResolveName_Array(Mem(), Off().GNames, missing[i], resolved[i]);
+            }
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> wlock(detail::NameCacheMutex());
+            auto& cache = detail::NameCache();
+            for (size_t i = 0; i < missing.size(); ++i)
+            {
+                if (!resolved[i].empty())
+                {
+                    cache.try_emplace(missing[i], resolved[i]);
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            i32 id = names[i].ComparisonIndex;
+            if (id <= 0 || !out[i].empty())
+            {
+                continue;
+            }
+            auto it = std::lower_bound(missing.begin(), missing.end(), id);
+            if (it != missing.end() && *it == id)
+            {
+                out[i] = resolved[it - missing.begin()];
+            }
+        }
+    }
+
+    // Number 后缀
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (!out[i].empty() && names[i].Number > 0)
+        {
+            out[i] += "_" + std::to_string(names[i].Number - 1);
+        }
+    }
+}
+
+} // namespace xrd
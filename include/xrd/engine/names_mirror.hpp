@@ -0,0 +1,261 @@
+#pragma once
+// Xrd-eXternalrEsolve - FNamePool 本地镜像
+// FNamePool 在游戏运行期间只追加：记录每个块已同步的字节数与池的 CurrentBlock / CurrentByteCursor，
+// Sync 只读取上次同步之后追加的字节，代价与新增名称量成正比
+// 镜像命中时 ResolveNameCached / ResolveNamesBatch 在本地解码，不再逐个远程读取
+// 由 names.hpp 末尾包含
+
+#include "names.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace xrd
+{
+
+// 一次同步的结果
+struct NamePoolSyncStats
+{
+    bool ok = false;
+    u32 newNames = 0;       // 本次新解析出的条目数
+    u64 bytesFetched = 0;   // 本次远程读取的条目字节数
+    u32 blocks = 0;         // 镜像当前覆盖的块数
+};
+
+class NamePoolMirror
+{
+public:
+    // 同步到池的当前状态；gnames 或块布局变化时从头重建
+    // 正在写入的尾部条目（游标已前移但头部尚为 0）不计入，下次同步重新读取
+    NamePoolSyncStats Sync(const IMemoryAccessor& mem, const UEOffsets& off)
+    {
+        std::lock_guard<std::mutex> syncLock(m_syncMtx);
+        NamePoolSyncStats stats;
+        if (!off.bUseNamePool || off.GNames == 0)
+        {
+            return stats;
+        }
+        u32 blockBits = off.FNamePoolBlockBits > 0 ? static_cast<u32>(off.FNamePoolBlockBits) : 16;
+        u32 stride = off.FNameEntryStride > 0 ? static_cast<u32>(off.FNameEntryStride) : 2;
+        u32 blockBytes = (1u << blockBits) * stride;
+
+        // 池头部：+0x08 CurrentBlock, +0x0C CurrentByteCursor, +0x10 Blocks[]
+        u32 current[2] = {0, 0};
+        if (!mem.Read(off.GNames + 0x08, current, sizeof(current))
+            || current[0] > 0x2000 || current[1] > blockBytes)
+        {
+            return stats;
+        }
+        u32 currentBlock = current[0];
+        u32 cursor = current[1];
+
+        if (m_gnames != off.GNames || m_blockBits != blockBits || m_stride != stride)
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mtx);
+            m_blocks.clear();
+            m_count = 0;
+            m_gnames = off.GNames;
+            m_blockBits = blockBits;
+            m_stride = stride;
+        }
+
+        // 新出现的块指针一次读齐
+        size_t known = m_blocks.size();
+        std::vector<uptr> newPtrs;
+        if (currentBlock + 1 > known)
+        {
+            newPtrs.resize(currentBlock + 1 - known);
+            if (!mem.Read(off.GNames + 0x10 + known * sizeof(uptr),
+                    newPtrs.data(), newPtrs.size() * sizeof(uptr)))
+            {
+                return stats;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        for (uptr p : newPtrs)
+        {
+            m_blocks.push_back(Block{p});
+        }
+        stats.ok = true;
+        for (u32 b = 0; b <= currentBlock && stats.ok; ++b)
+        {
+            Block& block = m_blocks[b];
+            if (block.complete)
+            {
+                continue;
+            }
+            bool isCurrent = (b == currentBlock);
+            u32 end = isCurrent ? cursor : blockBytes;
+            u32 have = static_cast<u32>(block.bytes.size());
+            if (end > have)
+            {
+                block.bytes.resize(end);
+                if (!IsCanonicalUserPtr(block.addr)
+                    || !mem.Read(block.addr + have, block.bytes.data() + have, end - have))
+                {
+                    // 读取失败：保留已同步部分，下次从同一位置继续
+                    block.bytes.resize(have);
+                    stats.ok = false;
+                    break;
+                }
+                stats.bytesFetched += end - have;
+            }
+            stats.newNames += Parse(block, !isCurrent);
+        }
+        m_count += stats.newNames;
+        stats.blocks = static_cast<u32>(m_blocks.size());
+        return stats;
+    }
+
+    // 本地解码；条目不在已同步范围内时返回 false（调用方回退到远程读取）
+    bool Lookup(uptr gnames, i32 compIdx, std::string& out) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        if (compIdx < 0 || gnames != m_gnames || m_blocks.empty())
+        {
+            return false;
+        }
+        u32 b = static_cast<u32>(compIdx) >> m_blockBits;
+        if (b >= m_blocks.size())
+        {
+            return false;
+        }
+        const Block& block = m_blocks[b];
+        u32 pos = (static_cast<u32>(compIdx) & ((1u << m_blockBits) - 1)) * m_stride;
+        if (pos + 2 > block.parsed)
+        {
+            return false;
+        }
+        u16 header = 0;
+        std::memcpy(&header, block.bytes.data() + pos, sizeof(header));
+        u16 len = header >> 6;
+        bool isWide = (header & 1) != 0;
+        u32 body = isWide ? len * 2u : len;
+        if (len == 0 || len > 1024 || pos + 2 + body > block.parsed)
+        {
+            return false;
+        }
+        detail::DecodeNameEntry(block.bytes.data() + pos + 2, len, isWide, out);
+        return true;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> syncLock(m_syncMtx);
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        m_blocks.clear();
+        m_count = 0;
+        m_gnames = 0;
+    }
+
+    bool Ready() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return m_count > 0;
+    }
+
+    // 已镜像的条目数
+    u64 Count() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return m_count;
+    }
+
+    // 镜像占用的条目字节数
+    u64 Bytes() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        u64 total = 0;
+        for (auto& b : m_blocks)
+        {
+            total += b.bytes.size();
+        }
+        return total;
+    }
+
+private:
+    struct Block
+    {
+        uptr addr = 0;
+        std::vector<u8> bytes;  // 已读取的块前缀
+        u32 parsed = 0;         // 已确认完整的条目末尾（stride 对齐）
+        bool complete = false;  // 已写满的块：不会再变化
+    };
+
+    // 从 parsed 处解析新条目，返回新增条目数
+    // 写满的块遇到头部为 0 即是块尾空隙，标记完成；当前块遇到 0 说明条目尚未写完，丢弃其后的字节
+    u32 Parse(Block& block, bool full)
+    {
+        u32 added = 0;
+        u32 pos = block.parsed;
+        u32 size = static_cast<u32>(block.bytes.size());
+        while (pos + 2 <= size)
+        {
+            u16 header = 0;
+            std::memcpy(&header, block.bytes.data() + pos, sizeof(header));
+            u16 len = header >> 6;
+            u32 entry = 2 + ((header & 1) ? len * 2u : len);
+            if (len == 0 || pos + entry > size)
+            {
+                break;
+            }
+            added++;
+            pos = (pos + entry + m_stride - 1) / m_stride * m_stride;
+        }
+        block.parsed = (std::min)(pos, size);
+        if (full)
+        {
+            block.complete = true;
+            std::vector<u8>(block.bytes.begin(), block.bytes.begin() + block.parsed).swap(block.bytes);
+        }
+        else
+        {
+            block.bytes.resize(block.parsed);
+        }
+        return added;
+    }
+
+    mutable std::shared_mutex m_mtx;
+    std::mutex m_syncMtx;
+    std::vector<Block> m_blocks;
+    u64 m_count = 0;
+    uptr m_gnames = 0;
+    u32 m_blockBits = 16;
+    u32 m_stride = 2;
+};
+
+// 当前上下文的名称池镜像
+inline NamePoolMirror& GetNamePoolMirror()
+{
+    return ContextLocal<NamePoolMirror>();
+}
+
+// 以全局上下文同步名称池镜像（首次调用读取整个池，之后只读追加部分）
+// 长时间运行的会话可周期性调用，替代 ClearResolvedNameCache 后逐个重新解析
+inline NamePoolSyncStats SyncNamePool()
+{
+    if (!IsInited())
+    {
+        return {};
+    }
+    return GetNamePoolMirror().Sync(Mem(), Off());
+}
+
+namespace detail
+{
+    inline bool LookupNamePoolMirror(uptr gnames, i32 compIdx, std::string& out)
+    {
+        return GetNamePoolMirror().Lookup(gnames, compIdx, out);
+    }
+
+    inline void ClearNamePoolMirror()
+    {
+        GetNamePoolMirror().Clear();
+    }
+} // namespace detail
+
+} // namespace xrd
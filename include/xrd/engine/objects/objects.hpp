@@ -39,28 +39,36 @@ inline uptr GetObjectByIndex(i32 index)
 // 名称缓存：避免重复 ReadProcessMemory
 namespace detail
 {
+    struct ObjectNameCacheSlot
+    {
+        std::unordered_map<uptr, std::string> cache;
+        std::shared_mutex mtx;
+    };
+
+    struct ObjectClassNameCacheSlot
+    {
+        std::unordered_map<uptr, std::string> cache;
+        std::shared_mutex mtx;
+    };
+
     inline std::unordered_map<uptr, std::string>& GetNameCache()
     {
-        static std::unordered_map<uptr, std::string> cache;
-        return cache;
+        return ContextLocal<ObjectNameCacheSlot>().cache;
     }
 
     inline std::shared_mutex& GetNameCacheMutex()
     {
-        static std::shared_mutex mtx;
-        return mtx;
+        return ContextLocal<ObjectNameCacheSlot>().mtx;
     }
 
     inline std::unordered_map<uptr, std::string>& GetClassNameCache()
     {
-        static std::unordered_map<uptr, std::string> cache;
-        return cache;
+        return ContextLocal<ObjectClassNameCacheSlot>().cache;
     }
 
     inline std::shared_mutex& GetClassNameCacheMutex()
     {
-        static std::shared_mutex mtx;
-        return mtx;
+        return ContextLocal<ObjectClassNameCacheSlot>().mtx;
     }
 } // namespace detail
 
@@ -372,32 +380,64 @@ inline u64 GetPropertyFlags(uptr prop)
     return flags;
 }
 
-// 读取 FProperty 的 alignment
-// 对标 Rei-Dumper UEProperty::GetAlignment：使用 EClassCastFlags 精确判断类型
-inline i32 GetPropertyAlignment(uptr prop)
+// FFieldClass CastFlags 缓存（FFieldClass 全局只有几十个，缓存后避免重复远程读取）
+// 导出期间归属 DumpSession（SessionLocal），结束时随会话释放
+// 多线程采集时并发读写，使用读写锁保护
+namespace detail
 {
-    auto& off = Off();
+    struct FieldClassCacheSlot
+    {
+        std::unordered_map<uptr, u64> cache;
+        std::shared_mutex mtx;
+        CacheCounters counters;
+    };
 
-    // 读取 FFieldClass::CastFlags（带本地缓存）
-    static std::unordered_map<uptr, u64> fieldClassCache;
-    u64 cf = 0;
+    inline std::unordered_map<uptr, u64>& GetFieldClassCache()
     {
-        uptr cls = 0;
-        GReadPtr(prop + off.FField_Class, cls);
-        if (cls)
+        return SessionLocal<FieldClassCacheSlot>().cache;
+    }
+
+    inline std::shared_mutex& GetFieldClassCacheMutex()
+    {
+        return SessionLocal<FieldClassCacheSlot>().mtx;
+    }
+
+    // 读取 FFieldClass::CastFlags（带缓存）
+    inline u64 ReadFieldClassCastFlags(uptr cls)
+    {
+        if (!cls)
         {
-            auto cit = fieldClassCache.find(cls);
-            if (cit != fieldClassCache.end())
-            {
-                cf = cit->second;
-            }
-            else
+            return 0;
+        }
+        auto& slot = SessionLocal<FieldClassCacheSlot>();
+        {
+            std::shared_lock<std::shared_mutex> rlock(slot.mtx);
+            auto it = slot.cache.find(cls);
+            if (it != slot.cache.end())
             {
-                GReadValue(cls + off.FFieldClass_CastFlags, cf);
-                fieldClassCache[cls] = cf;
+                slot.counters.Hit();
+                return it->second;
             }
         }
+        slot.counters.Miss();
+        u64 flags = 0;
+        GReadValue(cls + Off().FFieldClass_CastFlags, flags);
+        std::unique_lock<std::shared_mutex> wlock(slot.mtx);
+        slot.cache.try_emplace(cls, flags);
+        return flags;
     }
+} // namespace detail
+
+// 读取 FProperty 的 alignment
+// 对标 Rei-Dumper UEProperty::GetAlignment：使用 EClassCastFlags 精确判断类型
+inline i32 GetPropertyAlignment(uptr prop)
+{
+    auto& off = Off();
+
+    // 读取 FFieldClass::CastFlags（带缓存）
+    uptr cls = 0;
+    GReadPtr(prop + off.FField_Class, cls);
+    u64 cf = detail::ReadFieldClassCastFlags(cls);
 
     constexpr i32 ptrAlign = sizeof(void*); // 8
 
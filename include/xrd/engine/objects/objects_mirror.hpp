@@ -0,0 +1,373 @@
+#pragma once
+// Xrd-eXternalrEsolve - GObjects 增量镜像
+// 每次同步按块整段读取 FUObjectItem 数组，在本地逐槽比较对象指针与 SerialNumber，
+// 只对变化的槽重新读取类指针并失效旧指针的名称缓存；变化集合（新增 / 移除 / 复用）推送给订阅者
+// 长期运行的工具以 ForEach 遍历本地镜像，不再逐个 GetObjectByIndex
+
+#include "objects.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace xrd
+{
+
+// 一次同步的变化集合（索引升序）
+struct ObjectTableDelta
+{
+    bool ok = false;
+    i32 count = 0;              // 同步后的槽数（NumElements）
+    std::vector<i32> added;     // 空槽 / 新槽出现对象
+    std::vector<i32> removed;   // 对象被销毁（槽变空或超出新的 NumElements）
+    std::vector<i32> reused;    // 槽被新对象占用（指针或 SerialNumber 变化）
+    u64 bytesFetched = 0;       // 本次读取的 FUObjectItem 字节数
+    u32 reads = 0;              // 本次整段读取次数
+
+    bool Empty() const { return added.empty() && removed.empty() && reused.empty(); }
+};
+
+class ObjectTableMirror
+{
+public:
+    using Subscriber = std::function<void(const ObjectTableDelta&)>;
+
+    // 同步到 GObjects 的当前状态；GObjects 地址或条目布局变化时从头重建（全部槽计为新增）
+    // 订阅者在本线程、释放全部镜像锁之后依次调用，回调内可以读取镜像或再次 Sync
+    // 多个线程并发 Sync 时，各自的通知之间不保证按同步完成的先后排列
+    ObjectTableDelta Sync(const IMemoryAccessor& mem, const UEOffsets& off)
+    {
+        std::unique_lock<std::mutex> syncLock(m_syncMtx);
+        ObjectTableDelta delta;
+        if (off.GObjects == 0 || off.FUObjectItemSize < off.FUObjectItemInitialOffset + 8)
+        {
+            return delta;
+        }
+        i32 count = resolve::GetObjectCount(mem, off);
+        if (count < 0 || count > 0x4000000)
+        {
+            return delta;
+        }
+
+        std::vector<Slot> next;
+        if (!FetchSlots(mem, off, count, next, delta))
+        {
+            return delta;
+        }
+
+        if (m_gobjects != off.GObjects || m_itemSize != off.FUObjectItemSize
+            || m_serialOffset != SerialOffset(off))
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mtx);
+            m_slots.clear();
+            m_gobjects = off.GObjects;
+            m_itemSize = off.FUObjectItemSize;
+            m_serialOffset = SerialOffset(off);
+        }
+
+        // 本地比较：只收集变化的槽
+        std::vector<uptr> stale;
+        std::vector<i32> changed;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mtx);
+            i32 old = static_cast<i32>(m_slots.size());
+            for (i32 i = 0; i < count; ++i)
+            {
+                const Slot& n = next[i];
+                const Slot* o = i < old ? &m_slots[i] : nullptr;
+                bool had = o && o->obj != 0;
+                if (!had)
+                {
+                    if (n.obj)
+                    {
+                        delta.added.push_back(i);
+                        changed.push_back(i);
+                    }
+                    continue;
+                }
+                if (!n.obj)
+                {
+                    delta.removed.push_back(i);
+                    stale.push_back(o->obj);
+                }
+                else if (n.obj != o->obj || (o->serial != 0 && n.serial != o->serial))
+                {
+                    delta.reused.push_back(i);
+                    stale.push_back(o->obj);
+                    changed.push_back(i);
+                }
+                else
+                {
+                    // 未变化：沿用已解码的类指针（SerialNumber 可能由 0 变为首次分配的值）
+                    next[i].cls = o->cls;
+                }
+            }
+            for (i32 i = count; i < old; ++i)
+            {
+                if (m_slots[i].obj)
+                {
+                    delta.removed.push_back(i);
+                    stale.push_back(m_slots[i].obj);
+                }
+            }
+        }
+
+        DecodeClasses(mem, off, changed, next);
+        InvalidateNameCaches(stale);
+
+        std::vector<std::pair<u32, Subscriber>> subscribers;
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mtx);
+            m_slots.swap(next);
+            m_live = 0;
+            for (auto& s : m_slots)
+            {
+                m_live += s.obj != 0;
+            }
+            subscribers = m_subscribers;
+        }
+        delta.ok = true;
+        delta.count = count;
+        syncLock.unlock();
+        if (!delta.Empty())
+        {
+            for (auto& [id, fn] : subscribers)
+            {
+                fn(delta);
+            }
+        }
+        return delta;
+    }
+
+    // 订阅变化；返回的编号用于 Unsubscribe
+    u32 Subscribe(Subscriber fn)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        u32 id = ++m_nextId;
+        m_subscribers.emplace_back(id, std::move(fn));
+        return id;
+    }
+
+    void Unsubscribe(u32 id)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        std::erase_if(m_subscribers, [id](const auto& s) { return s.first == id; });
+    }
+
+    // 遍历镜像中的非空槽（不产生远程读取）；回调返回 false 提前结束
+    // 回调期间持有读锁，不要在回调内调用 Sync
+    void ForEach(const std::function<bool(uptr obj, i32 index, uptr cls)>& callback) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        for (i32 i = 0; i < static_cast<i32>(m_slots.size()); ++i)
+        {
+            const Slot& s = m_slots[i];
+            if (s.obj && !callback(s.obj, i, s.cls))
+            {
+                break;
+            }
+        }
+    }
+
+    uptr ObjectAt(i32 index) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return index >= 0 && index < static_cast<i32>(m_slots.size()) ? m_slots[index].obj : 0;
+    }
+
+    uptr ClassAt(i32 index) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return index >= 0 && index < static_cast<i32>(m_slots.size()) ? m_slots[index].cls : 0;
+    }
+
+    i32 SerialAt(i32 index) const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return index >= 0 && index < static_cast<i32>(m_slots.size()) ? m_slots[index].serial : 0;
+    }
+
+    // 镜像的槽数 / 非空槽数
+    i32 Count() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return static_cast<i32>(m_slots.size());
+    }
+
+    i32 LiveCount() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return m_live;
+    }
+
+    // 清空镜像（保留订阅者）；下次同步全部槽计为新增
+    void Clear()
+    {
+        std::lock_guard<std::mutex> syncLock(m_syncMtx);
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        m_slots.clear();
+        m_live = 0;
+        m_gobjects = 0;
+    }
+
+private:
+    struct Slot
+    {
+        uptr obj = 0;
+        uptr cls = 0;
+        i32 serial = 0;
+    };
+
+    // FUObjectItem: Object / Flags / ClusterRootIndex / SerialNumber
+    // SerialNumber 偏移随引擎版本不同（见 UEOffsets::FUObjectItemSerialNumberOffset）
+    // 条目不足以容纳 SerialNumber 时只比较对象指针
+    static i32 SerialOffset(const UEOffsets& off)
+    {
+        i32 pos = off.FUObjectItemInitialOffset + off.FUObjectItemSerialNumberOffset;
+        return pos + 4 <= off.FUObjectItemSize ? pos : -1;
+    }
+
+    // 按块整段读取 [0, count) 的条目并拆成槽
+    static bool FetchSlots(const IMemoryAccessor& mem, const UEOffsets& off, i32 count,
+        std::vector<Slot>& out, ObjectTableDelta& delta)
+    {
+        out.assign(static_cast<size_t>(count), Slot{});
+        if (count == 0)
+        {
+            return true;
+        }
+        i32 itemSize = off.FUObjectItemSize;
+        i32 serialOff = SerialOffset(off);
+        i32 per = off.bIsChunkedObjArray && off.ChunkSize > 0 ? off.ChunkSize : count;
+        i32 chunks = (count + per - 1) / per;
+
+        std::vector<uptr> bases(static_cast<size_t>(chunks), 0);
+        uptr table = 0;
+        if (!ReadPtr(mem, off.GObjects, table) || !IsCanonicalUserPtr(table))
+        {
+            return false;
+        }
+        if (off.bIsChunkedObjArray)
+        {
+            if (!mem.Read(table, bases.data(), bases.size() * sizeof(uptr)))
+            {
+                return false;
+            }
+            delta.reads++;
+        }
+        else
+        {
+            bases[0] = table;
+        }
+
+        std::vector<u8> buf;
+        for (i32 c = 0; c < chunks; ++c)
+        {
+            i32 first = c * per;
+            i32 n = (std::min)(per, count - first);
+            if (!IsCanonicalUserPtr(bases[c]))
+            {
+                continue; // 块尚未分配：槽保持为空
+            }
+            buf.resize(static_cast<size_t>(n) * itemSize);
+            if (!mem.Read(bases[c], buf.data(), buf.size()))
+            {
+                return false;
+            }
+            delta.reads++;
+            delta.bytesFetched += buf.size();
+            for (i32 i = 0; i < n; ++i)
+            {
+                const u8* item = buf.data() + static_cast<size_t>(i) * itemSize;
+                Slot& s = out[first + i];
+                std::memcpy(&s.obj, item + off.FUObjectItemInitialOffset, sizeof(uptr));
+                if (!IsCanonicalUserPtr(s.obj))
+                {
+                    s.obj = 0;
+                    continue;
+                }
+                if (serialOff >= 0)
+                {
+                    std::memcpy(&s.serial, item + serialOff, sizeof(i32));
+                }
+            }
+        }
+        return true;
+    }
+
+    // 变化槽的类指针一轮 ReadBatch 读齐
+    static void DecodeClasses(const IMemoryAccessor& mem, const UEOffsets& off,
+        const std::vector<i32>& changed, std::vector<Slot>& slots)
+    {
+        if (changed.empty())
+        {
+            return;
+        }
+        std::vector<ReadBatchDesc> descs(changed.size());
+        for (size_t i = 0; i < changed.size(); ++i)
+        {
+            Slot& s = slots[changed[i]];
+            descs[i] = {s.obj + off.UObject_Class, &s.cls, sizeof(uptr)};
+        }
+        mem.ReadBatch(descs.data(), static_cast<u32>(descs.size()));
+        for (i32 idx : changed)
+        {
+            if (!IsCanonicalUserPtr(slots[idx].cls))
+            {
+                slots[idx].cls = 0;
+            }
+        }
+    }
+
+    // 旧对象已销毁，其地址可能被新对象复用：丢弃按地址缓存的名称
+    static void InvalidateNameCaches(const std::vector<uptr>& stale)
+    {
+        if (stale.empty())
+        {
+            return;
+        }
+        {
+            std::unique_lock<std::shared_mutex> wlock(detail::GetNameCacheMutex());
+            for (uptr p : stale)
+            {
+                detail::GetNameCache().erase(p);
+            }
+        }
+        std::unique_lock<std::shared_mutex> wlock(detail::GetClassNameCacheMutex());
+        for (uptr p : stale)
+        {
+            detail::GetClassNameCache().erase(p);
+        }
+    }
+
+    mutable std::shared_mutex m_mtx;
+    std::mutex m_syncMtx;
+    std::vector<Slot> m_slots;
+    std::vector<std::pair<u32, Subscriber>> m_subscribers;
+    u32 m_nextId = 0;
+    i32 m_live = 0;
+    uptr m_gobjects = 0;
+    i32 m_itemSize = 0;
+    i32 m_serialOffset = 0;
+};
+
+// 当前上下文的对象表镜像
+inline ObjectTableMirror& GetObjectTableMirror()
+{
+    return ContextLocal<ObjectTableMirror>();
+}
+
+// 以全局上下文同步对象表镜像；首次调用等同一次整表读取
+inline ObjectTableDelta SyncObjectTable()
+{
+    if (!IsInited())
+    {
+        return {};
+    }
+    return GetObjectTableMirror().Sync(Mem(), Off());
+}
+
+} // namespace xrd
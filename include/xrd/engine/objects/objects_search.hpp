@@ -131,16 +131,20 @@ namespace detail
         }
     };
 
+    struct PropOffsetCacheSlot
+    {
+        std::unordered_map<PropCacheKey, i32, PropCacheKeyHash> cache;
+        std::shared_mutex mtx;
+    };
+
     inline std::unordered_map<PropCacheKey, i32, PropCacheKeyHash>& PropOffsetCache()
     {
-        static std::unordered_map<PropCacheKey, i32, PropCacheKeyHash> cache;
-        return cache;
+        return ContextLocal<PropOffsetCacheSlot>().cache;
     }
 
     inline std::shared_mutex& PropOffsetCacheMutex()
     {
-        static std::shared_mutex mtx;
-        return mtx;
+        return ContextLocal<PropOffsetCacheSlot>().mtx;
     }
 } // namespace detail
 
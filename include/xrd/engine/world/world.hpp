@@ -18,10 +18,15 @@ namespace xrd
 
 namespace detail
 {
+    struct GWorldResolveSlot
+    {
+        std::mutex mtx;
+        std::chrono::steady_clock::time_point lastAttempt{};
+    };
+
     inline std::mutex& GWorldResolveMutex()
     {
-        static std::mutex m;
-        return m;
+        return ContextLocal<GWorldResolveSlot>().mtx;
     }
 
     // 延迟发现 World 链偏移（与 AutoInit Phase 6 相同逻辑）
@@ -67,17 +72,15 @@ namespace detail
             return;
         }
 
-        uptr lpData = 0;
-        i32 lpCount = 0;
-        ReadPtr(*ctx.mem, gi + ctx.off.UGameInstance_LocalPlayers, lpData);
-        ReadI32(*ctx.mem, gi + ctx.off.UGameInstance_LocalPlayers + 8, lpCount);
-        if (!IsCanonicalUserPtr(lpData) || lpCount <= 0)
+        std::vector<uptr> localPlayers;
+        ReadRemoteArray(*ctx.mem, gi + ctx.off.UGameInstance_LocalPlayers, localPlayers);
+        if (localPlayers.empty())
         {
             return;
         }
 
-        uptr lp0 = 0;
-        if (!ReadPtr(*ctx.mem, lpData, lp0) || !IsCanonicalUserPtr(lp0))
+        uptr lp0 = localPlayers[0];
+        if (!IsCanonicalUserPtr(lp0))
         {
             return;
         }
@@ -146,11 +149,11 @@ namespace detail
     inline bool TryLazyResolveGWorld()
     {
         using clock = std::chrono::steady_clock;
-        static auto s_lastAttempt = clock::time_point{};
+        auto& lastAttempt = ContextLocal<GWorldResolveSlot>().lastAttempt;
 
         // 无锁快速检查冷却，避免频繁加锁
         auto now = clock::now();
-        if (now - s_lastAttempt < std::chrono::seconds(3))
+        if (now - lastAttempt < std::chrono::seconds(3))
         {
             return false;
         }
@@ -166,11 +169,11 @@ namespace detail
 
         // 双检查冷却（持锁后再验一次）
         now = clock::now();
-        if (now - s_lastAttempt < std::chrono::seconds(3))
+        if (now - lastAttempt < std::chrono::seconds(3))
         {
             return false;
         }
-        s_lastAttempt = now;
+        lastAttempt = now;
 
         std::cerr << "[xrd] 尝试延迟扫描 GWorld...\n";
 
@@ -64,15 +64,13 @@ inline uptr GetPlayerController()
             uptr gi = 0;
             if (GReadPtr(world + off.UWorld_OwningGameInstance, gi) && IsCanonicalUserPtr(gi))
             {
-                uptr lpData = 0;
-                i32 lpCount = 0;
-                GReadPtr(gi + off.UGameInstance_LocalPlayers, lpData);
-                GReadI32(gi + off.UGameInstance_LocalPlayers + 8, lpCount);
+                std::vector<uptr> localPlayers;
+                GReadRemoteArray(gi + off.UGameInstance_LocalPlayers, localPlayers);
 
-                if (IsCanonicalUserPtr(lpData) && lpCount > 0)
+                if (!localPlayers.empty())
                 {
-                    uptr lp0 = 0;
-                    if (GReadPtr(lpData, lp0) && IsCanonicalUserPtr(lp0))
+                    uptr lp0 = localPlayers[0];
+                    if (IsCanonicalUserPtr(lp0))
                     {
                         uptr pc = 0;
                         if (GReadPtr(lp0 + off.ULocalPlayer_PlayerController, pc) && IsCanonicalUserPtr(pc))
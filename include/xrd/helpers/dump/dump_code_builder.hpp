@@ -0,0 +1,177 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：代码输出构建器
+// 分块追加缓冲区：生成函数直接向其追加文本或 format 结果，避免临时字符串
+// 块按几何级数增长，已写入的内容不搬移；最终 ToString 一次性拼接
+
+#include "../../core/types.hpp"
+#include <string>
+#include <string_view>
+#include <format>
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+namespace xrd
+{
+namespace detail
+{
+
+class CodeBuilder
+{
+public:
+    static constexpr size_t kInitialChunk = 4 * 1024;
+    static constexpr size_t kMaxChunk = 1024 * 1024;
+
+    CodeBuilder() = default;
+    CodeBuilder(const CodeBuilder&) = delete;
+    CodeBuilder& operator=(const CodeBuilder&) = delete;
+    CodeBuilder(CodeBuilder&&) = default;
+    CodeBuilder& operator=(CodeBuilder&&) = default;
+
+    void Append(std::string_view s)
+    {
+        while (!s.empty())
+        {
+            if (chunks.empty() || chunks.back().used == chunks.back().cap)
+            {
+                Grow(s.size());
+            }
+            Chunk& c = chunks.back();
+            size_t n = (std::min)(s.size(), c.cap - c.used);
+            std::memcpy(c.data.get() + c.used, s.data(), n);
+            c.used += n;
+            total += n;
+            s.remove_prefix(n);
+        }
+    }
+
+    void Append(char ch)
+    {
+        if (chunks.empty() || chunks.back().used == chunks.back().cap)
+        {
+            Grow(1);
+        }
+        Chunk& c = chunks.back();
+        c.data[c.used++] = ch;
+        total++;
+    }
+
+    CodeBuilder& operator+=(std::string_view s)
+    {
+        Append(s);
+        return *this;
+    }
+
+    CodeBuilder& operator+=(char ch)
+    {
+        Append(ch);
+        return *this;
+    }
+
+    // 直接格式化到缓冲区，不产生临时字符串
+    template<typename... Args>
+    void Format(std::format_string<Args...> fmt, Args&&... args)
+    {
+        std::format_to(Inserter{this}, fmt, std::forward<Args>(args)...);
+    }
+
+    size_t Size() const { return total; }
+    bool Empty() const { return total == 0; }
+
+    // 块分配次数（生成统计用）
+    u64 Allocations() const { return allocations; }
+
+    // 当前线程所有 CodeBuilder 的累计块分配次数
+    // 调用方在一段生成前后取差值，得到该段的分配次数
+    static u64& ThreadAllocations()
+    {
+        thread_local u64 count = 0;
+        return count;
+    }
+
+    // 可复用的临时字符串：拼接列文本等短暂用途，容量跨调用保留
+    // 返回前已清空；同一时刻只能有一个使用者
+    std::string& Scratch()
+    {
+        scratch.clear();
+        return scratch;
+    }
+
+    void AppendTo(std::string& out) const
+    {
+        out.reserve(out.size() + total);
+        for (auto& c : chunks)
+        {
+            out.append(c.data.get(), c.used);
+        }
+    }
+
+    void AppendTo(CodeBuilder& out) const
+    {
+        for (auto& c : chunks)
+        {
+            out.Append(std::string_view(c.data.get(), c.used));
+        }
+    }
+
+    std::string ToString() const
+    {
+        std::string out;
+        AppendTo(out);
+        return out;
+    }
+
+    // 输出迭代器：std::format_to 逐字符写入当前块
+    struct Inserter
+    {
+        using iterator_category = std::output_iterator_tag;
+        using value_type = void;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = void;
+
+        CodeBuilder* b;
+
+        Inserter& operator=(char ch)
+        {
+            b->Append(ch);
+            return *this;
+        }
+        Inserter& operator*() { return *this; }
+        Inserter& operator++() { return *this; }
+        Inserter operator++(int) { return *this; }
+    };
+
+private:
+    struct Chunk
+    {
+        std::unique_ptr<char[]> data;
+        size_t used = 0;
+        size_t cap = 0;
+    };
+
+    void Grow(size_t hint)
+    {
+        size_t cap = chunks.empty()
+            ? kInitialChunk
+            : (std::min)(chunks.back().cap * 2, kMaxChunk);
+        cap = (std::max)(cap, (std::min)(hint, kMaxChunk));
+        Chunk c;
+        c.data.reset(new char[cap]);
+        c.cap = cap;
+        chunks.push_back(std::move(c));
+        allocations++;
+        ThreadAllocations()++;
+    }
+
+    std::vector<Chunk> chunks;
+    size_t total = 0;
+    u64 allocations = 0;
+    std::string scratch;
+};
+
+} // namespace detail
+} // namespace xrd
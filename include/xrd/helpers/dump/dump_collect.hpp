@@ -5,69 +5,99 @@
 #include "../../core/context.hpp"
 #include "../../engine/objects/objects.hpp"
 #include "dump_type_resolve.hpp"
+#include "dump_string_pool.hpp"
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
+#include <mutex>
+#include <shared_mutex>
 
 namespace xrd
 {
 namespace detail
 {
 
+// 名称类字段为驻留字符串（4 字节编号），数值字段紧凑排列
+// 大型游戏上数十万条属性的缓存主要由这些字符串构成，驻留后每种文本只存一份
 struct PropertyInfo
 {
-    std::string name;
-    std::string typeName;
-    std::string fieldClassName; // 原始 FField 类名，用于 BitField 判断
+    InternedString name;
+    InternedString typeName;
+    InternedString fieldClassName; // 原始 FField 类名，用于 BitField 判断
     i32 offset   = 0;
     i32 size     = 0;
     i32 arrayDim = 1;
-    u64 flags    = 0;
     // BoolProperty BitField 信息
     bool isBitField = false;
     u8 bitIndex     = 0;
     u8 bitCount     = 1;
     u8 fieldMask    = 0xFF;
+    u64 flags    = 0;
+    // 类型描述符：在线采集时有效，至下次 ClearTypeDescCache；离线加载的模型为空
+    const TypeDesc* typeDesc = nullptr;
+    TypeRefList typeRefs; // 类型中引用的结构体/枚举（驻留列表，冷数据不随属性复制）
 };
 
 struct FunctionParam
 {
-    std::string name;
-    std::string typeName;       // 原始类型（参数结构体中使用）
-    std::string sigTypeName;    // 签名类型（含 const/&/* 修饰）
-    std::string fieldClassName; // 原始属性类名，用于判断 move 类型
-    u64 flags = 0;
+    InternedString name;
+    InternedString typeName;       // 原始类型（参数结构体中使用）
+    InternedString sigTypeName;    // 签名类型（含 const/&/* 修饰）
+    InternedString fieldClassName; // 原始属性类名，用于判断 move 类型
     i32 offset = 0;
     i32 size   = 0;
+    u64 flags = 0;
     bool isReturnParam = false;
     bool isOutParam    = false;
     bool isConstParam  = false;
     bool isRefParam    = false;  // OutParm + ReferenceParm = 引用参数
     bool isMoveType    = false;  // 大类型使用 std::move
+    TypeRefList typeRefs; // 类型中引用的结构体/枚举（驻留列表）
 };
 
 struct FunctionInfo
 {
-    std::string name;
-    std::string returnType;
-    u64 functionFlags = 0;
+    InternedString name;
+    InternedString returnType;
     i32 paramStructSize = 0; // UFunction 的 ParamsSize
+    u64 functionFlags = 0;
     std::vector<FunctionParam> params;
 };
 
+// 属性 / 函数缓存归属当前导出会话（见 DumpSession），未绑定会话时归属上下文
+struct PropertiesCacheSlot
+{
+    std::unordered_map<uptr, std::vector<PropertyInfo>> cache;
+    std::shared_mutex mtx;
+    CacheCounters counters;
+};
+
+struct FunctionsCacheSlot
+{
+    std::unordered_map<uptr, std::vector<FunctionInfo>> cache;
+    std::shared_mutex mtx;
+    CacheCounters counters;
+};
+
 // 属性缓存：每个 struct 地址只读一次，避免重复 ReadProcessMemory
 // 4592 structs × 平均10属性 × 3次调用 = 节省 ~80% 的远程读取
 inline std::unordered_map<uptr, std::vector<PropertyInfo>>& GetPropertiesCache()
 {
-    static std::unordered_map<uptr, std::vector<PropertyInfo>> cache;
-    return cache;
+    return SessionLocal<PropertiesCacheSlot>().cache;
+}
+
+// 属性缓存读写锁：多线程采集时共享读、独占写
+inline std::shared_mutex& GetPropertiesCacheMutex()
+{
+    return SessionLocal<PropertiesCacheSlot>().mtx;
 }
 
 // 清空属性缓存（每次 DumpSdk 开始前调用）
 inline void ClearPropertiesCache()
 {
+    std::unique_lock<std::shared_mutex> wlock(GetPropertiesCacheMutex());
     GetPropertiesCache().clear();
 }
 
@@ -117,18 +147,9 @@ inline void ReadBoolPropertyBitInfo(uptr prop, PropertyInfo& pi)
     }
 }
 
-// 收集一个 UStruct 的所有属性（精确类型）
-// 结果缓存到 GetPropertiesCache()，每个 struct 地址只读一次
-inline std::vector<PropertyInfo> CollectProperties(uptr structObj)
+// 从进程读取一个 UStruct 的所有属性（精确类型），按偏移排序；不经过缓存
+inline std::vector<PropertyInfo> ReadStructProperties(uptr structObj)
 {
-    // 先查缓存
-    auto& cache = GetPropertiesCache();
-    auto it = cache.find(structObj);
-    if (it != cache.end())
-    {
-        return it->second;
-    }
-
     std::vector<PropertyInfo> props;
 
     // FField 链（UE4.25+）
@@ -158,7 +179,14 @@ inline std::vector<PropertyInfo> CollectProperties(uptr structObj)
             PropertyInfo pi;
             pi.name           = piName;
             pi.fieldClassName = piClassName;
-            pi.typeName       = ResolvePropertyType(prop, piClassName);
+            {
+                std::vector<TypeRef> refList;
+                TypeRefCapture refs(&refList);
+                pi.typeDesc = ResolveTypeDesc(prop, piClassName);
+                NoteTypeRefs(*pi.typeDesc);
+                pi.typeName = pi.typeDesc->name;
+                pi.typeRefs = InternTypeRefs(refList);
+            }
             pi.offset         = GetPropertyOffset(prop);
             pi.size           = GetPropertyElementSize(prop);
             pi.arrayDim       = GetPropertyArrayDim(prop);
@@ -170,7 +198,7 @@ inline std::vector<PropertyInfo> CollectProperties(uptr structObj)
                 ReadBoolPropertyBitInfo(prop, pi);
             }
 
-            props.push_back(pi);
+            props.push_back(std::move(pi));
             prop = GetFFieldNext(prop);
         }
     }
@@ -190,8 +218,14 @@ inline std::vector<PropertyInfo> CollectProperties(uptr structObj)
                 PropertyInfo pi;
                 pi.name           = GetObjectName(child);
                 pi.fieldClassName = className;
-                pi.typeName       = ResolvePropertyType(
-                    child, className);
+                {
+                    std::vector<TypeRef> refList;
+                    TypeRefCapture refs(&refList);
+                    pi.typeDesc = ResolveTypeDesc(child, className);
+                    NoteTypeRefs(*pi.typeDesc);
+                    pi.typeName = pi.typeDesc->name;
+                    pi.typeRefs = InternTypeRefs(refList);
+                }
                 pi.offset         = GetPropertyOffset(child);
                 pi.size           = GetPropertyElementSize(child);
                 pi.arrayDim       = GetPropertyArrayDim(child);
@@ -203,7 +237,7 @@ inline std::vector<PropertyInfo> CollectProperties(uptr structObj)
 
                 if (!pi.name.empty())
                 {
-                    props.push_back(pi);
+                    props.push_back(std::move(pi));
                 }
             }
             child = GetFieldNext(child);
@@ -218,9 +252,48 @@ inline std::vector<PropertyInfo> CollectProperties(uptr structObj)
         }
     );
 
-    // 存入缓存
-    cache[structObj] = props;
-    return cache[structObj];
+    return props;
+}
+
+// 收集一个 UStruct 的所有属性
+// 结果缓存到 GetPropertiesCache()，每个 struct 地址只读一次；返回缓存内的引用，
+// 在下次 ClearPropertiesCache 前有效（节点式容器，其他条目插入不影响），调用方不再复制整个列表
+// 可多线程并发调用：远程读取在锁外进行，同一地址并发未命中时先写入者生效
+inline const std::vector<PropertyInfo>& CollectProperties(uptr structObj)
+{
+    auto& slot = SessionLocal<PropertiesCacheSlot>();
+    auto& cache = slot.cache;
+    {
+        std::shared_lock<std::shared_mutex> rlock(slot.mtx);
+        auto it = cache.find(structObj);
+        if (it != cache.end())
+        {
+            slot.counters.Hit();
+            return it->second;
+        }
+    }
+    slot.counters.Miss();
+
+    std::vector<PropertyInfo> props = ReadStructProperties(structObj);
+    std::unique_lock<std::shared_mutex> wlock(slot.mtx);
+    auto [it, inserted] = cache.try_emplace(structObj, std::move(props));
+    return it->second;
+}
+
+// 流式导出用：命中缓存时返回缓存引用；未命中时读入 scratch 并返回它，结果不写入缓存（内存保持平稳）
+inline const std::vector<PropertyInfo>& CollectPropertiesTransient(
+    uptr structObj, std::vector<PropertyInfo>& scratch)
+{
+    {
+        std::shared_lock<std::shared_mutex> rlock(GetPropertiesCacheMutex());
+        auto it = GetPropertiesCache().find(structObj);
+        if (it != GetPropertiesCache().end())
+        {
+            return it->second;
+        }
+    }
+    scratch = ReadStructProperties(structObj);
+    return scratch;
 }
 
 // 反转函数列表，使输出顺序与 Rei-Dumper 一致
@@ -232,6 +305,26 @@ inline void ReverseIfNeeded(std::vector<FunctionInfo>& funcs)
     std::reverse(funcs.begin(), funcs.end());
 }
 
+// 清理标识符：非法 ASCII 字符替换为下划线，数字开头时加下划线前缀
+inline std::string SanitizeIdentifier(std::string name)
+{
+    for (auto& c : name)
+    {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (uc < 0x80 && !std::isalnum(uc) && c != '_')
+        {
+            c = '_';
+        }
+    }
+    if (!name.empty()
+        && std::isdigit(
+            static_cast<unsigned char>(name[0])))
+    {
+        name = "_" + name;
+    }
+    return name;
+}
+
 // 构建参数的签名类型（含 const/&/* 修饰）
 // 对标 Rei-Dumper CppGenerator::GenerateFunctionInfo
 inline void BuildSignatureType(FunctionParam& fp)
@@ -296,25 +389,15 @@ inline std::vector<FunctionParam> CollectFuncParams(uptr funcObj)
             if (flags & 0x80)
             {
                 FunctionParam fp;
-                fp.name           = GetFFieldName(prop);
-                // 清理参数名：非法 ASCII 字符替换为下划线
-                for (auto& c : fp.name)
-                {
-                    unsigned char uc = static_cast<unsigned char>(c);
-                    if (uc < 0x80 && !std::isalnum(uc) && c != '_')
-                    {
-                        c = '_';
-                    }
-                }
-                if (!fp.name.empty()
-                    && std::isdigit(
-                        static_cast<unsigned char>(fp.name[0])))
+                fp.name           = SanitizeIdentifier(GetFFieldName(prop));
+                fp.fieldClassName = GetFFieldClassName(prop);
                 {
-                    fp.name = "_" + fp.name;
+                    std::vector<TypeRef> refList;
+                    TypeRefCapture refs(&refList);
+                    fp.typeName = ResolvePropertyType(
+                        prop, fp.fieldClassName);
+                    fp.typeRefs = InternTypeRefs(refList);
                 }
-                fp.fieldClassName = GetFFieldClassName(prop);
-                fp.typeName       = ResolvePropertyType(
-                    prop, fp.fieldClassName);
                 fp.flags          = flags;
                 fp.offset         = GetPropertyOffset(prop);
                 fp.size           = GetPropertyElementSize(prop);
@@ -333,7 +416,7 @@ inline std::vector<FunctionParam> CollectFuncParams(uptr funcObj)
                     fp.fieldClassName == "SetProperty");
 
                 BuildSignatureType(fp);
-                params.push_back(fp);
+                params.push_back(std::move(fp));
             }
             prop = GetFFieldNext(prop);
         }
@@ -345,26 +428,23 @@ inline std::vector<FunctionParam> CollectFuncParams(uptr funcObj)
 // 函数缓存：每个 struct 地址只读一次
 inline std::unordered_map<uptr, std::vector<FunctionInfo>>& GetFunctionsCache()
 {
-    static std::unordered_map<uptr, std::vector<FunctionInfo>> cache;
-    return cache;
+    return SessionLocal<FunctionsCacheSlot>().cache;
+}
+
+inline std::shared_mutex& GetFunctionsCacheMutex()
+{
+    return SessionLocal<FunctionsCacheSlot>().mtx;
 }
 
 inline void ClearFunctionsCache()
 {
+    std::unique_lock<std::shared_mutex> wlock(GetFunctionsCacheMutex());
     GetFunctionsCache().clear();
 }
 
-// 收集一个 UStruct 的所有函数（精确签名）
-// 结果缓存到 GetFunctionsCache()，每个 struct 地址只读一次
-inline std::vector<FunctionInfo> CollectFunctions(uptr structObj)
+// 从进程读取一个 UStruct 的所有函数（精确签名）；不经过缓存
+inline std::vector<FunctionInfo> ReadStructFunctions(uptr structObj)
 {
-    auto& cache = GetFunctionsCache();
-    auto it = cache.find(structObj);
-    if (it != cache.end())
-    {
-        return it->second;
-    }
-
     std::vector<FunctionInfo> funcs;
 
     uptr child = GetChildren(structObj);
@@ -391,11 +471,11 @@ inline std::vector<FunctionInfo> CollectFunctions(uptr structObj)
         if (className == "Function")
         {
             FunctionInfo fi;
-            fi.name = GetObjectName(child);
+            std::string funcName = GetObjectName(child);
 
             // 跳过包含控制字符的垃圾函数名
             bool hasCtrl = false;
-            for (char c : fi.name)
+            for (char c : funcName)
             {
                 if (static_cast<unsigned char>(c) < 0x20)
                 {
@@ -403,27 +483,14 @@ inline std::vector<FunctionInfo> CollectFunctions(uptr structObj)
                     break;
                 }
             }
-            if (fi.name.empty() || hasCtrl)
+            if (funcName.empty() || hasCtrl)
             {
                 child = GetFieldNext(child);
                 continue;
             }
 
             // 清理函数名：空格等非法 ASCII 字符替换为下划线
-            for (auto& c : fi.name)
-            {
-                unsigned char uc = static_cast<unsigned char>(c);
-                if (uc < 0x80 && !std::isalnum(uc) && c != '_')
-                {
-                    c = '_';
-                }
-            }
-            if (!fi.name.empty()
-                && std::isdigit(
-                    static_cast<unsigned char>(fi.name[0])))
-            {
-                fi.name = "_" + fi.name;
-            }
+            fi.name = SanitizeIdentifier(std::move(funcName));
 
             if (Off().UFunction_FunctionFlags != -1)
             {
@@ -460,10 +527,47 @@ inline std::vector<FunctionInfo> CollectFunctions(uptr structObj)
     }
 
     ReverseIfNeeded(funcs);
-
-    cache[structObj] = funcs;
     return funcs;
 }
 
+// 收集一个 UStruct 的所有函数
+// 结果缓存到 GetFunctionsCache()；引用有效期与并发语义同 CollectProperties
+inline const std::vector<FunctionInfo>& CollectFunctions(uptr structObj)
+{
+    auto& slot = SessionLocal<FunctionsCacheSlot>();
+    auto& cache = slot.cache;
+    {
+        std::shared_lock<std::shared_mutex> rlock(slot.mtx);
+        auto it = cache.find(structObj);
+        if (it != cache.end())
+        {
+            slot.counters.Hit();
+            return it->second;
+        }
+    }
+    slot.counters.Miss();
+
+    std::vector<FunctionInfo> funcs = ReadStructFunctions(structObj);
+    std::unique_lock<std::shared_mutex> wlock(slot.mtx);
+    auto [it, inserted] = cache.try_emplace(structObj, std::move(funcs));
+    return it->second;
+}
+
+// 流式导出用，语义同 CollectPropertiesTransient
+inline const std::vector<FunctionInfo>& CollectFunctionsTransient(
+    uptr structObj, std::vector<FunctionInfo>& scratch)
+{
+    {
+        std::shared_lock<std::shared_mutex> rlock(GetFunctionsCacheMutex());
+        auto it = GetFunctionsCache().find(structObj);
+        if (it != GetFunctionsCache().end())
+        {
+            return it->second;
+        }
+    }
+    scratch = ReadStructFunctions(structObj);
+    return scratch;
+}
+
 } // namespace detail
 } // namespace xrd
@@ -1,23 +1,86 @@
 #pragma once
 // Xrd-eXternalrEsolve - 依赖拓扑排序
-// 完全对标 Rei-Dumper DependencyManager：
-// 使用 unordered_map<i32> / unordered_set<i32> 存储依赖图
-// 遍历顺序由 MSVC STL 的哈希桶决定，与 Rei-Dumper 完全一致
+// 完全对标 Rei-Dumper DependencyManager 的输出顺序：
+// 依赖图存为压缩稀疏行（CSR），节点与边的排列复现 MSVC unordered_map/set<i32> 的遍历顺序
+// （规则见 dump_hash_order.hpp），DFS 为显式栈迭代，任何编译器下结果一致
 
 #include "dump_prefix.hpp"
 #include "dump_collect.hpp"
+#include "dump_hash_order.hpp"
 #include <string>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
-#include <functional>
 
 namespace xrd
 {
 namespace detail
 {
 
+// 压缩稀疏行依赖图：节点编号 0..n-1
+// 节点 i 的依赖为 edges[offsets[i], offsets[i + 1])，按插入顺序存放
+struct DepGraphCsr
+{
+    std::vector<u32> offsets{0};
+    std::vector<u32> edges;
+
+    u32 NodeCount() const { return static_cast<u32>(offsets.size() - 1); }
+
+    void AddEdge(u32 to) { edges.push_back(to); }
+
+    // 结束当前节点的边列表，开始下一个节点
+    void EndNode() { offsets.push_back(static_cast<u32>(edges.size())); }
+};
+
+// 后序 DFS 拓扑排序，返回节点编号序列（依赖在前）
+// 顺序规则：按节点编号依次作为起点；每个节点按边的存放顺序访问依赖；
+// 遇到已完成或仍在栈上的节点（循环依赖）直接跳过
+// 与 Rei-Dumper 的递归 VisitAllNodesWithCallback 结果相同，但不受递归深度限制
+inline std::vector<u32> TopoOrderCsr(const DepGraphCsr& g)
+{
+    u32 n = g.NodeCount();
+    std::vector<u8> state(n, 0); // 0 未访问，1 在栈上，2 已完成
+    std::vector<u32> result;
+    result.reserve(n);
+
+    struct Frame
+    {
+        u32 node;
+        u32 edge;
+    };
+    std::vector<Frame> stack;
+
+    for (u32 root = 0; root < n; ++root)
+    {
+        if (state[root])
+        {
+            continue;
+        }
+        state[root] = 1;
+        stack.push_back({root, g.offsets[root]});
+        while (!stack.empty())
+        {
+            Frame& top = stack.back();
+            if (top.edge < g.offsets[top.node + 1])
+            {
+                u32 dep = g.edges[top.edge++];
+                if (!state[dep])
+                {
+                    state[dep] = 1;
+                    stack.push_back({dep, g.offsets[dep]});
+                }
+                continue;
+            }
+            state[top.node] = 2;
+            result.push_back(top.node);
+            stack.pop_back();
+        }
+    }
+    return result;
+}
+
 // 从属性类型中提取依赖的结构体/类名（裸名，不含前缀）
+// 结构体排序的边顺序取决于这些名字的插入序列（见 TopoSortEntries），
+// 因此保留按类型字符串提取的方式，而不是改用 PropertyInfo::typeRefs
 inline std::vector<std::string> ExtractDepNames(
     const std::string& typeName)
 {
@@ -95,41 +158,11 @@ inline std::vector<std::string> ExtractDepNames(
     return names;
 }
 
-// 收集一个结构体/类的所有依赖名（裸名）
-// 使用缓存的 PropertyInfo.typeName 提取依赖
-inline std::unordered_set<std::string> CollectEntryDeps(
-    const StructEntry& entry)
-{
-    std::unordered_set<std::string> deps;
-
-    if (!entry.superName.empty())
-    {
-        deps.insert(entry.superName);
-    }
-
-    auto props = CollectProperties(entry.addr);
-    for (auto& prop : props)
-    {
-        auto depNames = ExtractDepNames(prop.typeName);
-        for (auto& dn : depNames)
-        {
-            if (dn != entry.name)
-            {
-                deps.insert(dn);
-            }
-        }
-
-
-    }
-
-
-    return deps;
-}
-
 // 对标 Rei-Dumper DependencyManager：
-// 使用 unordered_map<i32, unordered_set<i32>> 存储依赖图
-// DFS 遍历顺序完全由 MSVC 的 unordered_map/set 哈希桶决定
-// 这样编译后的迭代顺序与 Rei-Dumper 完全一致
+// 节点顺序为 objIndex 按 entries 顺序插入 unordered_map<i32> 后的遍历顺序
+// 边顺序为各节点依赖集合 unordered_set<i32> 的遍历顺序；
+// 结构体的依赖集合按依赖名 unordered_set<std::string>（super + 属性类型中的名字）的遍历顺序插入，
+// 名字集合包含列表外的类型，它们同样影响桶的排列，不能只用列表内的索引代替
 //
 // 对标 Rei-Dumper InitDependencies 的关键区别：
 //   - 类（isClass=true）：只添加 super 依赖（AddDependency），不添加属性依赖
@@ -145,94 +178,104 @@ inline std::vector<const StructEntry*> TopoSortEntries(
 
     // 构建 objIndex → 条目指针映射
     std::unordered_map<i32, const StructEntry*> idxMap;
-    // 构建 name → objIndex 映射（仅限当前列表内）
+    // 构建 name → objIndex 映射（仅限当前列表内，用于 super 查找）
     std::unordered_map<std::string, i32> nameToIdx;
+    idxMap.reserve(entries.size());
+    nameToIdx.reserve(entries.size());
+    HashOrderSet keys;
     for (auto* e : entries)
     {
         idxMap[e->objIndex] = e;
         nameToIdx[e->name] = e->objIndex;
+        keys.insert(e->objIndex);
     }
 
-    // 对标 Rei-Dumper：用 unordered_map<i32, unordered_set<i32>>
-    // 按 GObjects 索引存储依赖关系
-    std::unordered_map<i32, std::unordered_set<i32>> depGraph;
-
-    // 对标 Rei-Dumper InitDependencies：先 SetExists 确保每个条目都在图中
-    for (auto* e : entries)
+    // 节点编号 = 依赖图键的遍历顺序
+    std::vector<i32> order(keys.begin(), keys.end());
+    std::unordered_map<i32, u32> nodeOf;
+    nodeOf.reserve(order.size());
+    for (u32 i = 0; i < order.size(); ++i)
     {
-        depGraph[e->objIndex];
+        nodeOf[order[i]] = i;
     }
 
-    for (auto* e : entries)
+    DepGraphCsr graph;
+    graph.offsets.reserve(order.size() + 1);
+    graph.edges.reserve(order.size() * 2);
+    // 类型字符串 → 依赖名：同一包内大量属性共用类型，每种只解析一次
+    std::unordered_map<u32, std::vector<std::string>> depNamesOf;
+    HashOrderStringSet names;
+    HashOrderSet localDeps;
+    for (i32 idx : order)
     {
+        const StructEntry* e = idxMap[idx];
+        i32 superIdx = -1;
+        if (!e->superName.empty())
+        {
+            auto nit = nameToIdx.find(e->superName);
+            if (nit != nameToIdx.end())
+            {
+                superIdx = nit->second;
+            }
+        }
+
         if (e->isClass)
         {
             // 对标 Rei-Dumper：类只添加 super 依赖（AddDependency）
             // 属性依赖不影响类的排序（属性通常是指针，只需前向声明）
-            if (!e->superName.empty())
+            if (superIdx >= 0)
             {
-                auto nit = nameToIdx.find(e->superName);
-                if (nit != nameToIdx.end())
-                {
-                    depGraph[e->objIndex].insert(nit->second);
-                }
+                graph.AddEdge(nodeOf[superIdx]);
             }
         }
         else
         {
             // 对标 Rei-Dumper：结构体添加 super + 属性依赖（SetDependencies）
-            auto allDeps = CollectEntryDeps(*e);
-            std::unordered_set<i32> localDeps;
-            for (auto& d : allDeps)
+            // 对标 CollectEntryDeps：先按名字去重，再按名字集合的遍历顺序映射到列表内的索引
+            // 集合每次回到新建状态，保证遍历顺序只取决于本条目
+            names.reset();
+            if (!e->superName.empty())
+            {
+                names.insert(e->superName);
+            }
+            for (auto& prop : CollectProperties(e->addr))
             {
-                auto nit = nameToIdx.find(d);
+                auto [it, inserted] = depNamesOf.try_emplace(prop.typeName.id());
+                if (inserted)
+                {
+                    it->second = ExtractDepNames(prop.typeName);
+                }
+                for (auto& dn : it->second)
+                {
+                    if (dn != e->name)
+                    {
+                        names.insert(dn);
+                    }
+                }
+            }
+            localDeps.reset();
+            for (auto& dn : names)
+            {
+                auto nit = nameToIdx.find(dn);
                 if (nit != nameToIdx.end())
                 {
                     localDeps.insert(nit->second);
                 }
             }
-            depGraph[e->objIndex] = std::move(localDeps);
-        }
-    }
-
-
-    // 对标 Rei-Dumper VisitAllNodesWithCallback：
-    // 遍历 unordered_map，对每个节点做 DFS
-    std::vector<const StructEntry*> result;
-    result.reserve(entries.size());
-    std::unordered_set<i32> visited;
-
-    std::function<void(i32)> visit;
-    visit = [&](i32 idx)
-    {
-        if (visited.count(idx))
-        {
-            return;
-        }
-        visited.insert(idx);
-
-        auto it = depGraph.find(idx);
-        if (it != depGraph.end())
-        {
-            for (i32 dep : it->second)
+            for (i32 d : localDeps)
             {
-                visit(dep);
+                graph.AddEdge(nodeOf[d]);
             }
         }
+        graph.EndNode();
+    }
 
-        auto mit = idxMap.find(idx);
-        if (mit != idxMap.end())
-        {
-            result.push_back(mit->second);
-        }
-    };
-
-    // 遍历 unordered_map<i32>，顺序由 MSVC 哈希桶决定
-    for (const auto& [idx, deps] : depGraph)
+    std::vector<const StructEntry*> result;
+    result.reserve(order.size());
+    for (u32 node : TopoOrderCsr(graph))
     {
-        visit(idx);
+        result.push_back(idxMap[order[node]]);
     }
-
     return result;
 }
 
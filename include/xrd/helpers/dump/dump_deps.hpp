@@ -7,8 +7,10 @@
 #include "../../engine/objects/objects.hpp"
 #include "dump_prefix.hpp"
 #include "dump_collect.hpp"
-#include <unordered_set>
+#include "dump_hash_order.hpp"
+#include <set>
 #include <unordered_map>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 
@@ -35,10 +37,21 @@ namespace ECF
 }
 
 // UClass CastFlags 缓存（UClass 对象数量有限，缓存后避免重复远程读取）
+struct UClassCastFlagsCacheSlot
+{
+    std::unordered_map<uptr, u64> cache;
+    std::shared_mutex mtx;
+    CacheCounters counters;
+};
+
 inline std::unordered_map<uptr, u64>& GetUClassCastFlagsCache()
 {
-    static std::unordered_map<uptr, u64> cache;
-    return cache;
+    return SessionLocal<UClassCastFlagsCacheSlot>().cache;
+}
+
+inline std::shared_mutex& GetUClassCastFlagsCacheMutex()
+{
+    return SessionLocal<UClassCastFlagsCacheSlot>().mtx;
 }
 
 // 读取 UObject 的 UClass::CastFlags（带缓存）
@@ -53,19 +66,26 @@ inline u64 ReadUClassCastFlags(uptr obj)
     {
         return 0;
     }
-    auto& cache = GetUClassCastFlagsCache();
-    auto it = cache.find(cls);
-    if (it != cache.end())
+    auto& slot = SessionLocal<UClassCastFlagsCacheSlot>();
+    auto& cache = slot.cache;
     {
-        return it->second;
+        std::shared_lock<std::shared_mutex> rlock(slot.mtx);
+        auto it = cache.find(cls);
+        if (it != cache.end())
+        {
+            slot.counters.Hit();
+            return it->second;
+        }
     }
+    slot.counters.Miss();
     u64 flags = 0;
     auto& off = Off();
     if (off.UClass_CastFlags != -1)
     {
         GReadValue(cls + off.UClass_CastFlags, flags);
     }
-    cache[cls] = flags;
+    std::unique_lock<std::shared_mutex> wlock(slot.mtx);
+    cache.try_emplace(cls, flags);
     return flags;
 }
 
@@ -77,16 +97,10 @@ struct PackageDeps
         bool needStructs = false;
         bool needClasses = false;
     };
-    std::unordered_map<i32, DepInfo> deps;
+    HashOrderMap<DepInfo> deps; // 遍历顺序同 MSVC unordered_map，决定包拓扑排序的边顺序
+    std::set<i32> fwd;          // 只需前向声明即可满足的包（<Pkg>_fwd.hpp），不参与拓扑排序
 };
 
-// FFieldClass CastFlags 缓存（FFieldClass 全局只有几十个，缓存后避免重复远程读取）
-inline std::unordered_map<uptr, u64>& GetFieldClassCache()
-{
-    static std::unordered_map<uptr, u64> cache;
-    return cache;
-}
-
 // 读取 FField 的 CastFlags（带缓存优化）
 // FField→Class 指针需要每次读取，但 Class→CastFlags 可以缓存
 inline u64 ReadFieldCastFlags(uptr ffield)
@@ -97,20 +111,7 @@ inline u64 ReadFieldCastFlags(uptr ffield)
     }
     uptr cls = 0;
     GReadPtr(ffield + Off().FField_Class, cls);
-    if (!cls)
-    {
-        return 0;
-    }
-    auto& cache = GetFieldClassCache();
-    auto it = cache.find(cls);
-    if (it != cache.end())
-    {
-        return it->second;
-    }
-    u64 flags = 0;
-    GReadValue(cls + Off().FFieldClass_CastFlags, flags);
-    cache[cls] = flags;
-    return flags;
+    return ReadFieldClassCastFlags(cls);
 }
 
 // 从单个 FField 属性收集依赖的 struct/enum 的 GObjects 索引
@@ -119,7 +120,7 @@ inline u64 ReadFieldCastFlags(uptr ffield)
 inline void CollectPropertyDep(
     uptr prop,
     u64 castFlags,
-    std::unordered_set<i32>& store)
+    HashOrderSet& store)
 {
     auto& off = Off();
 
@@ -338,28 +339,72 @@ inline void CollectPropertyDep(
     }
 }
 
-// 全局枚举名→GObjects索引查找表（枚举名不含 E 前缀）
-// 用于缓存路径中查找枚举依赖
-inline std::unordered_map<std::string, i32>&
-GetEnumIndexLookup()
+// 依赖对象信息：包索引 + 类别（由 DumpCppSdk 从 entries/enums 填充）
+struct DepObjectInfo
 {
-    static std::unordered_map<std::string, i32> lookup;
-    return lookup;
+    i32 pkgIndex = -1;
+    bool isUClass = false; // UE 类型名恰为 "Class"
+    bool isEnum   = false;
+};
+
+// GObjects 索引→依赖对象信息查找表（归属当前导出会话）
+// 依赖收集只产生 entries/enums 中的索引，查表即可，无需远程读取
+// 这也是从模型文件离线导出时依赖收集能正常工作的前提
+struct DepObjectLookupSlot
+{
+    std::unordered_map<i32, DepObjectInfo> lookup;
+};
+
+inline std::unordered_map<i32, DepObjectInfo>& GetDepObjectLookup()
+{
+    return SessionLocal<DepObjectLookupSlot>().lookup;
+}
+
+// 查询依赖对象信息：先查表，未命中时回退远程读取（未初始化时返回 false）
+inline bool ResolveDepObject(i32 depIdx, DepObjectInfo& out)
+{
+    auto& lookup = GetDepObjectLookup();
+    auto it = lookup.find(depIdx);
+    if (it != lookup.end())
+    {
+        out = it->second;
+        return true;
+    }
+    uptr depObj = GetObjectByIndex(depIdx);
+    if (!depObj)
+    {
+        return false;
+    }
+    std::string depClassName = GetObjectClassName(depObj);
+    out.pkgIndex = GetPackageIndex(depObj);
+    out.isUClass = (depClassName == "Class");
+    out.isEnum = (depClassName == "Enum"
+        || depClassName == "UserDefinedEnum");
+    return true;
 }
 
 // 收集一个 UStruct 的所有属性依赖
 // 对标 Rei-Dumper PackageManagerUtils::GetDependencies
-// 复用 CollectProperties 缓存，避免重复遍历 FField 链
-inline std::unordered_set<i32> CollectStructDeps(uptr structObj)
+// 优先使用条目的成员摘要（采集后属性缓存可能已释放），其次是 CollectProperties 缓存，
+// 两者都没有时才遍历 FField 链
+inline HashOrderSet CollectStructDeps(const StructEntry& entry)
 {
-    std::unordered_set<i32> deps;
+    HashOrderSet deps;
+    uptr structObj = entry.addr;
 
-    // 直接从已缓存的 PropertyInfo 中提取依赖的 struct/enum 名
-    // 再通过全局查找表转换为 GObjects 索引
-    // 这样完全避免了重复的 FField 链遍历（ReadProcessMemory）
+    // 直接使用收集属性时记录的类型引用（GObjects 索引）
+    // 完全避免了重复的 FField 链遍历（ReadProcessMemory）与类型字符串解析
     auto& props = detail::GetPropertiesCache();
     auto pit = props.find(structObj);
-    if (pit == props.end())
+    if (entry.membersSummarized)
+    {
+        // 摘要保留了引用的首次出现顺序，插入序列与读取缓存时一致
+        for (i32 idx : entry.memberRefs)
+        {
+            deps.insert(idx);
+        }
+    }
+    else if (pit == props.end())
     {
         // 缓存未命中时才走原始路径（理论上不应发生，因为对齐计算阶段已填充缓存）
         if (Off().bUseFProperty)
@@ -384,111 +429,19 @@ inline std::unordered_set<i32> CollectStructDeps(uptr structObj)
     }
     else
     {
-        // 缓存命中：从 typeName 中提取依赖名，再查 GObjects 索引
-        auto& lookup = GetEntryLookup();
+        // 缓存命中：直接使用收集属性时记录的类型引用
+        // 容器模板参数内的结构体同样计入：TSet/TMap 在类作用域 sizeof 元素类型，需要完整定义
         for (auto& pi : pit->second)
         {
-            // 从类型字符串中提取裸名（去掉 class/struct/前缀/指针）
-            std::string t = pi.typeName;
-            // 去掉 const
-            if (t.find("const ") == 0) t = t.substr(6);
-            // 去掉 class/struct 关键字
-            if (t.find("class ") == 0) t = t.substr(6);
-            if (t.find("struct ") == 0) t = t.substr(7);
-            // 去掉尾部 */& 和空格
-            while (!t.empty()
-                && (t.back() == '*' || t.back() == '&'
-                    || t.back() == ' '))
-            {
-                t.pop_back();
-            }
-            // 处理模板（TArray<X>、TMap<K,V> 等）
-            // 递归提取所有尖括号内的类型名
-            std::vector<std::string> toCheck;
-            toCheck.push_back(t);
-            while (!toCheck.empty())
+            for (auto& r : pi.typeRefs)
             {
-                std::string cur = toCheck.back();
-                toCheck.pop_back();
-                auto lt = cur.find('<');
-                auto gt = cur.rfind('>');
-                if (lt != std::string::npos
-                    && gt != std::string::npos)
-                {
-                    std::string inner =
-                        cur.substr(lt + 1, gt - lt - 1);
-                    // 按逗号分割（忽略嵌套尖括号）
-                    int depth2 = 0;
-                    size_t start = 0;
-                    for (size_t i = 0; i < inner.size(); ++i)
-                    {
-                        if (inner[i] == '<') depth2++;
-                        else if (inner[i] == '>') depth2--;
-                        else if (inner[i] == ','
-                            && depth2 == 0)
-                        {
-                            std::string part =
-                                inner.substr(start, i - start);
-                            // 修剪前导空格
-                            while (!part.empty() && part[0] == ' ')
-                            {
-                                part = part.substr(1);
-                            }
-                            toCheck.push_back(part);
-                            start = i + 1;
-                        }
-                    }
-                    {
-                        std::string part = inner.substr(start);
-                        // 修剪前导空格
-                        while (!part.empty() && part[0] == ' ')
-                        {
-                            part = part.substr(1);
-                        }
-                        toCheck.push_back(part);
-                    }
-                    continue;
-                }
-                // 去掉前缀后查表
-                if (cur.length() > 1)
-                {
-                    char prefix = cur[0];
-                    if (prefix == 'U' || prefix == 'A'
-                        || prefix == 'I' || prefix == 'F')
-                    {
-                        std::string bare = cur.substr(1);
-                        auto lit = lookup.find(bare);
-                        if (lit != lookup.end())
-                        {
-                            i32 idx = lit->second->objIndex;
-                            if (idx > 0) deps.insert(idx);
-                        }
-                    }
-                    // 枚举类型以 E 前缀开头，查枚举索引表
-                    // 先用去掉 E 前缀的名字查（如 ECharacterModel → CharacterModel）
-                    // 再用完整名查（如 Enum_Resolution 原名就以 E 开头）
-                    if (prefix == 'E')
-                    {
-                        auto& enumLk = GetEnumIndexLookup();
-                        std::string bare = cur.substr(1);
-                        auto eit = enumLk.find(bare);
-                        if (eit == enumLk.end())
-                        {
-                            eit = enumLk.find(cur);
-                        }
-                        if (eit != enumLk.end()
-                            && eit->second > 0)
-                        {
-                            deps.insert(eit->second);
-                        }
-                    }
-                }
+                deps.insert(r.index);
             }
         }
     }
 
     // 排除自身索引
-    i32 selfIdx = GetObjectIndex(structObj);
+    i32 selfIdx = entry.objIndex >= 0 ? entry.objIndex : GetObjectIndex(structObj);
     deps.erase(selfIdx);
 
     return deps;
@@ -498,18 +451,18 @@ inline std::unordered_set<i32> CollectStructDeps(uptr structObj)
 // 对标 Rei-Dumper PackageManagerUtils::SetPackageDependencies
 inline void SetPackageDeps(
     PackageDeps& pkgDeps,
-    const std::unordered_set<i32>& objDeps,
+    const HashOrderSet& objDeps,
     i32 myPkgIndex,
     bool allowSelfPkg = false)
 {
     for (i32 depIdx : objDeps)
     {
-        uptr depObj = GetObjectByIndex(depIdx);
-        if (!depObj)
+        DepObjectInfo info;
+        if (!ResolveDepObject(depIdx, info))
         {
             continue;
         }
-        i32 depPkgIdx = GetPackageIndex(depObj);
+        i32 depPkgIdx = info.pkgIndex;
         if (depPkgIdx < 0)
         {
             continue;
@@ -519,8 +472,7 @@ inline void SetPackageDeps(
             continue;
         }
         // 区分依赖类型：struct/enum → needStructs, class → needClasses
-        std::string depClassName = GetObjectClassName(depObj);
-        if (depClassName == "Class")
+        if (info.isUClass)
         {
             pkgDeps.deps[depPkgIdx].needClasses = true;
         }
@@ -533,27 +485,21 @@ inline void SetPackageDeps(
 }
 
 // 将 enum 依赖添加到 classes 依赖列表
-// 用缓存的 UClass::CastFlags 判断是否是 Enum
+// 枚举类别来自依赖对象查找表
 inline void AddEnumPkgDeps(
     PackageDeps& pkgDeps,
-    const std::unordered_set<i32>& objDeps,
+    const HashOrderSet& objDeps,
     i32 myPkgIndex,
     bool allowSelfPkg = false)
 {
-    constexpr u64 CASTCLASS_UEnum = 0x0000000000000004ULL;
     for (i32 depIdx : objDeps)
     {
-        uptr depObj = GetObjectByIndex(depIdx);
-        if (!depObj)
-        {
-            continue;
-        }
-        u64 classCF = ReadUClassCastFlags(depObj);
-        if (!(classCF & CASTCLASS_UEnum))
+        DepObjectInfo info;
+        if (!ResolveDepObject(depIdx, info) || !info.isEnum)
         {
             continue;
         }
-        i32 depPkgIdx = GetPackageIndex(depObj);
+        i32 depPkgIdx = info.pkgIndex;
         if (depPkgIdx < 0)
         {
             continue;
@@ -566,184 +512,105 @@ inline void AddEnumPkgDeps(
     }
 }
 
-// 从类型字符串提取依赖（支持模板嵌套）
-inline void CollectTypeNameDepsFromString(
-    const std::string& typeName,
-    std::unordered_set<i32>& deps)
+// 收集函数参数（含返回值）类型引用的结构体/枚举索引
+// 签名中的结构体按值或引用出现，模板参数内的也计入
+inline void CollectParamTypeDeps(
+    const FunctionParam& param,
+    HashOrderSet& deps)
 {
-    std::vector<std::string> toCheck;
-    toCheck.push_back(typeName);
-    auto& lookup = GetEntryLookup();
-    auto& enumLk = GetEnumIndexLookup();
-
-    while (!toCheck.empty())
+    for (auto& r : param.typeRefs)
     {
-        std::string cur = toCheck.back();
-        toCheck.pop_back();
-
-        // 去掉前导空白和限定词
-        auto trimLeft = [](std::string& s)
-        {
-            while (!s.empty() && s.front() == ' ')
-            {
-                s.erase(s.begin());
-            }
-        };
-        trimLeft(cur);
-        if (cur.rfind("const ", 0) == 0)
-        {
-            cur = cur.substr(6);
-            trimLeft(cur);
-        }
-        if (cur.rfind("class ", 0) == 0)
-        {
-            cur = cur.substr(6);
-            trimLeft(cur);
-        }
-        if (cur.rfind("struct ", 0) == 0)
-        {
-            cur = cur.substr(7);
-            trimLeft(cur);
-        }
+        deps.insert(r.index);
+    }
+}
 
-        // 模板类型：递归拆分尖括号内部
-        auto lt = cur.find('<');
-        auto gt = cur.rfind('>');
-        if (lt != std::string::npos && gt != std::string::npos && gt > lt)
+// 仅写入 struct/enum 依赖，忽略 class 依赖（class 指针类型可由前向声明满足）
+// enumsAsFwd：枚举带固定底层类型，opaque 声明即是完整类型，只需 _fwd.hpp
+inline void SetPackageStructLikeDeps(
+    PackageDeps& pkgDeps,
+    const HashOrderSet& objDeps,
+    i32 myPkgIndex,
+    bool allowSelfPkg = false,
+    bool enumsAsFwd = false)
+{
+    for (i32 depIdx : objDeps)
+    {
+        DepObjectInfo info;
+        if (!ResolveDepObject(depIdx, info))
         {
-            std::string base = cur.substr(0, lt);
-            toCheck.push_back(base);
-
-            std::string inner = cur.substr(lt + 1, gt - lt - 1);
-            int depth = 0;
-            size_t start = 0;
-            for (size_t i = 0; i < inner.size(); ++i)
-            {
-                if (inner[i] == '<') depth++;
-                else if (inner[i] == '>') depth--;
-                else if (inner[i] == ',' && depth == 0)
-                {
-                    toCheck.push_back(inner.substr(start, i - start));
-                    start = i + 1;
-                }
-            }
-            toCheck.push_back(inner.substr(start));
             continue;
         }
-
-        // 去掉尾部指针/引用/空格
-        while (!cur.empty() && (cur.back() == '*' || cur.back() == '&' || cur.back() == ' '))
-        {
-            cur.pop_back();
-        }
-        trimLeft(cur);
-        if (cur.empty())
+        i32 depPkgIdx = info.pkgIndex;
+        if (depPkgIdx < 0)
         {
             continue;
         }
-
-        // 去掉命名空间限定，仅保留最后一个标识符
-        auto ns = cur.rfind("::");
-        if (ns != std::string::npos)
+        if (!allowSelfPkg && depPkgIdx == myPkgIndex)
         {
-            cur = cur.substr(ns + 2);
+            continue;
         }
 
-        if (cur.size() <= 1)
+        // Class 依赖在属性/函数签名场景中不需要强制 include *_classes.hpp
+        if (info.isUClass)
         {
             continue;
         }
 
-        char prefix = cur[0];
-        if (prefix == 'U' || prefix == 'A'
-            || prefix == 'I' || prefix == 'F')
+        if (enumsAsFwd && info.isEnum)
         {
-            std::string bare = cur.substr(1);
-            auto it = lookup.find(bare);
-            if (it != lookup.end())
-            {
-                i32 idx = it->second->objIndex;
-                if (idx > 0)
-                {
-                    deps.insert(idx);
-                }
-            }
+            pkgDeps.fwd.insert(depPkgIdx);
         }
-        else if (prefix == 'E')
+        else
         {
-            // 枚举先查去 E 前缀，再查完整名
-            std::string bare = cur.substr(1);
-            auto it = enumLk.find(bare);
-            if (it == enumLk.end())
-            {
-                it = enumLk.find(cur);
-            }
-            if (it != enumLk.end() && it->second > 0)
-            {
-                deps.insert(it->second);
-            }
+            pkgDeps.deps[depPkgIdx].needStructs = true;
         }
     }
 }
 
-// 仅写入 struct/enum 依赖，忽略 class 依赖（class 指针类型可由前向声明满足）
-inline void SetPackageStructLikeDeps(
+// 写入只需前向声明的 struct/enum 依赖（函数声明中的参数 / 返回值类型允许不完整）
+inline void SetPackageFwdDeps(
     PackageDeps& pkgDeps,
-    const std::unordered_set<i32>& objDeps,
-    i32 myPkgIndex,
-    bool allowSelfPkg = false)
+    const HashOrderSet& objDeps,
+    i32 myPkgIndex)
 {
     for (i32 depIdx : objDeps)
     {
-        uptr depObj = GetObjectByIndex(depIdx);
-        if (!depObj)
-        {
-            continue;
-        }
-        i32 depPkgIdx = GetPackageIndex(depObj);
-        if (depPkgIdx < 0)
-        {
-            continue;
-        }
-        if (!allowSelfPkg && depPkgIdx == myPkgIndex)
+        DepObjectInfo info;
+        if (!ResolveDepObject(depIdx, info) || info.isUClass)
         {
             continue;
         }
-
-        // Class 依赖在属性/函数签名场景中不需要强制 include *_classes.hpp
-        std::string depClassName = GetObjectClassName(depObj);
-        if (depClassName == "Class")
+        if (info.pkgIndex >= 0 && info.pkgIndex != myPkgIndex)
         {
-            continue;
+            pkgDeps.fwd.insert(info.pkgIndex);
         }
-
-        pkgDeps.deps[depPkgIdx].needStructs = true;
     }
 }
 
 // 收集一个 struct/class 条目的完整包依赖
 // 对标 Rei-Dumper PackageManager::InitDependencies
+// forwardDecls 为 true 时按值成员与父类才 include 完整定义，枚举与函数签名类型改为 include _fwd.hpp；
+// _parameters.hpp 的依赖单独收集（参数结构体按值持有成员，含同包类型）
 inline void CollectEntryPackageDeps(
     const StructEntry& entry,
     i32 myPkgIndex,
     PackageDeps& structsDeps,
     PackageDeps& classesDeps,
-    PackageDeps& paramsDeps)
+    PackageDeps& paramsDeps,
+    bool forwardDecls = false)
 {
     bool isClass = entry.isClass;
     PackageDeps& targetDeps = isClass
         ? classesDeps : structsDeps;
 
     // 属性依赖
-    auto objDeps = CollectStructDeps(entry.addr);
-    SetPackageStructLikeDeps(targetDeps, objDeps, myPkgIndex);
+    auto objDeps = CollectStructDeps(entry);
+    SetPackageStructLikeDeps(targetDeps, objDeps, myPkgIndex, false, forwardDecls);
 
     // super 类型依赖
-    // 直接使用真实父对象地址，避免按短名查表导致的跨包重名错配
-    uptr super = GetSuperStruct(entry.addr);
-    if (super)
+    // 使用收集阶段记录的真实父对象包索引，避免按短名查表导致的跨包重名错配
     {
-        i32 superPkgIdx = GetPackageIndex(super);
+        i32 superPkgIdx = entry.superPkgIndex;
         if (superPkgIdx >= 0 && superPkgIdx != myPkgIndex)
         {
             auto& req = targetDeps.deps[superPkgIdx];
@@ -759,22 +626,38 @@ inline void CollectEntryPackageDeps(
     }
 
     // 类的函数签名依赖（返回值 + 参数）
-    // 用 CollectFunctions 缓存避免重复遍历
+    // 优先使用成员摘要，未填写时用 CollectFunctions 缓存
     if (isClass)
     {
-        std::unordered_set<i32> funcTypeDeps;
-        auto funcs = CollectFunctions(entry.addr);
-        for (const auto& fn : funcs)
+        HashOrderSet funcTypeDeps;
+        if (entry.membersSummarized)
         {
-            CollectTypeNameDepsFromString(fn.returnType, funcTypeDeps);
-            for (const auto& p : fn.params)
+            for (i32 idx : entry.paramRefs)
             {
-                CollectTypeNameDepsFromString(p.sigTypeName, funcTypeDeps);
-                CollectTypeNameDepsFromString(p.typeName, funcTypeDeps);
+                funcTypeDeps.insert(idx);
+            }
+        }
+        else
+        {
+            for (const auto& fn : CollectFunctions(entry.addr))
+            {
+                for (const auto& p : fn.params)
+                {
+                    CollectParamTypeDeps(p, funcTypeDeps);
+                }
             }
         }
 
-        if (!funcTypeDeps.empty())
+        if (funcTypeDeps.empty())
+        {
+            return;
+        }
+        if (forwardDecls)
+        {
+            SetPackageFwdDeps(targetDeps, funcTypeDeps, myPkgIndex);
+            SetPackageStructLikeDeps(paramsDeps, funcTypeDeps, myPkgIndex, true);
+        }
+        else
         {
             SetPackageStructLikeDeps(targetDeps, funcTypeDeps, myPkgIndex);
             SetPackageStructLikeDeps(paramsDeps, funcTypeDeps, myPkgIndex);
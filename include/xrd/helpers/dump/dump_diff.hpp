@@ -0,0 +1,233 @@
+#pragma once
+// Xrd-eXternalrEsolve - 反射布局差异
+// 比较两个游戏版本的布局快照（dump_layout_snapshot.hpp，来自实时采集或 .xrdm 模型）：
+//   类/结构体的增删、大小与父类变化；成员的增删、偏移移动与类型变化；函数与枚举值的增删改
+// 内容哈希相同的类型直接跳过，只对变化的类型按名称对齐做成员级比较
+// 报告写出与对外接口见 dump_diff_report.hpp
+
+#include "dump_layout_snapshot.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+namespace xrd
+{
+namespace detail
+{
+
+enum class LayoutChangeKind : u8
+{
+    TypeAdded, TypeRemoved, SizeChanged, SuperChanged,
+    MemberAdded, MemberRemoved, MemberMoved, MemberTypeChanged,
+    FunctionAdded, FunctionRemoved, FunctionChanged,
+    EnumAdded, EnumRemoved, EnumValueAdded, EnumValueRemoved, EnumValueChanged,
+};
+
+// 一条变化：owner 为类型/枚举的完整名（LayoutType::key / LayoutEnum::key），item 为成员/函数/枚举值（类型级变化为空）
+// 数值字段按种类解释：大小、偏移、枚举值；文本字段为类型名或签名
+struct LayoutChange
+{
+    LayoutChangeKind kind;
+    std::string owner;
+    std::string item;
+    i64 oldValue = 0;
+    i64 newValue = 0;
+    std::string oldText;
+    std::string newText;
+};
+
+struct LayoutDiffStats
+{
+    u32 typesCompared = 0;
+    u32 typesSkipped = 0;  // 哈希相同
+    u32 enumsCompared = 0;
+    u32 enumsSkipped = 0;
+};
+
+// 按名称对齐两个列表：onPair(旧项或空, 新项或空)，新列表顺序在前，删除项随后
+template<typename T, typename F>
+inline void ForEachByName(const std::vector<T>& a, const std::vector<T>& b, F&& onPair)
+{
+    std::unordered_map<std::string_view, const T*> oldByName;
+    oldByName.reserve(a.size());
+    for (auto& x : a)
+    {
+        oldByName.emplace(x.name, &x);
+    }
+    for (auto& y : b)
+    {
+        auto it = oldByName.find(y.name);
+        if (it == oldByName.end())
+        {
+            onPair(nullptr, &y);
+        }
+        else
+        {
+            onPair(it->second, &y);
+            oldByName.erase(it);
+        }
+    }
+    for (auto& x : a)
+    {
+        if (oldByName.count(x.name))
+        {
+            onPair(&x, nullptr);
+        }
+    }
+}
+
+// 成员级比较（仅对哈希不同的类型调用）
+inline void DiffLayoutType(const LayoutType& a, const LayoutType& b, std::vector<LayoutChange>& out)
+{
+    using K = LayoutChangeKind;
+    const std::string& owner = b.key; // 与 TypeAdded/TypeRemoved 一致，重名类型可区分
+    if (a.size != b.size)
+    {
+        out.push_back({K::SizeChanged, owner, {}, a.size, b.size});
+    }
+    if (a.superName != b.superName)
+    {
+        out.push_back({K::SuperChanged, owner, {}, 0, 0, a.superName, b.superName});
+    }
+
+    ForEachByName(a.members, b.members,
+        [&](const LayoutMember* x, const LayoutMember* y)
+        {
+            if (!x)
+            {
+                out.push_back({K::MemberAdded, owner, y->name, 0, y->offset, {}, y->type});
+                return;
+            }
+            if (!y)
+            {
+                out.push_back({K::MemberRemoved, owner, x->name, x->offset, 0, x->type});
+                return;
+            }
+            // 位域偏移以位为单位比较
+            i64 oldPos = static_cast<i64>(x->offset) * 8 + x->bitIndex;
+            i64 newPos = static_cast<i64>(y->offset) * 8 + y->bitIndex;
+            if (oldPos != newPos)
+            {
+                out.push_back({K::MemberMoved, owner, y->name, x->offset, y->offset,
+                    x->isBitField ? ":" + std::to_string(x->bitIndex) : std::string(),
+                    y->isBitField ? ":" + std::to_string(y->bitIndex) : std::string()});
+            }
+            if (x->type != y->type || x->size != y->size || x->arrayDim != y->arrayDim)
+            {
+                out.push_back({K::MemberTypeChanged, owner, y->name, x->size, y->size,
+                    x->arrayDim > 1 ? x->type + "[" + std::to_string(x->arrayDim) + "]" : x->type,
+                    y->arrayDim > 1 ? y->type + "[" + std::to_string(y->arrayDim) + "]" : y->type});
+            }
+        });
+
+    ForEachByName(a.functions, b.functions,
+        [&](const LayoutFunction* x, const LayoutFunction* y)
+        {
+            if (!x)
+            {
+                out.push_back({K::FunctionAdded, owner, y->name, 0, 0, {}, y->signature});
+            }
+            else if (!y)
+            {
+                out.push_back({K::FunctionRemoved, owner, x->name, 0, 0, x->signature});
+            }
+            else if (x->signature != y->signature || x->flags != y->flags)
+            {
+                out.push_back({K::FunctionChanged, owner, y->name,
+                    static_cast<i64>(x->flags), static_cast<i64>(y->flags),
+                    x->signature, y->signature});
+            }
+        });
+}
+
+inline void DiffLayoutEnum(const LayoutEnum& a, const LayoutEnum& b, std::vector<LayoutChange>& out)
+{
+    using K = LayoutChangeKind;
+    ForEachByName(a.members, b.members,
+        [&](const EnumMember* x, const EnumMember* y)
+        {
+            if (!x)
+            {
+                out.push_back({K::EnumValueAdded, b.key, y->name, 0, y->value});
+            }
+            else if (!y)
+            {
+                out.push_back({K::EnumValueRemoved, b.key, x->name, x->value, 0});
+            }
+            else if (x->value != y->value)
+            {
+                out.push_back({K::EnumValueChanged, b.key, y->name, x->value, y->value});
+            }
+        });
+}
+
+// 比较两份快照（a 为旧版本，b 为新版本）
+inline std::vector<LayoutChange> DiffLayoutSnapshots(
+    const LayoutSnapshot& a,
+    const LayoutSnapshot& b,
+    LayoutDiffStats* stats = nullptr)
+{
+    using K = LayoutChangeKind;
+    std::vector<LayoutChange> out;
+    LayoutDiffStats st;
+
+    for (auto& t : b.types)
+    {
+        auto it = a.typeIndex.find(t.key);
+        if (it == a.typeIndex.end())
+        {
+            out.push_back({K::TypeAdded, t.key, {}, 0, t.size});
+            continue;
+        }
+        const LayoutType& old = a.types[it->second];
+        st.typesCompared++;
+        if (old.hash == t.hash)
+        {
+            st.typesSkipped++;
+            continue;
+        }
+        DiffLayoutType(old, t, out);
+    }
+    for (auto& t : a.types)
+    {
+        if (!b.typeIndex.count(t.key))
+        {
+            out.push_back({K::TypeRemoved, t.key, {}, t.size, 0});
+        }
+    }
+
+    for (auto& e : b.enums)
+    {
+        auto it = a.enumIndex.find(e.key);
+        if (it == a.enumIndex.end())
+        {
+            out.push_back({K::EnumAdded, e.key, {}, 0, static_cast<i64>(e.members.size())});
+            continue;
+        }
+        const LayoutEnum& old = a.enums[it->second];
+        st.enumsCompared++;
+        if (old.hash == e.hash)
+        {
+            st.enumsSkipped++;
+            continue;
+        }
+        DiffLayoutEnum(old, e, out);
+    }
+    for (auto& e : a.enums)
+    {
+        if (!b.enumIndex.count(e.key))
+        {
+            out.push_back({K::EnumRemoved, e.key, {}, static_cast<i64>(e.members.size()), 0});
+        }
+    }
+
+    if (stats)
+    {
+        *stats = st;
+    }
+    return out;
+}
+
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,154 @@
+#pragma once
+// Xrd-eXternalrEsolve - 反射布局差异：报告与对外接口
+// 报告为纯文本，每行一条变化，首列两个字符表示种类：
+//   +T / -T  类型增删          ~S  大小变化        ~P  父类变化
+//   +M / -M  成员增删          >M  成员偏移移动    ~M  成员类型/大小变化
+//   +F / -F  函数增删          ~F  函数签名/标志变化
+//   +E / -E  枚举增删          +V / -V / ~V  枚举值增删改
+
+#include "dump_diff.hpp"
+#include "dump_model_load.hpp"
+#include "dump_code_builder.hpp"
+#include <fstream>
+#include <chrono>
+#include <iostream>
+
+namespace xrd
+{
+namespace detail
+{
+
+inline void FormatLayoutChange(CodeBuilder& out, const LayoutChange& c)
+{
+    using K = LayoutChangeKind;
+    switch (c.kind)
+    {
+        case K::TypeAdded:
+            out.Format("+T {} size=0x{:X}\n", c.owner, c.newValue); break;
+        case K::TypeRemoved:
+            out.Format("-T {} size=0x{:X}\n", c.owner, c.oldValue); break;
+        case K::SizeChanged:
+            out.Format("~S {} 0x{:X} -> 0x{:X}\n", c.owner, c.oldValue, c.newValue); break;
+        case K::SuperChanged:
+            out.Format("~P {} {} -> {}\n", c.owner, c.oldText, c.newText); break;
+        case K::MemberAdded:
+            out.Format("+M {}.{} 0x{:X} {}\n", c.owner, c.item, c.newValue, c.newText); break;
+        case K::MemberRemoved:
+            out.Format("-M {}.{} 0x{:X} {}\n", c.owner, c.item, c.oldValue, c.oldText); break;
+        case K::MemberMoved:
+            out.Format(">M {}.{} 0x{:X}{} -> 0x{:X}{}\n", c.owner, c.item,
+                c.oldValue, c.oldText, c.newValue, c.newText); break;
+        case K::MemberTypeChanged:
+            out.Format("~M {}.{} {} (0x{:X}) -> {} (0x{:X})\n", c.owner, c.item,
+                c.oldText, c.oldValue, c.newText, c.newValue); break;
+        case K::FunctionAdded:
+            out.Format("+F {}.{} {}\n", c.owner, c.item, c.newText); break;
+        case K::FunctionRemoved:
+            out.Format("-F {}.{} {}\n", c.owner, c.item, c.oldText); break;
+        case K::FunctionChanged:
+            out.Format("~F {}.{} {} [0x{:X}] -> {} [0x{:X}]\n", c.owner, c.item,
+                c.oldText, static_cast<u64>(c.oldValue), c.newText, static_cast<u64>(c.newValue));
+            break;
+        case K::EnumAdded:
+            out.Format("+E {} ({} values)\n", c.owner, c.newValue); break;
+        case K::EnumRemoved:
+            out.Format("-E {} ({} values)\n", c.owner, c.oldValue); break;
+        case K::EnumValueAdded:
+            out.Format("+V {}::{} = {}\n", c.owner, c.item, c.newValue); break;
+        case K::EnumValueRemoved:
+            out.Format("-V {}::{} = {}\n", c.owner, c.item, c.oldValue); break;
+        case K::EnumValueChanged:
+            out.Format("~V {}::{} {} -> {}\n", c.owner, c.item, c.oldValue, c.newValue); break;
+    }
+}
+
+inline bool WriteLayoutDiffReport(
+    const std::wstring& reportPath,
+    const std::vector<LayoutChange>& changes,
+    const LayoutDiffStats& stats)
+{
+    CodeBuilder out;
+    out.Format("// Layout diff by Xrd-eXternalrEsolve\n"
+        "// types compared: {} (unchanged {}), enums compared: {} (unchanged {}), changes: {}\n\n",
+        stats.typesCompared, stats.typesSkipped,
+        stats.enumsCompared, stats.enumsSkipped, changes.size());
+    for (auto& c : changes)
+    {
+        FormatLayoutChange(out, c);
+    }
+
+    std::ofstream file(reportPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    std::string text = out.ToString();
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    return file.good();
+}
+
+// 比较并写出报告，记录比较耗时
+inline bool DiffAndReport(
+    const LayoutSnapshot& oldSnap,
+    const LayoutSnapshot& newSnap,
+    const std::wstring& reportPath)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    LayoutDiffStats stats;
+    auto changes = DiffLayoutSnapshots(oldSnap, newSnap, &stats);
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - t0).count();
+    std::cerr << "[xrd] 布局差异: " << changes.size() << " 处变化, 比较 "
+              << stats.typesCompared << " 个类型 (跳过 " << stats.typesSkipped
+              << "), 耗时 " << ms << " ms\n";
+    return WriteLayoutDiffReport(reportPath, changes, stats);
+}
+
+} // namespace detail
+
+// ─── 比较两份反射模型文件（旧版本, 新版本） ───
+// 加载模型会替换属性/函数缓存
+inline bool DiffReflectionModels(
+    const std::wstring& oldModelPath,
+    const std::wstring& newModelPath,
+    const std::wstring& reportPath)
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!LoadReflectionModel(oldModelPath, m))
+    {
+        return false;
+    }
+    detail::LayoutSnapshot oldSnap = detail::BuildLayoutSnapshot(m);
+    if (!LoadReflectionModel(newModelPath, m))
+    {
+        return false;
+    }
+    detail::LayoutSnapshot newSnap = detail::BuildLayoutSnapshot(m);
+    return detail::DiffAndReport(oldSnap, newSnap, reportPath);
+}
+
+// ─── 比较旧模型文件与当前进程 ───
+// 先加载旧模型建立快照，再实时采集（采集会重建缓存）
+inline bool DiffReflectionModelWithLive(
+    const std::wstring& oldModelPath,
+    const std::wstring& reportPath,
+    const SdkDumpOptions& options = {})
+{
+    if (!IsInited()) return false;
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!LoadReflectionModel(oldModelPath, m))
+    {
+        return false;
+    }
+    detail::LayoutSnapshot oldSnap = detail::BuildLayoutSnapshot(m);
+    // 快照需要全部条目的成员，采集时不按内存上限释放
+    SdkDumpOptions captureOptions = options;
+    captureOptions.memoryBudgetMB = 0;
+    if (!CaptureReflectionModel(m, captureOptions))
+    {
+        return false;
+    }
+    detail::LayoutSnapshot newSnap = detail::BuildLayoutSnapshot(m);
+    return detail::DiffAndReport(oldSnap, newSnap, reportPath);
+}
+
+} // namespace xrd
@@ -5,6 +5,8 @@
 #include "../../core/context.hpp"
 #include "../../engine/objects/objects.hpp"
 #include "../../engine/names.hpp"
+#include "../../engine/names_batch.hpp"
+#include "dump_progress.hpp"
 #include <string>
 #include <vector>
 #include <iostream>
@@ -23,6 +25,7 @@ struct EnumMember
 struct EnumInfo
 {
     uptr addr = 0;
+    i32 objIndex = -1;  // 枚举对象自身的 GObjects 索引
     i32 pkgIndex = -1;  // 包对象的 GObjects 索引
     std::string name;
     std::string outerName;
@@ -30,8 +33,16 @@ struct EnumInfo
     u8 underlyingTypeSize = 1; // 枚举底层类型大小，由属性的 ElementSize 决定
 };
 
+// UEnum::Names 的元素：TPair<FName, int64> = 16 字节
+struct EnumNamePair
+{
+    FName name;
+    i64 value;
+};
+static_assert(sizeof(EnumNamePair) == 16);
+
 // 从 UEnum 对象读取枚举成员
-// UEnum::Names 是一个 TArray<TPair<FName, int64>>
+// 整个 Names 数组一次读取、本地解码，名称批量解析
 inline std::vector<EnumMember> ReadEnumMembers(uptr enumObj)
 {
     std::vector<EnumMember> result;
@@ -40,33 +51,25 @@ inline std::vector<EnumMember> ReadEnumMembers(uptr enumObj)
         return result;
     }
 
-    // TArray 布局: +0x00 Data*, +0x08 Count (i32), +0x0C Max (i32)
-    uptr data = 0;
-    i32 count = 0;
-    GReadPtr(enumObj + Off().UEnum_Names, data);
-    GReadI32(enumObj + Off().UEnum_Names + 8, count);
-
-    if (!IsCanonicalUserPtr(data) || count <= 0 || count > 1024)
+    std::vector<EnumNamePair> pairs;
+    if (!GReadRemoteArray(enumObj + Off().UEnum_Names, pairs) || pairs.empty())
     {
         return result;
     }
 
-    // 每个元素是 TPair<FName, int64> = 16 字节
-    constexpr i32 kPairSize = 16;
-
-    for (i32 i = 0; i < count; ++i)
+    std::vector<FName> fnames;
+    fnames.reserve(pairs.size());
+    for (auto& p : pairs)
     {
-        uptr pairAddr = data + i * kPairSize;
-
-        FName fname{};
-        i64 value = 0;
-        if (!GReadValue(pairAddr, fname))
-        {
-            continue;
-        }
-        GReadValue(pairAddr + 8, value);
+        fnames.push_back(p.name);
+    }
+    std::vector<std::string> names;
+    ResolveNamesBatch(fnames.data(), fnames.size(), names);
 
-        std::string name = GetNameFromFName(fname.ComparisonIndex, fname.Number);
+    result.reserve(pairs.size());
+    for (size_t i = 0; i < pairs.size(); ++i)
+    {
+        std::string& name = names[i];
         if (name.empty())
         {
             continue;
@@ -79,20 +82,33 @@ inline std::vector<EnumMember> ReadEnumMembers(uptr enumObj)
             name = name.substr(colonPos + 2);
         }
 
-        result.push_back({std::move(name), value});
+        result.push_back({std::move(name), pairs[i].value});
     }
 
     return result;
 }
 
 // 收集所有 UEnum 对象
-inline std::vector<EnumInfo> CollectAllEnums()
+// progress 非空时按对象数汇报进度；取消时返回空列表
+inline std::vector<EnumInfo> CollectAllEnums(SdkProgressReporter* progress = nullptr)
 {
     std::vector<EnumInfo> enums;
     i32 total = GetTotalObjectCount();
+    if (progress)
+    {
+        progress->BeginStage(SdkDumpStage::CollectEnums, static_cast<u64>(total));
+    }
 
     for (i32 i = 0; i < total; ++i)
     {
+        if (progress && (i & 0xFFF) == 0)
+        {
+            if (progress->Cancelled())
+            {
+                return {};
+            }
+            progress->SetDone(static_cast<u64>(i));
+        }
         uptr obj = GetObjectByIndex(i);
         if (!IsCanonicalUserPtr(obj))
         {
@@ -107,6 +123,7 @@ inline std::vector<EnumInfo> CollectAllEnums()
 
         EnumInfo ei;
         ei.addr = obj;
+        ei.objIndex = i;
         ei.name = GetObjectName(obj);
         if (ei.name.empty())
         {
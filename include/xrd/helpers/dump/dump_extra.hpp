@@ -1,9 +1,10 @@
 #pragma once
 // Xrd-eXternalrEsolve - SDK 导出：附加格式
-// OffsetTable 和 Mapping 导出
+// OffsetTable、Mapping 与 .usmap 导出（写入逻辑与采集分离，可由反射模型驱动）
 // 从 dump_sdk.hpp 拆分，保持单文件 300 行以内
 
 #include "dump_sdk.hpp"
+#include "dump_usmap.hpp"
 #include <fstream>
 #include <filesystem>
 #include <set>
@@ -11,11 +12,14 @@
 namespace xrd
 {
 
-// ─── 导出偏移表格式 ───
-inline bool DumpOffsetTable(const std::wstring& outputPath)
+namespace detail
 {
-    if (!IsInited()) return false;
 
+// 写入 OffsetsTable.txt（属性取自 CollectProperties 缓存）
+inline bool WriteOffsetTable(
+    const std::wstring& outputPath,
+    const std::vector<StructEntry>& entries)
+{
     namespace fs = std::filesystem;
     fs::create_directories(outputPath);
 
@@ -25,10 +29,9 @@ inline bool DumpOffsetTable(const std::wstring& outputPath)
 
     file << "// Offset dump by Xrd-eXternalrEsolve\n\n";
 
-    auto entries = CollectAllStructEntries();
     for (auto& entry : entries)
     {
-        auto props = detail::CollectProperties(entry.addr);
+        const auto& props = CollectProperties(entry.addr);
         file << "[" << entry.name << "] // Size: 0x"
              << std::hex << entry.size << std::dec << "\n";
         for (auto& prop : props)
@@ -46,11 +49,11 @@ inline bool DumpOffsetTable(const std::wstring& outputPath)
     return true;
 }
 
-// ─── 导出 Mapping ───
-inline bool DumpMapping(const std::wstring& outputPath)
+// 写入 Mapping.txt（属性取自 CollectProperties 缓存）
+inline bool WriteMapping(
+    const std::wstring& outputPath,
+    const std::vector<StructEntry>& entries)
 {
-    if (!IsInited()) return false;
-
     namespace fs = std::filesystem;
     fs::create_directories(outputPath);
 
@@ -61,13 +64,12 @@ inline bool DumpMapping(const std::wstring& outputPath)
     file << "// Mapping dump by Xrd-eXternalrEsolve\n\n";
 
     std::set<std::string> written;
-    auto entries = CollectAllStructEntries();
     for (auto& entry : entries)
     {
         if (written.count(entry.name)) continue;
         written.insert(entry.name);
 
-        auto props = detail::CollectProperties(entry.addr);
+        const auto& props = CollectProperties(entry.addr);
         for (auto& prop : props)
         {
             file << entry.name << "." << prop.name << " "
@@ -81,10 +83,41 @@ inline bool DumpMapping(const std::wstring& outputPath)
     return true;
 }
 
+} // namespace detail
+
+// ─── 导出偏移表格式 ───
+inline bool DumpOffsetTable(const std::wstring& outputPath)
+{
+    if (!IsInited()) return false;
+    detail::AutoDumpSession session;
+    return detail::WriteOffsetTable(outputPath, CollectAllStructEntries());
+}
+
+// ─── 导出 Mapping ───
+inline bool DumpMapping(const std::wstring& outputPath)
+{
+    if (!IsInited()) return false;
+    detail::AutoDumpSession session;
+    return detail::WriteMapping(outputPath, CollectAllStructEntries());
+}
+
+// ─── 导出 .usmap（FModel / CUE4Parse 类型映射） ───
+// 类型树依赖在线解析的类型描述符，因此只能在线导出
+inline bool DumpUsmap(
+    const std::wstring& outputPath,
+    UsmapCompression compression = UsmapCompression::None)
+{
+    if (!IsInited()) return false;
+    detail::AutoDumpSession session;
+    return detail::WriteUsmap(outputPath, CollectAllStructEntries(),
+        detail::CollectAllEnums(), compression);
+}
+
 // ─── 导出 GObjects-Dump 格式（对标 Rei-Dumper 的 Dumpspace 格式） ───
 inline bool DumpSpaceSdk(const std::wstring& outputPath)
 {
     if (!IsInited()) return false;
+    detail::AutoDumpSession session;
 
     namespace fs = std::filesystem;
     fs::create_directories(outputPath);
@@ -165,7 +198,7 @@ inline bool DumpSpaceSdk(const std::wstring& outputPath)
 
             if (isClassOrStruct)
             {
-                auto props = detail::CollectProperties(obj);
+                const auto& props = detail::CollectProperties(obj);
                 for (auto& prop : props)
                 {
                     file << std::format(
@@ -0,0 +1,457 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：后台文件写入
+// 生成端把整个文件内容构建到一块连续缓冲区后提交，后台线程逐个文件一次性写入
+// 避免大量小块 << 与反复打开/追加文件（带杀软过滤驱动的文件系统上开销显著）
+
+#include "../../core/types.hpp"
+#include "../../core/utf.hpp"
+#include <Windows.h>
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+#include <type_traits>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <iostream>
+
+namespace xrd
+{
+namespace detail
+{
+
+// FNV-1a 64 位增量哈希
+struct Fnv1a64
+{
+    static constexpr u64 kOffset = 1469598103934665603ull;
+    static constexpr u64 kPrime  = 1099511628211ull;
+
+    u64 value = kOffset;
+
+    void Add(const void* data, size_t size)
+    {
+        const u8* p = static_cast<const u8*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            value ^= p[i];
+            value *= kPrime;
+        }
+    }
+
+    // 字符串带长度前缀，避免 "ab"+"c" 与 "a"+"bc" 相同
+    void Add(const std::string& s)
+    {
+        AddValue(static_cast<u64>(s.size()));
+        Add(s.data(), s.size());
+    }
+
+    template<typename T>
+    void AddValue(const T& v)
+    {
+        static_assert(std::is_arithmetic_v<T>);
+        Add(&v, sizeof(T));
+    }
+};
+
+inline u64 HashText(const std::string& text)
+{
+    Fnv1a64 h;
+    h.Add(text.data(), text.size());
+    return h.value;
+}
+
+// 宽字符路径转 UTF-8（增量清单以 UTF-8 相对路径为键）
+inline std::string PathToUtf8(const std::wstring& w)
+{
+    return WideToUtf8(w);
+}
+
+// 换行转换：与文本模式 ofstream 一致，'\n' 写为 "\r\n"
+inline std::string ToCrLf(const std::string& text)
+{
+    size_t lf = 0;
+    for (char c : text)
+    {
+        if (c == '\n')
+        {
+            lf++;
+        }
+    }
+    if (lf == 0)
+    {
+        return text;
+    }
+    std::string out;
+    out.reserve(text.size() + lf);
+    for (char c : text)
+    {
+        if (c == '\n')
+        {
+            out += '\r';
+        }
+        out += c;
+    }
+    return out;
+}
+
+// 以单次 WriteFile 写入整个文件（超过 4GB 时分块），返回是否成功
+inline bool WriteWholeFile(const std::wstring& path, const std::string& data)
+{
+    HANDLE h = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr,
+        CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (h == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    bool ok = true;
+    size_t pos = 0;
+    while (pos < data.size())
+    {
+        DWORD chunk = static_cast<DWORD>(
+            (std::min)(data.size() - pos, static_cast<size_t>(0x7FFFF000)));
+        DWORD written = 0;
+        if (!WriteFile(h, data.data() + pos, chunk, &written, nullptr)
+            || written == 0)
+        {
+            ok = false;
+            break;
+        }
+        pos += written;
+    }
+    CloseHandle(h);
+    return ok;
+}
+
+// 写入统计
+struct SdkWriteStats
+{
+    u64 files = 0;
+    u64 bytes = 0;          // 实际写入字节数（含 CRLF 转换）
+    u64 failedFiles = 0;
+    u64 unchangedFiles = 0;    // 内容哈希与清单一致而跳过写盘的文件
+    double writeSeconds = 0.0; // 后台线程用于换行转换与写盘的时间
+    u64 peakQueuedBytes = 0;   // 队列中待写文本的峰值
+    u64 throttledSubmits = 0;  // 因队列超过上限而阻塞的提交次数
+};
+
+// 后台写入器：Submit 只入队，写盘在独立线程完成，Finish 等待队列清空
+// 同一路径多次提交时后者覆盖前者（按提交顺序写入）
+// TrackHashes 后记录每个文件的内容哈希；与上次清单一致且文件存在时跳过写盘
+// SetQueueLimit 后待写文本超过上限时 Submit 阻塞，文件写完即释放其文本
+class SdkFileWriter
+{
+public:
+    SdkFileWriter()
+        : worker([this]() { Run(); })
+    {
+    }
+
+    ~SdkFileWriter()
+    {
+        Finish();
+    }
+
+    SdkFileWriter(const SdkFileWriter&) = delete;
+    SdkFileWriter& operator=(const SdkFileWriter&) = delete;
+
+    // 以 root 为根记录相对路径的内容哈希；previous 为上次清单（可为 nullptr）
+    // 须在首次 Submit 之前调用
+    void TrackHashes(
+        const std::wstring& root,
+        const std::unordered_map<std::string, u64>* previous)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        trackRoot = root;
+        prevHashes = previous;
+        tracking = true;
+    }
+
+    // 待写文本的字节上限，0 = 不限制
+    // 单个文件超过上限时仍可提交（队列为空时放行），不会死锁
+    void SetQueueLimit(u64 bytes)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        queueLimit = bytes;
+    }
+
+    // 每写完一个文件把写入字节数累加到 counter（进度汇报用），nullptr 关闭
+    // 须在首次 Submit 之前调用
+    void ObserveBytes(std::atomic<u64>* counter)
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        bytesObserver = counter;
+    }
+
+    // 已提交 / 已处理的任务数（含未变化文件）
+    u64 Submitted() const { return submitted.load(std::memory_order_relaxed); }
+    u64 Completed() const { return completed.load(std::memory_order_relaxed); }
+
+    // 等待队列清空，超时返回 false；调用方可在两次等待之间汇报进度或检查取消
+    bool WaitDrained(u32 timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return drainCv.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+            [&] { return Completed() == Submitted(); });
+    }
+
+    // 丢弃尚未开始写入的文件；正在写的文件会写完，不会留下半个文件
+    // 返回丢弃的文件数
+    size_t Abort()
+    {
+        size_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            dropped = queue.size();
+            queue.clear();
+            queuedBytes = 0;
+            completed.fetch_add(dropped, std::memory_order_relaxed);
+        }
+        drainCv.notify_all();
+        return dropped;
+    }
+
+    // 标记文件未重新生成：沿用上次清单中的哈希，不写盘
+    void KeepUnchanged(std::wstring path)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            queue.push_back({std::move(path), std::string(), true});
+            submitted.fetch_add(1, std::memory_order_relaxed);
+        }
+        cv.notify_one();
+    }
+
+    // Finish 之后读取：相对路径 → 内容哈希（只含成功写出或确认未变化的文件）
+    const std::unordered_map<std::string, u64>& FileHashes() const
+    {
+        return fileHashes;
+    }
+
+    // Finish 之后读取：写盘失败文件的相对路径（TrackHashes 后才记录）
+    const std::unordered_set<std::string>& FailedFiles() const
+    {
+        return failedKeys;
+    }
+
+    // 提交一个完整文件；content 被移入队列
+    void Submit(std::wstring path, std::string content)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            u64 size = content.size();
+            if (queueLimit && queuedBytes > 0 && queuedBytes + size > queueLimit)
+            {
+                stats.throttledSubmits++;
+                drainCv.wait(lock, [&]
+                {
+                    return queuedBytes == 0 || queuedBytes + size <= queueLimit;
+                });
+            }
+            queuedBytes += size;
+            stats.peakQueuedBytes = (std::max)(stats.peakQueuedBytes, queuedBytes);
+            queue.push_back({std::move(path), std::move(content)});
+            submitted.fetch_add(1, std::memory_order_relaxed);
+        }
+        cv.notify_one();
+    }
+
+    // 等待所有已提交文件写完并停止后台线程；可重复调用
+    const SdkWriteStats& Finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_one();
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+        return stats;
+    }
+
+    // 打印写入统计
+    void Report() const
+    {
+        std::cerr << "[xrd] 文件写入: " << stats.files << " 个文件, "
+                  << stats.bytes << " 字节, "
+                  << stats.writeSeconds << "s";
+        if (stats.unchangedFiles)
+        {
+            std::cerr << ", 未变化 " << stats.unchangedFiles << " 个";
+        }
+        if (stats.failedFiles)
+        {
+            std::cerr << ", 失败 " << stats.failedFiles << " 个";
+        }
+        if (queueLimit)
+        {
+            std::cerr << ", 队列峰值 " << (stats.peakQueuedBytes >> 20)
+                      << " MB / 上限 " << (queueLimit >> 20) << " MB, 阻塞 "
+                      << stats.throttledSubmits << " 次";
+        }
+        std::cerr << "\n";
+    }
+
+private:
+    struct Job
+    {
+        std::wstring path;
+        std::string content;
+        bool keepOnly = false;
+    };
+
+    std::string RelativeKey(const std::wstring& path) const
+    {
+        std::wstring rel = path;
+        if (rel.compare(0, trackRoot.size(), trackRoot) == 0)
+        {
+            rel.erase(0, trackRoot.size());
+        }
+        while (!rel.empty() && (rel[0] == L'/' || rel[0] == L'\\'))
+        {
+            rel.erase(0, 1);
+        }
+        std::replace(rel.begin(), rel.end(), L'\\', L'/');
+        return PathToUtf8(rel);
+    }
+
+    // 返回 true 表示内容与上次一致，无需写盘；否则 hash 为新内容的哈希，写盘成功后才记录
+    bool RecordHash(const Job& job, const std::string& key, u64& hash)
+    {
+        u64 prev = 0;
+        bool hasPrev = false;
+        if (prevHashes)
+        {
+            auto it = prevHashes->find(key);
+            if (it != prevHashes->end())
+            {
+                prev = it->second;
+                hasPrev = true;
+            }
+        }
+        if (job.keepOnly)
+        {
+            if (hasPrev)
+            {
+                fileHashes[key] = prev;
+            }
+            return true;
+        }
+        hash = HashText(job.content);
+        std::error_code ec;
+        if (hasPrev && prev == hash && std::filesystem::exists(job.path, ec))
+        {
+            fileHashes[key] = hash;
+            return true;
+        }
+        return false;
+    }
+
+    void Run()
+    {
+        for (;;)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (queue.empty())
+                {
+                    return;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            u64 size = job.content.size();
+            Write(job);
+            // 文件写完立即释放文本，再归还队列额度
+            std::string().swap(job.content);
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                queuedBytes -= (std::min)(queuedBytes, size); // Abort 已清零时不下溢
+                completed.fetch_add(1, std::memory_order_relaxed);
+            }
+            drainCv.notify_all();
+        }
+    }
+
+    void Write(const Job& job)
+    {
+        using Clock = std::chrono::steady_clock;
+        std::string key;
+        u64 hash = 0;
+        if (tracking)
+        {
+            key = RelativeKey(job.path);
+        }
+        if (tracking && RecordHash(job, key, hash))
+        {
+            if (!job.keepOnly)
+            {
+                stats.unchangedFiles++;
+            }
+            return;
+        }
+        if (job.keepOnly)
+        {
+            return;
+        }
+        auto t0 = Clock::now();
+        std::string data = ToCrLf(job.content);
+        bool ok = WriteWholeFile(job.path, data);
+        stats.writeSeconds += std::chrono::duration<double>(
+            Clock::now() - t0).count();
+        stats.files++;
+        if (ok)
+        {
+            if (tracking)
+            {
+                fileHashes[key] = hash;
+                failedKeys.erase(key); // 同一路径重新提交且写成功
+            }
+            stats.bytes += data.size();
+            if (bytesObserver)
+            {
+                bytesObserver->fetch_add(data.size(), std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            // 不记录哈希：下次增量导出不会把缺失或过期的文件当作未变化
+            stats.failedFiles++;
+            if (tracking)
+            {
+                fileHashes.erase(key);
+                failedKeys.insert(key);
+            }
+        }
+    }
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable drainCv; // 任务完成时唤醒阻塞的 Submit / WaitDrained
+    std::deque<Job> queue;
+    u64 queueLimit = 0;
+    u64 queuedBytes = 0;
+    std::atomic<u64> submitted{0};
+    std::atomic<u64> completed{0};
+    std::atomic<u64>* bytesObserver = nullptr;
+    bool stopping = false;
+    SdkWriteStats stats;
+    bool tracking = false;
+    std::wstring trackRoot;
+    const std::unordered_map<std::string, u64>* prevHashes = nullptr;
+    std::unordered_map<std::string, u64> fileHashes;
+    std::unordered_set<std::string> failedKeys;
+    std::thread worker; // 最后初始化：启动时其余成员已构造
+};
+
+} // namespace detail
+} // namespace xrd
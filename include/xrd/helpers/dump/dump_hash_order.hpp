@@ -0,0 +1,372 @@
+#pragma once
+// Xrd-eXternalrEsolve - 确定性 i32 哈希容器
+// HashOrderSet / HashOrderMap 以固定规则复现 MSVC STL unordered_set/unordered_map<i32> 的遍历顺序
+// HashOrderStringSet 对应 unordered_set<std::string>（结构体排序时按依赖名去重）
+// 依赖图、包分组与包依赖表使用它们：SDK 中包与类型的排列只取决于插入序列，与编译器/标准库无关
+//
+// 顺序规则（MSVC STL xhash，VS2019 起）：
+//   哈希：FNV-1a 64 作用于键的字节（i32 为 4 个小端字节，字符串为其字符），低位作桶号
+//   桶数：初始 8，始终为 2 的幂；插入使元素数超过桶数时扩容（max_load_factor = 1）
+//         桶数 < 512 时扩为 8 倍，否则扩为 2 倍
+//   插入：所在桶为空时追加到链表末尾，否则插到该桶第一个元素之前
+//   扩容：按原链表顺序重新分桶，桶内首个元素位置不动，其余移到该桶第一个元素之前
+//   删除只摘除节点；clear 保留桶数（与 MSVC 一致），reset 回到默认构造状态
+// 接口与 std 容器同名，作为依赖代码中 unordered_set/map<i32> 的直接替换
+
+#include "../../core/types.hpp"
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace xrd
+{
+namespace detail
+{
+
+// MSVC std::hash：FNV-1a 64 作用于键的对象表示
+inline size_t HashOrderBytes(const unsigned char* p, size_t n)
+{
+    u64 h = 14695981039346656037ull;
+    for (size_t i = 0; i < n; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return static_cast<size_t>(h);
+}
+
+inline size_t HashOrderHash(i32 key)
+{
+    u32 v = static_cast<u32>(key);
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        bytes[i] = static_cast<unsigned char>((v >> (i * 8)) & 0xFF);
+    }
+    return HashOrderBytes(bytes, 4);
+}
+
+inline size_t HashOrderHash(std::string_view key)
+{
+    return HashOrderBytes(reinterpret_cast<const unsigned char*>(key.data()), key.size());
+}
+
+// 顺序核心：双向链表（节点 0 为哨兵）+ 每桶 [lo, hi] 区间
+// K 为 i32 或 std::string，哈希见 HashOrderHash
+template<typename K>
+class HashOrderIndexT
+{
+public:
+    static constexpr size_t kMinBuckets = 8;
+
+    HashOrderIndexT() { reset(); }
+
+    template<typename Q>
+    static size_t Hash(const Q& key) { return HashOrderHash(key); }
+
+    // 返回节点编号，0 表示不存在
+    template<typename Q>
+    u32 Find(const Q& key) const
+    {
+        size_t b = Hash(key) & mask;
+        if (lo[b] == 0)
+        {
+            return 0;
+        }
+        for (u32 n = hi[b];; n = nodes[n].prev)
+        {
+            if (nodes[n].key == key)
+            {
+                return n;
+            }
+            if (n == lo[b])
+            {
+                return 0;
+            }
+        }
+    }
+
+    template<typename Q>
+    u32 Insert(const Q& key, bool& inserted)
+    {
+        u32 found = Find(key);
+        inserted = (found == 0);
+        if (found)
+        {
+            return found;
+        }
+        if (count + 1 > lo.size())
+        {
+            size_t buckets = lo.size();
+            Rehash(buckets < 512 ? buckets * 8 : buckets * 2);
+        }
+        size_t b = Hash(key) & mask;
+        u32 n = static_cast<u32>(nodes.size());
+        nodes.push_back({K(key), 0, 0});
+        if (lo[b] == 0)
+        {
+            LinkBefore(n, 0);
+            lo[b] = hi[b] = n;
+        }
+        else
+        {
+            LinkBefore(n, lo[b]);
+            lo[b] = n;
+        }
+        count++;
+        return n;
+    }
+
+    template<typename Q>
+    bool Erase(const Q& key)
+    {
+        u32 n = Find(key);
+        if (!n)
+        {
+            return false;
+        }
+        size_t b = Hash(key) & mask;
+        if (hi[b] == n)
+        {
+            if (lo[b] == n)
+            {
+                lo[b] = hi[b] = 0;
+            }
+            else
+            {
+                hi[b] = nodes[n].prev;
+            }
+        }
+        else if (lo[b] == n)
+        {
+            lo[b] = nodes[n].next;
+        }
+        Unlink(n);
+        count--;
+        return true;
+    }
+
+    // 清空元素，保留桶数
+    void clear()
+    {
+        nodes.resize(1);
+        nodes[0] = {K{}, 0, 0};
+        std::fill(lo.begin(), lo.end(), 0u);
+        std::fill(hi.begin(), hi.end(), 0u);
+        count = 0;
+    }
+
+    // 回到默认构造状态（8 个桶），保留已分配的内存
+    void reset()
+    {
+        lo.assign(kMinBuckets, 0);
+        hi.assign(kMinBuckets, 0);
+        mask = kMinBuckets - 1;
+        clear();
+    }
+
+    u32 First() const { return nodes[0].next; }
+    u32 Next(u32 n) const { return nodes[n].next; }
+    const K& Key(u32 n) const { return nodes[n].key; }
+    size_t Size() const { return count; }
+    size_t NodeCapacity() const { return nodes.size(); }
+
+private:
+    struct Node
+    {
+        K key;
+        u32 prev;
+        u32 next;
+    };
+
+    void LinkBefore(u32 n, u32 before)
+    {
+        u32 after = nodes[before].prev;
+        nodes[n].prev = after;
+        nodes[n].next = before;
+        nodes[after].next = n;
+        nodes[before].prev = n;
+    }
+
+    void Unlink(u32 n)
+    {
+        nodes[nodes[n].prev].next = nodes[n].next;
+        nodes[nodes[n].next].prev = nodes[n].prev;
+    }
+
+    void Rehash(size_t buckets)
+    {
+        lo.assign(buckets, 0);
+        hi.assign(buckets, 0);
+        mask = buckets - 1;
+        u32 n = nodes[0].next;
+        while (n != 0)
+        {
+            u32 next = nodes[n].next;
+            size_t b = Hash(nodes[n].key) & mask;
+            if (lo[b] == 0)
+            {
+                lo[b] = hi[b] = n;
+            }
+            else
+            {
+                Unlink(n);
+                LinkBefore(n, lo[b]);
+                lo[b] = n;
+            }
+            n = next;
+        }
+    }
+
+    std::vector<Node> nodes;
+    std::vector<u32> lo;
+    std::vector<u32> hi;
+    size_t mask = 0;
+    size_t count = 0;
+};
+
+using HashOrderIndex = HashOrderIndexT<i32>;
+
+// 按链表顺序遍历的前向迭代器；Deref 决定解引用结果
+template<typename Owner, typename Ref>
+class HashOrderIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_cv_t<std::remove_reference_t<Ref>>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::remove_reference_t<Ref>*;
+    using reference = Ref;
+
+    HashOrderIterator() = default;
+    HashOrderIterator(Owner* o, u32 n) : owner(o), node(n) {}
+
+    Ref operator*() const { return owner->Deref(node); }
+    pointer operator->() const { return &owner->Deref(node); }
+    HashOrderIterator& operator++()
+    {
+        node = owner->order.Next(node);
+        return *this;
+    }
+    HashOrderIterator operator++(int)
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+    bool operator==(const HashOrderIterator& o) const { return node == o.node; }
+    bool operator!=(const HashOrderIterator& o) const { return node != o.node; }
+
+private:
+    Owner* owner = nullptr;
+    u32 node = 0;
+};
+
+class HashOrderSet
+{
+public:
+    using const_iterator = HashOrderIterator<const HashOrderSet, const i32&>;
+    using iterator = const_iterator;
+
+    bool insert(i32 key)
+    {
+        bool inserted = false;
+        u32 n = order.Insert(key, inserted);
+        if (inserted)
+        {
+            keys.resize(order.NodeCapacity());
+            keys[n] = key;
+        }
+        return inserted;
+    }
+    size_t count(i32 key) const { return order.Find(key) ? 1 : 0; }
+    size_t erase(i32 key) { return order.Erase(key) ? 1 : 0; }
+    void clear() { order.clear(); keys.clear(); }
+    void reset() { order.reset(); keys.clear(); }
+    size_t size() const { return order.Size(); }
+    bool empty() const { return order.Size() == 0; }
+    const_iterator begin() const { return {this, order.First()}; }
+    const_iterator end() const { return {this, 0}; }
+
+private:
+    friend const_iterator;
+    const i32& Deref(u32 n) const { return keys[n]; }
+
+    HashOrderIndex order;
+    std::vector<i32> keys; // 按节点编号存放，供迭代器返回引用
+};
+
+// unordered_set<std::string> 的确定性替换；只需插入与遍历
+class HashOrderStringSet
+{
+public:
+    using const_iterator = HashOrderIterator<const HashOrderStringSet, const std::string&>;
+    using iterator = const_iterator;
+
+    bool insert(std::string_view key)
+    {
+        bool inserted = false;
+        order.Insert(key, inserted);
+        return inserted;
+    }
+    size_t count(std::string_view key) const { return order.Find(key) ? 1 : 0; }
+    void reset() { order.reset(); }
+    size_t size() const { return order.Size(); }
+    bool empty() const { return order.Size() == 0; }
+    const_iterator begin() const { return {this, order.First()}; }
+    const_iterator end() const { return {this, 0}; }
+
+private:
+    friend const_iterator;
+    const std::string& Deref(u32 n) const { return order.Key(n); }
+
+    HashOrderIndexT<std::string> order;
+};
+
+template<typename V>
+class HashOrderMap
+{
+public:
+    using value_type = std::pair<i32, V>;
+    using iterator = HashOrderIterator<HashOrderMap, value_type&>;
+    using const_iterator = HashOrderIterator<const HashOrderMap, const value_type&>;
+
+    V& operator[](i32 key)
+    {
+        bool inserted = false;
+        u32 n = order.Insert(key, inserted);
+        if (inserted)
+        {
+            values.resize(order.NodeCapacity());
+            values[n].first = key;
+        }
+        return values[n].second;
+    }
+    iterator find(i32 key) { return {this, order.Find(key)}; }
+    const_iterator find(i32 key) const { return {this, order.Find(key)}; }
+    size_t count(i32 key) const { return order.Find(key) ? 1 : 0; }
+    void clear() { order.clear(); values.clear(); }
+    size_t size() const { return order.Size(); }
+    bool empty() const { return order.Size() == 0; }
+    iterator begin() { return {this, order.First()}; }
+    iterator end() { return {this, 0}; }
+    const_iterator begin() const { return {this, order.First()}; }
+    const_iterator end() const { return {this, 0}; }
+
+private:
+    friend iterator;
+    friend const_iterator;
+    value_type& Deref(u32 n) { return values[n]; }
+    const value_type& Deref(u32 n) const { return values[n]; }
+
+    HashOrderIndex order;
+    std::vector<value_type> values; // 按节点编号存放，0 号为哨兵占位
+};
+
+} // namespace detail
+} // namespace xrd
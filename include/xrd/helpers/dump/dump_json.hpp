@@ -0,0 +1,213 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：流式 JSON 反射数据
+// 单次遍历 GObjects，每遇到一个类/结构体/枚举就写出一条记录后丢弃
+// 属性与函数沿用 CollectProperties / CollectFunctions：命中已有缓存则复用，未命中的结果不写入缓存
+// 因此内存占用与对象数量无关（名称缓存与类型描述符表只随不同名称/类型数增长）
+// 对象的类名按类指针在本地表中解析，不经过按对象地址缓存的 GetObjectClassName
+//
+// 文件结构：
+//   {"generator":"Xrd-eXternalrEsolve","format":1,"objects":[
+//   {"kind":"class","name":...,"properties":[...],"functions":[...]},
+//   {"kind":"enum","name":...,"members":[...]},
+//   ...],"counts":{"classes":N,"structs":N,"enums":N}}
+
+#include "dump_collect.hpp"
+#include "dump_enum.hpp"
+#include "dump_json_writer.hpp"
+#include "dump_session.hpp"
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+namespace xrd
+{
+
+namespace detail
+{
+
+constexpr i32 kJsonDumpFormat = 1;
+
+inline void WriteJsonProperties(JsonWriter& w, const std::vector<PropertyInfo>& props)
+{
+    w.Key("properties");
+    w.BeginArray();
+    for (auto& p : props)
+    {
+        w.BeginObject();
+        w.Field("name", p.name);
+        w.Field("type", p.typeName);
+        w.Field("fieldClass", p.fieldClassName);
+        w.Field("offset", p.offset);
+        w.Field("size", p.size);
+        w.Field("arrayDim", p.arrayDim);
+        w.Field("flags", p.flags);
+        if (p.isBitField)
+        {
+            w.Field("bitIndex", p.bitIndex);
+            w.Field("bitCount", p.bitCount);
+        }
+        w.EndObject();
+    }
+    w.EndArray();
+}
+
+inline void WriteJsonFunctions(JsonWriter& w, const std::vector<FunctionInfo>& funcs)
+{
+    w.Key("functions");
+    w.BeginArray();
+    for (auto& f : funcs)
+    {
+        w.BeginObject();
+        w.Field("name", f.name);
+        w.Field("flags", f.functionFlags);
+        w.Field("paramsSize", f.paramStructSize);
+        w.Field("returnType", f.returnType);
+        w.Key("params");
+        w.BeginArray();
+        for (auto& p : f.params)
+        {
+            if (p.isReturnParam)
+            {
+                continue;
+            }
+            w.BeginObject();
+            w.Field("name", p.name);
+            w.Field("type", p.sigTypeName);
+            w.Field("offset", p.offset);
+            w.Field("size", p.size);
+            w.Field("flags", p.flags);
+            w.EndObject();
+        }
+        w.EndArray();
+        w.EndObject();
+    }
+    w.EndArray();
+}
+
+// 写出一个类/结构体记录
+inline void WriteJsonStruct(JsonWriter& w, uptr obj, i32 index, bool isClass)
+{
+    w.BeginObject();
+    w.Field("kind", isClass ? "class" : "struct");
+    w.Field("name", GetObjectName(obj));
+    w.Field("index", index);
+    uptr pkg = GetOutermostOuter(obj);
+    w.Field("package", pkg ? GetObjectName(pkg) : std::string("Global"));
+    uptr super = GetSuperStruct(obj);
+    w.Field("super", super ? GetObjectName(super) : std::string());
+    w.Field("size", GetStructSize(obj));
+    std::vector<PropertyInfo> propScratch;
+    WriteJsonProperties(w, CollectPropertiesTransient(obj, propScratch));
+    if (isClass)
+    {
+        std::vector<FunctionInfo> funcScratch;
+        WriteJsonFunctions(w, CollectFunctionsTransient(obj, funcScratch));
+    }
+    w.EndObject();
+}
+
+// 写出一个枚举记录
+inline void WriteJsonEnum(JsonWriter& w, uptr obj, i32 index, const std::string& name)
+{
+    w.BeginObject();
+    w.Field("kind", "enum");
+    w.Field("name", name);
+    w.Field("index", index);
+    uptr pkg = GetOutermostOuter(obj);
+    w.Field("package", pkg ? GetObjectName(pkg) : std::string("Global"));
+    w.Key("members");
+    w.BeginArray();
+    for (auto& m : ReadEnumMembers(obj))
+    {
+        w.BeginObject();
+        w.Field("name", m.name);
+        w.Field("value", m.value);
+        w.EndObject();
+    }
+    w.EndArray();
+    w.EndObject();
+}
+
+} // namespace detail
+
+// ─── 导出 JSON 反射数据（Reflection.json） ───
+inline bool DumpJson(const std::wstring& outputPath)
+{
+    if (!IsInited()) return false;
+    detail::AutoDumpSession session;
+
+    namespace fs = std::filesystem;
+    fs::create_directories(outputPath);
+    std::ofstream file(outputPath + L"/Reflection.json", std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    detail::JsonWriter w(file);
+    w.BeginObject();
+    w.Field("generator", "Xrd-eXternalrEsolve");
+    w.Field("format", detail::kJsonDumpFormat);
+    w.Key("objects");
+    w.BeginArray();
+
+    u32 classes = 0;
+    u32 structs = 0;
+    u32 enums = 0;
+    std::unordered_map<uptr, std::string> classNames; // 类指针 → 类名，条目数 = 不同类的数量
+    i32 total = GetTotalObjectCount();
+    for (i32 i = 0; i < total; ++i)
+    {
+        uptr obj = GetObjectByIndex(i);
+        if (!IsCanonicalUserPtr(obj))
+        {
+            continue;
+        }
+
+        uptr cls = GetObjectClass(obj);
+        auto cit = classNames.find(cls);
+        if (cit == classNames.end())
+        {
+            cit = classNames.emplace(cls, GetObjectName(cls)).first;
+        }
+        const std::string& className = cit->second;
+        bool isClass = detail::IsClassTypeName(className);
+        if (isClass || detail::IsScriptStructTypeName(className))
+        {
+            if (GetObjectName(obj).empty())
+            {
+                continue;
+            }
+            w.Newline();
+            detail::WriteJsonStruct(w, obj, i, isClass);
+            (isClass ? classes : structs)++;
+        }
+        else if (className == "Enum" || className == "UserDefinedEnum")
+        {
+            std::string name = GetObjectName(obj);
+            if (name.empty())
+            {
+                continue;
+            }
+            w.Newline();
+            detail::WriteJsonEnum(w, obj, i, name);
+            enums++;
+        }
+    }
+
+    w.Newline();
+    w.EndArray();
+    w.Key("counts");
+    w.BeginObject();
+    w.Field("classes", classes);
+    w.Field("structs", structs);
+    w.Field("enums", enums);
+    w.EndObject();
+    w.EndObject();
+    w.Flush();
+    if (!w.Good()) return false;
+
+    std::cerr << "[xrd] JSON 导出完成: " << classes << " 个类, "
+              << structs << " 个结构体, " << enums << " 个枚举\n";
+    return true;
+}
+
+} // namespace xrd
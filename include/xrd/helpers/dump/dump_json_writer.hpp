@@ -0,0 +1,179 @@
+#pragma once
+// Xrd-eXternalrEsolve - 流式 JSON 写出器
+// 直接把记录写入固定大小的缓冲区，满了就写到输出流：不构建 DOM，不保留已写出的字符串
+// 只负责语法（逗号、引号、转义），嵌套结构由调用方按顺序调用保证
+
+#include "../../core/types.hpp"
+#include <ostream>
+#include <string_view>
+#include <charconv>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+namespace xrd
+{
+namespace detail
+{
+
+class JsonWriter
+{
+public:
+    static constexpr size_t kBufferSize = 256 * 1024;
+
+    explicit JsonWriter(std::ostream& stream)
+        : out(stream), buffer(new char[kBufferSize])
+    {
+    }
+    ~JsonWriter() { Flush(); }
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    void BeginObject() { Separator(); Raw('{'); first.push_back(true); }
+    void EndObject()   { first.pop_back(); PendingNewline(); Raw('}'); }
+    void BeginArray()  { Separator(); Raw('['); first.push_back(true); }
+    void EndArray()    { first.pop_back(); PendingNewline(); Raw(']'); }
+
+    // 对象键；随后必须写入一个值
+    void Key(std::string_view k)
+    {
+        Separator();
+        Quoted(k);
+        Raw(':');
+        afterKey = true;
+    }
+
+    void String(std::string_view v) { Separator(); Quoted(v); }
+    void Bool(bool v)               { Separator(); Raw(v ? std::string_view("true") : "false"); }
+    void Null()                     { Separator(); Raw(std::string_view("null")); }
+
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    void Number(T v)
+    {
+        Separator();
+        char tmp[32];
+        auto res = std::to_chars(tmp, tmp + sizeof(tmp), v);
+        Raw(std::string_view(tmp, res.ptr - tmp));
+    }
+
+    // 键值对简写
+    void Field(std::string_view k, std::string_view v) { Key(k); String(v); }
+    void Field(std::string_view k, const char* v)      { Key(k); String(v); }
+    void Field(std::string_view k, bool v)             { Key(k); Bool(v); }
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    void Field(std::string_view k, T v)                { Key(k); Number(v); }
+
+    // 下一个值（或容器结束符）前换行，逗号留在上一行末尾，便于逐行处理
+    void Newline() { newline = true; }
+
+    void Flush()
+    {
+        if (used)
+        {
+            out.write(buffer.get(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+    }
+
+    bool Good() const { return out.good(); }
+
+private:
+    void Separator()
+    {
+        if (afterKey)
+        {
+            afterKey = false;
+            return;
+        }
+        if (!first.empty())
+        {
+            if (!first.back())
+            {
+                Raw(',');
+            }
+            first.back() = false;
+        }
+        PendingNewline();
+    }
+
+    void PendingNewline()
+    {
+        if (newline)
+        {
+            newline = false;
+            Raw('\n');
+        }
+    }
+
+    void Raw(char c)
+    {
+        if (used == kBufferSize)
+        {
+            Flush();
+        }
+        buffer[used++] = c;
+    }
+
+    void Raw(std::string_view s)
+    {
+        if (s.size() > kBufferSize - used)
+        {
+            Flush();
+            if (s.size() > kBufferSize)
+            {
+                out.write(s.data(), static_cast<std::streamsize>(s.size()));
+                return;
+            }
+        }
+        std::memcpy(buffer.get() + used, s.data(), s.size());
+        used += s.size();
+    }
+
+    // 带引号的字符串：无需转义的连续片段整段拷贝
+    void Quoted(std::string_view s)
+    {
+        static constexpr char kHex[] = "0123456789abcdef";
+        Raw('"');
+        size_t start = 0;
+        for (size_t i = 0; i < s.size(); ++i)
+        {
+            unsigned char c = static_cast<unsigned char>(s[i]);
+            if (c >= 0x20 && c != '"' && c != '\\')
+            {
+                continue;
+            }
+            Raw(s.substr(start, i - start));
+            start = i + 1;
+            switch (c)
+            {
+                case '"':  Raw(std::string_view("\\\"")); break;
+                case '\\': Raw(std::string_view("\\\\")); break;
+                case '\n': Raw(std::string_view("\\n")); break;
+                case '\r': Raw(std::string_view("\\r")); break;
+                case '\t': Raw(std::string_view("\\t")); break;
+                default:
+                {
+                    char esc[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                    Raw(std::string_view(esc, 6));
+                    break;
+                }
+            }
+        }
+        Raw(s.substr(start));
+        Raw('"');
+    }
+
+    std::ostream& out;
+    std::unique_ptr<char[]> buffer;
+    size_t used = 0;
+    std::vector<bool> first; // 每层容器是否还未写入元素
+    bool afterKey = false;
+    bool newline = false;
+};
+
+
+} // namespace detail
+} // namespace xrd
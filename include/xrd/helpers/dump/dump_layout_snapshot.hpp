@@ -0,0 +1,185 @@
+#pragma once
+// Xrd-eXternalrEsolve - 反射布局快照
+// 一次采集或一份 .xrdm 模型的类型布局摘要（大小、父类、成员、函数、枚举值）
+// 每个类型/枚举预先计算内容哈希，供 dump_diff.hpp 跳过未变化的类型
+// 快照自带全部数据，不引用全局缓存
+
+#include "dump_sdk.hpp"
+#include "dump_file_writer.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+
+namespace xrd
+{
+namespace detail
+{
+
+struct LayoutMember
+{
+    std::string name;
+    std::string type;
+    i32 offset = 0;
+    i32 size = 0;
+    i32 arrayDim = 1;
+    bool isBitField = false;
+    u8 bitIndex = 0;
+};
+
+struct LayoutFunction
+{
+    std::string name;
+    std::string signature; // 返回类型(参数签名类型, ...)
+    u64 flags = 0;
+};
+
+struct LayoutType
+{
+    std::string key;       // 完整名（Class /Script/Engine.Actor），跨版本匹配用
+    std::string name;
+    std::string superName;
+    i32 size = 0;
+    u64 hash = 0;
+    std::vector<LayoutMember> members;
+    std::vector<LayoutFunction> functions;
+};
+
+struct LayoutEnum
+{
+    std::string key;       // 包名.枚举名
+    u64 hash = 0;
+    std::vector<EnumMember> members;
+};
+
+// 布局快照：两份快照可同时存在
+struct LayoutSnapshot
+{
+    std::vector<LayoutType> types;
+    std::vector<LayoutEnum> enums;
+    std::unordered_map<std::string, u32> typeIndex;
+    std::unordered_map<std::string, u32> enumIndex;
+};
+
+inline u64 HashLayoutType(const LayoutType& t)
+{
+    Fnv1a64 h;
+    h.Add(t.superName);
+    h.AddValue(t.size);
+    h.AddValue(static_cast<u64>(t.members.size()));
+    for (auto& m : t.members)
+    {
+        h.Add(m.name);
+        h.Add(m.type);
+        h.AddValue(m.offset);
+        h.AddValue(m.size);
+        h.AddValue(m.arrayDim);
+        h.AddValue(m.isBitField);
+        h.AddValue(m.bitIndex);
+    }
+    h.AddValue(static_cast<u64>(t.functions.size()));
+    for (auto& f : t.functions)
+    {
+        h.Add(f.name);
+        h.Add(f.signature);
+        h.AddValue(f.flags);
+    }
+    return h.value;
+}
+
+inline u64 HashLayoutEnum(const LayoutEnum& e)
+{
+    Fnv1a64 h;
+    h.AddValue(static_cast<u64>(e.members.size()));
+    for (auto& m : e.members)
+    {
+        h.Add(m.name);
+        h.AddValue(m.value);
+    }
+    return h.value;
+}
+
+// 由反射模型与当前属性/函数缓存构建快照
+// 实时采集（CaptureReflectionModel）与模型加载（LoadReflectionModel）后缓存均已就绪
+// 加载另一份模型会替换缓存，因此应在每次采集/加载之后立即构建
+inline LayoutSnapshot BuildLayoutSnapshot(const SdkModel& m)
+{
+    LayoutSnapshot snap;
+    snap.types.reserve(m.entries.size());
+    snap.enums.reserve(m.enums.size());
+
+    std::shared_lock<std::shared_mutex> plock(GetPropertiesCacheMutex());
+    std::shared_lock<std::shared_mutex> flock(GetFunctionsCacheMutex());
+    auto& propCache = GetPropertiesCache();
+    auto& funcCache = GetFunctionsCache();
+
+    for (auto& e : m.entries)
+    {
+        LayoutType t;
+        t.key = e.fullName.empty() ? e.outerName + "." + e.name : e.fullName;
+        if (snap.typeIndex.count(t.key))
+        {
+            continue;
+        }
+        t.name = e.name;
+        t.superName = e.superName;
+        t.size = e.size;
+
+        auto pc = propCache.find(e.addr);
+        if (pc != propCache.end())
+        {
+            t.members.reserve(pc->second.size());
+            for (auto& p : pc->second)
+            {
+                t.members.push_back({p.name, p.typeName, p.offset, p.size,
+                    p.arrayDim, p.isBitField, p.bitIndex});
+            }
+        }
+        auto fc = funcCache.find(e.addr);
+        if (fc != funcCache.end())
+        {
+            t.functions.reserve(fc->second.size());
+            for (auto& f : fc->second)
+            {
+                LayoutFunction lf{f.name, f.returnType + "(", f.functionFlags};
+                bool firstParam = true;
+                for (auto& p : f.params)
+                {
+                    if (p.isReturnParam)
+                    {
+                        continue;
+                    }
+                    if (!firstParam)
+                    {
+                        lf.signature += ", ";
+                    }
+                    lf.signature += p.sigTypeName;
+                    firstParam = false;
+                }
+                lf.signature += ')';
+                t.functions.push_back(std::move(lf));
+            }
+        }
+        t.hash = HashLayoutType(t);
+        snap.typeIndex.emplace(t.key, static_cast<u32>(snap.types.size()));
+        snap.types.push_back(std::move(t));
+    }
+
+    for (auto& ei : m.enums)
+    {
+        LayoutEnum le;
+        le.key = ei.outerName + "." + ei.name;
+        if (snap.enumIndex.count(le.key))
+        {
+            continue;
+        }
+        le.members = ei.members;
+        le.hash = HashLayoutEnum(le);
+        snap.enumIndex.emplace(le.key, static_cast<u32>(snap.enums.size()));
+        snap.enums.push_back(std::move(le));
+    }
+    return snap;
+}
+
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,351 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：增量清单
+// 记录每个包反射输入的哈希与每个输出文件内容的哈希（FNV-1a 64）
+// 再次导出时：输入哈希不变的包跳过代码生成；内容哈希不变的文件跳过写盘
+// 清单保存在 CppSDK/sdk_manifest.bin，变更列表写入 CppSDK/sdk_changes.txt
+
+#include "dump_sdk_package.hpp"
+#include "dump_file_writer.hpp"
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 包输入哈希的格式版本：生成器输出格式或哈希覆盖范围变化时提升
+constexpr u32 kPackageHashVersion = 3;
+
+inline void HashStructEntry(Fnv1a64& h, const StructEntry& e)
+{
+    h.Add(e.name);
+    h.Add(e.fullName);
+    h.Add(e.outerName);
+    h.Add(e.superName);
+    h.Add(e.collisionNs);
+    h.Add(e.objClassName);
+    h.AddValue(e.objIndex);
+    h.AddValue(e.superSize);
+    h.AddValue(e.size);
+    h.AddValue(e.alignment);
+    h.AddValue(e.highestMemberAlign);
+    h.AddValue(e.lastMemberEnd);
+    h.AddValue(e.unalignedSize);
+    u32 bits = (e.isClass ? 1u : 0u)
+        | (e.isActorChild ? 2u : 0u)
+        | (e.isInterfaceChild ? 4u : 0u)
+        | (e.isFinal ? 8u : 0u)
+        | (e.bUseExplicitAlignment ? 16u : 0u)
+        | (e.bHasReusedTrailingPadding ? 32u : 0u)
+        | (e.bCanSkipTrailingPad ? 64u : 0u);
+    h.AddValue(bits);
+}
+
+inline void HashTypeRefs(Fnv1a64& h, TypeRefList refs)
+{
+    h.AddValue(static_cast<u64>(refs.size()));
+    for (auto& r : refs)
+    {
+        h.AddValue(r.index);
+        h.AddValue(r.isEnum);
+        h.AddValue(r.inTemplate);
+    }
+}
+
+// 计算一个包的生成输入哈希
+// 覆盖：包内条目及其属性/函数、父类条目（跨包布局信息）、枚举、依赖包的文件名与类别
+// 只读访问缓存与查找表，可在工作线程中执行（持缓存读锁：写入线程可能同时释放已写完包的缓存）
+inline u64 HashPackageInputs(const PackageGenContext& ctx, i32 pkgIdx)
+{
+    Fnv1a64 h;
+    h.AddValue(kPackageHashVersion);
+
+    auto sit = ctx.pkgIdxToSanitized.find(pkgIdx);
+    h.Add(sit != ctx.pkgIdxToSanitized.end() ? sit->second : std::string());
+    auto oit = ctx.pkgIdxToOuter.find(pkgIdx);
+    h.Add(oit != ctx.pkgIdxToOuter.end() ? oit->second : std::string());
+
+    std::shared_lock<std::shared_mutex> plock(GetPropertiesCacheMutex());
+    std::shared_lock<std::shared_mutex> flock(GetFunctionsCacheMutex());
+    auto& propCache = GetPropertiesCache();
+    auto& funcCache = GetFunctionsCache();
+    auto& lookup = GetEntryLookup();
+
+    auto pit = ctx.pkgMap.find(pkgIdx);
+    if (pit != ctx.pkgMap.end())
+    {
+        h.AddValue(static_cast<u64>(pit->second.size()));
+        for (auto* e : pit->second)
+        {
+            HashStructEntry(h, *e);
+            if (!e->superName.empty())
+            {
+                auto sup = lookup.find(e->superName);
+                if (sup != lookup.end())
+                {
+                    HashStructEntry(h, *sup->second);
+                }
+            }
+            auto pc = propCache.find(e->addr);
+            if (pc != propCache.end())
+            {
+                h.AddValue(static_cast<u64>(pc->second.size()));
+                for (auto& p : pc->second)
+                {
+                    h.Add(p.name);
+                    h.Add(p.typeName);
+                    h.Add(p.fieldClassName);
+                    h.AddValue(p.offset);
+                    h.AddValue(p.size);
+                    h.AddValue(p.arrayDim);
+                    h.AddValue(p.flags);
+                    h.AddValue(p.isBitField);
+                    h.AddValue(p.bitIndex);
+                    h.AddValue(p.bitCount);
+                    h.AddValue(p.fieldMask);
+                    HashTypeRefs(h, p.typeRefs);
+                }
+            }
+            auto fc = funcCache.find(e->addr);
+            if (fc != funcCache.end())
+            {
+                h.AddValue(static_cast<u64>(fc->second.size()));
+                for (auto& f : fc->second)
+                {
+                    h.Add(f.name);
+                    h.Add(f.returnType);
+                    h.AddValue(f.functionFlags);
+                    h.AddValue(f.paramStructSize);
+                    h.AddValue(static_cast<u64>(f.params.size()));
+                    for (auto& p : f.params)
+                    {
+                        h.Add(p.name);
+                        h.Add(p.typeName);
+                        h.Add(p.sigTypeName);
+                        h.Add(p.fieldClassName);
+                        h.AddValue(p.flags);
+                        h.AddValue(p.offset);
+                        h.AddValue(p.size);
+                        u32 bits = (p.isReturnParam ? 1u : 0u)
+                            | (p.isOutParam ? 2u : 0u)
+                            | (p.isConstParam ? 4u : 0u)
+                            | (p.isRefParam ? 8u : 0u)
+                            | (p.isMoveType ? 16u : 0u);
+                        h.AddValue(bits);
+                        HashTypeRefs(h, p.typeRefs);
+                    }
+                }
+            }
+        }
+    }
+
+    auto eit = ctx.enumsByPkgIdx.find(pkgIdx);
+    if (eit != ctx.enumsByPkgIdx.end())
+    {
+        h.AddValue(static_cast<u64>(eit->second.size()));
+        for (auto& ei : eit->second)
+        {
+            h.Add(ei.name);
+            h.AddValue(ei.underlyingTypeSize);
+            h.AddValue(static_cast<u64>(ei.members.size()));
+            for (auto& m : ei.members)
+            {
+                h.Add(m.name);
+                h.AddValue(m.value);
+            }
+        }
+    }
+
+    // 依赖：按依赖包文件名排序后计入（unordered_map 遍历顺序不稳定）
+    auto hashDeps = [&](const std::unordered_map<i32, PackageDeps>& all)
+    {
+        std::vector<std::string> items;
+        auto dit = all.find(pkgIdx);
+        if (dit != all.end())
+        {
+            for (auto& [depIdx, info] : dit->second.deps)
+            {
+                auto ds = ctx.pkgIdxToSanitized.find(depIdx);
+                std::string item = (ds != ctx.pkgIdxToSanitized.end())
+                    ? ds->second : std::to_string(depIdx);
+                item += info.needStructs ? "|S" : "|-";
+                item += info.needClasses ? "C" : "-";
+                item += ctx.pkgsWithStructs.count(depIdx) ? "1" : "0";
+                items.push_back(std::move(item));
+            }
+            for (i32 depIdx : dit->second.fwd)
+            {
+                auto ds = ctx.pkgIdxToSanitized.find(depIdx);
+                items.push_back(((ds != ctx.pkgIdxToSanitized.end())
+                    ? ds->second : std::to_string(depIdx)) + "|F");
+            }
+        }
+        std::sort(items.begin(), items.end());
+        h.AddValue(static_cast<u64>(items.size()));
+        for (auto& s : items)
+        {
+            h.Add(s);
+        }
+    };
+    hashDeps(ctx.structsDeps);
+    hashDeps(ctx.classesDeps);
+    hashDeps(ctx.paramsDeps);
+    h.AddValue(ctx.forwardDecls);
+    return h.value;
+}
+
+// 增量清单：包名 → 输入哈希，相对路径 → 内容哈希（UTF-8，'/' 分隔）
+struct SdkManifest
+{
+    static constexpr u32 kMagic   = 0x53445258; // "XRDS"
+    static constexpr u32 kVersion = 1;
+
+    std::unordered_map<std::string, u64> packages;
+    std::unordered_map<std::string, u64> files;
+
+    // 读取失败或版本不符时返回 false 并保持为空（视为全量导出）
+    bool Load(const std::wstring& path)
+    {
+        packages.clear();
+        files.clear();
+        std::ifstream f(path, std::ios::binary);
+        if (!f.is_open())
+        {
+            return false;
+        }
+        u32 head[4] = {};
+        f.read(reinterpret_cast<char*>(head), sizeof(head));
+        if (!f.good() || head[0] != kMagic || head[1] != kVersion)
+        {
+            return false;
+        }
+        auto readMap = [&](std::unordered_map<std::string, u64>& m, u32 count)
+        {
+            for (u32 i = 0; i < count; ++i)
+            {
+                u64 hash = 0;
+                u32 len = 0;
+                f.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+                f.read(reinterpret_cast<char*>(&len), sizeof(len));
+                if (!f.good() || len > 4096)
+                {
+                    return false;
+                }
+                std::string key(len, '\0');
+                f.read(key.data(), len);
+                if (!f.good())
+                {
+                    return false;
+                }
+                m[std::move(key)] = hash;
+            }
+            return true;
+        };
+        if (!readMap(packages, head[2]) || !readMap(files, head[3]))
+        {
+            packages.clear();
+            files.clear();
+            return false;
+        }
+        return true;
+    }
+
+    // 按键排序写出，相同内容的清单字节一致
+    bool Save(const std::wstring& path) const
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        if (!f.is_open())
+        {
+            return false;
+        }
+        u32 head[4] = {kMagic, kVersion,
+            static_cast<u32>(packages.size()), static_cast<u32>(files.size())};
+        f.write(reinterpret_cast<const char*>(head), sizeof(head));
+        auto writeMap = [&](const std::unordered_map<std::string, u64>& m)
+        {
+            std::vector<std::pair<std::string, u64>> items(m.begin(), m.end());
+            std::sort(items.begin(), items.end());
+            for (auto& [key, hash] : items)
+            {
+                u32 len = static_cast<u32>(key.size());
+                f.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+                f.write(reinterpret_cast<const char*>(&len), sizeof(len));
+                f.write(key.data(), len);
+            }
+        };
+        writeMap(packages);
+        writeMap(files);
+        return f.good();
+    }
+};
+
+// 每个包可能生成的文件后缀（位于 CppSDK/SDK/ 下）
+inline constexpr const char* kPackageFileSuffixes[] = {
+    "_structs.hpp", "_classes.hpp", "_functions.cpp", "_parameters.hpp", "_fwd.hpp"};
+
+// 包能否跳过生成：输入哈希与上次一致，且上次生成的文件都还在磁盘上
+inline bool CanSkipPackage(
+    const SdkManifest& prev,
+    const std::string& sanitized,
+    u64 inputHash,
+    const std::wstring& sdkDir)
+{
+    auto it = prev.packages.find(sanitized);
+    if (it == prev.packages.end() || it->second != inputHash)
+    {
+        return false;
+    }
+    for (const char* suffix : kPackageFileSuffixes)
+    {
+        std::string file = sanitized + suffix;
+        if (prev.files.count("SDK/" + file))
+        {
+            std::error_code ec;
+            if (!std::filesystem::exists(
+                sdkDir + L"/" + Utf8ToWide(file), ec))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 写出变更列表：每行 "A|M|D 包名"（新增/修改/删除），供构建脚本只重编变化的包
+inline void WriteChangeList(
+    const std::wstring& path,
+    const SdkManifest& prev,
+    const SdkManifest& next,
+    const std::vector<std::string>& changed)
+{
+    std::ofstream f(path, std::ios::trunc);
+    if (!f.is_open())
+    {
+        return;
+    }
+    for (auto& name : changed)
+    {
+        f << (prev.packages.count(name) ? "M " : "A ") << name << "\n";
+    }
+    std::vector<std::string> removed;
+    for (auto& [name, hash] : prev.packages)
+    {
+        if (!next.packages.count(name))
+        {
+            removed.push_back(name);
+        }
+    }
+    std::sort(removed.begin(), removed.end());
+    for (auto& name : removed)
+    {
+        f << "D " << name << "\n";
+    }
+}
+
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,284 @@
+#pragma once
+// Xrd-eXternalrEsolve - 反射模型文件：保存 / 加载 / 离线导出
+// 采集一次进程，保存为 .xrdm；之后 SDK/OffsetTable/Mapping 均可仅凭该文件重新生成
+// 文件格式见 dump_model_format.hpp
+
+#include "dump_model_format.hpp"
+#include "dump_extra.hpp"
+#include <Windows.h>
+#include <fstream>
+#include <filesystem>
+#include <iostream>
+#include <cstring>
+
+namespace xrd
+{
+namespace detail
+{
+namespace model
+{
+
+// 追加一个 8 字节对齐的段，返回段描述
+template<typename T>
+inline Section AppendSection(std::vector<u8>& buf, const T* data, u64 count)
+{
+    while (buf.size() % 8 != 0)
+    {
+        buf.push_back(0);
+    }
+    Section sec;
+    sec.offset = buf.size();
+    sec.count = count;
+    if (count)
+    {
+        const u8* p = reinterpret_cast<const u8*>(data);
+        buf.insert(buf.end(), p, p + sizeof(T) * count);
+    }
+    return sec;
+}
+
+// 只读内存映射文件（RAII）
+class MappedFile
+{
+public:
+    ~MappedFile()
+    {
+        if (view) UnmapViewOfFile(view);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    }
+
+    bool Open(const std::wstring& path)
+    {
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER li{};
+        if (!GetFileSizeEx(file, &li) || li.QuadPart <= 0)
+        {
+            return false;
+        }
+        size = static_cast<u64>(li.QuadPart);
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            return false;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        return view != nullptr;
+    }
+
+    const u8* Data() const { return static_cast<const u8*>(view); }
+    u64 Size() const { return size; }
+
+private:
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+    void* view = nullptr;
+    u64 size = 0;
+};
+
+// 段越界检查，通过后返回记录指针
+template<typename T>
+inline const T* SectionPtr(const MappedFile& mf, const Section& sec)
+{
+    if (sec.offset % 8 != 0 || sec.offset > mf.Size()
+        || sec.count > (mf.Size() - sec.offset) / sizeof(T))
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<const T*>(mf.Data() + sec.offset);
+}
+
+} // namespace model
+} // namespace detail
+
+// ─── 保存反射模型 ───
+// 属性/函数取自 GetPropertiesCache / GetFunctionsCache（CaptureReflectionModel 已预热）；
+// 内存上限模式下采集后已释放的条目逐个重新读取，不写回缓存
+inline bool SaveReflectionModel(
+    const detail::SdkModel& m,
+    const std::wstring& filePath)
+{
+    using namespace detail::model;
+    std::vector<detail::PropertyInfo> propScratch;
+    std::vector<detail::FunctionInfo> funcScratch;
+
+    StringTableBuilder strings;
+    std::vector<StructRecord> structs;
+    std::vector<PropRecord> props;
+    std::vector<FuncRecord> funcs;
+    std::vector<ParamRecord> params;
+    std::vector<EnumRecord> enums;
+    std::vector<EnumMemberRecord> members;
+    std::vector<TypeRefRecord> typeRefs;
+    auto addRefs = [&](detail::TypeRefList refs,
+        u32& first, u32& count)
+    {
+        first = static_cast<u32>(typeRefs.size());
+        for (auto& r : refs)
+        {
+            TypeRefRecord tr;
+            tr.index = r.index;
+            tr.bits = (r.isEnum ? TF::IsEnum : 0)
+                | (r.inTemplate ? TF::InTemplate : 0);
+            typeRefs.push_back(tr);
+        }
+        count = static_cast<u32>(refs.size());
+    };
+    structs.reserve(m.entries.size());
+    enums.reserve(m.enums.size());
+
+    for (auto& e : m.entries)
+    {
+        StructRecord r;
+        r.addr = e.addr;
+        r.objIndex = e.objIndex;
+        r.pkgIndex = e.pkgIndex;
+        r.superPkgIndex = e.superPkgIndex;
+        r.name = strings.Add(e.name);
+        r.fullName = strings.Add(e.fullName);
+        r.outerName = strings.Add(e.outerName);
+        r.superName = strings.Add(e.superName);
+        r.objClassName = strings.Add(e.objClassName);
+        r.superSize = e.superSize;
+        r.size = e.size;
+        r.alignment = e.alignment;
+        r.highestMemberAlign = e.highestMemberAlign;
+        r.flags = (e.isClass ? SF::IsClass : 0)
+            | (e.isActorChild ? SF::IsActorChild : 0)
+            | (e.isInterfaceChild ? SF::IsInterfaceChild : 0)
+            | (e.isFinal ? SF::IsFinal : 0)
+            | (e.bUseExplicitAlignment ? SF::UseExplicitAlignment : 0);
+
+        r.firstProp = static_cast<u32>(props.size());
+        {
+            for (auto& pi : detail::CollectPropertiesTransient(e.addr, propScratch))
+            {
+                PropRecord pr;
+                pr.name = strings.Add(pi.name);
+                pr.typeName = strings.Add(pi.typeName);
+                pr.fieldClassName = strings.Add(pi.fieldClassName);
+                pr.offset = pi.offset;
+                pr.size = pi.size;
+                pr.arrayDim = pi.arrayDim;
+                pr.flags = pi.flags;
+                pr.isBitField = pi.isBitField ? 1 : 0;
+                pr.bitIndex = pi.bitIndex;
+                pr.bitCount = pi.bitCount;
+                pr.fieldMask = pi.fieldMask;
+                addRefs(pi.typeRefs, pr.firstRef, pr.refCount);
+                props.push_back(pr);
+            }
+        }
+        r.propCount = static_cast<u32>(props.size()) - r.firstProp;
+
+        r.firstFunc = static_cast<u32>(funcs.size());
+        if (e.isClass)
+        {
+            for (auto& fi : detail::CollectFunctionsTransient(e.addr, funcScratch))
+            {
+                FuncRecord fr;
+                fr.name = strings.Add(fi.name);
+                fr.returnType = strings.Add(fi.returnType);
+                fr.functionFlags = fi.functionFlags;
+                fr.paramStructSize = fi.paramStructSize;
+                fr.firstParam = static_cast<u32>(params.size());
+                for (auto& p : fi.params)
+                {
+                    ParamRecord pr;
+                    pr.name = strings.Add(p.name);
+                    pr.typeName = strings.Add(p.typeName);
+                    pr.sigTypeName = strings.Add(p.sigTypeName);
+                    pr.fieldClassName = strings.Add(p.fieldClassName);
+                    pr.flags = p.flags;
+                    pr.offset = p.offset;
+                    pr.size = p.size;
+                    pr.bits = (p.isReturnParam ? PF::IsReturn : 0)
+                        | (p.isOutParam ? PF::IsOut : 0)
+                        | (p.isConstParam ? PF::IsConst : 0)
+                        | (p.isRefParam ? PF::IsRef : 0)
+                        | (p.isMoveType ? PF::IsMove : 0);
+                    addRefs(p.typeRefs, pr.firstRef, pr.refCount);
+                    params.push_back(pr);
+                }
+                fr.paramCount = static_cast<u32>(params.size()) - fr.firstParam;
+                funcs.push_back(fr);
+            }
+        }
+        r.funcCount = static_cast<u32>(funcs.size()) - r.firstFunc;
+        structs.push_back(r);
+    }
+
+    for (auto& ei : m.enums)
+    {
+        EnumRecord r;
+        r.addr = ei.addr;
+        r.objIndex = ei.objIndex;
+        r.pkgIndex = ei.pkgIndex;
+        r.name = strings.Add(ei.name);
+        r.outerName = strings.Add(ei.outerName);
+        r.underlyingTypeSize = ei.underlyingTypeSize;
+        r.firstMember = static_cast<u32>(members.size());
+        for (auto& em : ei.members)
+        {
+            EnumMemberRecord mr;
+            mr.name = strings.Add(em.name);
+            mr.value = em.value;
+            members.push_back(mr);
+        }
+        r.memberCount = static_cast<u32>(members.size()) - r.firstMember;
+        enums.push_back(r);
+    }
+
+    // 组装文件：先占位 Header，最后回填
+    Header h;
+    h.headerSize = sizeof(Header);
+    h.offsetsSize = sizeof(UEOffsets);
+    h.imageBase = m.imageBase;
+
+    std::vector<u8> buf(sizeof(Header), 0);
+    auto index = strings.BuildIndex();
+    h.offsets     = AppendSection(buf, &m.off, 1);
+    h.stringIndex = AppendSection(buf, index.data(), index.size());
+    h.stringData  = AppendSection(buf, strings.Data().data(), strings.Data().size());
+    h.structs     = AppendSection(buf, structs.data(), structs.size());
+    h.props       = AppendSection(buf, props.data(), props.size());
+    h.funcs       = AppendSection(buf, funcs.data(), funcs.size());
+    h.params      = AppendSection(buf, params.data(), params.size());
+    h.enums       = AppendSection(buf, enums.data(), enums.size());
+    h.enumMembers = AppendSection(buf, members.data(), members.size());
+    h.typeRefs    = AppendSection(buf, typeRefs.data(), typeRefs.size());
+    h.fileSize = buf.size();
+    std::memcpy(buf.data(), &h, sizeof(Header));
+
+    auto parent = std::filesystem::path(filePath).parent_path();
+    if (!parent.empty())
+    {
+        std::filesystem::create_directories(parent);
+    }
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(buf.data()),
+        static_cast<std::streamsize>(buf.size()));
+    if (!file.good())
+    {
+        return false;
+    }
+
+    std::cerr << "[xrd] 反射模型已保存: " << structs.size() << " 个类/结构体, "
+              << enums.size() << " 个枚举, " << props.size() << " 个属性, "
+              << funcs.size() << " 个函数, " << (index.size() - 1)
+              << " 个字符串, " << buf.size() << " 字节\n";
+    return true;
+}
+
+} // namespace xrd
+
+#include "dump_model_load.hpp"
@@ -0,0 +1,272 @@
+#pragma once
+// Xrd-eXternalrEsolve - 反射模型文件格式
+// 定长记录 + 去重字符串表，文件映射到内存后可按偏移直接访问
+// 布局：Header | UEOffsets 快照 | 字符串索引 | 字符串数据 | 各类定长记录段
+// 记录之间用下标引用（firstXxx + xxxCount），字符串用字符串表 ID 引用
+
+#include "../../core/types.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+
+namespace xrd
+{
+namespace detail
+{
+namespace model
+{
+
+constexpr u32 kMagic   = 0x4D445258; // "XRDM"
+constexpr u16 kVersion = 2;
+
+// 段描述：文件内偏移 + 元素数量
+struct Section
+{
+    u64 offset = 0;
+    u64 count  = 0;
+};
+
+struct Header
+{
+    u32 magic       = kMagic;
+    u16 version     = kVersion;
+    u16 headerSize  = 0;
+    u32 offsetsSize = 0;  // sizeof(UEOffsets)，布局变化时拒绝加载
+    u32 reserved    = 0;
+    u64 imageBase   = 0;
+    u64 fileSize    = 0;
+    Section offsets;      // UEOffsets 快照（count = 1）
+    Section stringIndex;  // u32[count]，字符串 i 位于 [idx[i], idx[i+1])
+    Section stringData;   // char[count]
+    Section structs;
+    Section props;
+    Section funcs;
+    Section params;
+    Section enums;
+    Section enumMembers;
+    Section typeRefs;
+};
+
+// StructRecord::flags 位定义
+namespace SF
+{
+    constexpr u32 IsClass               = 1u << 0;
+    constexpr u32 IsActorChild          = 1u << 1;
+    constexpr u32 IsInterfaceChild      = 1u << 2;
+    constexpr u32 IsFinal               = 1u << 3;
+    constexpr u32 UseExplicitAlignment  = 1u << 4;
+}
+
+struct StructRecord
+{
+    u64 addr = 0;         // 原始 UStruct 地址，仅作为缓存键
+    i32 objIndex = -1;
+    i32 pkgIndex = -1;
+    i32 superPkgIndex = -1;
+    u32 name = 0;
+    u32 fullName = 0;
+    u32 outerName = 0;
+    u32 superName = 0;
+    u32 objClassName = 0;
+    i32 superSize = 0;
+    i32 size = 0;
+    i32 alignment = 1;
+    i32 highestMemberAlign = 1;
+    u32 flags = 0;
+    u32 firstProp = 0;
+    u32 propCount = 0;
+    u32 firstFunc = 0;
+    u32 funcCount = 0;
+    u32 pad = 0;
+};
+
+struct PropRecord
+{
+    u32 name = 0;
+    u32 typeName = 0;
+    u32 fieldClassName = 0;
+    i32 offset = 0;
+    i32 size = 0;
+    i32 arrayDim = 1;
+    u64 flags = 0;
+    u8  isBitField = 0;
+    u8  bitIndex = 0;
+    u8  bitCount = 1;
+    u8  fieldMask = 0xFF;
+    u32 firstRef = 0;
+    u32 refCount = 0;
+    u32 pad = 0;
+};
+
+struct FuncRecord
+{
+    u32 name = 0;
+    u32 returnType = 0;
+    u64 functionFlags = 0;
+    i32 paramStructSize = 0;
+    u32 firstParam = 0;
+    u32 paramCount = 0;
+    u32 pad = 0;
+};
+
+// ParamRecord::bits 位定义
+namespace PF
+{
+    constexpr u8 IsReturn = 1u << 0;
+    constexpr u8 IsOut    = 1u << 1;
+    constexpr u8 IsConst  = 1u << 2;
+    constexpr u8 IsRef    = 1u << 3;
+    constexpr u8 IsMove   = 1u << 4;
+}
+
+struct ParamRecord
+{
+    u32 name = 0;
+    u32 typeName = 0;
+    u32 sigTypeName = 0;
+    u32 fieldClassName = 0;
+    u64 flags = 0;
+    i32 offset = 0;
+    i32 size = 0;
+    u8  bits = 0;
+    u8  pad[3] = {};
+    u32 firstRef = 0;
+    u32 refCount = 0;
+    u32 pad2 = 0;
+};
+
+// TypeRefRecord::bits 位定义
+namespace TF
+{
+    constexpr u8 IsEnum     = 1u << 0;
+    constexpr u8 InTemplate = 1u << 1;
+}
+
+// 属性/参数类型中引用的结构体/枚举（PropRecord/ParamRecord 按区间引用）
+struct TypeRefRecord
+{
+    i32 index = -1;
+    u8  bits = 0;
+    u8  pad[3] = {};
+};
+
+struct EnumRecord
+{
+    u64 addr = 0;
+    i32 objIndex = -1;
+    i32 pkgIndex = -1;
+    u32 name = 0;
+    u32 outerName = 0;
+    u32 firstMember = 0;
+    u32 memberCount = 0;
+    u8  underlyingTypeSize = 1;
+    u8  pad[7] = {};
+};
+
+struct EnumMemberRecord
+{
+    u32 name = 0;
+    u32 pad = 0;
+    i64 value = 0;
+};
+
+// 记录大小固定，格式变化时必须提升 kVersion
+static_assert(sizeof(Header) == 192);
+static_assert(sizeof(StructRecord) == 80);
+static_assert(sizeof(PropRecord) == 48);
+static_assert(sizeof(FuncRecord) == 32);
+static_assert(sizeof(ParamRecord) == 48);
+static_assert(sizeof(EnumRecord) == 40);
+static_assert(sizeof(EnumMemberRecord) == 16);
+static_assert(sizeof(TypeRefRecord) == 8);
+
+// 字符串表构建：相同字符串只存一份，ID 0 固定为空串
+class StringTableBuilder
+{
+public:
+    StringTableBuilder()
+    {
+        Add(std::string());
+    }
+
+    u32 Add(const std::string& s)
+    {
+        auto it = ids.find(s);
+        if (it != ids.end())
+        {
+            return it->second;
+        }
+        u32 id = static_cast<u32>(starts.size());
+        starts.push_back(static_cast<u32>(data.size()));
+        data += s;
+        ids.emplace(s, id);
+        return id;
+    }
+
+    // 索引数组：count + 1 项，末项为数据总长
+    std::vector<u32> BuildIndex() const
+    {
+        std::vector<u32> index = starts;
+        index.push_back(static_cast<u32>(data.size()));
+        return index;
+    }
+
+    const std::string& Data() const { return data; }
+
+private:
+    std::vector<u32> starts;
+    std::string data;
+    std::unordered_map<std::string, u32> ids;
+};
+
+// 字符串表读取：直接引用映射内存
+class StringTableView
+{
+public:
+    StringTableView() = default;
+    StringTableView(const u32* index, u64 indexCount,
+        const char* data, u64 dataSize)
+        : index(index), indexCount(indexCount),
+          data(data), dataSize(dataSize)
+    {
+    }
+
+    // 校验索引单调且不越界
+    bool Validate() const
+    {
+        if (indexCount == 0 || index[indexCount - 1] != dataSize)
+        {
+            return false;
+        }
+        for (u64 i = 1; i < indexCount; ++i)
+        {
+            if (index[i] < index[i - 1])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    u64 Count() const { return indexCount ? indexCount - 1 : 0; }
+
+    std::string Get(u32 id) const
+    {
+        if (id >= Count())
+        {
+            return std::string();
+        }
+        return std::string(data + index[id], index[id + 1] - index[id]);
+    }
+
+private:
+    const u32* index = nullptr;
+    u64 indexCount = 0;
+    const char* data = nullptr;
+    u64 dataSize = 0;
+};
+
+} // namespace model
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,340 @@
+#pragma once
+// Xrd-eXternalrEsolve - 反射模型文件：加载与离线导出
+// 映射文件 → 校验 → 还原 SdkModel 并填充属性/函数缓存
+// 从 dump_model.hpp 拆分，保持单文件 300 行以内
+
+#include "dump_model.hpp"
+#include "dump_offsets_sdk.hpp"
+#include "dump_session.hpp"
+
+namespace xrd
+{
+namespace detail
+{
+
+// 离线导出期间临时替换全局偏移与模块基址（gen:: 写入 Basic.hpp 时读取）
+// 析构时恢复；不应与实时读取线程并发使用
+class ScopedModelOffsets
+{
+public:
+    explicit ScopedModelOffsets(const SdkModel& m)
+        : savedOff(Ctx().off), savedBase(Ctx().mainModule.base)
+    {
+        Ctx().off = m.off;
+        Ctx().mainModule.base = m.imageBase;
+    }
+
+    ~ScopedModelOffsets()
+    {
+        Ctx().off = savedOff;
+        Ctx().mainModule.base = savedBase;
+    }
+
+    ScopedModelOffsets(const ScopedModelOffsets&) = delete;
+    ScopedModelOffsets& operator=(const ScopedModelOffsets&) = delete;
+
+private:
+    UEOffsets savedOff;
+    uptr savedBase;
+};
+
+} // namespace detail
+
+// ─── 加载反射模型 ───
+// 成功后 out 可直接交给 GenerateCppSdk；属性/函数缓存被替换为文件内容
+inline bool LoadReflectionModel(
+    const std::wstring& filePath,
+    detail::SdkModel& out)
+{
+    using namespace detail::model;
+    auto fail = [](const char* why)
+    {
+        std::cerr << "[xrd] 反射模型加载失败: " << why << "\n";
+        return false;
+    };
+
+    MappedFile mf;
+    if (!mf.Open(filePath))
+    {
+        return fail("无法打开文件");
+    }
+    if (mf.Size() < sizeof(Header))
+    {
+        return fail("文件过小");
+    }
+    Header h;
+    std::memcpy(&h, mf.Data(), sizeof(Header));
+    if (h.magic != kMagic)
+    {
+        return fail("magic 不匹配");
+    }
+    if (h.version != kVersion || h.headerSize != sizeof(Header))
+    {
+        return fail("版本不兼容");
+    }
+    if (h.offsetsSize != sizeof(UEOffsets))
+    {
+        return fail("UEOffsets 布局不一致（不同版本的 xrd 生成）");
+    }
+    if (h.fileSize != mf.Size())
+    {
+        return fail("文件大小与头部记录不一致（文件被截断？）");
+    }
+
+    auto* offPtr  = SectionPtr<UEOffsets>(mf, h.offsets);
+    auto* strIdx  = SectionPtr<u32>(mf, h.stringIndex);
+    auto* strData = SectionPtr<char>(mf, h.stringData);
+    auto* structs = SectionPtr<StructRecord>(mf, h.structs);
+    auto* props   = SectionPtr<PropRecord>(mf, h.props);
+    auto* funcs   = SectionPtr<FuncRecord>(mf, h.funcs);
+    auto* params  = SectionPtr<ParamRecord>(mf, h.params);
+    auto* enums   = SectionPtr<EnumRecord>(mf, h.enums);
+    auto* members = SectionPtr<EnumMemberRecord>(mf, h.enumMembers);
+    auto* refs    = SectionPtr<TypeRefRecord>(mf, h.typeRefs);
+    if (!offPtr || h.offsets.count != 1 || !strIdx || !strData
+        || !structs || !props || !funcs || !params || !enums || !members
+        || !refs)
+    {
+        return fail("段越界");
+    }
+    StringTableView strings(strIdx, h.stringIndex.count,
+        strData, h.stringData.count);
+    if (!strings.Validate())
+    {
+        return fail("字符串表损坏");
+    }
+
+    // 下标区间检查
+    auto inRange = [](u32 first, u32 count, u64 total)
+    {
+        return static_cast<u64>(first) + count <= total;
+    };
+
+    std::vector<detail::TypeRef> refScratch;
+    auto loadRefs = [&](u32 first, u32 count,
+        detail::TypeRefList& dst)
+    {
+        if (!inRange(first, count, h.typeRefs.count))
+        {
+            return false;
+        }
+        refScratch.clear();
+        for (u32 k = 0; k < count; ++k)
+        {
+            const auto& tr = refs[first + k];
+            refScratch.push_back({tr.index, (tr.bits & TF::IsEnum) != 0,
+                (tr.bits & TF::InTemplate) != 0});
+        }
+        dst = detail::InternTypeRefs(refScratch);
+        return true;
+    };
+
+    auto& propCache = detail::GetPropertiesCache();
+    auto& funcCache = detail::GetFunctionsCache();
+    propCache.clear();
+    funcCache.clear();
+
+    out = detail::SdkModel{};
+    std::memcpy(&out.off, offPtr, sizeof(UEOffsets));
+    out.imageBase = h.imageBase;
+    out.entries.reserve(h.structs.count);
+    out.enums.reserve(h.enums.count);
+
+    for (u64 i = 0; i < h.structs.count; ++i)
+    {
+        const auto& r = structs[i];
+        if (!inRange(r.firstProp, r.propCount, h.props.count)
+            || !inRange(r.firstFunc, r.funcCount, h.funcs.count))
+        {
+            return fail("结构体记录越界");
+        }
+        detail::StructEntry e;
+        e.addr = r.addr;
+        e.objIndex = r.objIndex;
+        e.pkgIndex = r.pkgIndex;
+        e.superPkgIndex = r.superPkgIndex;
+        e.name = strings.Get(r.name);
+        e.fullName = strings.Get(r.fullName);
+        e.outerName = strings.Get(r.outerName);
+        e.superName = strings.Get(r.superName);
+        e.objClassName = strings.Get(r.objClassName);
+        e.superSize = r.superSize;
+        e.size = r.size;
+        e.alignment = r.alignment;
+        e.highestMemberAlign = r.highestMemberAlign;
+        e.isClass = (r.flags & SF::IsClass) != 0;
+        e.isActorChild = (r.flags & SF::IsActorChild) != 0;
+        e.isInterfaceChild = (r.flags & SF::IsInterfaceChild) != 0;
+        e.isFinal = (r.flags & SF::IsFinal) != 0;
+        e.bUseExplicitAlignment = (r.flags & SF::UseExplicitAlignment) != 0;
+
+        auto& propList = propCache[e.addr];
+        propList.reserve(r.propCount);
+        for (u32 k = 0; k < r.propCount; ++k)
+        {
+            const auto& pr = props[r.firstProp + k];
+            detail::PropertyInfo pi;
+            pi.name = strings.Get(pr.name);
+            pi.typeName = strings.Get(pr.typeName);
+            pi.fieldClassName = strings.Get(pr.fieldClassName);
+            pi.offset = pr.offset;
+            pi.size = pr.size;
+            pi.arrayDim = pr.arrayDim;
+            pi.flags = pr.flags;
+            pi.isBitField = pr.isBitField != 0;
+            pi.bitIndex = pr.bitIndex;
+            pi.bitCount = pr.bitCount;
+            pi.fieldMask = pr.fieldMask;
+            if (!loadRefs(pr.firstRef, pr.refCount, pi.typeRefs))
+            {
+                return fail("类型引用记录越界");
+            }
+            propList.push_back(std::move(pi));
+        }
+
+        // 仅 class 在采集时收集函数；struct 保持未缓存状态与实时导出一致
+        if (e.isClass)
+        {
+            auto& funcList = funcCache[e.addr];
+            funcList.reserve(r.funcCount);
+            for (u32 k = 0; k < r.funcCount; ++k)
+            {
+                const auto& fr = funcs[r.firstFunc + k];
+                if (!inRange(fr.firstParam, fr.paramCount, h.params.count))
+                {
+                    return fail("函数记录越界");
+                }
+                detail::FunctionInfo fi;
+                fi.name = strings.Get(fr.name);
+                fi.returnType = strings.Get(fr.returnType);
+                fi.functionFlags = fr.functionFlags;
+                fi.paramStructSize = fr.paramStructSize;
+                fi.params.reserve(fr.paramCount);
+                for (u32 j = 0; j < fr.paramCount; ++j)
+                {
+                    const auto& pr = params[fr.firstParam + j];
+                    detail::FunctionParam fp;
+                    fp.name = strings.Get(pr.name);
+                    fp.typeName = strings.Get(pr.typeName);
+                    fp.sigTypeName = strings.Get(pr.sigTypeName);
+                    fp.fieldClassName = strings.Get(pr.fieldClassName);
+                    fp.flags = pr.flags;
+                    fp.offset = pr.offset;
+                    fp.size = pr.size;
+                    fp.isReturnParam = (pr.bits & PF::IsReturn) != 0;
+                    fp.isOutParam = (pr.bits & PF::IsOut) != 0;
+                    fp.isConstParam = (pr.bits & PF::IsConst) != 0;
+                    fp.isRefParam = (pr.bits & PF::IsRef) != 0;
+                    fp.isMoveType = (pr.bits & PF::IsMove) != 0;
+                    if (!loadRefs(pr.firstRef, pr.refCount, fp.typeRefs))
+                    {
+                        return fail("类型引用记录越界");
+                    }
+                    fi.params.push_back(std::move(fp));
+                }
+                funcList.push_back(std::move(fi));
+            }
+        }
+        out.entries.push_back(std::move(e));
+    }
+
+    for (u64 i = 0; i < h.enums.count; ++i)
+    {
+        const auto& r = enums[i];
+        if (!inRange(r.firstMember, r.memberCount, h.enumMembers.count))
+        {
+            return fail("枚举记录越界");
+        }
+        detail::EnumInfo ei;
+        ei.addr = r.addr;
+        ei.objIndex = r.objIndex;
+        ei.pkgIndex = r.pkgIndex;
+        ei.name = strings.Get(r.name);
+        ei.outerName = strings.Get(r.outerName);
+        ei.underlyingTypeSize = r.underlyingTypeSize;
+        ei.members.reserve(r.memberCount);
+        for (u32 k = 0; k < r.memberCount; ++k)
+        {
+            const auto& mr = members[r.firstMember + k];
+            ei.members.push_back({strings.Get(mr.name), mr.value});
+        }
+        out.enums.push_back(std::move(ei));
+    }
+
+    std::cerr << "[xrd] 反射模型已加载: " << out.entries.size()
+              << " 个类/结构体, " << out.enums.size() << " 个枚举\n";
+    return true;
+}
+
+// 采集并保存反射模型（一次附加进程，之后可离线反复生成）
+inline bool DumpReflectionModel(
+    const std::wstring& filePath,
+    const SdkDumpOptions& options = {})
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!CaptureReflectionModel(m, options))
+    {
+        return false;
+    }
+    return SaveReflectionModel(m, filePath);
+}
+
+// ─── 离线导出：仅凭模型文件生成 ───
+
+inline bool DumpCppSdkFromModel(
+    const std::wstring& modelPath,
+    const std::wstring& outputPath,
+    const SdkDumpOptions& options = {})
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!LoadReflectionModel(modelPath, m))
+    {
+        return false;
+    }
+    detail::ScopedModelOffsets scoped(m);
+    return GenerateCppSdk(m, outputPath, options);
+}
+
+inline bool DumpOffsetTableFromModel(
+    const std::wstring& modelPath,
+    const std::wstring& outputPath)
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!LoadReflectionModel(modelPath, m))
+    {
+        return false;
+    }
+    return detail::WriteOffsetTable(outputPath, m.entries);
+}
+
+inline bool DumpOffsetsSdkFromModel(
+    const std::wstring& modelPath,
+    const std::wstring& outputPath,
+    const OffsetsSdkOptions& options = {})
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!LoadReflectionModel(modelPath, m))
+    {
+        return false;
+    }
+    return GenerateOffsetsSdk(m, outputPath, options);
+}
+
+inline bool DumpMappingFromModel(
+    const std::wstring& modelPath,
+    const std::wstring& outputPath)
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel m;
+    if (!LoadReflectionModel(modelPath, m))
+    {
+        return false;
+    }
+    return detail::WriteMapping(outputPath, m.entries);
+}
+
+} // namespace xrd
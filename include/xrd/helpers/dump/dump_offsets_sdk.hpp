@@ -0,0 +1,273 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：仅偏移的 constexpr 头文件
+// 与 DumpCppSdk 使用同一反射模型（条目 / 属性缓存 / 枚举 / 包名映射），
+// 只输出结构体大小与对齐、成员偏移和枚举值，不含类体、预定义函数与参数结构体
+// 与 OffsetsTable.txt 不同，结果可在编译期使用（static_assert、模板参数、constexpr 计算）
+//
+// 输出结构（OffsetsSDK/Offsets.hpp）：
+//   namespace SDK::Offsets::Engine
+//   {
+//   enum class ENetRole : uint8 { ... };          // 与 _structs.hpp 中的定义一致
+//   namespace AActor
+//   {
+//       inline constexpr int32 SizeOf = 0x0290;
+//       inline constexpr int32 AlignOf = 0x08;
+//       inline constexpr int32 RootComponent = 0x0130; // class USceneComponent*
+//       inline constexpr int32 bHidden = 0x0058;       // uint8 : 1
+//       inline constexpr uint8 bHidden_Mask = 0x02;
+//   }
+//   }
+// 同一作用域内的重名标识符加 _N 后缀；splitByPackage 时每个包一个 Offsets/<Pkg>.hpp
+
+#include "dump_sdk.hpp"
+#include "dump_session.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace xrd
+{
+
+struct OffsetsSdkOptions
+{
+    // 每个包单独写入 OffsetsSDK/Offsets/<Pkg>.hpp，Offsets.hpp 只 include 全部包
+    // 关闭时全部写入 Offsets.hpp
+    bool splitByPackage = false;
+
+    // 输出枚举定义（enum class，与 C++ SDK 中的名称、底层类型和成员一致）
+    bool includeEnums = true;
+};
+
+namespace detail
+{
+
+// 每个文件开头的类型别名（限定在 SDK::Offsets 内，与完整 SDK 同时 include 不冲突；重复的别名声明合法）
+inline constexpr std::string_view kOffsetsSdkPrelude = R"(#pragma once
+
+/*
+* Offsets generated by Xrd-eXternalrEsolve
+*/
+
+#include <cstdint>
+
+namespace SDK::Offsets
+{
+	using int8 = std::int8_t;
+	using int16 = std::int16_t;
+	using int32 = std::int32_t;
+	using int64 = std::int64_t;
+	using uint8 = std::uint8_t;
+	using uint16 = std::uint16_t;
+	using uint32 = std::uint32_t;
+	using uint64 = std::uint64_t;
+}
+
+)";
+
+// 取得作用域内唯一的标识符：已被占用时加 _N 后缀
+inline std::string ClaimOffsetsName(
+    std::unordered_set<std::string>& used, std::string name)
+{
+    if (used.insert(name).second)
+    {
+        return name;
+    }
+    for (int n = 0;; ++n)
+    {
+        std::string alt = name + "_" + std::to_string(n);
+        if (used.insert(alt).second)
+        {
+            return alt;
+        }
+    }
+}
+
+// 单个结构体/类的偏移命名空间
+inline void AppendOffsetsEntry(
+    CodeBuilder& out,
+    const StructEntry& entry,
+    std::unordered_set<std::string>& typeNames)
+{
+    std::string nsName = ClaimOffsetsName(typeNames, AddStructPrefix(
+        entry.name, entry.isClass, entry.isActorChild, entry.isInterfaceChild));
+
+    out.Format("// {} {}.{}\n",
+        entry.objClassName.empty()
+            ? std::string_view(entry.isClass ? "Class" : "ScriptStruct")
+            : std::string_view(entry.objClassName),
+        StripPackagePrefix(entry.outerName), entry.name);
+    out.Format("namespace {}\n{{\n", nsName);
+    out.Format("\tinline constexpr int32 SizeOf = 0x{:04X};\n", entry.size);
+    out.Format("\tinline constexpr int32 AlignOf = 0x{:02X};\n",
+        entry.alignment > 0 ? entry.alignment : 1);
+
+    std::unordered_set<std::string> memberNames = {"SizeOf", "AlignOf"};
+    for (auto& prop : CollectProperties(entry.addr))
+    {
+        std::string name;
+        AppendMemberName(name, prop.name);
+        name = ClaimOffsetsName(memberNames, std::move(name));
+        if (prop.isBitField)
+        {
+            out.Format("\tinline constexpr int32 {} = 0x{:04X}; // {} : {}\n",
+                name, prop.offset, prop.typeName, prop.bitCount);
+            out.Format("\tinline constexpr uint8 {} = 0x{:02X};\n",
+                ClaimOffsetsName(memberNames, name + "_Mask"), prop.fieldMask);
+        }
+        else if (prop.arrayDim > 1)
+        {
+            out.Format("\tinline constexpr int32 {} = 0x{:04X}; // {}[0x{:X}]\n",
+                name, prop.offset, prop.typeName, prop.arrayDim);
+        }
+        else
+        {
+            out.Format("\tinline constexpr int32 {} = 0x{:04X}; // {}\n",
+                name, prop.offset, prop.typeName);
+        }
+    }
+    out += "}\n\n";
+}
+
+// 单个包的命名空间：枚举在前，结构体/类按名称排序
+inline void AppendOffsetsPackage(
+    CodeBuilder& out,
+    const std::string& nsName,
+    std::vector<const StructEntry*> entries,
+    std::vector<const EnumInfo*> enums,
+    const OffsetsSdkOptions& options)
+{
+    std::sort(entries.begin(), entries.end(),
+        [](const StructEntry* a, const StructEntry* b) { return a->name < b->name; });
+    std::sort(enums.begin(), enums.end(),
+        [](const EnumInfo* a, const EnumInfo* b) { return a->name < b->name; });
+
+    out.Format("namespace SDK::Offsets::{}\n{{\n\n", nsName);
+    if (options.includeEnums)
+    {
+        for (auto* ei : enums)
+        {
+            AppendEnumCode(out, *ei);
+        }
+    }
+    std::unordered_set<std::string> typeNames;
+    for (auto* e : entries)
+    {
+        AppendOffsetsEntry(out, *e, typeNames);
+    }
+    out.Format("}} // namespace SDK::Offsets::{}\n\n", nsName);
+}
+
+} // namespace detail
+
+// ─── 生成仅偏移的 constexpr 头文件（OffsetsSDK/Offsets.hpp） ───
+// 仅依赖反射模型与属性缓存，不做远程读取；会写入枚举底层大小等派生字段（同 GenerateCppSdk）
+inline bool GenerateOffsetsSdk(
+    detail::SdkModel& model,
+    const std::wstring& outputPath,
+    const OffsetsSdkOptions& options = {})
+{
+    namespace fs = std::filesystem;
+    auto t0 = std::chrono::steady_clock::now();
+
+    std::wstring dir = outputPath + L"/OffsetsSDK";
+    fs::create_directories(options.splitByPackage ? dir + L"/Offsets" : dir);
+
+    auto& entries = model.entries;
+    auto& allEnums = model.enums;
+
+    // 前缀与枚举底层类型依赖条目查找表和属性缓存
+    auto& lookup = detail::GetEntryLookup();
+    lookup.clear();
+    for (auto& e : entries)
+    {
+        lookup[e.name] = &e;
+    }
+    detail::DetectEnumUnderlyingSizes(allEnums, entries);
+
+    // 包索引的遍历顺序与 GenerateCppSdk 相同，冲突包名得到相同的 _N 后缀
+    auto pkgMap = GroupByPackageIndex(entries);
+    detail::HashOrderMap<std::vector<const detail::EnumInfo*>> enumsByPkgIdx;
+    for (auto& ei : allEnums)
+    {
+        enumsByPkgIdx[ei.pkgIndex].push_back(&ei);
+    }
+    detail::HashOrderSet allPkgIndices;
+    for (auto& [k, v] : pkgMap)
+    {
+        allPkgIndices.insert(k);
+    }
+    for (auto& [k, v] : enumsByPkgIdx)
+    {
+        allPkgIndices.insert(k);
+    }
+    auto pkgNames = AssignPackageNames(allPkgIndices, entries, allEnums);
+
+    // 输出按包名排序，与 GObjects 顺序无关
+    std::vector<std::pair<std::string, i32>> packages;
+    std::unordered_set<std::string> pkgNamespaces;
+    for (i32 idx : allPkgIndices)
+    {
+        std::string ns;
+        detail::AppendMemberName(ns, pkgNames.sanitized[idx]);
+        packages.push_back({detail::ClaimOffsetsName(pkgNamespaces, std::move(ns)), idx});
+    }
+    std::sort(packages.begin(), packages.end());
+
+    detail::SdkFileWriter writer;
+    detail::CodeBuilder single;
+    single += detail::kOffsetsSdkPrelude;
+    for (auto& [ns, idx] : packages)
+    {
+        auto eit = pkgMap.find(idx);
+        auto nit = enumsByPkgIdx.find(idx);
+        detail::CodeBuilder pkgOut;
+        detail::CodeBuilder& out = options.splitByPackage ? pkgOut : single;
+        if (options.splitByPackage)
+        {
+            out += detail::kOffsetsSdkPrelude;
+            single.Format("#include \"Offsets/{}.hpp\"\n", ns);
+        }
+        detail::AppendOffsetsPackage(out, ns,
+            eit != pkgMap.end() ? eit->second : std::vector<const detail::StructEntry*>{},
+            nit != enumsByPkgIdx.end() ? nit->second : std::vector<const detail::EnumInfo*>{},
+            options);
+        if (options.splitByPackage)
+        {
+            writer.Submit(dir + L"/Offsets/" + detail::Utf8ToWide(ns) + L".hpp",
+                pkgOut.ToString());
+        }
+    }
+    writer.Submit(dir + L"/Offsets.hpp", single.ToString());
+    const auto& stats = writer.Finish();
+    writer.Report();
+
+    std::cerr << std::fixed << std::setprecision(2)
+              << "[xrd] 偏移头文件导出完成: " << packages.size() << " 个包, "
+              << entries.size() << " 个类/结构体 ("
+              << std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count()
+              << "s)\n";
+    return stats.failedFiles == 0;
+}
+
+// ─── 导出仅偏移的 constexpr 头文件 ───
+// 采集 + 生成；需要并行采集时先 CaptureReflectionModel 再 GenerateOffsetsSdk
+inline bool DumpOffsetsSdk(
+    const std::wstring& outputPath,
+    const OffsetsSdkOptions& options = {})
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel model;
+    if (!CaptureReflectionModel(model))
+    {
+        return false;
+    }
+    return GenerateOffsetsSdk(model, outputPath, options);
+}
+
+} // namespace xrd
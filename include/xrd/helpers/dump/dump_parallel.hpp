@@ -0,0 +1,233 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：并行工具
+// OrderedParallelFor：工作线程并发生成，调用线程按下标顺序消费
+// 消费顺序与串行完全一致，保证输出字节级相同
+// 工作线程继承调用线程绑定的上下文与导出会话（ScopedThreadBinding），并行导出时各自读写自己的缓存
+// 异常路径上先停止并等待全部工作线程，再把异常交给调用方
+
+#include "../../core/types.hpp"
+#include "../../core/context.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 解析工作线程数：0 表示使用硬件并发数
+inline u32 ResolveWorkerCount(u32 requested)
+{
+    if (requested > 0)
+    {
+        return requested;
+    }
+    u32 hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// 等待全部线程结束（异常路径上也必须调用，joinable 的 std::thread 析构会 std::terminate）
+inline void JoinAll(std::vector<std::thread>& threads)
+{
+    for (auto& t : threads)
+    {
+        if (t.joinable())
+        {
+            t.join();
+        }
+    }
+}
+
+// 启动 count 个线程执行 fn(workerIndex) 并等待全部结束
+// 任务分发由 fn 自行完成（通常配合 std::atomic 下标）
+// fn 抛出的第一个异常在全部线程结束后于调用线程重新抛出
+template<typename Fn>
+inline void RunWorkers(u32 count, Fn&& fn)
+{
+    ThreadBinding binding = CaptureThreadBinding();
+    std::mutex errorMtx;
+    std::exception_ptr error;
+    std::vector<std::thread> threads;
+    threads.reserve(count);
+    try
+    {
+        for (u32 w = 0; w < count; ++w)
+        {
+            threads.emplace_back([&fn, &errorMtx, &error, w, binding]()
+            {
+                ScopedThreadBinding scope(binding);
+                try
+                {
+                    fn(w);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(errorMtx);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            });
+        }
+    }
+    catch (...)
+    {
+        // 线程创建失败：已启动的线程各自完成后再抛出
+        JoinAll(threads);
+        throw;
+    }
+    JoinAll(threads);
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+// produce(i) 在工作线程中执行，返回 Result；consume(i, Result&&) 在调用线程按 i 升序执行
+// 已消费的结果立即释放，内存占用取决于生成领先写入的程度
+// maxAhead > 0 时工作线程最多领先消费位置 maxAhead 项，限制滞留结果的数量；0 = 不限制
+// workers <= 1 时退化为串行，不创建线程
+// produce 或 consume 抛出的第一个异常在全部工作线程结束后于调用线程重新抛出（同 RunWorkers）
+template<typename Result, typename Produce, typename Consume>
+inline void OrderedParallelFor(
+    size_t count, u32 workers,
+    Produce&& produce, Consume&& consume,
+    size_t maxAhead = 0)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    if (workers <= 1 || count == 1)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            consume(i, produce(i));
+        }
+        return;
+    }
+
+    std::vector<std::optional<Result>> slots(count);
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable aheadCv;
+    std::atomic<size_t> next{0};
+    size_t consumed = 0;      // 受 mtx 保护
+    bool stop = false;        // 受 mtx 保护；任一方抛出异常时置位，工作线程不再领取新项
+    std::exception_ptr error; // 受 mtx 保护；produce 抛出的第一个异常
+
+    ThreadBinding binding = CaptureThreadBinding();
+    auto worker = [&]()
+    {
+        ScopedThreadBinding scope(binding);
+        for (;;)
+        {
+            size_t i = next.fetch_add(1);
+            if (i >= count)
+            {
+                return;
+            }
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                if (maxAhead > 0)
+                {
+                    aheadCv.wait(lock, [&] { return stop || i < consumed + maxAhead; });
+                }
+                if (stop)
+                {
+                    return;
+                }
+            }
+            std::optional<Result> r;
+            try
+            {
+                r.emplace(produce(i));
+            }
+            catch (...)
+            {
+                // 记录异常并停止：调用线程被唤醒后不再等待这一项
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    stop = true;
+                }
+                aheadCv.notify_all();
+                cv.notify_all();
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                slots[i] = std::move(r);
+            }
+            cv.notify_all();
+        }
+    };
+
+    u32 threadCount = static_cast<u32>(
+        std::min<size_t>(workers, count));
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    try
+    {
+        for (u32 t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back(worker);
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            std::optional<Result> r;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                cv.wait(lock, [&] { return error || slots[i].has_value(); });
+                if (!slots[i].has_value())
+                {
+                    break; // produce 已抛出异常，剩余项不再消费
+                }
+                r = std::move(slots[i]);
+                slots[i].reset();
+            }
+            consume(i, std::move(*r));
+            if (maxAhead > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    consumed = i + 1;
+                }
+                aheadCv.notify_all();
+            }
+        }
+    }
+    catch (...)
+    {
+        // consume 抛出（写入失败、bad_alloc 等）或线程创建失败：
+        // 让工作线程放弃剩余项并唤醒等待领先窗口的线程，全部结束后再向调用方抛出
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+        }
+        aheadCv.notify_all();
+        cv.notify_all();
+        JoinAll(threads);
+        throw;
+    }
+
+    JoinAll(threads);
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace detail
+} // namespace xrd
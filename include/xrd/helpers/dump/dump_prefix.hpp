@@ -1,11 +1,14 @@
 #pragma once
-// Xrd-eXternalrEsolve - 前缀工具和全局查找表
+// Xrd-eXternalrEsolve - 前缀工具和条目查找表
 // 提供 AddStructPrefix / GetEntryLookup / LookupPrefixedName
 // 被 dump_type_resolve.hpp 和 dump_sdk_struct.hpp 共同使用
 
 #include "../../core/types.hpp"
+#include "../../core/context.hpp"
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace xrd
 {
@@ -22,6 +25,7 @@ struct StructEntry
     std::string fullName;
     std::string outerName;  // 包名
     std::string superName;
+    i32 superPkgIndex = -1;     // 父类所在包的 GObjects 索引（无父类为 -1，依赖收集使用）
     i32 superSize = 0;
     i32 size = 0;
     bool isClass = false;
@@ -40,6 +44,16 @@ struct StructEntry
     std::string collisionNs;
     // 对标 Rei-Dumper：UE 完整类型名（用于 BP_STATIC_CLASS_IMPL_FULLNAME）
     std::string objClassName;
+
+    // 成员摘要（SummarizeEntryMembers 由属性/函数缓存填写）
+    // 布局修正、枚举底层类型与跨包依赖只读这些字段，内存上限模式下采集后即释放属性/函数缓存
+    bool membersSummarized = false;
+    bool hasMembers = false;
+    i32 membersEnd = 0;      // max(superSize, 自身属性的结束偏移)
+    i32 minMemberOffset = 0; // 自身属性的最小偏移（无属性时为 size）
+    std::vector<i32> memberRefs; // 属性类型引用的结构体/枚举索引（含容器模板参数），按首次出现顺序
+    std::vector<i32> paramRefs;  // 函数参数/返回值类型引用的结构体/枚举索引（仅类）
+    std::vector<std::pair<std::string, u8>> enumMemberSizes; // 关联枚举的属性：枚举名与属性大小
 };
 
 // 参考 Rei-Dumper GetCppName: 总是加前缀，通过继承链判断 A/I/U/F
@@ -68,12 +82,34 @@ inline std::string AddStructPrefix(
     return "F" + name;
 }
 
-// 全局条目查找表（在导出前由 DumpCppSdk 填充）
+// UE 类型名是否为可导出的类（含蓝图生成类）
+inline bool IsClassTypeName(const std::string& className)
+{
+    return className == "Class"
+        || className == "BlueprintGeneratedClass"
+        || className == "WidgetBlueprintGeneratedClass"
+        || className == "AnimBlueprintGeneratedClass"
+        || className == "DynamicClass";
+}
+
+// UE 类型名是否为可导出的结构体
+inline bool IsScriptStructTypeName(const std::string& className)
+{
+    return className == "ScriptStruct"
+        || className == "Struct"
+        || className == "UserDefinedStruct";
+}
+
+// 条目查找表（在导出前由 DumpCppSdk 填充，归属当前导出会话）
 // 用于在生成代码时查找 super 的 actor/interface 标记
+struct EntryLookupSlot
+{
+    std::unordered_map<std::string, const StructEntry*> lookup;
+};
+
 inline std::unordered_map<std::string, const StructEntry*>& GetEntryLookup()
 {
-    static std::unordered_map<std::string, const StructEntry*> lookup;
-    return lookup;
+    return SessionLocal<EntryLookupSlot>().lookup;
 }
 
 // 根据名字查找 super 的前缀
@@ -0,0 +1,183 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：进度、预计剩余时间与取消
+// SdkDumpOptions::onProgress 按阶段接收已完成/总数、已写字节与 ETA
+// SdkDumpOptions::cancel 指向调用方持有的取消令牌，采集 / 生成 / 写盘循环中检查
+// 回调可能在工作线程中触发，但不会并发进入；回调内不要阻塞太久
+
+#include "../../core/types.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <mutex>
+
+namespace xrd
+{
+
+enum class SdkDumpStage : u8
+{
+    CollectEnums,   // 枚举采集（遍历 GObjects）
+    CollectStructs, // 类/结构体条目采集（遍历 GObjects）
+    Warmup,         // 属性/函数缓存预热（远程读取主体）
+    Layout,         // 布局修正与跨包依赖（条目数）
+    Generate,       // 分包生成（包数）
+    Write,          // 等待后台写盘完成（文件数）
+    Done,
+};
+
+inline const char* SdkDumpStageName(SdkDumpStage stage)
+{
+    switch (stage)
+    {
+    case SdkDumpStage::CollectEnums:   return "CollectEnums";
+    case SdkDumpStage::CollectStructs: return "CollectStructs";
+    case SdkDumpStage::Warmup:         return "Warmup";
+    case SdkDumpStage::Layout:         return "Layout";
+    case SdkDumpStage::Generate:       return "Generate";
+    case SdkDumpStage::Write:          return "Write";
+    case SdkDumpStage::Done:           return "Done";
+    }
+    return "Unknown";
+}
+
+// 一次进度快照
+struct SdkDumpProgress
+{
+    SdkDumpStage stage = SdkDumpStage::CollectEnums;
+    u64 done = 0;
+    u64 total = 0;              // 0 = 未知
+    u64 bytesWritten = 0;       // 已写盘字节数（含 CRLF 转换，不含跳过写盘的未变化文件）
+    double elapsedSeconds = 0;  // 本次调用开始至今
+    double stageSeconds = 0;    // 当前阶段开始至今
+    double itemsPerSecond = 0;  // 当前阶段吞吐
+    double etaSeconds = -1;     // 当前阶段预计剩余时间，-1 = 未知
+};
+
+using SdkProgressCallback = std::function<void(const SdkDumpProgress&)>;
+
+// 取消令牌：由调用方持有，可从任意线程（如 GUI 的取消按钮）调用 Cancel
+class SdkCancelToken
+{
+public:
+    void Cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+    void Reset() { m_cancelled.store(false, std::memory_order_relaxed); }
+    bool IsCancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> m_cancelled{false};
+};
+
+namespace detail
+{
+
+// 进度汇报器：阶段内 Advance 可被多个线程并发调用，回调按 intervalMs 节流
+class SdkProgressReporter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    SdkProgressReporter(const SdkProgressCallback* callback = nullptr,
+        const SdkCancelToken* cancel = nullptr, u32 intervalMs = 200)
+        : m_callback(callback && *callback ? callback : nullptr),
+          m_cancel(cancel),
+          m_intervalMs(intervalMs),
+          m_start(Clock::now()),
+          m_stageStart(m_start)
+    {
+    }
+
+    bool Cancelled() const
+    {
+        return m_cancel && m_cancel->IsCancelled();
+    }
+
+    // 已写字节计数器，交给 SdkFileWriter::ObserveBytes
+    std::atomic<u64>& BytesCounter() { return m_bytes; }
+
+    void BeginStage(SdkDumpStage stage, u64 total)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mtx);
+            m_stage = stage;
+            m_total = total;
+            m_done.store(0, std::memory_order_relaxed);
+            m_stageStart = Clock::now();
+        }
+        Report(true);
+    }
+
+    void Advance(u64 n = 1)
+    {
+        m_done.fetch_add(n, std::memory_order_relaxed);
+        Report(false);
+    }
+
+    void SetDone(u64 done)
+    {
+        m_done.store(done, std::memory_order_relaxed);
+        Report(false);
+    }
+
+    void Report(bool force)
+    {
+        if (!m_callback)
+        {
+            return;
+        }
+        i64 nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            Clock::now() - m_start).count();
+        if (!force && nowMs - m_lastMs.load(std::memory_order_relaxed) < m_intervalMs)
+        {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(m_mtx, std::defer_lock);
+        if (force)
+        {
+            lock.lock();
+        }
+        else if (!lock.try_lock())
+        {
+            return; // 另一线程正在汇报
+        }
+        m_lastMs.store(nowMs, std::memory_order_relaxed);
+        (*m_callback)(Snapshot());
+    }
+
+private:
+    // 调用方持有 m_mtx
+    SdkDumpProgress Snapshot() const
+    {
+        auto now = Clock::now();
+        SdkDumpProgress p;
+        p.stage = m_stage;
+        p.done = m_done.load(std::memory_order_relaxed);
+        p.total = m_total;
+        p.bytesWritten = m_bytes.load(std::memory_order_relaxed);
+        p.elapsedSeconds = std::chrono::duration<double>(now - m_start).count();
+        p.stageSeconds = std::chrono::duration<double>(now - m_stageStart).count();
+        if (p.stageSeconds > 0 && p.done > 0)
+        {
+            p.itemsPerSecond = p.done / p.stageSeconds;
+            if (p.total >= p.done)
+            {
+                p.etaSeconds = (p.total - p.done) / p.itemsPerSecond;
+            }
+        }
+        return p;
+    }
+
+    const SdkProgressCallback* m_callback;
+    const SdkCancelToken* m_cancel;
+    i64 m_intervalMs;
+    Clock::time_point m_start;
+    Clock::time_point m_stageStart;
+    std::mutex m_mtx;
+    SdkDumpStage m_stage = SdkDumpStage::CollectEnums;
+    u64 m_total = 0;
+    std::atomic<u64> m_done{0};
+    std::atomic<u64> m_bytes{0};
+    std::atomic<i64> m_lastMs{0};
+};
+
+} // namespace detail
+} // namespace xrd
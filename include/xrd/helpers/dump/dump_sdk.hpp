@@ -10,6 +10,13 @@
 #include "dump_sdk_infra.hpp"
 #include "dump_sdk_writer.hpp"
 #include "dump_dep_sort.hpp"
+#include "dump_parallel.hpp"
+#include "dump_sdk_package.hpp"
+#include "dump_manifest.hpp"
+#include "dump_sdk_layout.hpp"
+#include "dump_sdk_budget.hpp"
+#include "dump_progress.hpp"
+#include "dump_session.hpp"
 #include <fstream>
 #include <filesystem>
 #include <set>
@@ -18,10 +25,10 @@
 #include <unordered_set>
 #include <iostream>
 #include <algorithm>
-#include <functional>
 #include <chrono>
 #include <iomanip>
 #include <climits>
+#include <optional>
 
 namespace xrd
 {
@@ -103,10 +110,16 @@ inline bool IsChildOf(uptr cls, uptr ancestor)
 }
 
 // 收集所有需要导出的结构体/类
-inline std::vector<detail::StructEntry> CollectAllStructEntries()
+// progress 非空时按对象数汇报进度；取消时返回空列表
+inline std::vector<detail::StructEntry> CollectAllStructEntries(
+    detail::SdkProgressReporter* progress = nullptr)
 {
     std::vector<detail::StructEntry> entries;
     i32 total = GetTotalObjectCount();
+    if (progress)
+    {
+        progress->BeginStage(SdkDumpStage::CollectStructs, static_cast<u64>(total));
+    }
 
     uptr actorClass = 0;
     uptr interfaceClass = 0;
@@ -129,6 +142,14 @@ inline std::vector<detail::StructEntry> CollectAllStructEntries()
 
     for (i32 i = 0; i < total; ++i)
     {
+        if (progress && (i & 0xFFF) == 0)
+        {
+            if (progress->Cancelled())
+            {
+                return {};
+            }
+            progress->SetDone(static_cast<u64>(i));
+        }
         uptr obj = GetObjectByIndex(i);
         if (!IsCanonicalUserPtr(obj))
         {
@@ -136,14 +157,8 @@ inline std::vector<detail::StructEntry> CollectAllStructEntries()
         }
 
         std::string className = GetObjectClassName(obj);
-        bool isClass  = (className == "Class" ||
-                         className == "BlueprintGeneratedClass" ||
-                         className == "WidgetBlueprintGeneratedClass" ||
-                         className == "AnimBlueprintGeneratedClass" ||
-                         className == "DynamicClass");
-        bool isStruct = (className == "ScriptStruct"
-                         || className == "Struct"
-                         || className == "UserDefinedStruct");
+        bool isClass  = detail::IsClassTypeName(className);
+        bool isStruct = detail::IsScriptStructTypeName(className);
         if (!isClass && !isStruct)
         {
             continue;
@@ -165,6 +180,7 @@ inline std::vector<detail::StructEntry> CollectAllStructEntries()
         if (super)
         {
             entry.superName = GetObjectName(super);
+            entry.superPkgIndex = GetPackageIndex(super);
             entry.superSize = GetStructSize(super);
         }
 
@@ -316,14 +332,12 @@ inline std::vector<detail::StructEntry> CollectAllStructEntries()
     return entries;
 }
 
-// 按包索引分组（对标 Rei-Dumper：使用 unordered_map<i32>）
-inline std::unordered_map<i32,
-    std::vector<const detail::StructEntry*>>
+// 按包索引分组（对标 Rei-Dumper：键的遍历顺序同 MSVC unordered_map<i32>）
+inline detail::HashOrderMap<std::vector<const detail::StructEntry*>>
 GroupByPackageIndex(
     const std::vector<detail::StructEntry>& entries)
 {
-    std::unordered_map<i32,
-        std::vector<const detail::StructEntry*>> pkgMap;
+    detail::HashOrderMap<std::vector<const detail::StructEntry*>> pkgMap;
     for (auto& e : entries)
     {
         pkgMap[e.pkgIndex].push_back(&e);
@@ -331,14 +345,61 @@ GroupByPackageIndex(
     return pkgMap;
 }
 
+// 包名映射：pkgIndex → 包路径 / 清理后的名称（文件名与冲突命名空间）
+struct SdkPackageNames
+{
+    std::unordered_map<i32, std::string> outer;
+    std::unordered_map<i32, std::string> sanitized;
+};
+
+// 对标 Rei-Dumper：检测包名冲突，冲突时加 _N 后缀（按 allPkgIndices 的遍历顺序编号）
+inline SdkPackageNames AssignPackageNames(
+    const detail::HashOrderSet& allPkgIndices,
+    const std::vector<detail::StructEntry>& entries,
+    const std::vector<detail::EnumInfo>& enums)
+{
+    SdkPackageNames names;
+    for (auto& e : entries)
+    {
+        names.outer[e.pkgIndex] = e.outerName;
+    }
+    for (auto& ei : enums)
+    {
+        if (names.outer.find(ei.pkgIndex) == names.outer.end())
+        {
+            names.outer[ei.pkgIndex] = ei.outerName;
+        }
+    }
+
+    // 先统计每个 sanitized 名出现的次数
+    std::map<std::string, std::vector<i32>> sanToIndices;
+    for (i32 idx : allPkgIndices)
+    {
+        auto oit = names.outer.find(idx);
+        std::string outer = (oit != names.outer.end())
+            ? oit->second : "Unknown";
+        sanToIndices[SanitizePackageName(outer)].push_back(idx);
+    }
+    for (auto& [san, indices] : sanToIndices)
+    {
+        names.sanitized[indices[0]] = san;
+        for (size_t i = 1; i < indices.size(); ++i)
+        {
+            names.sanitized[indices[i]] = san + "_" + std::to_string(i - 1);
+        }
+    }
+    return names;
+}
+
 // 对包列表进行依赖排序（DFS 拓扑排序）
 // 对标 Rei-Dumper IterateDependencies：
-// 使用 unordered_map<i32> 存储包依赖图
-// 遍历顺序由 MSVC 哈希桶决定，与 Rei-Dumper 一致
+// 节点顺序为 allPkgIndices 按遍历顺序插入 unordered_map<i32> 后的遍历顺序
+// 边顺序为先 classes 依赖、后 structs 依赖插入 unordered_set<i32> 后的遍历顺序
+// 均按 dump_hash_order.hpp 的规则复现 MSVC 结果；排序本身见 TopoOrderCsr
 inline std::vector<i32> TopoSortPackagesByIndex(
     const std::unordered_map<i32, detail::PackageDeps>& cDeps,
     const std::unordered_map<i32, detail::PackageDeps>& sDeps,
-    const std::unordered_set<i32>& allPkgIndices)
+    const detail::HashOrderSet& allPkgIndices)
 {
     if (allPkgIndices.size() <= 1)
     {
@@ -346,392 +407,383 @@ inline std::vector<i32> TopoSortPackagesByIndex(
             allPkgIndices.begin(), allPkgIndices.end());
     }
 
-    // 构建依赖图：unordered_map<i32, unordered_set<i32>>
-    // 对标 Rei-Dumper PackageInfos 的遍历
-    std::unordered_map<i32,
-        std::unordered_set<i32>> depGraph;
-
+    detail::HashOrderSet keys;
     for (i32 pkg : allPkgIndices)
     {
-        depGraph[pkg]; // SetExists
+        keys.insert(pkg); // SetExists
     }
-
-    for (i32 pkg : allPkgIndices)
+    std::vector<i32> order(keys.begin(), keys.end());
+    std::unordered_map<i32, u32> nodeOf;
+    nodeOf.reserve(order.size());
+    for (u32 i = 0; i < order.size(); ++i)
     {
-        auto cit = cDeps.find(pkg);
-        if (cit != cDeps.end())
-        {
-            for (auto& [dep, info] : cit->second.deps)
-            {
-                if (allPkgIndices.count(dep) && dep != pkg)
-                {
-                    depGraph[pkg].insert(dep);
-                }
-            }
-        }
-        auto sit = sDeps.find(pkg);
-        if (sit != sDeps.end())
-        {
-            for (auto& [dep, info] : sit->second.deps)
-            {
-                if (allPkgIndices.count(dep) && dep != pkg)
-                {
-                    depGraph[pkg].insert(dep);
-                }
-            }
-        }
+        nodeOf[order[i]] = i;
     }
 
-    std::vector<i32> result;
-    result.reserve(allPkgIndices.size());
-    std::unordered_set<i32> visited;
-    std::unordered_set<i32> inStack; // 循环检测
-
-    std::function<void(i32)> visit;
-    visit = [&](i32 idx)
+    detail::DepGraphCsr graph;
+    graph.offsets.reserve(order.size() + 1);
+    detail::HashOrderSet deps;
+    auto addDeps = [&](const std::unordered_map<i32, detail::PackageDeps>& all,
+        i32 pkg)
     {
-        if (visited.count(idx))
-        {
-            return;
-        }
-        if (inStack.count(idx))
+        auto it = all.find(pkg);
+        if (it == all.end())
         {
-            // 检测到循环依赖，跳过
             return;
         }
-        inStack.insert(idx);
-        auto it = depGraph.find(idx);
-        if (it != depGraph.end())
+        for (auto& [dep, info] : it->second.deps)
         {
-            for (i32 dep : it->second)
+            if (allPkgIndices.count(dep) && dep != pkg)
             {
-                visit(dep);
+                deps.insert(dep);
             }
         }
-        inStack.erase(idx);
-        visited.insert(idx);
-        result.push_back(idx);
     };
+    for (i32 pkg : order)
+    {
+        deps.reset();
+        addDeps(cDeps, pkg);
+        addDeps(sDeps, pkg);
+        for (i32 dep : deps)
+        {
+            graph.AddEdge(nodeOf[dep]);
+        }
+        graph.EndNode();
+    }
 
-    // 遍历 unordered_map<i32>，顺序由 MSVC 哈希桶决定
-    for (const auto& [idx, deps] : depGraph)
+    std::vector<i32> result;
+    result.reserve(order.size());
+    for (u32 node : detail::TopoOrderCsr(graph))
     {
-        visit(idx);
+        result.push_back(order[node]);
     }
     return result;
 }
 
-// ─── 主导出函数：Dumper7 品质 C++ SDK ───
-inline bool DumpCppSdk(const std::wstring& outputPath)
+// SDK 导出选项
+struct SdkDumpOptions
+{
+    u32 workerCount = 0; // 包代码生成线程数，0 = 硬件并发数，1 = 串行
+
+    // 采集线程的内存访问器：每项对应一个采集线程，线程内通过 SetThreadMemAccessor 绑定
+    // nullptr 项表示该线程使用全局通道（仅当全局访问器本身线程安全时使用，如 WinApi）
+    // 为空时在调用线程串行采集
+    std::vector<IMemoryAccessor*> collectAccessors;
+
+    // 增量导出：读取 CppSDK/sdk_manifest.bin，输入未变的包跳过生成，内容未变的文件跳过写盘
+    // 关闭时全量生成并重写所有文件（仍会写出新的清单）
+    bool incremental = true;
+
+    // 前向声明：每个包额外生成 <Pkg>_fwd.hpp，CppSDK/SDK_fwd.hpp 汇总全部 _fwd.hpp
+    // 按值成员与父类才 include 完整定义；枚举（opaque 声明）与函数签名中的类型只 include _fwd.hpp，
+    // _parameters.hpp 按参数实际引用的类型收集依赖，下游只 include 单个包时拉入的头文件大幅减少
+    // 默认关闭，与 Rei-Dumper 的 include 布局一致；开启会改变生成头文件的布局，由调用方显式选择
+    bool forwardDeclarations = false;
+
+    // 内存上限（MB）：0 = 不限制，缓存保留到所属 DumpSession 结束（见 dump_session.hpp）
+    // 设置后只有条目元数据与成员摘要常驻：采集阶段每个条目写完摘要即释放其属性/函数，
+    // 生成阶段逐包重新读取成员（需要目标进程仍在运行），包写出后释放；
+    // 生成领先写盘的包数与待写文本按上限扣除常驻部分后的余量限制（见 dump_sdk_budget.hpp）
+    // 代价是成员被远程读取两次；离线模型（DumpCppSdkFromModel）的成员已全部加载，只随写盘逐包释放
+    // 上限只约束导出自身的模型、成员缓存与写盘队列，对象表镜像、名称缓存等进程级缓存不计入
+    u32 memoryBudgetMB = 0;
+
+    // 进度回调：阶段、已完成/总数、已写字节、吞吐与 ETA
+    // 可能在工作线程中调用，但调用之间互斥；阶段切换时总会回调一次
+    SdkProgressCallback onProgress;
+    u32 progressIntervalMs = 200;
+
+    // 取消令牌（调用方持有）：采集 / 生成 / 写盘循环中检查
+    // 取消后函数返回 false；已写出的文件保持完整，未开始写入的文件被丢弃，增量清单不更新
+    const SdkCancelToken* cancel = nullptr;
+};
+
+namespace detail
+{
+
+// 反射模型：一次 SDK 导出所需的全部反射数据
+// entries/enums 保存条目元数据；属性/函数数据位于
+// GetPropertiesCache / GetFunctionsCache（以 entry.addr 为键）
+// 由 CaptureReflectionModel 从进程采集，或由 LoadReflectionModel 从模型文件恢复
+struct SdkModel
+{
+    std::vector<StructEntry> entries;
+    std::vector<EnumInfo> enums;
+    UEOffsets off;        // 采集时的偏移快照（Basic.hpp 的 Offsets 命名空间使用）
+    uptr imageBase = 0;   // 主模块基址（计算 GObjects/GNames 等 RVA）
+};
+
+} // namespace detail
+
+// ─── 采集阶段：从目标进程读取全部反射数据 ───
+// 采集完成后每个条目的成员摘要已填写；未设置 memoryBudgetMB 时属性/函数缓存也已填满，
+// 生成阶段不再需要远程读取
+// progress 为空时使用自己的汇报器；DumpCppSdk 传入与生成阶段共用的汇报器，
+// 使 elapsedSeconds 与已写字节在整个导出中连续累计
+inline bool CaptureReflectionModel(
+    detail::SdkModel& model,
+    const SdkDumpOptions& options = {},
+    detail::SdkProgressReporter* progress = nullptr)
 {
     if (!IsInited())
     {
-        std::cerr << "[xrd] 未初始化，无法导出 SDK\n";
+        std::cerr << "[xrd] 未初始化，无法采集反射模型\n";
         return false;
     }
 
-    namespace fs = std::filesystem;
     using Clock = std::chrono::steady_clock;
     auto t0 = Clock::now();
     auto elapsed = [&]() -> double {
         return std::chrono::duration<double>(Clock::now() - t0).count();
     };
-
-    std::wstring cppSdkDir = outputPath + L"/CppSDK";
-    std::wstring sdkDir    = cppSdkDir + L"/SDK";
-    fs::create_directories(sdkDir);
-
-    std::cerr << "[xrd] 开始导出 Dumper7 品质 C++ SDK...\n";
-
-    // 收集枚举（按包索引分组）
-    auto allEnums = detail::CollectAllEnums();
-    std::unordered_map<i32,
-        std::vector<detail::EnumInfo>> enumsByPkgIdx;
-    for (auto& ei : allEnums)
+    std::optional<detail::SdkProgressReporter> ownProgress;
+    if (!progress)
     {
-        enumsByPkgIdx[ei.pkgIndex].push_back(ei);
+        progress = &ownProgress.emplace(&options.onProgress,
+            options.cancel, options.progressIntervalMs);
     }
-    // 填充枚举名→GObjects索引查找表（供依赖收集缓存路径使用）
+    auto cancelled = [&]() -> bool
     {
-        auto& enumLk = detail::GetEnumIndexLookup();
-        enumLk.clear();
-        for (auto& ei : allEnums)
+        if (!progress->Cancelled())
         {
-            i32 idx = GetObjectIndex(ei.addr);
-            if (idx > 0)
-            {
-                enumLk[ei.name] = idx;
-            }
+            return false;
         }
+        std::cerr << "[xrd] 反射模型采集已取消 (" << elapsed() << "s)\n";
+        return true;
+    };
+
+    // 收集枚举
+    model.enums = detail::CollectAllEnums(progress);
+    if (cancelled())
+    {
+        return false;
     }
     std::cerr << std::fixed << std::setprecision(2)
               << "[xrd] 枚举收集完成 (" << elapsed() << "s)\n";
     std::cerr.flush();
 
     // 收集结构体/类
-    auto entries = CollectAllStructEntries();
-    auto pkgMap = GroupByPackageIndex(entries);
-
-    std::cerr << "[xrd] 找到 " << entries.size()
+    model.entries = CollectAllStructEntries(progress);
+    if (cancelled())
+    {
+        return false;
+    }
+    std::cerr << "[xrd] 找到 " << model.entries.size()
               << " 个类/结构体, "
-              << allEnums.size() << " 个枚举, "
-              << pkgMap.size() << " 个包 ("
+              << model.enums.size() << " 个枚举 ("
               << elapsed() << "s)\n";
-    std::cerr.flush();    // 填充全局查找表
+    std::cerr.flush();
+
+    // 填充条目查找表（属性类型解析时查询 super/前缀）
     auto& lookup = detail::GetEntryLookup();
     lookup.clear();
-    for (auto& e : entries)
+    for (auto& e : model.entries)
     {
         lookup[e.name] = &e;
     }
-    std::cerr << "[xrd] 查找表填充完成 (" << elapsed() << "s)\n";
-    std::cerr.flush();
 
-    // 预热属性缓存
+    // 预热属性缓存；内存上限模式下写完摘要即释放该条目的成员
+    bool releaseMembers = options.memoryBudgetMB > 0;
     std::cerr << "[xrd] 预热缓存...\n";
     std::cerr.flush();
     detail::ClearPropertiesCache();
     detail::ClearFunctionsCache();
-    i32 warmupCount = 0;
-    for (auto& e : entries)
-    {
-        detail::CollectProperties(e.addr);
-        if (e.isClass)
-        {
-            detail::CollectFunctions(e.addr);
-        }
-        warmupCount++;
-        if (warmupCount % 1000 == 0)
-        {
-            std::cerr << "[xrd] 预热: "
-                << warmupCount << "/" << entries.size()
-                << " (" << elapsed() << "s)\n";
-            std::cerr.flush();
-        }
-    }
-    std::cerr << "[xrd] 缓存预热完成 ("
-              << elapsed() << "s)\n";
-    std::cerr.flush();
-
-    // 对标 Rei-Dumper InitSizesAndIsFinal：
-    // 计算 lastMemberEnd / unalignedSize / bHasReusedTrailingPadding
-    // 当子类属性侵入父类尾部 padding 时，需要用 #pragma pack(push, 0x1) + alignas
+    detail::ClearTypeDescCache();
+    std::atomic<size_t> nextEntry{0};
+    std::atomic<size_t> warmupCount{0};
+    std::mutex logMtx;
+    progress->BeginStage(SdkDumpStage::Warmup, model.entries.size());
+    auto warmup = [&]()
     {
-        auto& propCache = detail::GetPropertiesCache();
-        // 第一遍：计算每个 entry 的 lastMemberEnd
-        for (auto& e : entries)
+        for (;;)
         {
-            if (e.isInterfaceChild) continue;
-
-            auto cit = propCache.find(e.addr);
-            if (cit == propCache.end() || cit->second.empty())
+            size_t i = nextEntry.fetch_add(1);
+            if (i >= model.entries.size() || progress->Cancelled())
             {
-                e.lastMemberEnd = e.superSize;
-                e.unalignedSize = e.size;
-                continue;
+                return;
             }
-
-            i32 maxEnd = e.superSize;
-            for (auto& pi : cit->second)
+            auto& e = model.entries[i];
+            detail::CollectProperties(e.addr);
+            if (e.isClass)
             {
-                i32 memberEnd = pi.offset + (pi.size * pi.arrayDim);
-                if (memberEnd > maxEnd)
-                {
-                    maxEnd = memberEnd;
-                }
+                detail::CollectFunctions(e.addr);
             }
-            e.lastMemberEnd = maxEnd;
-            // unalignedSize 初始等于 aligned size，
-            // 只有被检测到 bHasReusedTrailingPadding 时才被缩短
-            e.unalignedSize = e.size;
-        }
-
-        // 建立可修改的 name → StructEntry* 映射
-        std::unordered_map<std::string, detail::StructEntry*>
-            mutableLookup;
-        for (auto& e : entries)
-        {
-            mutableLookup[e.name] = &e;
-        }
-
-        // 第二遍：检测子类是否侵入父类尾部 padding
-        for (auto& e : entries)
-        {
-            if (e.isInterfaceChild || e.superName.empty()) continue;
-
-            auto cit = propCache.find(e.addr);
-            if (cit == propCache.end() || cit->second.empty()) continue;
-
-            // 找到最小的属性偏移
-            i32 minPropOffset = e.size;
-            for (auto& pi : cit->second)
+            detail::SummarizeEntryMembers(e);
+            if (releaseMembers)
             {
-                if (pi.offset < minPropOffset)
-                {
-                    minPropOffset = pi.offset;
-                }
+                detail::ReleaseCachedMembers({&e});
             }
-
-            // 如果子类最小属性偏移 < 父类 aligned size，说明侵入了父类尾部 padding
-            if (minPropOffset < e.superSize)
+            size_t done = warmupCount.fetch_add(1) + 1;
+            progress->Advance();
+            if (done % 1000 == 0)
             {
-                // 在父类 entry 中标记 bHasReusedTrailingPadding
-                auto superIt = mutableLookup.find(e.superName);
-                if (superIt != mutableLookup.end())
-                {
-                    auto* superEntry = superIt->second;
-                    // 父类的 unalignedSize 应缩短到子类最小属性偏移处
-                    if (!superEntry->bHasReusedTrailingPadding
-                        || minPropOffset < superEntry->unalignedSize)
-                    {
-                        superEntry->bHasReusedTrailingPadding = true;
-                        superEntry->unalignedSize = minPropOffset;
-                    }
-                }
-            }
-        }
-        // 第三遍：计算 bCanSkipTrailingPad
-        // packed 类如果 Align(lastMemberEnd, alignment) == size，
-        // 说明 alignas 足以提供 trailing pad，不需要显式 trailing pad 成员
-        // 此时子类可从 lastMemberEnd 开始生成显式 pad
-        for (auto& e : entries)
-        {
-            if (e.isInterfaceChild || e.bHasReusedTrailingPadding)
-                continue;
-            // 只对 class 生效：class 的 bUseExplicitAlignment 同时控制 #pragma pack
-            // struct 的 pack 由 bHasReusedTrailingPadding 控制，不在此处理
-            if (!e.isClass || !e.bUseExplicitAlignment)
-                continue;
-            i32 a = e.alignment > 0 ? e.alignment : 1;
-            i32 aligned = (e.lastMemberEnd + a - 1) & ~(a - 1);
-            if (aligned == e.size)
-            {
-                e.bCanSkipTrailingPad = true;
+                std::lock_guard<std::mutex> lock(logMtx);
+                std::cerr << "[xrd] 预热: "
+                    << done << "/" << model.entries.size()
+                    << " (" << elapsed() << "s)\n";
+                std::cerr.flush();
             }
         }
+    };
 
-        std::cerr << "[xrd] 尾部 padding 重用检测完成 ("
-            << elapsed() << "s)\n";
-        std::cerr.flush();
+    // 缓存内容与采集顺序无关，并行结果与串行一致
+    const auto& accessors = options.collectAccessors;
+    if (accessors.empty())
+    {
+        warmup();
     }
-
-    // 从属性缓存中检测枚举底层类型大小
-    // 对标 Rei-Dumper：遍历所有 ByteProperty/EnumProperty，用 ElementSize 确定枚举大小
+    else
     {
-        // 建立 enum 名 → EnumInfo* 的查找表
-        std::unordered_map<std::string, std::vector<detail::EnumInfo*>> enumByName;
-        for (auto& ei : allEnums)
-        {
-            enumByName[ei.name].push_back(&ei);
-        }
-
-        auto& propCache = detail::GetPropertiesCache();
-        for (auto& [structAddr, props] : propCache)
-        {
-            for (auto& pi : props)
+        std::cerr << "[xrd] 并行采集: " << accessors.size() << " 个线程\n";
+        detail::RunWorkers(static_cast<u32>(accessors.size()),
+            [&](u32 w)
             {
-                // EnumProperty: typeName 就是枚举名
-                if (pi.fieldClassName == "EnumProperty")
+                if (accessors[w])
                 {
-                    auto eit = enumByName.find(pi.typeName);
-                    if (eit != enumByName.end())
-                    {
-                        for (auto* ep : eit->second)
-                        {
-                            if (pi.size > 0 && (u8)pi.size > ep->underlyingTypeSize)
-                            {
-                                ep->underlyingTypeSize = (u8)pi.size;
-                            }
-                        }
-                    }
+                    SetThreadMemAccessor(accessors[w]);
                 }
-                // ByteProperty 关联枚举: typeName 是枚举名（非 "uint8"）
-                else if (pi.fieldClassName == "ByteProperty" && pi.typeName != "uint8")
-                {
-                    auto eit = enumByName.find(pi.typeName);
-                    if (eit != enumByName.end())
-                    {
-                        for (auto* ep : eit->second)
-                        {
-                            if (pi.size > 0 && (u8)pi.size > ep->underlyingTypeSize)
-                            {
-                                ep->underlyingTypeSize = (u8)pi.size;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        std::cerr << "[xrd] 枚举底层类型检测完成 ("
-            << elapsed() << "s)\n";
-        std::cerr.flush();
-
-        // 检测完成后重建 enumsByPkgIdx（之前的是检测前的副本）
-        enumsByPkgIdx.clear();
-        for (auto& ei : allEnums)
-        {
-            enumsByPkgIdx[ei.pkgIndex].push_back(ei);
-        }
+                warmup();
+                ClearThreadMemAccessor();
+            });
+    }
+    if (cancelled())
+    {
+        return false;
     }
+    std::cerr << "[xrd] 缓存预热完成 ("
+              << elapsed() << "s)\n";
+    auto& typeDescs = detail::GetTypeDescTable();
+    std::cerr << "[xrd] 类型描述符: " << typeDescs.Size() << " 个, 复用 "
+              << typeDescs.Hits() << " 次\n";
+    std::cerr.flush();
 
-    // 合并所有包索引
-    std::unordered_set<i32> allPkgIndices;
-    for (auto& [k, v] : pkgMap)
+    model.off = Off();
+    model.imageBase = Ctx().mainModule.base;
+    return true;
+}
+
+// ─── 生成阶段：仅依赖反射模型与属性/函数缓存，不做远程读取 ───
+// 布局修正 → 跨包依赖 → 分包生成 → 写盘
+// 会写入 entries/enums 的派生字段（尾部 padding、冲突命名空间、枚举底层大小）
+// options.memoryBudgetMB 非 0 时分包生成与写盘流式进行，见 dump_sdk_budget.hpp
+// progress 同 CaptureReflectionModel：为空时 elapsedSeconds 从本次生成开始计时
+inline bool GenerateCppSdk(
+    detail::SdkModel& model,
+    const std::wstring& outputPath,
+    const SdkDumpOptions& options = {},
+    detail::SdkProgressReporter* progress = nullptr)
+{
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+    auto t0 = Clock::now();
+    auto elapsed = [&]() -> double {
+        return std::chrono::duration<double>(Clock::now() - t0).count();
+    };
+
+    std::wstring cppSdkDir = outputPath + L"/CppSDK";
+    std::wstring sdkDir    = cppSdkDir + L"/SDK";
+    fs::create_directories(sdkDir);
+
+    // 所有输出文件经后台写入器一次性写盘
+    detail::SdkFileWriter writer;
+    std::optional<detail::SdkProgressReporter> ownProgress;
+    if (!progress)
     {
-        allPkgIndices.insert(k);
+        progress = &ownProgress.emplace(&options.onProgress,
+            options.cancel, options.progressIntervalMs);
     }
-    for (auto& [k, v] : enumsByPkgIdx)
+    writer.ObserveBytes(&progress->BytesCounter());
+
+    // 取消：丢弃未开始写入的文件，已写出的文件保持完整，不更新清单
+    auto abortDump = [&]() -> bool
     {
-        allPkgIndices.insert(k);
+        size_t dropped = writer.Abort();
+        writer.Finish();
+        std::cerr << "[xrd] SDK 导出已取消 (" << elapsed() << "s), 丢弃 "
+                  << dropped << " 个待写文件, 增量清单未更新\n";
+        return false;
+    };
+
+    // 增量清单：上次导出的包输入哈希与文件内容哈希
+    std::wstring manifestPath = cppSdkDir + L"/sdk_manifest.bin";
+    detail::SdkManifest prevManifest;
+    detail::SdkManifest nextManifest;
+    if (options.incremental && prevManifest.Load(manifestPath))
+    {
+        std::cerr << "[xrd] 增量导出: 上次清单 "
+                  << prevManifest.packages.size() << " 个包\n";
     }
+    writer.TrackHashes(cppSdkDir, &prevManifest.files);
+    std::vector<std::string> changedPkgs;
+
+    std::cerr << "[xrd] 开始导出 Dumper7 品质 C++ SDK...\n";
+
+    auto& entries = model.entries;
+    auto& allEnums = model.enums;
 
-    // 构建 pkgIndex → outerName 映射
-    std::unordered_map<i32, std::string> pkgIdxToOuter;
+    auto pkgMap = GroupByPackageIndex(entries);
+
+    // 填充条目查找表
+    auto& lookup = detail::GetEntryLookup();
+    lookup.clear();
     for (auto& e : entries)
     {
-        pkgIdxToOuter[e.pkgIndex] = e.outerName;
+        lookup[e.name] = &e;
     }
-    for (auto& ei : allEnums)
+    // 填充依赖对象查找表（依赖收集据此区分包和类别，无需远程读取）
     {
-        if (pkgIdxToOuter.find(ei.pkgIndex)
-            == pkgIdxToOuter.end())
+        auto& depLk = detail::GetDepObjectLookup();
+        depLk.clear();
+        for (auto& e : entries)
+        {
+            auto& info = depLk[e.objIndex];
+            info.pkgIndex = e.pkgIndex;
+            info.isUClass = (e.objClassName == "Class");
+        }
+        for (auto& ei : allEnums)
         {
-            pkgIdxToOuter[ei.pkgIndex] = ei.outerName;
+            auto& info = depLk[ei.objIndex];
+            info.pkgIndex = ei.pkgIndex;
+            info.isEnum = true;
         }
     }
+    std::cerr << std::fixed << std::setprecision(2)
+              << "[xrd] " << pkgMap.size()
+              << " 个包, 查找表填充完成 (" << elapsed() << "s)\n";
+    std::cerr.flush();
 
-    // 构建 pkgIndex → sanitizedName 映射
-    // 对标 Rei-Dumper：检测包名冲突，冲突时加 _N 后缀
-    std::unordered_map<i32, std::string> pkgIdxToSanitized;
+    // ─── 布局修正阶段：尾部 padding 重用、枚举底层类型 ───
+    detail::ComputeTrailingPadding(entries);
+    std::cerr << "[xrd] 尾部 padding 重用检测完成 ("
+        << elapsed() << "s)\n";
+    detail::DetectEnumUnderlyingSizes(allEnums, entries);
+    std::cerr << "[xrd] 枚举底层类型检测完成 ("
+        << elapsed() << "s)\n";
+    std::cerr.flush();
+
+    // 按包索引分组枚举（需在底层类型检测之后复制）
+    detail::HashOrderMap<std::vector<detail::EnumInfo>> enumsByPkgIdx;
+    for (auto& ei : allEnums)
     {
-        // 先统计每个 sanitized 名出现的次数
-        std::map<std::string, std::vector<i32>> sanToIndices;
-        for (i32 idx : allPkgIndices)
-        {
-            auto oit = pkgIdxToOuter.find(idx);
-            std::string outer = (oit != pkgIdxToOuter.end())
-                ? oit->second : "Unknown";
-            std::string san = SanitizePackageName(outer);
-            sanToIndices[san].push_back(idx);
-        }
-        for (auto& [san, indices] : sanToIndices)
-        {
-            if (indices.size() == 1)
-            {
-                pkgIdxToSanitized[indices[0]] = san;
-            }
-            else
-            {
-                pkgIdxToSanitized[indices[0]] = san;
-                for (size_t i = 1; i < indices.size(); ++i)
-                {
-                    pkgIdxToSanitized[indices[i]] =
-                        san + "_" + std::to_string(i - 1);
-                }
-            }
-        }
+        enumsByPkgIdx[ei.pkgIndex].push_back(ei);
     }
 
+    // 合并所有包索引（遍历顺序决定冲突包名的 _N 后缀与拓扑排序起点）
+    detail::HashOrderSet allPkgIndices;
+    for (auto& [k, v] : pkgMap)
+    {
+        allPkgIndices.insert(k);
+    }
+    for (auto& [k, v] : enumsByPkgIdx)
+    {
+        allPkgIndices.insert(k);
+    }
+
+    // 包名映射（冲突包名加 _N 后缀，见 AssignPackageNames）
+    auto pkgNames = AssignPackageNames(allPkgIndices, entries, allEnums);
+    auto& pkgIdxToOuter = pkgNames.outer;
+    auto& pkgIdxToSanitized = pkgNames.sanitized;
+
     // 构建冲突包的命名空间映射
     std::map<std::string, std::string> collisionNsMap;
     std::unordered_map<i32, std::string> collisionNsByIdx;
@@ -770,7 +822,7 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
     }
 
     // 生成辅助文件到 CppSDK/ 层级
-    detail::GenerateAuxiliaryFiles(cppSdkDir, collisionNsMap,
+    detail::GenerateAuxiliaryFiles(writer, cppSdkDir, collisionNsMap,
         entries);
     std::cerr << "[xrd] 辅助文件生成完成 (" << elapsed() << "s)\n";
     std::cerr.flush();
@@ -781,12 +833,18 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
     std::cerr.flush();
     std::unordered_map<i32, detail::PackageDeps> classesDeps;
     std::unordered_map<i32, detail::PackageDeps> structsDeps;
+    std::unordered_map<i32, detail::PackageDeps> paramsDeps;
 
     i32 depProgress = 0;
     i32 entryProgress = 0;
     i32 totalEntries = (i32)entries.size();
+    progress->BeginStage(SdkDumpStage::Layout, entries.size());
     for (i32 pkgIdx : allPkgIndices)
     {
+        if (progress->Cancelled())
+        {
+            return abortDump();
+        }
         auto structIt = pkgMap.find(pkgIdx);
         if (structIt == pkgMap.end())
         {
@@ -794,8 +852,6 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
             continue;
         }
 
-        // paramsDeps 参数传入一个临时占位，实际不使用
-        detail::PackageDeps unusedParams;
         for (auto* entry : structIt->second)
         {
             try
@@ -804,7 +860,8 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
                     *entry, pkgIdx,
                     structsDeps[pkgIdx],
                     classesDeps[pkgIdx],
-                    unusedParams);
+                    paramsDeps[pkgIdx],
+                    options.forwardDeclarations);
             }
             catch (...)
             {
@@ -813,6 +870,7 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
                     << entry->objIndex << ")\n";
             }
             entryProgress++;
+            progress->Advance();
             if (entryProgress % 500 == 0)
             {
                 std::cerr << "[xrd] 依赖进度: "
@@ -827,12 +885,12 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
         << entryProgress << " 条目)\n";
     std::cerr.flush();
 
-    // 打开 Assertions.inl
-    std::wstring assertPath = cppSdkDir + L"/Assertions.inl";
-    std::ofstream assertFile(assertPath, std::ios::app);
+    // Assertions.inl：头部 + 各包断言 + 结尾，在内存中拼接后一次提交
+    std::string assertText = gen::BuildAssertionsHeader();
 
-    // SDK.hpp 的 include 列表
+    // SDK.hpp / SDK_fwd.hpp 的 include 列表
     std::vector<std::string> sdkIncludes;
+    std::vector<std::string> fwdIncludes;
 
     // 对标 Rei-Dumper：按依赖顺序排列包
     std::cerr << "[xrd] 开始拓扑排序 ("
@@ -862,171 +920,268 @@ inline bool DumpCppSdk(const std::wstring& outputPath)
         pkgsWithStructs.insert(pi);
     }
 
-    i32 pkgCount = 0;
-    i32 totalPkgs = (i32)sortedPkgs.size();
-    for (i32 pkgIdx : sortedPkgs)
-    {
-        std::string sanitized = pkgIdxToSanitized[pkgIdx];
-        auto oit = pkgIdxToOuter.find(pkgIdx);
-        std::string outerName = (oit != pkgIdxToOuter.end())
-            ? oit->second : "Unknown";
-        std::string cleanPkg = CleanPackageName(outerName);
-
-        auto structIt = pkgMap.find(pkgIdx);
-        auto enumIt   = enumsByPkgIdx.find(pkgIdx);
+    u32 workers = detail::ResolveWorkerCount(options.workerCount);
+    auto limits = detail::MakePipelineLimits(options.memoryBudgetMB,
+        detail::EstimateResidentModelBytes(entries, allEnums)
+            + detail::EstimateMemberCacheBytes(), workers);
+    writer.SetQueueLimit(limits.writerQueueBytes);
+    std::mutex memberReadMtx; // 流式模式下包成员的远程读取串行化
 
-        std::vector<const detail::StructEntry*> classes;
-        std::vector<const detail::StructEntry*> structs;
-        if (structIt != pkgMap.end())
+    // 冻结缓存：并行生成阶段对缓存只读，先补齐可能缺失的条目
+    // 流式模式下改为在各包生成前读取（CollectPackageMembers）
+    if (!limits.streaming)
+    {
+        auto& propCache = detail::GetPropertiesCache();
+        auto& funcCache = detail::GetFunctionsCache();
+        for (auto& e : entries)
         {
-            for (auto* e : structIt->second)
+            if (!propCache.count(e.addr))
             {
-                if (e->isClass)
-                {
-                    classes.push_back(e);
-                }
-                else
-                {
-                    structs.push_back(e);
-                }
+                detail::CollectProperties(e.addr);
+            }
+            if (e.isClass && !funcCache.count(e.addr))
+            {
+                detail::CollectFunctions(e.addr);
             }
         }
+    }
 
-        if (pkgCount % 50 == 0)
-        {
-            std::cerr << "[xrd] 写入进度: "
-                << pkgCount << "/" << totalPkgs
-                << " (" << elapsed() << "s)\n";
-            std::cerr.flush();
-        }
-
-        // 对标 Rei-Dumper：包内按依赖拓扑排序
-        structs = detail::TopoSortEntries(structs);
-        classes = detail::TopoSortEntries(classes);
-
-        std::vector<detail::EnumInfo> emptyEnums;
-        const auto& pkgEnums = (enumIt != enumsByPkgIdx.end())
-            ? enumIt->second : emptyEnums;
-
-        // 获取依赖
-        detail::PackageDeps sDeps, cDeps, pDeps;
-        auto sit = structsDeps.find(pkgIdx);
-        if (sit != structsDeps.end())
-        {
-            sDeps = sit->second;
-        }
-        auto cit = classesDeps.find(pkgIdx);
-        if (cit != classesDeps.end())
-        {
-            cDeps = cit->second;
-        }
-        // parameters 文件的依赖 = structs 依赖 ∪ classes 依赖
-        // 因为函数参数可能引用任意 struct/class/enum
-        // 对标 Rei-Dumper：parameters include 是 structs+classes 的超集
-        pDeps = sDeps;
-        for (auto& [depIdx, info] : cDeps.deps)
-        {
-            auto& pInfo = pDeps.deps[depIdx];
-            if (info.needStructs) pInfo.needStructs = true;
-            if (info.needClasses) pInfo.needClasses = true;
-        }
+    // 生成阶段共享的只读数据
+    detail::PackageGenContext genCtx{
+        pkgMap, enumsByPkgIdx, structsDeps, classesDeps, paramsDeps,
+        pkgIdxToSanitized, pkgIdxToOuter, pkgsWithStructs,
+        options.forwardDeclarations};
 
-        bool hasStructsFile = !structs.empty()
-            || !pkgEnums.empty();
+    std::cerr << "[xrd] 并行生成包代码 (" << workers << " 线程)...\n";
+    std::cerr.flush();
 
-        // 检查类是否依赖同包的结构体或枚举
-        // _structs.hpp 同时包含结构体和枚举定义
-        // 需要同时检查两者的依赖
-        bool classesNeedOwnStructs = false;
-        if (hasStructsFile && !classes.empty())
+    i32 pkgCount = 0;
+    i32 totalPkgs = (i32)sortedPkgs.size();
+    double genSeconds = 0.0;
+    u64 genAllocs = 0;
+    u64 genTypes = 0;
+    std::vector<std::pair<double, std::string>> pkgTimings;
+    pkgTimings.reserve(sortedPkgs.size());
+
+    // 按拓扑顺序写入：文件内容、Assertions 追加顺序与串行完全一致
+    progress->BeginStage(SdkDumpStage::Generate, sortedPkgs.size());
+    detail::OrderedParallelFor<detail::PackageOutput>(
+        sortedPkgs.size(), workers,
+        [&](size_t i)
         {
-            // 收集同包的结构体裸名
-            std::unordered_set<std::string> structNames;
-            for (auto* s : structs)
+            // 取消后剩余的包快速返回空结果，消费端不再提交
+            if (progress->Cancelled())
             {
-                structNames.insert(s->name);
+                return detail::PackageOutput{};
+            }
+            // 生成异常不吞掉：OrderedParallelFor 停止全部工作线程后抛给调用方，
+            // 不会把空结果当作已生成的包写进清单
+            i32 pkg = sortedPkgs[i];
+            if (limits.streaming)
+            {
+                auto pit = pkgMap.find(pkg);
+                if (pit != pkgMap.end())
+                {
+                    detail::CollectPackageMembers(pit->second, memberReadMtx);
+                }
             }
-            // 收集同包的枚举名（枚举也在 _structs.hpp 中）
-            std::unordered_set<std::string> enumNames;
-            for (auto& ei : pkgEnums)
+            u64 inputHash = detail::HashPackageInputs(genCtx, pkg);
+            auto sit = pkgIdxToSanitized.find(pkg);
+            bool skip = options.incremental
+                && sit != pkgIdxToSanitized.end()
+                && detail::CanSkipPackage(prevManifest, sit->second,
+                    inputHash, sdkDir);
+            auto out = detail::BuildPackageOutput(genCtx, pkg, skip);
+            out.inputHash = inputHash;
+            return out;
+        },
+        [&](size_t i, detail::PackageOutput&& out)
+        {
+            if (progress->Cancelled())
             {
-                enumNames.insert(ei.name);
+                return;
             }
-            for (auto* cls : classes)
+            std::wstring wName = detail::Utf8ToWide(out.sanitized);
+            nextManifest.packages[out.sanitized] = out.inputHash;
+            if (out.unchanged)
             {
-                // 检查结构体依赖
-                auto deps2 = detail::CollectEntryDeps(*cls);
-                for (auto& d : deps2)
+                for (const char* suffix : detail::kPackageFileSuffixes)
                 {
-                    if (structNames.count(d))
-                    {
-                        classesNeedOwnStructs = true;
-                        break;
-                    }
+                    writer.KeepUnchanged(sdkDir + L"/" + wName
+                        + detail::Utf8ToWide(suffix));
                 }
-                if (classesNeedOwnStructs) break;
-                // 检查枚举依赖：遍历属性的 typeName
-                auto props = detail::CollectProperties(cls->addr);
-                for (auto& p : props)
+            }
+            else
+            {
+                changedPkgs.push_back(out.sanitized);
+            }
+            if (!out.structsText.empty())
+            {
+                writer.Submit(sdkDir + L"/" + wName
+                    + L"_structs.hpp", std::move(out.structsText));
+            }
+            if (!out.classesText.empty())
+            {
+                writer.Submit(sdkDir + L"/" + wName
+                    + L"_classes.hpp", std::move(out.classesText));
+            }
+            if (!out.functionsText.empty())
+            {
+                writer.Submit(sdkDir + L"/" + wName
+                    + L"_functions.cpp", std::move(out.functionsText));
+            }
+            if (!out.paramsText.empty())
+            {
+                writer.Submit(sdkDir + L"/" + wName
+                    + L"_parameters.hpp", std::move(out.paramsText));
+            }
+            if (!out.fwdText.empty())
+            {
+                writer.Submit(sdkDir + L"/" + wName
+                    + L"_fwd.hpp", std::move(out.fwdText));
+            }
+            assertText += out.assertText;
+
+            if (out.hasStructsFile)
+            {
+                sdkIncludes.push_back(
+                    out.sanitized + "_structs.hpp");
+            }
+            if (out.hasClasses)
+            {
+                sdkIncludes.push_back(
+                    out.sanitized + "_classes.hpp");
+            }
+            if (out.hasFwdFile)
+            {
+                fwdIncludes.push_back(out.sanitized + "_fwd.hpp");
+            }
+
+            genSeconds += out.seconds;
+            genAllocs += out.bufferAllocs;
+            genTypes += out.typeCount;
+            pkgTimings.push_back({out.seconds, out.sanitized});
+
+            // 文本已移交写盘队列；后续包不再读取本包条目的缓存
+            if (limits.streaming)
+            {
+                auto pit = pkgMap.find(sortedPkgs[i]);
+                if (pit != pkgMap.end())
                 {
-                    if (enumNames.count(p.typeName))
-                    {
-                        classesNeedOwnStructs = true;
-                        break;
-                    }
+                    detail::ReleaseCachedMembers(pit->second);
                 }
-                if (classesNeedOwnStructs) break;
             }
-        }
 
-        detail::WriteStructsFile(sdkDir, sanitized, cleanPkg,
-            structs, pkgEnums, sDeps, pkgIdxToSanitized,
-            &pkgsWithStructs);
-        detail::WriteClassesFile(sdkDir, sanitized, cleanPkg,
-            classes, cDeps, pkgIdxToSanitized,
-            hasStructsFile, classesNeedOwnStructs,
-            &pkgsWithStructs);
-        detail::WriteFunctionsFile(sdkDir, sanitized, cleanPkg,
-            classes);
-        detail::WriteParametersFile(sdkDir, sanitized, cleanPkg,
-            classes, pDeps, pkgIdxToSanitized);
+            pkgCount++;
+            progress->Advance();
+            if (pkgCount % 50 == 0)
+            {
+                std::cerr << "[xrd] 写入进度: "
+                    << pkgCount << "/" << totalPkgs
+                    << " (" << elapsed() << "s)\n";
+                std::cerr.flush();
+            }
+        },
+        limits.lookahead);
+    if (progress->Cancelled())
+    {
+        return abortDump();
+    }
 
-        detail::AppendAssertions(assertFile, structs, classes);
+    // 包生成耗时：累计 CPU 时间 + 最慢的几个包
+    std::sort(pkgTimings.begin(), pkgTimings.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::cerr << "[xrd] 包生成累计耗时 " << genSeconds
+              << "s (" << workers << " 线程)\n";
+    for (size_t i = 0; i < pkgTimings.size() && i < 10; ++i)
+    {
+        std::cerr << "[xrd]   " << pkgTimings[i].second << ": "
+                  << pkgTimings[i].first * 1000.0 << "ms\n";
+    }
+    if (genTypes > 0)
+    {
+        std::cerr << "[xrd] 代码生成缓冲区: " << genAllocs
+                  << " 次块分配 / " << genTypes << " 个类型 (平均 "
+                  << static_cast<double>(genAllocs) / genTypes << ")\n";
+    }
+    std::cerr.flush();
 
-        bool hasClasses = !classes.empty();
+    // 关闭 Assertions.inl 中的 #ifndef DUMPER7_DISABLE_ASSERTS
+    assertText += "\n#endif // DUMPER7_DISABLE_ASSERTS\n";
+    writer.Submit(cppSdkDir + L"/Assertions.inl", std::move(assertText));
 
-        if (hasStructsFile)
-        {
-            sdkIncludes.push_back(
-                sanitized + "_structs.hpp");
-        }
-        if (hasClasses)
+    detail::GenerateBasicHpp(writer, sdkDir);
+    detail::GenerateBasicCpp(writer, sdkDir);
+    detail::GenerateSdkHpp(writer, cppSdkDir, sdkIncludes);
+    if (options.forwardDeclarations)
+    {
+        detail::GenerateSdkFwdHpp(writer, cppSdkDir, fwdIncludes);
+    }
+
+    // 等待后台写入完成，期间汇报写盘进度并响应取消
+    progress->BeginStage(SdkDumpStage::Write, writer.Submitted());
+    while (!writer.WaitDrained(options.progressIntervalMs > 0
+        ? options.progressIntervalMs : 200))
+    {
+        if (progress->Cancelled())
         {
-            sdkIncludes.push_back(
-                sanitized + "_classes.hpp");
+            return abortDump();
         }
-
-        pkgCount++;
-        if (pkgCount % 50 == 0)
+        progress->SetDone(writer.Completed());
+    }
+    const auto& writeStats = writer.Finish();
+    writer.Report();
+
+    // 报告变化的包并保存清单
+    // 变更列表按本次生成结果写出；有文件写盘失败的包随后从清单中去掉输入哈希，
+    // 下次增量导出会重新生成它
+    detail::WriteChangeList(cppSdkDir + L"/sdk_changes.txt",
+        prevManifest, nextManifest, changedPkgs);
+    const auto& failedFiles = writer.FailedFiles();
+    if (!failedFiles.empty())
+    {
+        for (auto it = nextManifest.packages.begin(); it != nextManifest.packages.end();)
         {
-            std::cerr << "[xrd] 写入进度: "
-                << pkgCount << "/" << totalPkgs << " 包\n";
-            std::cerr.flush();
+            bool failed = false;
+            for (const char* suffix : detail::kPackageFileSuffixes)
+            {
+                if (failedFiles.count("SDK/" + it->first + suffix))
+                {
+                    failed = true;
+                    break;
+                }
+            }
+            it = failed ? nextManifest.packages.erase(it) : std::next(it);
         }
     }
+    nextManifest.files = writer.FileHashes();
+    nextManifest.Save(manifestPath);
+    std::cerr << "[xrd] 变化的包: " << changedPkgs.size()
+              << "/" << pkgCount << "（列表见 sdk_changes.txt）\n";
 
-    // 关闭 Assertions.inl 中的 #ifndef DUMPER7_DISABLE_ASSERTS
-    assertFile << "\n#endif // DUMPER7_DISABLE_ASSERTS\n";
-    assertFile.close();
-
-    detail::GenerateBasicHpp(sdkDir);
-    detail::GenerateBasicCpp(sdkDir);
-    detail::GenerateSdkHpp(cppSdkDir, sdkIncludes);
-
+    progress->BeginStage(SdkDumpStage::Done, 0);
     std::cerr << "[xrd] C++ SDK 导出完成: " << pkgCount
               << " 个包, " << sdkIncludes.size()
               << " 个文件\n";
-    return true;
+    return writeStats.failedFiles == 0;
+}
+
+// ─── 主导出函数：Dumper7 品质 C++ SDK ───
+// 采集 + 生成；需要离线重新生成时用 SaveReflectionModel / DumpCppSdkFromModel
+inline bool DumpCppSdk(
+    const std::wstring& outputPath,
+    const SdkDumpOptions& options = {})
+{
+    detail::AutoDumpSession session;
+    detail::SdkModel model;
+    // 采集与生成共用一个汇报器：elapsedSeconds 从导出开始计时，不在生成阶段归零
+    detail::SdkProgressReporter progress(&options.onProgress,
+        options.cancel, options.progressIntervalMs);
+    if (!CaptureReflectionModel(model, options, &progress))
+    {
+        return false;
+    }
+    return GenerateCppSdk(model, outputPath, options, &progress);
 }
 
 // 兼容旧接口
@@ -0,0 +1,142 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：内存上限与流式释放
+// 流水线：采集 → 布局修正 → 分包生成 → 写盘
+// 跨包布局与依赖只需要常驻的条目元数据与成员摘要（StructEntry::memberRefs 等）；
+// 属性/函数缓存只被所属包的生成读取。设置内存上限时，采集阶段每个条目写完摘要即释放其成员，
+// 生成阶段在包生成前重新读取该包的成员，包写出后再次释放，
+// 导出部分的峰值 ≈ 常驻元数据 + 生成窗口内各包的成员 + 写盘队列。内存上限在扣除常驻部分后分给后两者
+// 离线加载的模型（LoadReflectionModel）成员已全部在内存中，只能随写盘逐包释放
+
+#include "dump_prefix.hpp"
+#include "dump_collect.hpp"
+#include "dump_enum.hpp"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 属性/函数缓存的近似占用（容器容量 × 元素大小，不含哈希表节点开销）
+// 字符串已驻留在 StringPool 中，这里只计编号
+inline u64 EstimateMemberCacheBytes()
+{
+    u64 bytes = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(GetPropertiesCacheMutex());
+        for (auto& [addr, props] : GetPropertiesCache())
+        {
+            bytes += props.capacity() * sizeof(PropertyInfo);
+        }
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(GetFunctionsCacheMutex());
+        for (auto& [addr, funcs] : GetFunctionsCache())
+        {
+            bytes += funcs.capacity() * sizeof(FunctionInfo);
+            for (auto& f : funcs)
+            {
+                bytes += f.params.capacity() * sizeof(FunctionParam);
+            }
+        }
+    }
+    return bytes;
+}
+
+// 常驻元数据的近似占用：条目、摘要与枚举（不含驻留字符串池与类型描述符表）
+inline u64 EstimateResidentModelBytes(
+    const std::vector<StructEntry>& entries,
+    const std::vector<EnumInfo>& enums)
+{
+    u64 bytes = entries.capacity() * sizeof(StructEntry)
+        + enums.capacity() * sizeof(EnumInfo);
+    for (auto& e : entries)
+    {
+        bytes += e.name.capacity() + e.fullName.capacity() + e.outerName.capacity()
+            + e.superName.capacity() + e.objClassName.capacity()
+            + (e.memberRefs.capacity() + e.paramRefs.capacity()) * sizeof(i32)
+            + e.enumMemberSizes.capacity() * sizeof(e.enumMemberSizes[0]);
+    }
+    for (auto& ei : enums)
+    {
+        bytes += ei.members.capacity() * sizeof(ei.members[0]);
+    }
+    return bytes;
+}
+
+// 读取一个包全部条目的属性/函数（内存上限模式下生成前调用，已缓存的条目直接命中）
+// 生成工作线程共用调用方绑定的访问器，远程读取用 mtx 串行化；代码生成本身仍并行
+inline void CollectPackageMembers(
+    const std::vector<const StructEntry*>& entries, std::mutex& mtx)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto* e : entries)
+    {
+        CollectProperties(e->addr);
+        if (e->isClass)
+        {
+            CollectFunctions(e->addr);
+        }
+    }
+}
+
+// 释放一个包全部条目的属性/函数缓存
+// 其他包的生成只读取自己条目的缓存项，擦除不影响它们持有的引用
+inline void ReleaseCachedMembers(const std::vector<const StructEntry*>& entries)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(GetPropertiesCacheMutex());
+        auto& cache = GetPropertiesCache();
+        for (auto* e : entries)
+        {
+            cache.erase(e->addr);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(GetFunctionsCacheMutex());
+    auto& cache = GetFunctionsCache();
+    for (auto* e : entries)
+    {
+        cache.erase(e->addr);
+    }
+}
+
+// 分包生成 / 写盘阶段的限额
+struct SdkPipelineLimits
+{
+    bool streaming = false;    // 包写出后释放其缓存
+    u64 writerQueueBytes = 0;  // 待写文本上限，0 = 不限制
+    size_t lookahead = 0;      // 生成最多领先写盘的包数，0 = 不限制
+};
+
+// 由内存上限（MB，0 = 不限制）与常驻部分大小（元数据 + 尚未释放的成员缓存）推导限额
+// 常驻部分已超过上限时仍继续导出，只把生成窗口压到最小并给出警告
+inline SdkPipelineLimits MakePipelineLimits(u32 budgetMB, u64 residentBytes, u32 workers)
+{
+    SdkPipelineLimits limits;
+    if (budgetMB == 0)
+    {
+        return limits;
+    }
+    constexpr u64 kMinQueueBytes = 16ull << 20;
+    u64 budget = static_cast<u64>(budgetMB) << 20;
+    u64 headroom = budget > residentBytes ? budget - residentBytes : 0;
+    limits.streaming = true;
+    limits.writerQueueBytes = (std::max)(headroom / 2, kMinQueueBytes);
+    limits.lookahead = headroom > 0 ? (std::max<size_t>)(workers * 2u, 2) : 1;
+    std::cerr << "[xrd] 内存上限 " << budgetMB << " MB: 常驻部分约 "
+              << (residentBytes >> 20) << " MB, 写盘队列 "
+              << (limits.writerQueueBytes >> 20) << " MB, 生成窗口 "
+              << limits.lookahead << " 个包\n";
+    if (headroom == 0)
+    {
+        std::cerr << "[xrd] 警告: 常驻部分已超过内存上限，按最小窗口继续\n";
+    }
+    return limits;
+}
+
+} // namespace detail
+} // namespace xrd
@@ -1,12 +1,16 @@
 #pragma once
 // Xrd-eXternalrEsolve - SDK 导出：格式化工具
 // Padding 生成、成员字符串对齐、BitField 格式化
+// 直接追加到 CodeBuilder，不返回中间字符串
 // 对标 Dumper7 CppGenerator 的输出格式
 
 #include "dump_collect.hpp"
 #include "dump_property_flags.hpp"
+#include "dump_code_builder.hpp"
 #include <string>
+#include <string_view>
 #include <format>
+#include <iterator>
 
 namespace xrd
 {
@@ -50,18 +54,23 @@ inline bool HasBinaryGarbage(const std::string& s)
     return false;
 }
 
-// 生成对齐的成员字符串：Type(45列) Name;(50列) // Comment
+// 生成对齐的成员行：Type(45列) Name;(50列) // Comment
 // 对标 Rei-Dumper: 使用 Tab 缩进
-inline std::string MakeMemberString(
-    const std::string& type,
-    const std::string& name,
-    const std::string& comment)
+// nameCol 为已带分号的名称列；注释部分直接 format 到输出
+template<typename... Args>
+inline void AppendMemberLine(
+    CodeBuilder& out,
+    std::string_view type,
+    std::string_view nameCol,
+    std::format_string<Args...> commentFmt,
+    Args&&... commentArgs)
 {
     // 对标 Dumper7: <tab><--45 chars--><-------50 chars----->
+    size_t nameLen = nameCol.empty() ? 0 : nameCol.size() - 1;
     int nameFieldWidth = 50;
     if (type.length() >= 45)
     {
-        if (type.length() + name.length() > 95)
+        if (type.length() + nameLen > 95)
         {
             nameFieldWidth = 1;
         }
@@ -71,109 +80,143 @@ inline std::string MakeMemberString(
         }
     }
 
-    return std::format("\t{:{}} {:{}} // {}\n",
-        type, 45,
-        name + ";", nameFieldWidth,
-        comment);
+    out.Format("\t{:{}} {:{}} // ", type, 45, nameCol, nameFieldWidth);
+    out.Format(commentFmt, std::forward<Args>(commentArgs)...);
+    out += '\n';
+}
+
+// 字符串版本（预定义成员等低频路径使用）
+inline std::string MakeMemberString(
+    const std::string& type,
+    const std::string& name,
+    const std::string& comment)
+{
+    CodeBuilder b;
+    AppendMemberLine(b, type, name + ";", "{}", comment);
+    return b.ToString();
 }
 
 // 生成字节填充（属性之间的间隙）
 // 对标 Rei-Dumper: padding 注释末尾加 [ Rei-SdkDumper ]
+inline void AppendBytePadding(
+    CodeBuilder& out,
+    i32 offset,
+    i32 padSize,
+    std::string_view reason)
+{
+    std::string& col = out.Scratch();
+    std::format_to(std::back_inserter(col),
+        "Pad_{:X}[0x{:X}];", offset, padSize);
+    AppendMemberLine(out, "uint8", col,
+        "0x{:04X}(0x{:04X})({} [ Rei-SdkDumper ])",
+        offset, padSize, reason);
+}
+
 inline std::string GenerateBytePadding(
     i32 offset,
     i32 padSize,
     const std::string& reason)
 {
-    return MakeMemberString(
-        "uint8",
-        std::format("Pad_{:X}[0x{:X}]", offset, padSize),
-        std::format("0x{:04X}(0x{:04X})({} [ Rei-SdkDumper ])",
-            offset, padSize, reason));
+    CodeBuilder b;
+    AppendBytePadding(b, offset, padSize, reason);
+    return b.ToString();
 }
 
 // 生成位填充（BitField 之间的间隙）
-inline std::string GenerateBitPadding(
+inline void AppendBitPadding(
+    CodeBuilder& out,
     i32 underlayingSize,
     i32 prevEndBit,
     i32 offset,
     i32 padBits,
-    const std::string& reason)
+    std::string_view reason)
 {
-    return MakeMemberString(
-        GetTypeFromSize(underlayingSize),
-        std::format("BitPad_{:X}_{:X} : {:d}",
-            offset, prevEndBit, padBits),
-        std::format("0x{:04X}(0x{:04X})({} [ Rei-SdkDumper ])",
-            offset, underlayingSize, reason));
+    std::string& col = out.Scratch();
+    std::format_to(std::back_inserter(col),
+        "BitPad_{:X}_{:X} : {:d};", offset, prevEndBit, padBits);
+    AppendMemberLine(out, GetTypeFromSize(underlayingSize), col,
+        "0x{:04X}(0x{:04X})({} [ Rei-SdkDumper ])",
+        offset, underlayingSize, reason);
 }
 
-// 生成单个属性的成员字符串（含 BitField 处理）
-inline std::string FormatProperty(const PropertyInfo& prop)
+// 属性名转为成员标识符，追加到 out
+// 对标 Rei-Dumper：ASCII 范围的非法标识符字符替换为下划线
+// 保留非 ASCII 字符（如中文），MSVC 支持 UTF-8 标识符
+inline void AppendMemberName(std::string& out, std::string_view name)
 {
-    // 对标 Rei-Dumper：属性名中 ASCII 范围的非法标识符字符替换为下划线
-    // 保留非 ASCII 字符（如中文），MSVC 支持 UTF-8 标识符
-    std::string memberName = prop.name;
-    for (auto& c : memberName)
+    // 首字符为数字时加下划线前缀
+    if (!name.empty() && std::isdigit(
+        static_cast<unsigned char>(name[0])))
     {
-        unsigned char uc = static_cast<unsigned char>(c);
-        if (uc < 0x80
-            && !std::isalnum(uc) && c != '_')
-        {
-            c = '_';
-        }
+        out += '_';
     }
-    // 首字符为数字时加下划线前缀
-    if (!memberName.empty() && std::isdigit(
-        static_cast<unsigned char>(memberName[0])))
+    for (char c : name)
     {
-        memberName = "_" + memberName;
+        unsigned char uc = static_cast<unsigned char>(c);
+        out += (uc < 0x80 && !std::isalnum(uc) && c != '_') ? '_' : c;
     }
+}
+
+// 生成单个属性的成员行（含 BitField 处理）
+inline void AppendProperty(CodeBuilder& out, const PropertyInfo& prop)
+{
+    std::string& col = out.Scratch();
+    AppendMemberName(col, prop.name);
 
     if (prop.arrayDim > 1)
     {
-        memberName += std::format("[0x{:X}]", prop.arrayDim);
+        std::format_to(std::back_inserter(col), "[0x{:X}]", prop.arrayDim);
     }
     else if (prop.isBitField)
     {
-        memberName += std::format(" : {:d}", prop.bitCount);
+        std::format_to(std::back_inserter(col), " : {:d}", prop.bitCount);
     }
+    col += ';';
 
     // 属性标志字符串（对标 Rei-Dumper 格式）
     std::string flagStr = StringifyPropertyFlags(prop.flags);
 
-    std::string comment;
     if (prop.isBitField)
     {
-        std::string bitInfo = std::format(
-            "BitIndex: 0x{:02X}, PropSize: 0x{:04X}",
-            prop.bitIndex, prop.size);
         if (!flagStr.empty())
         {
-            bitInfo += " (" + flagStr + ")";
+            AppendMemberLine(out, prop.typeName, col,
+                "0x{:04X}(0x{:04X})(BitIndex: 0x{:02X}, PropSize: 0x{:04X} ({}))",
+                prop.offset, prop.size, prop.bitIndex, prop.size, flagStr);
+        }
+        else
+        {
+            AppendMemberLine(out, prop.typeName, col,
+                "0x{:04X}(0x{:04X})(BitIndex: 0x{:02X}, PropSize: 0x{:04X})",
+                prop.offset, prop.size, prop.bitIndex, prop.size);
         }
-        comment = std::format(
-            "0x{:04X}(0x{:04X})({})",
-            prop.offset, prop.size, bitInfo);
     }
     else
     {
-        comment = std::format("0x{:04X}(0x{:04X})({})",
+        AppendMemberLine(out, prop.typeName, col,
+            "0x{:04X}(0x{:04X})({})",
             prop.offset, prop.size, flagStr);
     }
+}
 
-    return MakeMemberString(prop.typeName, memberName, comment);
+// AppendMembers 是否会产生输出（调用方需要在输出成员前决定 public: 等结构）
+// 每个属性都输出一行；无属性时仅在需要尾部填充时输出
+inline bool MembersProduceOutput(
+    const std::vector<PropertyInfo>& props,
+    i32 superSize,
+    i32 structSize)
+{
+    return !props.empty() || structSize > superSize;
 }
 
 // 生成带 padding 的完整成员列表
 // 对标 Dumper7 的 GenerateMembers：处理字节填充和位填充
-inline std::string GenerateMembers(
+inline void AppendMembers(
+    CodeBuilder& out,
     const std::vector<PropertyInfo>& props,
     i32 superSize,
     i32 structSize)
 {
-    std::string out;
-    out.reserve(props.size() * 128);
-
     i32 prevEnd = superSize;
     bool lastWasBitField = false;
     i32 prevBitEndBit = 0;
@@ -190,7 +233,7 @@ inline std::string GenerateMembers(
             i32 totalBits = prevBitSize * 8;
             if (prevBitEndBit < totalBits)
             {
-                out += GenerateBitPadding(
+                AppendBitPadding(out,
                     prevBitSize, prevBitEndBit, prevBitOffset,
                     totalBits - prevBitEndBit,
                     "Fixing Bit-Field Size For New Byte");
@@ -201,7 +244,7 @@ inline std::string GenerateMembers(
         // 字节填充
         if (prop.offset > prevEnd)
         {
-            out += GenerateBytePadding(
+            AppendBytePadding(out,
                 prevEnd, prop.offset - prevEnd,
                 "Fixing Size After Last Property");
         }
@@ -216,7 +259,7 @@ inline std::string GenerateMembers(
 
             if (prevBitEndBit < prop.bitIndex)
             {
-                out += GenerateBitPadding(
+                AppendBitPadding(out,
                     prop.size, prevBitEndBit, prop.offset,
                     prop.bitIndex - prevBitEndBit,
                     "Fixing Bit-Field Size Between Bits");
@@ -239,18 +282,16 @@ inline std::string GenerateMembers(
             prevEnd = memberEnd;
         }
 
-        out += FormatProperty(prop);
+        AppendProperty(out, prop);
     }
 
     // 结构体尾部填充
     if (structSize > prevEnd)
     {
-        out += GenerateBytePadding(
+        AppendBytePadding(out,
             prevEnd, structSize - prevEnd,
             "Fixing Struct Size After Last Property");
     }
-
-    return out;
 }
 
 } // namespace detail
@@ -8,7 +8,9 @@
 #include "dump_function_flags.hpp"
 #include "dump_sdk_format.hpp"
 #include <string>
+#include <string_view>
 #include <format>
+#include <iterator>
 
 namespace xrd
 {
@@ -28,9 +30,10 @@ inline std::string BuildParamMemberType(const FunctionParam& p)
     return type;
 }
 
-// 生成 _parameters.hpp 中单个函数的参数结构体
+// 追加 _parameters.hpp 中单个函数的参数结构体
 // 对标 Rei-Dumper：带偏移/大小注释、padding
-inline std::string GenerateParamStruct(
+inline void AppendParamStruct(
+    CodeBuilder& out,
     const std::string& pkgName,
     const std::string& className,
     const FunctionInfo& func)
@@ -38,47 +41,43 @@ inline std::string GenerateParamStruct(
     // 跳过包含垃圾数据的函数
     if (HasBinaryGarbage(func.name))
     {
-        return "";
+        return;
     }
     for (auto& p : func.params)
     {
         if (HasBinaryGarbage(p.typeName)
             || HasBinaryGarbage(p.name))
         {
-            return "";
+            return;
         }
     }
 
-    std::string out;
-    std::string structName = className + "_" + func.name;
-
     // 函数注释头（对标 Rei-Dumper: Package.ClassName.FuncName）
-    out += std::format("// Function {}.{}.{}\n",
+    out.Format("// Function {}.{}.{}\n",
         pkgName, className, func.name);
-    out += std::format("// 0x{:04X} (0x{:04X} - 0x{:04X})\n",
+    out.Format("// 0x{:04X} (0x{:04X} - 0x{:04X})\n",
         func.paramStructSize, func.paramStructSize, 0);
-    out += std::format("struct {} final\n{{\npublic:\n",
-        structName);
+    out.Format("struct {}_{} final\n{{\npublic:\n",
+        className, func.name);
 
-    // 使用 GenerateMembers 风格的 padding 生成
+    // 使用 AppendMembers 风格的 padding 生成
     i32 prevEnd = 0;
     for (auto& p : func.params)
     {
         // 字节填充
         if (p.offset > prevEnd)
         {
-            out += GenerateBytePadding(
+            AppendBytePadding(out,
                 prevEnd, p.offset - prevEnd,
                 "Fixing Size After Last Property");
         }
 
-        std::string flagStr = StringifyPropertyFlags(p.flags);
-        std::string comment = std::format(
+        std::string& col = out.Scratch();
+        col += p.name;
+        col += ';';
+        AppendMemberLine(out, BuildParamMemberType(p), col,
             "0x{:04X}(0x{:04X})({})",
-            p.offset, p.size, flagStr);
-
-        out += MakeMemberString(
-            BuildParamMemberType(p), p.name, comment);
+            p.offset, p.size, StringifyPropertyFlags(p.flags));
         prevEnd = p.offset + p.size;
     }
 
@@ -86,26 +85,27 @@ inline std::string GenerateParamStruct(
     if (func.paramStructSize > prevEnd
         && func.paramStructSize > 0)
     {
-        out += GenerateBytePadding(
+        AppendBytePadding(out,
             prevEnd, func.paramStructSize - prevEnd,
             "Fixing Struct Size After Last Property");
     }
 
     out += "};\n";
-    out += std::format("#ifdef DUMPER7_ASSERTS_{}\n", structName);
-    out += std::format("DUMPER7_ASSERTS_{};\n", structName);
+    out.Format("#ifdef DUMPER7_ASSERTS_{}_{}\n", className, func.name);
+    out.Format("DUMPER7_ASSERTS_{}_{};\n", className, func.name);
     out += "#endif\n\n";
-
-    return out;
 }
 
-// 生成 _functions.cpp 中单个函数的实现
+// 追加 _functions.cpp 中单个函数的实现
 // 对标 Rei-Dumper：完整注释头、参数描述、Native 标志保存/恢复
-inline std::string GenerateFunctionImpl(
+// funcName 为输出用名称（与属性名冲突时带下划线后缀）
+inline void AppendFunctionImpl(
+    CodeBuilder& out,
     const std::string& pkgName,
     const std::string& className,
     const std::string& prefixedClassName,
     const FunctionInfo& func,
+    std::string_view funcName,
     bool isInterface,
     const std::string& collisionNs = "")
 {
@@ -113,7 +113,7 @@ inline std::string GenerateFunctionImpl(
     if (HasBinaryGarbage(func.name)
         || HasBinaryGarbage(func.returnType))
     {
-        return "";
+        return;
     }
     for (auto& p : func.params)
     {
@@ -121,59 +121,52 @@ inline std::string GenerateFunctionImpl(
             || HasBinaryGarbage(p.name)
             || HasBinaryGarbage(p.typeName))
         {
-            return "";
+            return;
         }
     }
 
-    std::string out;
     bool isNative = (func.functionFlags & 0x00000400) != 0;
     bool isStatic = (func.functionFlags & 0x00002000) != 0;
     bool isConst = (func.functionFlags & EFuncFlags::Const) != 0
         && !isStatic;
     bool hasParams = !func.params.empty();
 
-    // 冲突包使用命名空间限定名
-    std::string qualifiedClass = collisionNs.empty()
-        ? prefixedClassName
-        : (collisionNs + "::" + prefixedClassName);
-
     // 函数全名注释（对标 Rei-Dumper: Package.ClassName.FuncName）
-    out += std::format("// Function {}.{}.{}\n",
-        pkgName, className, func.name);
+    out.Format("// Function {}.{}.{}\n",
+        pkgName, className, funcName);
     // 函数标志注释
-    out += std::format("// ({})\n",
+    out.Format("// ({})\n",
         StringifyFunctionFlags(func.functionFlags));
 
     // 参数描述注释（对标 Rei-Dumper 的 40/55 列对齐）
+    // 类型为签名中的类型（含 const/&/*）
     if (hasParams)
     {
         out += "// Parameters:\n";
         for (auto& p : func.params)
         {
-            std::string flagStr =
-                StringifyPropertyFlags(p.flags);
-            // 对标 Rei-Dumper：签名中的类型（含 const/&/*）
-            std::string dispType = p.sigTypeName;
-            out += std::format("// {:{}}{:{}}({})\n",
-                dispType, 40, p.name, 55, flagStr);
+            out.Format("// {:{}}{:{}}({})\n",
+                p.sigTypeName, 40, p.name, 55,
+                StringifyPropertyFlags(p.flags));
         }
     }
     out += "\n";
 
-    // 函数签名（对标 Rei-Dumper 格式）
-    out += func.returnType + " " + qualifiedClass
-        + "::" + func.name + "(";
+    // 函数签名（对标 Rei-Dumper 格式），冲突包使用命名空间限定名
+    out.Format("{} {}{}{}::{}(", func.returnType,
+        collisionNs, collisionNs.empty() ? "" : "::",
+        prefixedClassName, funcName);
 
     bool first = true;
     for (auto& p : func.params)
     {
         if (p.isReturnParam) continue;
         if (!first) out += ", ";
-        out += p.sigTypeName + " " + p.name;
+        out.Format("{} {}", p.sigTypeName, p.name);
         first = false;
     }
 
-    out += ")";
+    out += ')';
     if (isConst)
     {
         out += " const";
@@ -185,27 +178,11 @@ inline std::string GenerateFunctionImpl(
     out += "\tif (Func == nullptr)\n";
 
     // GetFunction 调用
-    if (isInterface)
-    {
-        out += std::format(
-            "\t\tFunc = AsUObject()->Class->"
-            "GetFunction(\"{}\", \"{}\");\n",
-            className, func.name);
-    }
-    else if (isStatic)
-    {
-        out += std::format(
-            "\t\tFunc = StaticClass()->"
-            "GetFunction(\"{}\", \"{}\");\n",
-            className, func.name);
-    }
-    else
-    {
-        out += std::format(
-            "\t\tFunc = Class->"
-            "GetFunction(\"{}\", \"{}\");\n",
-            className, func.name);
-    }
+    std::string_view funcOwner = isInterface
+        ? "AsUObject()->Class->"
+        : (isStatic ? "StaticClass()->" : "Class->");
+    out.Format("\t\tFunc = {}GetFunction(\"{}\", \"{}\");\n",
+        funcOwner, className, funcName);
 
     // 参数结构体创建
     bool hasParamsToInit = false;
@@ -215,11 +192,8 @@ inline std::string GenerateFunctionImpl(
 
     if (hasParams)
     {
-        std::string paramStructName =
-            className + "_" + func.name;
-        out += std::format(
-            "\n\tParams::{} Parms{{}};\n",
-            paramStructName);
+        out.Format("\n\tParams::{}_{} Parms{{}};\n",
+            className, funcName);
 
         for (auto& p : func.params)
         {
@@ -230,7 +204,7 @@ inline std::string GenerateFunctionImpl(
                 // out-ptr 参数在调用后处理
                 if (p.isMoveType)
                 {
-                    outPtrAssignments += std::format(
+                    std::format_to(std::back_inserter(outPtrAssignments),
                         R"(
 
 	if ({0} != nullptr)
@@ -239,7 +213,7 @@ inline std::string GenerateFunctionImpl(
                 }
                 else
                 {
-                    outPtrAssignments += std::format(
+                    std::format_to(std::back_inserter(outPtrAssignments),
                         R"(
 
 	if ({0} != nullptr)
@@ -252,13 +226,12 @@ inline std::string GenerateFunctionImpl(
             // 普通参数赋值
             if (p.isMoveType)
             {
-                paramAssignments += std::format(
-                    "\tParms.{0} = std::move({0});\n",
-                    p.name);
+                std::format_to(std::back_inserter(paramAssignments),
+                    "\tParms.{0} = std::move({0});\n", p.name);
             }
             else
             {
-                paramAssignments += std::format(
+                std::format_to(std::back_inserter(paramAssignments),
                     "\tParms.{0} = {0};\n", p.name);
             }
             hasParamsToInit = true;
@@ -268,13 +241,12 @@ inline std::string GenerateFunctionImpl(
             {
                 if (p.isMoveType)
                 {
-                    outRefAssignments += std::format(
-                        "\n\t{0} = std::move(Parms.{0});",
-                        p.name);
+                    std::format_to(std::back_inserter(outRefAssignments),
+                        "\n\t{0} = std::move(Parms.{0});", p.name);
                 }
                 else
                 {
-                    outRefAssignments += std::format(
+                    std::format_to(std::back_inserter(outRefAssignments),
                         "\n\t{0} = Parms.{0};", p.name);
                 }
             }
@@ -282,7 +254,8 @@ inline std::string GenerateFunctionImpl(
 
         if (hasParamsToInit)
         {
-            out += "\n" + paramAssignments;
+            out += "\n";
+            out += paramAssignments;
         }
     }
 
@@ -307,7 +280,7 @@ inline std::string GenerateFunctionImpl(
     {
         out += "UObject::";
     }
-    out += std::format("ProcessEvent(Func, {});\n",
+    out.Format("ProcessEvent(Func, {});\n",
         hasParams ? "&Parms" : "nullptr");
 
     // 恢复 FunctionFlags
@@ -319,13 +292,15 @@ inline std::string GenerateFunctionImpl(
     // out-ref 参数回写
     if (!outRefAssignments.empty())
     {
-        out += outRefAssignments + "\n";
+        out += outRefAssignments;
+        out += '\n';
     }
 
     // out-ptr 参数回写
     if (!outPtrAssignments.empty())
     {
-        out += outPtrAssignments + "\n";
+        out += outPtrAssignments;
+        out += '\n';
     }
 
     // 返回值
@@ -339,48 +314,45 @@ inline std::string GenerateFunctionImpl(
     }
 
     out += "}\n\n";
-    return out;
 }
 
-// 生成断言宏定义（追加到 Assertions.inl）
+// 追加断言宏定义（Assertions.inl）
 // assertName 可以是 "UClassName" 或 "PkgName__UClassName"
 // typeName 是实际 C++ 类型名（可能含 ::）
-inline std::string GenerateAssertionMacro(
-    const std::string& assertName,
-    const std::string& typeName,
+inline void AppendAssertionMacro(
+    CodeBuilder& out,
+    std::string_view assertName,
+    std::string_view typeName,
     i32 size,
     i32 alignment = 0x08)
 {
-    std::string out;
-    out += std::format(
+    out.Format(
         "#define DUMPER7_ASSERTS_{} \\\n", assertName);
-    out += std::format(
+    out.Format(
         "static_assert(alignof({}) == 0x{:06X}, "
         "\"Wrong alignment on {}\"); \\\n",
         typeName, alignment, assertName);
-    out += std::format(
+    out.Format(
         "static_assert(sizeof({}) == 0x{:06X}, "
         "\"Wrong size on {}\"); \\\n",
         typeName, size > 0 ? size : 1, assertName);
     out += "\n";
-    return out;
 }
 
 // 参数结构体断言宏（仅校验 sizeof，避免不稳定的 align 误报）
-inline std::string GenerateParamAssertionMacro(
-    const std::string& assertName,
-    const std::string& typeName,
+inline void AppendParamAssertionMacro(
+    CodeBuilder& out,
+    std::string_view assertName,
+    std::string_view typeName,
     i32 size)
 {
-    std::string out;
-    out += std::format(
+    out.Format(
         "#define DUMPER7_ASSERTS_{} \\\n", assertName);
-    out += std::format(
+    out.Format(
         "static_assert(sizeof({}) == 0x{:06X}, "
         "\"Wrong size on {}\"); \\\n",
         typeName, size > 0 ? size : 1, assertName);
     out += "\n";
-    return out;
 }
 
 } // namespace detail
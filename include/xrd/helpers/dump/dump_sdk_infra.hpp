@@ -2,6 +2,7 @@
 // Xrd-eXternalrEsolve - SDK 导出：基础设施文件生成
 // 生成 Basic.hpp / Basic.cpp / SDK.hpp / 辅助文件
 // 调用 gen/ 下的各模块完成 Rei-Dumper 格式对齐
+// 各文件在内存中构建完整内容后交给 SdkFileWriter 后台写入
 
 #include "../../core/context.hpp"
 #include "gen/gen_basic_types.hpp"
@@ -12,7 +13,8 @@
 #include "gen/gen_basic_ffield.hpp"
 #include "gen/gen_auxiliary.hpp"
 #include "gen/gen_containers.hpp"
-#include <fstream>
+#include "dump_file_writer.hpp"
+#include <sstream>
 #include <string>
 #include <format>
 #include <vector>
@@ -25,14 +27,11 @@ namespace detail
 
 // 生成 Basic.hpp — 完整对标 Rei-Dumper 1262 行格式
 // 调用 gen/ 下各模块按顺序写入
-inline void GenerateBasicHpp(const std::wstring& sdkDir)
+inline void GenerateBasicHpp(
+    SdkFileWriter& out,
+    const std::wstring& sdkDir)
 {
-    std::wstring path = sdkDir + L"/Basic.hpp";
-    std::ofstream f(path);
-    if (!f.is_open())
-    {
-        return;
-    }
+    std::ostringstream f;
 
     // 第一部分：文件头、Offsets、InSDKUtils、前置声明、StaticClass 宏
     gen::WriteBasicHeader(f);
@@ -61,19 +60,16 @@ inline void GenerateBasicHpp(const std::wstring& sdkDir)
     // CyclicDependencyFixup 和命名空间闭合
     gen::WriteCyclicFixupAndClose(f);
 
-    f.close();
+    out.Submit(sdkDir + L"/Basic.hpp", f.str());
 }
 
 // 生成 Basic.cpp — 对标 Rei-Dumper Basic.cpp
 // 包含 GetImageBase / FindClassByName / UObject 方法实现
-inline void GenerateBasicCpp(const std::wstring& sdkDir)
+inline void GenerateBasicCpp(
+    SdkFileWriter& out,
+    const std::wstring& sdkDir)
 {
-    std::wstring path = sdkDir + L"/Basic.cpp";
-    std::ofstream f(path);
-    if (!f.is_open())
-    {
-        return;
-    }
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -213,21 +209,17 @@ bool FWeakObjectPtr::operator!=(const class UObject* Other) const
 
 )";
 
-    f.close();
+    out.Submit(sdkDir + L"/Basic.cpp", f.str());
 }
 
 // 生成 SDK.hpp — 主 include 文件，放在 CppSDK/ 层级
 // include 路径指向 SDK/ 子目录
 inline void GenerateSdkHpp(
+    SdkFileWriter& out,
     const std::wstring& cppSdkDir,
     const std::vector<std::string>& packageIncludes)
 {
-    std::wstring path = cppSdkDir + L"/SDK.hpp";
-    std::ofstream f(path);
-    if (!f.is_open())
-    {
-        return;
-    }
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -249,20 +241,55 @@ inline void GenerateSdkHpp(
     }
 
     f << "\n";
-    f.close();
+    out.Submit(cppSdkDir + L"/SDK.hpp", f.str());
+}
+
+// 生成 SDK_fwd.hpp — 全部包的前向声明，放在 CppSDK/ 层级
+// 只含 Basic.hpp 与各包 _fwd.hpp：下游头文件 include 它代替 SDK.hpp；
+// SDK.hpp 与本文件都不依赖 include 方的宏，可直接作为预编译头
+inline void GenerateSdkFwdHpp(
+    SdkFileWriter& out,
+    const std::wstring& cppSdkDir,
+    const std::vector<std::string>& fwdIncludes)
+{
+    std::ostringstream f;
+
+    f << R"(#pragma once
+
+/*
+* SDK generated by Xrd-eXternalrEsolve
+* Based on Dumper-7
+*
+* https://github.com/Encryqed/Dumper-7
+*/
+
+// Forward declarations of every SDK type (enums are opaque declarations and therefore complete).
+// Include SDK.hpp or the individual <Package>_classes.hpp / _structs.hpp where full definitions are needed.
+
+#include "SDK/Basic.hpp"
+)";
+
+    for (auto& inc : fwdIncludes)
+    {
+        f << "#include \"SDK/" << inc << "\"\n";
+    }
+
+    f << "\n";
+    out.Submit(cppSdkDir + L"/SDK_fwd.hpp", f.str());
 }
 
-// 生成辅助文件（PropertyFixup / NameCollisions / Assertions / Containers）
+// 生成辅助文件（PropertyFixup / NameCollisions / Containers）
+// Assertions.inl 由调用方以 gen::BuildAssertionsHeader 为开头拼接后提交
 inline void GenerateAuxiliaryFiles(
+    SdkFileWriter& out,
     const std::wstring& cppSdkDir,
     const std::map<std::string, std::string>& collisionNsMap,
     const std::vector<detail::StructEntry>& entries)
 {
-    gen::GeneratePropertyFixup(cppSdkDir);
-    gen::GenerateNameCollisions(cppSdkDir, collisionNsMap, entries);
-    gen::GenerateAssertionsHeader(cppSdkDir);
-    gen::GenerateUtfN(cppSdkDir);
-    gen::GenerateUnrealContainers(cppSdkDir);
+    gen::GeneratePropertyFixup(out, cppSdkDir);
+    gen::GenerateNameCollisions(out, cppSdkDir, collisionNsMap, entries);
+    gen::GenerateUtfN(out, cppSdkDir);
+    gen::GenerateUnrealContainers(out, cppSdkDir);
 }
 
 } // namespace detail
@@ -0,0 +1,194 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：布局修正阶段
+// 采集之后、分包生成之前执行，只依赖条目元数据与成员摘要，不做远程读取
+// 结果写回 StructEntry / EnumInfo 的派生字段，之后跨包布局只需这些常驻元数据
+// 成员摘要在采集时由 SummarizeEntryMembers 填写；加载的模型在此由缓存补齐
+// 从 dump_sdk.hpp 拆分
+
+#include "dump_prefix.hpp"
+#include "dump_enum.hpp"
+#include "dump_collect.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 由属性/函数缓存填写条目的成员摘要（见 StructEntry），已填写时直接返回
+// 只写入 e 自身，采集线程可对不同条目并发调用
+inline void SummarizeEntryMembers(StructEntry& e)
+{
+    if (e.membersSummarized)
+    {
+        return;
+    }
+    const auto& props = CollectProperties(e.addr);
+    e.hasMembers = !props.empty();
+    e.membersEnd = e.superSize;
+    e.minMemberOffset = e.size;
+    e.memberRefs.clear();
+    e.paramRefs.clear();
+    e.enumMemberSizes.clear();
+
+    std::unordered_set<i32> seen;
+    for (auto& pi : props)
+    {
+        e.membersEnd = (std::max)(e.membersEnd, pi.offset + pi.size * pi.arrayDim);
+        e.minMemberOffset = (std::min)(e.minMemberOffset, pi.offset);
+        for (auto& r : pi.typeRefs)
+        {
+            if (seen.insert(r.index).second)
+            {
+                e.memberRefs.push_back(r.index);
+            }
+        }
+        // EnumProperty 的 typeName 即枚举名；ByteProperty 关联枚举时 typeName 不是 "uint8"
+        const std::string& fc = pi.fieldClassName;
+        const std::string& typeName = pi.typeName;
+        if (pi.size > 0 && (fc == "EnumProperty"
+            || (fc == "ByteProperty" && typeName != "uint8")))
+        {
+            e.enumMemberSizes.push_back({typeName, static_cast<u8>(pi.size)});
+        }
+    }
+
+    if (e.isClass)
+    {
+        seen.clear();
+        for (auto& fn : CollectFunctions(e.addr))
+        {
+            for (auto& p : fn.params)
+            {
+                for (auto& r : p.typeRefs)
+                {
+                    if (seen.insert(r.index).second)
+                    {
+                        e.paramRefs.push_back(r.index);
+                    }
+                }
+            }
+        }
+    }
+    e.membersSummarized = true;
+}
+
+// 对标 Rei-Dumper InitSizesAndIsFinal：
+// 计算 lastMemberEnd / unalignedSize / bHasReusedTrailingPadding
+// 当子类属性侵入父类尾部 padding 时，需要用 #pragma pack(push, 0x1) + alignas
+inline void ComputeTrailingPadding(std::vector<StructEntry>& entries)
+{
+    // 第一遍：补齐成员摘要，计算每个 entry 的 lastMemberEnd
+    for (auto& e : entries)
+    {
+        SummarizeEntryMembers(e);
+        if (e.isInterfaceChild) continue;
+
+        if (!e.hasMembers)
+        {
+            e.lastMemberEnd = e.superSize;
+            e.unalignedSize = e.size;
+            continue;
+        }
+
+        e.lastMemberEnd = e.membersEnd;
+        // unalignedSize 初始等于 aligned size，
+        // 只有被检测到 bHasReusedTrailingPadding 时才被缩短
+        e.unalignedSize = e.size;
+    }
+
+    // 建立可修改的 name → StructEntry* 映射
+    std::unordered_map<std::string, StructEntry*>
+        mutableLookup;
+    for (auto& e : entries)
+    {
+        mutableLookup[e.name] = &e;
+    }
+
+    // 第二遍：检测子类是否侵入父类尾部 padding
+    for (auto& e : entries)
+    {
+        if (e.isInterfaceChild || e.superName.empty() || !e.hasMembers) continue;
+
+        // 最小的属性偏移
+        i32 minPropOffset = e.minMemberOffset;
+
+        // 如果子类最小属性偏移 < 父类 aligned size，说明侵入了父类尾部 padding
+        if (minPropOffset < e.superSize)
+        {
+            // 在父类 entry 中标记 bHasReusedTrailingPadding
+            auto superIt = mutableLookup.find(e.superName);
+            if (superIt != mutableLookup.end())
+            {
+                auto* superEntry = superIt->second;
+                // 父类的 unalignedSize 应缩短到子类最小属性偏移处
+                if (!superEntry->bHasReusedTrailingPadding
+                    || minPropOffset < superEntry->unalignedSize)
+                {
+                    superEntry->bHasReusedTrailingPadding = true;
+                    superEntry->unalignedSize = minPropOffset;
+                }
+            }
+        }
+    }
+    // 第三遍：计算 bCanSkipTrailingPad
+    // packed 类如果 Align(lastMemberEnd, alignment) == size，
+    // 说明 alignas 足以提供 trailing pad，不需要显式 trailing pad 成员
+    // 此时子类可从 lastMemberEnd 开始生成显式 pad
+    for (auto& e : entries)
+    {
+        if (e.isInterfaceChild || e.bHasReusedTrailingPadding)
+            continue;
+        // 只对 class 生效：class 的 bUseExplicitAlignment 同时控制 #pragma pack
+        // struct 的 pack 由 bHasReusedTrailingPadding 控制，不在此处理
+        if (!e.isClass || !e.bUseExplicitAlignment)
+            continue;
+        i32 a = e.alignment > 0 ? e.alignment : 1;
+        i32 aligned = (e.lastMemberEnd + a - 1) & ~(a - 1);
+        if (aligned == e.size)
+        {
+            e.bCanSkipTrailingPad = true;
+        }
+    }
+}
+
+// 从成员摘要中检测枚举底层类型大小
+// 对标 Rei-Dumper：遍历所有 ByteProperty/EnumProperty，用 ElementSize 确定枚举大小
+inline void DetectEnumUnderlyingSizes(
+    std::vector<EnumInfo>& enums,
+    std::vector<StructEntry>& entries)
+{
+    // 建立 enum 名 → EnumInfo* 的查找表
+    std::unordered_map<std::string, std::vector<EnumInfo*>> enumByName;
+    for (auto& ei : enums)
+    {
+        enumByName[ei.name].push_back(&ei);
+    }
+
+    for (auto& e : entries)
+    {
+        SummarizeEntryMembers(e);
+        for (auto& [enumName, size] : e.enumMemberSizes)
+        {
+            auto eit = enumByName.find(enumName);
+            if (eit == enumByName.end())
+            {
+                continue;
+            }
+            for (auto* ep : eit->second)
+            {
+                if (size > ep->underlyingTypeSize)
+                {
+                    ep->underlyingTypeSize = size;
+                }
+            }
+        }
+    }
+}
+
+} // namespace detail
+} // namespace xrd
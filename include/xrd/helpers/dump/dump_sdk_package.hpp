@@ -0,0 +1,232 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：单包代码生成
+// 把一个包的 _structs/_classes/_functions/_parameters/_fwd 与断言文本生成到内存
+// 只读访问查找表与属性/函数缓存，可在工作线程中并行执行
+// 从 dump_sdk.hpp 拆分，保持单文件 300 行以内
+
+#include "dump_sdk_writer.hpp"
+#include "dump_dep_sort.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace xrd
+{
+
+inline std::string CleanPackageName(const std::string& raw);
+
+namespace detail
+{
+
+// 单个包的生成结果（文本为空表示不需要该文件）
+struct PackageOutput
+{
+    std::string sanitized;
+    std::string structsText;
+    std::string classesText;
+    std::string functionsText;
+    std::string paramsText;
+    std::string fwdText;
+    std::string assertText;
+    bool hasStructsFile = false;
+    bool hasClasses = false;
+    bool hasFwdFile = false;
+    bool unchanged = false; // 增量导出：输入哈希未变，仅生成了断言文本
+    u64 inputHash = 0;
+    double seconds = 0.0;
+    u64 bufferAllocs = 0; // 本包代码生成的 CodeBuilder 块分配次数
+    u32 typeCount = 0;    // 本包生成的结构体/类/枚举数量
+};
+
+// 生成阶段共享的只读数据（由 GenerateCppSdk 在分发前准备好）
+struct PackageGenContext
+{
+    const HashOrderMap<std::vector<const StructEntry*>>& pkgMap;
+    const HashOrderMap<std::vector<EnumInfo>>& enumsByPkgIdx;
+    const std::unordered_map<i32, PackageDeps>& structsDeps;
+    const std::unordered_map<i32, PackageDeps>& classesDeps;
+    const std::unordered_map<i32, PackageDeps>& paramsDeps;
+    const std::unordered_map<i32, std::string>& pkgIdxToSanitized;
+    const std::unordered_map<i32, std::string>& pkgIdxToOuter;
+    const std::unordered_set<i32>& pkgsWithStructs;
+    bool forwardDecls = false; // 生成 _fwd.hpp，依赖按 SdkDumpOptions::forwardDeclarations 收集
+};
+
+// 生成单个包
+// assertionsOnly 为 true 时只生成断言文本与文件存在标记（增量导出跳过未变化的包）
+inline PackageOutput BuildPackageOutput(
+    const PackageGenContext& ctx, i32 pkgIdx,
+    bool assertionsOnly = false)
+{
+    auto tp = std::chrono::steady_clock::now();
+    u64 allocsBefore = CodeBuilder::ThreadAllocations();
+    PackageOutput out;
+    auto sit0 = ctx.pkgIdxToSanitized.find(pkgIdx);
+    if (sit0 != ctx.pkgIdxToSanitized.end())
+    {
+        out.sanitized = sit0->second;
+    }
+    auto oit = ctx.pkgIdxToOuter.find(pkgIdx);
+    std::string outerName = (oit != ctx.pkgIdxToOuter.end())
+        ? oit->second : "Unknown";
+    std::string cleanPkg = CleanPackageName(outerName);
+
+    auto structIt = ctx.pkgMap.find(pkgIdx);
+    auto enumIt   = ctx.enumsByPkgIdx.find(pkgIdx);
+
+    std::vector<const StructEntry*> classes;
+    std::vector<const StructEntry*> structs;
+    if (structIt != ctx.pkgMap.end())
+    {
+        for (auto* e : structIt->second)
+        {
+            if (e->isClass)
+            {
+                classes.push_back(e);
+            }
+            else
+            {
+                structs.push_back(e);
+            }
+        }
+    }
+
+    // 对标 Rei-Dumper：包内按依赖拓扑排序
+    structs = TopoSortEntries(structs);
+    classes = TopoSortEntries(classes);
+
+    std::vector<EnumInfo> emptyEnums;
+    const auto& pkgEnums = (enumIt != ctx.enumsByPkgIdx.end())
+        ? enumIt->second : emptyEnums;
+
+    bool hasStructsFile = !structs.empty()
+        || !pkgEnums.empty();
+    out.hasStructsFile = hasStructsFile;
+    out.hasClasses = !classes.empty();
+    out.hasFwdFile = ctx.forwardDecls && (hasStructsFile || out.hasClasses);
+    out.assertText = BuildAssertions(structs, classes);
+    if (assertionsOnly)
+    {
+        out.unchanged = true;
+        out.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - tp).count();
+        return out;
+    }
+
+    // 获取依赖
+    PackageDeps sDeps, cDeps, pDeps;
+    auto sit = ctx.structsDeps.find(pkgIdx);
+    if (sit != ctx.structsDeps.end())
+    {
+        sDeps = sit->second;
+    }
+    auto cit = ctx.classesDeps.find(pkgIdx);
+    if (cit != ctx.classesDeps.end())
+    {
+        cDeps = cit->second;
+    }
+    if (ctx.forwardDecls)
+    {
+        // 参数结构体只按值引用 struct/enum，依赖已单独收集
+        auto pit = ctx.paramsDeps.find(pkgIdx);
+        if (pit != ctx.paramsDeps.end())
+        {
+            pDeps = pit->second;
+        }
+    }
+    else
+    {
+        // parameters 文件的依赖 = structs 依赖 ∪ classes 依赖
+        // 因为函数参数可能引用任意 struct/class/enum
+        // 对标 Rei-Dumper：parameters include 是 structs+classes 的超集
+        pDeps = sDeps;
+        for (auto& [depIdx, info] : cDeps.deps)
+        {
+            auto& pInfo = pDeps.deps[depIdx];
+            if (info.needStructs) pInfo.needStructs = true;
+            if (info.needClasses) pInfo.needClasses = true;
+        }
+    }
+
+    // 检查类是否依赖同包的结构体或枚举
+    // _structs.hpp 同时包含结构体和枚举定义
+    // 需要同时检查两者的依赖
+    bool classesNeedOwnStructs = false;
+    bool classesNeedOwnFwd = false;
+    if (hasStructsFile && !classes.empty())
+    {
+        // 同包结构体与枚举的 GObjects 索引（两者都在 _structs.hpp 中）
+        std::unordered_set<i32> ownIndices;
+        for (auto* s : structs)
+        {
+            ownIndices.insert(s->objIndex);
+        }
+        for (auto& ei : pkgEnums)
+        {
+            ownIndices.insert(ei.objIndex);
+        }
+        for (auto* cls : classes)
+        {
+            const auto& props = CollectProperties(cls->addr);
+            for (auto& p : props)
+            {
+                for (auto& r : p.typeRefs)
+                {
+                    if (ownIndices.count(r.index))
+                    {
+                        classesNeedOwnStructs = true;
+                        break;
+                    }
+                }
+                if (classesNeedOwnStructs) break;
+            }
+            if (classesNeedOwnStructs) break;
+        }
+        // 函数签名中的同包 struct/enum 只需前向声明
+        for (size_t i = 0; i < classes.size() && ctx.forwardDecls
+            && !classesNeedOwnStructs && !classesNeedOwnFwd; ++i)
+        {
+            for (auto& fn : CollectFunctions(classes[i]->addr))
+            {
+                for (auto& p : fn.params)
+                {
+                    for (auto& r : p.typeRefs)
+                    {
+                        classesNeedOwnFwd = classesNeedOwnFwd || ownIndices.count(r.index);
+                    }
+                }
+            }
+        }
+    }
+    if (classesNeedOwnFwd)
+    {
+        cDeps.fwd.insert(pkgIdx);
+    }
+
+    out.structsText = BuildStructsFile(cleanPkg,
+        structs, pkgEnums, sDeps, ctx.pkgIdxToSanitized,
+        &ctx.pkgsWithStructs);
+    out.classesText = BuildClassesFile(out.sanitized,
+        cleanPkg, classes, cDeps, ctx.pkgIdxToSanitized,
+        hasStructsFile, classesNeedOwnStructs,
+        &ctx.pkgsWithStructs);
+    out.functionsText = BuildFunctionsFile(
+        out.sanitized, cleanPkg, classes);
+    out.paramsText = BuildParametersFile(cleanPkg,
+        classes, pDeps, ctx.pkgIdxToSanitized, &ctx.pkgsWithStructs);
+    if (out.hasFwdFile)
+    {
+        out.fwdText = BuildForwardFile(cleanPkg, structs, classes, pkgEnums);
+    }
+    out.bufferAllocs = CodeBuilder::ThreadAllocations() - allocsBefore;
+    out.typeCount = static_cast<u32>(
+        structs.size() + classes.size() + pkgEnums.size());
+    out.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - tp).count();
+    return out;
+}
+
+} // namespace detail
+} // namespace xrd
@@ -1,6 +1,6 @@
 #pragma once
 // Xrd-eXternalrEsolve - SDK 导出：结构体/类/枚举生成
-// 生成单个 struct/class/enum 的 C++ 代码文本
+// 将单个 struct/class/enum 的 C++ 代码直接追加到 CodeBuilder
 // 对标 Rei-Dumper 的 _classes.hpp / _structs.hpp 格式
 
 #include "dump_sdk_format.hpp"
@@ -10,6 +10,7 @@
 #include "dump_function_flags.hpp"
 #include "gen/gen_struct_predefined.hpp"
 #include <string>
+#include <string_view>
 #include <format>
 #include <vector>
 #include <unordered_map>
@@ -20,330 +21,316 @@ namespace xrd
 namespace detail
 {
 
-// 生成函数签名字符串（用于 _classes.hpp 中的声明）
-inline std::string FormatFunctionDeclaration(
-    const FunctionInfo& func)
+// 追加函数签名（用于 _classes.hpp 中的声明）
+// renamed：函数名与属性名冲突时输出带下划线后缀的名称
+inline void AppendFunctionDeclaration(
+    CodeBuilder& out,
+    const FunctionInfo& func,
+    bool renamed)
 {
     // 跳过包含垃圾数据的函数签名
     if (HasBinaryGarbage(func.returnType)
         || HasBinaryGarbage(func.name))
     {
-        return "";
+        return;
     }
     for (auto& p : func.params)
     {
         if (HasBinaryGarbage(p.sigTypeName)
             || HasBinaryGarbage(p.name))
         {
-            return "";
+            return;
         }
     }
 
-    std::string sig = "\t";
+    out += '\t';
     bool isStatic = (func.functionFlags & 0x00002000) != 0;
     bool isConst = (func.functionFlags & EFuncFlags::Const) != 0
         && !isStatic;
     if (isStatic)
     {
-        sig += "static ";
+        out += "static ";
     }
-    sig += func.returnType + " " + func.name + "(";
+    out.Format("{} {}{}(", func.returnType, func.name,
+        renamed ? "_" : "");
     bool first = true;
     for (auto& p : func.params)
     {
         if (p.isReturnParam) continue;
-        if (!first) sig += ", ";
-        sig += p.sigTypeName + " " + p.name;
+        if (!first) out += ", ";
+        out.Format("{} {}", p.sigTypeName, p.name);
         first = false;
     }
-    sig += ")";
+    out += ')';
     if (isConst)
     {
-        sig += " const";
+        out += " const";
     }
-    sig += ";\n";
-    return sig;
+    out += ";\n";
 }
 
-// 生成单个枚举的 C++ 代码（用于 _structs.hpp）
-inline std::string GenerateEnumCode(const EnumInfo& ei)
+// 枚举的底层类型名：根据 underlyingTypeSize 确定（对标 Rei-Dumper）
+inline const char* EnumUnderlyingTypeName(const EnumInfo& ei)
 {
-    static std::unordered_map<std::string, bool> globalEnumNames;
-    static std::unordered_set<std::string> illegalNames = {
+    static constexpr const char* kEnumTypeBySize[] = {
+        "uint8", "uint16", "InvalidEnumSize", "uint32",
+        "InvalidEnumSize", "InvalidEnumSize", "InvalidEnumSize", "uint64"
+    };
+    return (ei.underlyingTypeSize >= 1 && ei.underlyingTypeSize <= 8)
+        ? kEnumTypeBySize[ei.underlyingTypeSize - 1] : "uint8";
+}
+
+// 追加枚举的 opaque 声明（用于 _fwd.hpp），与 AppendEnumCode 的名称和底层类型一致
+inline void AppendEnumForwardDecl(CodeBuilder& out, const EnumInfo& ei)
+{
+    bool needPrefix = !ei.name.empty() && ei.name[0] != 'E';
+    out.Format("enum class {}{} : {};\n",
+        needPrefix ? "E" : "", ei.name, EnumUnderlyingTypeName(ei));
+}
+
+// 追加单个枚举的 C++ 代码（用于 _structs.hpp）
+inline void AppendEnumCode(CodeBuilder& out, const EnumInfo& ei)
+{
+    static const std::unordered_set<std::string> illegalNames = {
         "IN", "OUT", "TRUE", "FALSE", "DELETE",
         "PF_MAX", "SW_MAX", "MM_MAX", "SIZE_MAX",
         "RELATIVE", "TRANSPARENT", "NO_ERROR",
         "EVENT_MAX", "IGNORE"
     };
 
-    std::string out;
-    out += std::format("// Enum {}.{}\n",
+    out.Format("// Enum {}.{}\n",
         StripPackagePrefix(ei.outerName), ei.name);
-    out += std::format("// NumValues: 0x{:04X}\n",
+    out.Format("// NumValues: 0x{:04X}\n",
         ei.members.size());
-    // 根据 underlyingTypeSize 确定底层类型（对标 Rei-Dumper）
-    static constexpr const char* kEnumTypeBySize[] = {
-        "uint8", "uint16", "InvalidEnumSize", "uint32",
-        "InvalidEnumSize", "InvalidEnumSize", "InvalidEnumSize", "uint64"
-    };
-    const char* enumType = (ei.underlyingTypeSize >= 1 && ei.underlyingTypeSize <= 8)
-        ? kEnumTypeBySize[ei.underlyingTypeSize - 1] : "uint8";
+    const char* enumType = EnumUnderlyingTypeName(ei);
     // 对标 Rei-Dumper：枚举名不以 E 开头时加 E 前缀
-    std::string enumName = ei.name;
-    if (!enumName.empty() && enumName[0] != 'E')
-    {
-        enumName = "E" + enumName;
-    }
-    out += std::format("enum class {} : {}\n{{\n",
-        enumName, enumType);
+    bool needPrefix = !ei.name.empty() && ei.name[0] != 'E';
+    out.Format("enum class {}{} : {}\n{{\n",
+        needPrefix ? "E" : "", ei.name, enumType);
 
-    std::vector<std::pair<std::string, int>> localNames;
+    std::vector<std::pair<std::string_view, int>> localNames;
+    localNames.reserve(ei.members.size());
     for (size_t i = 0; i < ei.members.size(); ++i)
     {
         auto& m = ei.members[i];
-        std::string name = m.name;
         int collisionCount = 0;
 
-        auto git = globalEnumNames.find(name);
-        bool isNewGlobal = (git == globalEnumNames.end());
-        if (isNewGlobal)
-        {
-            globalEnumNames[name] = true;
-        }
-        if (!isNewGlobal)
+        // 同一枚举内的重名成员加 _N 后缀（只看本枚举，
+        // 不依赖跨枚举的全局状态，多线程生成时结果确定）
+        for (auto& [ln, lc] : localNames)
         {
-            for (auto& [ln, lc] : localNames)
+            if (ln == m.name)
             {
-                if (ln == name)
-                {
-                    collisionCount = lc + 1;
-                    break;
-                }
+                collisionCount = lc + 1;
+                break;
             }
         }
-        if (illegalNames.count(name))
+        if (illegalNames.count(m.name))
         {
             if (collisionCount == 0)
             {
                 collisionCount = 1;
             }
         }
-        localNames.push_back({name, collisionCount});
+        localNames.push_back({m.name, collisionCount});
         if (collisionCount > 0)
         {
-            name += "_" + std::to_string(collisionCount - 1);
+            std::string& name = out.Scratch();
+            std::format_to(std::back_inserter(name), "{}_{}",
+                m.name, collisionCount - 1);
+            out.Format("\t{:{}} = {},\n", name, 40, m.value);
+        }
+        else
+        {
+            out.Format("\t{:{}} = {},\n", m.name, 40, m.value);
         }
-        out += std::format("\t{:{}} = {},\n",
-            name, 40, m.value);
     }
     out += "};\n\n";
-    return out;
 }
 
-// 生成 StaticClass/StaticName/GetDefaultObj 内联函数体
-inline std::string GenerateStaticClassFuncs(
-    const std::string& qualifiedName,
-    const std::string& rawName,
-    const std::string& objClassName,
-    bool hasCollision,
-    const std::string& outerName)
+// StaticClass/StaticName/GetDefaultObj 所需的类信息
+struct StaticClassArgs
+{
+    std::string_view qualifiedName;
+    std::string_view rawName;
+    std::string_view objClassName;
+    std::string_view outerName;
+    bool hasCollision = false;
+};
+
+// 追加 StaticClass/StaticName/GetDefaultObj 内联函数体
+inline void AppendStaticClassFuncs(
+    CodeBuilder& out,
+    const StaticClassArgs& args)
 {
-    std::string out;
     bool isBPClass = (
-        objClassName == "BlueprintGeneratedClass" ||
-        objClassName == "WidgetBlueprintGeneratedClass" ||
-        objClassName == "AnimBlueprintGeneratedClass");
+        args.objClassName == "BlueprintGeneratedClass" ||
+        args.objClassName == "WidgetBlueprintGeneratedClass" ||
+        args.objClassName == "AnimBlueprintGeneratedClass");
 
     out += "\tstatic class UClass* StaticClass()\n";
     out += "\t{\n";
-    if (hasCollision)
+    if (args.hasCollision)
     {
-        std::string shortOuter = StripPackagePrefix(outerName);
-        std::string fullNameStr = objClassName + " "
-            + shortOuter + "." + rawName;
-        out += std::format(
-            "\t\tBP_STATIC_CLASS_IMPL_FULLNAME(\"{}\")\n",
-            fullNameStr);
+        out.Format(
+            "\t\tBP_STATIC_CLASS_IMPL_FULLNAME(\"{} {}.{}\")\n",
+            args.objClassName,
+            StripPackagePrefix(std::string(args.outerName)),
+            args.rawName);
     }
     else if (isBPClass)
     {
-        out += std::format(
-            "\t\tBP_STATIC_CLASS_IMPL(\"{}\")\n", rawName);
+        out.Format(
+            "\t\tBP_STATIC_CLASS_IMPL(\"{}\")\n", args.rawName);
     }
     else
     {
-        out += std::format(
-            "\t\tSTATIC_CLASS_IMPL(\"{}\")\n", rawName);
+        out.Format(
+            "\t\tSTATIC_CLASS_IMPL(\"{}\")\n", args.rawName);
     }
     out += "\t}\n";
     out += "\tstatic const class FName& StaticName()\n";
     out += "\t{\n";
-    out += std::format(
-        "\t\tSTATIC_NAME_IMPL(L\"{}\")\n", rawName);
+    out.Format(
+        "\t\tSTATIC_NAME_IMPL(L\"{}\")\n", args.rawName);
     out += "\t}\n";
-    out += std::format(
-        "\tstatic class {}* GetDefaultObj()\n", qualifiedName);
+    out.Format(
+        "\tstatic class {}* GetDefaultObj()\n", args.qualifiedName);
     out += "\t{\n";
-    out += std::format(
-        "\t\treturn GetDefaultObjImpl<{}>();\n", qualifiedName);
+    out.Format(
+        "\t\treturn GetDefaultObjImpl<{}>();\n", args.qualifiedName);
     out += "\t}\n";
-    return out;
 }
 
 // 统一函数条目：追踪 inline/static/const 切换
+// 文本来源三选一：text（静态字面量）、func（反射函数声明）、staticClass
 struct FuncEntry
 {
-    std::string text;
+    std::string_view text;
     bool bIsInline  = false;
     bool bIsStatic  = false;
     bool bIsConst   = false;
+    const FunctionInfo* func = nullptr;
+    bool bRenamed = false;
+    const StaticClassArgs* staticClass = nullptr;
 };
 
 // UObject 预定义非内联函数条目
-inline std::vector<FuncEntry> BuildUObjectPredefEntries()
+// 条目文本均为字面量，列表只构建一次
+inline const std::vector<FuncEntry>& BuildUObjectPredefEntries()
 {
-    std::vector<FuncEntry> entries;
-    entries.push_back({
-        "\tstatic class UObject* FindObjectFastImpl("
-        "const std::string& Name, "
-        "EClassCastFlags RequiredType = EClassCastFlags::None);\n",
-        false, true, false});
-    entries.push_back({
-        "\tstatic class UObject* FindObjectImpl("
-        "const std::string& FullName, "
-        "EClassCastFlags RequiredType = EClassCastFlags::None);\n",
-        false, true, false});
-    entries.push_back({
-        "\tstd::string GetFullName() const;\n",
-        false, false, true});
-    entries.push_back({
-        "\tstd::string GetName() const;\n",
-        false, false, true});
-    entries.push_back({
-        "\tbool HasTypeFlag(EClassCastFlags TypeFlags) const;\n",
-        false, false, true});
-    entries.push_back({
-        "\tbool IsA(EClassCastFlags TypeFlags) const;\n",
-        false, false, true});
-    entries.push_back({
-        "\tbool IsA(const class FName& ClassName) const;\n",
-        false, false, true});
-    entries.push_back({
-        "\tbool IsA(const class UClass* TypeClass) const;\n",
-        false, false, true});
-    entries.push_back({
-        "\tbool IsDefaultObject() const;\n",
-        false, false, true});
+    static const std::vector<FuncEntry> entries = {
+        {"\tstatic class UObject* FindObjectFastImpl("
+         "const std::string& Name, "
+         "EClassCastFlags RequiredType = EClassCastFlags::None);\n",
+         false, true, false},
+        {"\tstatic class UObject* FindObjectImpl("
+         "const std::string& FullName, "
+         "EClassCastFlags RequiredType = EClassCastFlags::None);\n",
+         false, true, false},
+        {"\tstd::string GetFullName() const;\n", false, false, true},
+        {"\tstd::string GetName() const;\n", false, false, true},
+        {"\tbool HasTypeFlag(EClassCastFlags TypeFlags) const;\n",
+         false, false, true},
+        {"\tbool IsA(EClassCastFlags TypeFlags) const;\n",
+         false, false, true},
+        {"\tbool IsA(const class FName& ClassName) const;\n",
+         false, false, true},
+        {"\tbool IsA(const class UClass* TypeClass) const;\n",
+         false, false, true},
+        {"\tbool IsDefaultObject() const;\n", false, false, true},
+    };
     return entries;
 }
 
 // UObject 预定义内联函数条目
-inline std::vector<FuncEntry> BuildUObjectInlineEntries()
+inline const std::vector<FuncEntry>& BuildUObjectInlineEntries()
 {
-    std::vector<FuncEntry> entries;
-    {
-        std::string t;
-        t += "\tstatic class UClass* FindClass(const std::string& ClassFullName)\n";
-        t += "\t{\n";
-        t += "\t\treturn FindObject<class UClass>(ClassFullName, EClassCastFlags::Class);\n";
-        t += "\t}\n";
-        entries.push_back({t, true, true, false});
-    }
-    {
-        std::string t;
-        t += "\tstatic class UClass* FindClassFast(const std::string& ClassName)\n";
-        t += "\t{\n";
-        t += "\t\treturn FindObjectFast<class UClass>(ClassName, EClassCastFlags::Class);\n";
-        t += "\t}\n";
-        entries.push_back({t, true, true, false});
-    }
-    {
-        std::string t;
-        t += "\t\n";
-        t += "\ttemplate<typename UEType = UObject>\n";
-        t += "\tstatic UEType* FindObject(const std::string& Name, EClassCastFlags RequiredType = EClassCastFlags::None)\n";
-        t += "\t{\n";
-        t += "\t\treturn static_cast<UEType*>(FindObjectImpl(Name, RequiredType));\n";
-        t += "\t}\n";
-        entries.push_back({t, true, true, false});
-    }
-    {
-        std::string t;
-        t += "\ttemplate<typename UEType = UObject>\n";
-        t += "\tstatic UEType* FindObjectFast(const std::string& Name, EClassCastFlags RequiredType = EClassCastFlags::None)\n";
-        t += "\t{\n";
-        t += "\t\treturn static_cast<UEType*>(FindObjectFastImpl(Name, RequiredType));\n";
-        t += "\t}\n";
-        entries.push_back({t, true, true, false});
-    }
-    {
-        std::string t;
-        t += "\tvoid ProcessEvent(class UFunction* Function, void* Parms) const\n";
-        t += "\t{\n";
-        t += "\t\tInSDKUtils::CallGameFunction(InSDKUtils::GetVirtualFunction<void(*)(const UObject*, class UFunction*, void*)>(this, Offsets::ProcessEventIdx), this, Function, Parms);\n";
-        t += "\t}\n";
-        entries.push_back({t, true, false, true});
-    }
+    static const std::vector<FuncEntry> entries = {
+        {"\tstatic class UClass* FindClass(const std::string& ClassFullName)\n"
+         "\t{\n"
+         "\t\treturn FindObject<class UClass>(ClassFullName, EClassCastFlags::Class);\n"
+         "\t}\n",
+         true, true, false},
+        {"\tstatic class UClass* FindClassFast(const std::string& ClassName)\n"
+         "\t{\n"
+         "\t\treturn FindObjectFast<class UClass>(ClassName, EClassCastFlags::Class);\n"
+         "\t}\n",
+         true, true, false},
+        {"\t\n"
+         "\ttemplate<typename UEType = UObject>\n"
+         "\tstatic UEType* FindObject(const std::string& Name, EClassCastFlags RequiredType = EClassCastFlags::None)\n"
+         "\t{\n"
+         "\t\treturn static_cast<UEType*>(FindObjectImpl(Name, RequiredType));\n"
+         "\t}\n",
+         true, true, false},
+        {"\ttemplate<typename UEType = UObject>\n"
+         "\tstatic UEType* FindObjectFast(const std::string& Name, EClassCastFlags RequiredType = EClassCastFlags::None)\n"
+         "\t{\n"
+         "\t\treturn static_cast<UEType*>(FindObjectFastImpl(Name, RequiredType));\n"
+         "\t}\n",
+         true, true, false},
+        {"\tvoid ProcessEvent(class UFunction* Function, void* Parms) const\n"
+         "\t{\n"
+         "\t\tInSDKUtils::CallGameFunction(InSDKUtils::GetVirtualFunction<void(*)(const UObject*, class UFunction*, void*)>(this, Offsets::ProcessEventIdx), this, Function, Parms);\n"
+         "\t}\n",
+         true, false, true},
+    };
     return entries;
 }
 
 // UStruct 预定义函数条目
-inline std::vector<FuncEntry> BuildUStructPredefEntries()
+inline const std::vector<FuncEntry>& BuildUStructPredefEntries()
 {
-    std::vector<FuncEntry> entries;
-    entries.push_back({"\tbool IsSubclassOf(const UStruct* Base) const;\n", false, false, true});
-    entries.push_back({"\tbool IsSubclassOf(const FName& baseClassName) const;\n", false, false, true});
+    static const std::vector<FuncEntry> entries = {
+        {"\tbool IsSubclassOf(const UStruct* Base) const;\n", false, false, true},
+        {"\tbool IsSubclassOf(const FName& baseClassName) const;\n", false, false, true},
+    };
     return entries;
 }
 
 // UClass 预定义函数条目
-inline std::vector<FuncEntry> BuildUClassPredefEntries()
+inline const std::vector<FuncEntry>& BuildUClassPredefEntries()
 {
-    std::vector<FuncEntry> entries;
-    entries.push_back({"\tclass UFunction* GetFunction(const char* ClassName, const char* FuncName) const;\n", false, false, true});
+    static const std::vector<FuncEntry> entries = {
+        {"\tclass UFunction* GetFunction(const char* ClassName, const char* FuncName) const;\n", false, false, true},
+    };
     return entries;
 }
 
-// StaticClass 条目列表
-inline std::vector<FuncEntry> BuildStaticClassEntries(
-    const std::string& qualifiedName,
-    const std::string& rawName,
-    const std::string& objClassName,
-    bool hasCollision,
-    const std::string& outerName)
+// StaticClass 条目：args 须在输出前保持有效
+inline FuncEntry BuildStaticClassEntry(const StaticClassArgs& args)
 {
-    std::vector<FuncEntry> entries;
-    std::string scText = GenerateStaticClassFuncs(qualifiedName, rawName, objClassName, hasCollision, outerName);
-    entries.push_back({scText, true, true, false});
-    return entries;
+    FuncEntry fe;
+    fe.bIsInline = true;
+    fe.bIsStatic = true;
+    fe.staticClass = &args;
+    return fe;
 }
 
 // Interface 工具函数条目
-inline std::vector<FuncEntry> BuildInterfaceAsUObjectEntries()
+inline const std::vector<FuncEntry>& BuildInterfaceAsUObjectEntries()
 {
-    std::vector<FuncEntry> entries;
-
-    std::string asObj;
-    asObj += "\tclass UObject* AsUObject()\n";
-    asObj += "\t{\n";
-    asObj += "\t\treturn reinterpret_cast<UObject*>(this);\n";
-    asObj += "\t}\n";
-    entries.push_back({asObj, true, false, false});
-
-    std::string asObjConst;
-    asObjConst += "\tconst class UObject* AsUObject() const\n";
-    asObjConst += "\t{\n";
-    asObjConst += "\t\treturn reinterpret_cast<const UObject*>(this);\n";
-    asObjConst += "\t}\n";
-    entries.push_back({asObjConst, true, false, true});
-
+    static const std::vector<FuncEntry> entries = {
+        {"\tclass UObject* AsUObject()\n"
+         "\t{\n"
+         "\t\treturn reinterpret_cast<UObject*>(this);\n"
+         "\t}\n",
+         true, false, false},
+        {"\tconst class UObject* AsUObject() const\n"
+         "\t{\n"
+         "\t\treturn reinterpret_cast<const UObject*>(this);\n"
+         "\t}\n",
+         true, false, true},
+    };
     return entries;
 }
 
 // 输出统一函数列表，处理 inline/static/const 切换
-inline std::string EmitFunctionEntries(const std::vector<FuncEntry>& entries)
+inline void EmitFunctionEntries(
+    CodeBuilder& out,
+    const std::vector<FuncEntry>& entries)
 {
-    std::string out;
     bool wasLastInline = false;
     bool wasLastStatic = false;
     bool wasLastConst  = false;
@@ -368,21 +355,75 @@ inline std::string EmitFunctionEntries(const std::vector<FuncEntry>& entries)
                 didSwitch = false;
             }
         }
-        out += fe.text;
+        if (fe.func)
+        {
+            AppendFunctionDeclaration(out, *fe.func, fe.bRenamed);
+        }
+        else if (fe.staticClass)
+        {
+            AppendStaticClassFuncs(out, *fe.staticClass);
+        }
+        else
+        {
+            out += fe.text;
+        }
         wasLastInline = fe.bIsInline;
         wasLastStatic = fe.bIsStatic;
         wasLastConst  = fe.bIsConst;
         isFirst = false;
     }
-    return out;
 }
 
-// 生成 _classes.hpp 中单个类的代码
-// 使用统一函数条目列表，精确追踪 inline/static/const 切换
-inline std::string GenerateClassCode(const StructEntry& entry)
+// 子类成员布局的起点：父类尾部填充被复用或可跳过时从父类实际末尾开始
+inline i32 EffectiveSuperSize(const StructEntry& entry)
+{
+    i32 effectiveSuperSize = entry.superSize;
+    if (entry.superName.empty())
+    {
+        return effectiveSuperSize;
+    }
+    auto& lk = GetEntryLookup();
+    auto superIt = lk.find(entry.superName);
+    if (superIt == lk.end())
+    {
+        return effectiveSuperSize;
+    }
+    if (superIt->second->bHasReusedTrailingPadding)
+    {
+        effectiveSuperSize = superIt->second->unalignedSize;
+    }
+    else if (superIt->second->bCanSkipTrailingPad)
+    {
+        // 父类有 pack 且 alignas 足以填充 trailing pad
+        // 子类从 lastMemberEnd 开始生成显式 pad
+        effectiveSuperSize = superIt->second->lastMemberEnd;
+    }
+    else
+    {
+        i32 parentAlign2 = superIt->second->alignment > 0
+            ? superIt->second->alignment : 1;
+        effectiveSuperSize = (entry.superSize + parentAlign2 - 1)
+            & ~(parentAlign2 - 1);
+    }
+    return effectiveSuperSize;
+}
+
+// 成员布局的终点
+// bCanSkipTrailingPad：不生成 trailing pad，靠 alignas 填充
+// 子类会从 lastMemberEnd 开始生成显式 pad
+inline i32 EffectiveStructSize(const StructEntry& entry)
 {
-    std::string out;
+    if (entry.bCanSkipTrailingPad)
+    {
+        return entry.lastMemberEnd;
+    }
+    return entry.unalignedSize > 0 ? entry.unalignedSize : entry.size;
+}
 
+// 追加 _classes.hpp 中单个类的代码
+// 使用统一函数条目列表，精确追踪 inline/static/const 切换
+inline void AppendClassCode(CodeBuilder& out, const StructEntry& entry)
+{
     std::string prefixedName = AddStructPrefix(
         entry.name, entry.isClass,
         entry.isActorChild, entry.isInterfaceChild);
@@ -395,12 +436,9 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     bool hasCollision = !entry.collisionNs.empty();
     std::string qualifiedName = hasCollision
         ? (entry.collisionNs + "::" + prefixedName) : prefixedName;
-    std::string assertName = hasCollision
-        ? (entry.collisionNs + "__" + prefixedName) : prefixedName;
 
     // 对标 Rei-Dumper：注释中 superSize 使用 aligned 值
     i32 alignedEntrySize = entry.size;
-    // 注释用 aligned superSize（对标 Rei-Dumper）
     i32 parentAlignForComment = 1;
     if (!entry.superName.empty())
     {
@@ -418,15 +456,16 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     bool isInterface = entry.isInterfaceChild;
 
     // 注释头
-    std::string cleanOuter = StripPackagePrefix(entry.outerName);
     std::string objClassName = entry.objClassName;
     if (objClassName.empty() && entry.addr)
     {
         objClassName = GetObjectClassName(entry.addr);
     }
-    std::string commentType = objClassName.empty()
-        ? (entry.isClass ? "Class" : "ScriptStruct") : objClassName;
-    out += std::format("// {} {}.{}\n", commentType, cleanOuter, entry.name);
+    out.Format("// {} {}.{}\n",
+        objClassName.empty()
+            ? std::string_view(entry.isClass ? "Class" : "ScriptStruct")
+            : std::string_view(objClassName),
+        StripPackagePrefix(entry.outerName), entry.name);
 
     if (isInterface)
     {
@@ -434,13 +473,13 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     }
     else
     {
-        out += std::format("// 0x{:04X} (0x{:04X} - 0x{:04X})\n",
+        out.Format("// 0x{:04X} (0x{:04X} - 0x{:04X})\n",
             sizeWithoutSuper > 0 ? sizeWithoutSuper : 0,
             entry.size, commentSuperSize);
     }
 
     // 类声明
-    std::string finalStr = entry.isFinal ? " final" : "";
+    std::string_view finalStr = entry.isFinal ? " final" : "";
 
     // 对标 Rei-Dumper：#pragma pack(push, 0x1) 只给有 alignas 的类
     // （bUseExplicitAlignment = true 时同时输出 alignas 和 #pragma pack）
@@ -454,79 +493,38 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     out += "class ";
     if (isInterface)
     {
-        out += qualifiedName + " final";
+        out += qualifiedName;
+        out += " final";
     }
     else if (!prefixedSuper.empty())
     {
         if (entry.bUseExplicitAlignment)
         {
-            out += std::format("alignas(0x{:02X}) ",
-                entry.alignment);
+            out.Format("alignas(0x{:02X}) ", entry.alignment);
         }
-        out += qualifiedName + finalStr + " : public " + prefixedSuper;
+        out.Format("{}{} : public {}",
+            qualifiedName, finalStr, prefixedSuper);
     }
     else
     {
         // 无父类：使用显式对齐或默认 0x08
         i32 align = entry.bUseExplicitAlignment
             ? entry.alignment : 0x08;
-        out += std::format("alignas(0x{:02X}) {}{}",
+        out.Format("alignas(0x{:02X}) {}{}",
             align, qualifiedName, finalStr);
     }
 
-    // ─── 收集成员 ───
-    std::string membersStr;
+    // ─── 成员 ───
+    // 预定义成员替换自动收集的属性；属性列表同时用于函数名冲突检测
     std::string predefMembers = GetPredefinedMembers(entry.name);
-    if (!predefMembers.empty())
-    {
-        membersStr = predefMembers;
-    }
-    else
-    {
-        auto props = CollectProperties(entry.addr);
-        i32 effectiveSuperSize = entry.superSize;
-        auto& lk = GetEntryLookup();
-        if (!entry.superName.empty())
-        {
-            auto superIt = lk.find(entry.superName);
-            if (superIt != lk.end())
-            {
-                if (superIt->second->bHasReusedTrailingPadding)
-                {
-                    effectiveSuperSize =
-                        superIt->second->unalignedSize;
-                }
-                else if (superIt->second->bCanSkipTrailingPad)
-                {
-                    // 父类有 pack 且 alignas 足以填充 trailing pad
-                    // 子类从 lastMemberEnd 开始生成显式 pad
-                    effectiveSuperSize =
-                        superIt->second->lastMemberEnd;
-                }
-                else
-                {
-                    i32 parentAlign2 = superIt->second->alignment > 0
-                        ? superIt->second->alignment : 1;
-                    effectiveSuperSize =
-                        (entry.superSize + parentAlign2 - 1)
-                        & ~(parentAlign2 - 1);
-                }
-            }
-        }
-        i32 effectiveSize = entry.unalignedSize > 0
-            ? entry.unalignedSize : entry.size;
-        // bCanSkipTrailingPad：不生成 trailing pad，靠 alignas 填充
-        // 子类会从 lastMemberEnd 开始生成显式 pad
-        if (entry.bCanSkipTrailingPad)
-        {
-            effectiveSize = entry.lastMemberEnd;
-        }
-        membersStr = GenerateMembers(
-            props, effectiveSuperSize, effectiveSize);
-    }
+    const auto& props = CollectProperties(entry.addr);
+    i32 effectiveSuperSize = EffectiveSuperSize(entry);
+    i32 effectiveSize = EffectiveStructSize(entry);
+    bool bMembersOutput = !predefMembers.empty()
+        || MembersProduceOutput(props, effectiveSuperSize, effectiveSize);
 
     i32 effectiveAlign = entry.alignment > 0 ? entry.alignment : 8;
-    bool bHasMembers = !membersStr.empty() || (sizeWithoutSuper >= effectiveAlign);
+    bool bHasMembers = bMembersOutput || (sizeWithoutSuper >= effectiveAlign);
 
     // ─── 构建统一函数条目列表 ───
     std::vector<FuncEntry> funcEntries;
@@ -534,46 +532,41 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     // 预定义非内联函数
     if (entry.name == "Object")
     {
-        auto v = BuildUObjectPredefEntries();
+        auto& v = BuildUObjectPredefEntries();
         funcEntries.insert(funcEntries.end(), v.begin(), v.end());
     }
     else if (entry.name == "Struct")
     {
-        auto v = BuildUStructPredefEntries();
+        auto& v = BuildUStructPredefEntries();
         funcEntries.insert(funcEntries.end(), v.begin(), v.end());
     }
     else if (entry.name == "Class")
     {
-        auto v = BuildUClassPredefEntries();
+        auto& v = BuildUClassPredefEntries();
         funcEntries.insert(funcEntries.end(), v.begin(), v.end());
     }
 
     // 反射函数（non-inline）
-    // 收集属性名，用于检测函数名冲突
-    auto allProps = CollectProperties(entry.addr);
-    std::unordered_set<std::string> propNames;
-    for (auto& pi : allProps)
+    // 对标 Rei-Dumper：函数名与属性名冲突时加下划线后缀
+    std::unordered_set<std::string_view> propNames;
+    for (auto& pi : props)
     {
         propNames.insert(pi.name);
     }
-    auto funcs = CollectFunctions(entry.addr);
+    const auto& funcs = CollectFunctions(entry.addr);
     for (auto& func : funcs)
     {
-        // 对标 Rei-Dumper：函数名与属性名冲突时加下划线后缀
-        FunctionInfo resolved = func;
-        if (propNames.count(resolved.name))
-        {
-            resolved.name += "_";
-        }
-        bool isStatic = (resolved.functionFlags & 0x00002000) != 0;
-        funcEntries.push_back({
-            FormatFunctionDeclaration(resolved), false, isStatic, false});
+        FuncEntry fe;
+        fe.bIsStatic = (func.functionFlags & 0x00002000) != 0;
+        fe.func = &func;
+        fe.bRenamed = propNames.count(func.name) > 0;
+        funcEntries.push_back(fe);
     }
 
     // 预定义内联函数
     if (entry.name == "Object")
     {
-        auto v = BuildUObjectInlineEntries();
+        auto& v = BuildUObjectInlineEntries();
         funcEntries.insert(funcEntries.end(), v.begin(), v.end());
     }
 
@@ -581,18 +574,18 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     bool hasStaticClass = entry.isClass
         && entry.name != "Object"
         && (!entry.superName.empty() || isInterface);
+    StaticClassArgs staticArgs{
+        qualifiedName, entry.name, objClassName,
+        entry.outerName, hasCollision};
     if (hasStaticClass)
     {
-        auto v = BuildStaticClassEntries(
-            qualifiedName, entry.name, objClassName,
-            hasCollision, entry.outerName);
-        funcEntries.insert(funcEntries.end(), v.begin(), v.end());
+        funcEntries.push_back(BuildStaticClassEntry(staticArgs));
     }
 
     // interface 需要 AsUObject() 供函数实现调用
     if (isInterface && entry.isClass)
     {
-        auto v = BuildInterfaceAsUObjectEntries();
+        auto& v = BuildInterfaceAsUObjectEntries();
         funcEntries.insert(funcEntries.end(), v.begin(), v.end());
     }
 
@@ -607,7 +600,14 @@ inline std::string GenerateClassCode(const StructEntry& entry)
 
     if (bHasMembers)
     {
-        out += membersStr;
+        if (!predefMembers.empty())
+        {
+            out += predefMembers;
+        }
+        else
+        {
+            AppendMembers(out, props, effectiveSuperSize, effectiveSize);
+        }
         if (bHasFunctions)
         {
             out += "\npublic:\n";
@@ -616,7 +616,7 @@ inline std::string GenerateClassCode(const StructEntry& entry)
 
     if (bHasFunctions)
     {
-        out += EmitFunctionEntries(funcEntries);
+        EmitFunctionEntries(out, funcEntries);
     }
 
     out += "};\n";
@@ -624,17 +624,17 @@ inline std::string GenerateClassCode(const StructEntry& entry)
     {
         out += "#pragma pack(pop)\n";
     }
-    out += std::format("#ifdef DUMPER7_ASSERTS_{}\n", assertName);
-    out += std::format("DUMPER7_ASSERTS_{};\n", assertName);
+    std::string_view nsSep = hasCollision ? "__" : "";
+    out.Format("#ifdef DUMPER7_ASSERTS_{}{}{}\n",
+        entry.collisionNs, nsSep, prefixedName);
+    out.Format("DUMPER7_ASSERTS_{}{}{};\n",
+        entry.collisionNs, nsSep, prefixedName);
     out += "#endif\n\n";
-    return out;
 }
 
-// 生成 _structs.hpp 中单个结构体的代码
-inline std::string GenerateStructCode(const StructEntry& entry)
+// 追加 _structs.hpp 中单个结构体的代码
+inline void AppendStructCode(CodeBuilder& out, const StructEntry& entry)
 {
-    std::string out;
-
     std::string prefixedName = AddStructPrefix(
         entry.name, entry.isClass,
         entry.isActorChild, entry.isInterfaceChild);
@@ -652,16 +652,15 @@ inline std::string GenerateStructCode(const StructEntry& entry)
     {
         objClassName = GetObjectClassName(entry.addr);
     }
-    std::string commentType = objClassName.empty()
-        ? "ScriptStruct" : objClassName;
-    out += std::format("// {} {}.{}\n",
-        commentType, StripPackagePrefix(entry.outerName), entry.name);
-    out += std::format("// 0x{:04X} (0x{:04X} - 0x{:04X})\n",
+    out.Format("// {} {}.{}\n",
+        objClassName.empty()
+            ? std::string_view("ScriptStruct")
+            : std::string_view(objClassName),
+        StripPackagePrefix(entry.outerName), entry.name);
+    out.Format("// 0x{:04X} (0x{:04X} - 0x{:04X})\n",
         sizeWithoutSuper > 0 ? sizeWithoutSuper : 0,
         entry.size, entry.superSize);
 
-    std::string finalStr = entry.isFinal ? " final" : "";
-
     // 对标 Rei-Dumper：
     // - #pragma pack(push, 0x1) 只在 bHasReusedTrailingPadding 时使用
     // - alignas 在 bUseExplicitAlignment 时使用（minAlign > highestMemberAlign）
@@ -674,59 +673,31 @@ inline std::string GenerateStructCode(const StructEntry& entry)
     out += "struct ";
     if (entry.bUseExplicitAlignment)
     {
-        out += std::format("alignas(0x{:02X}) ", entry.alignment);
+        out.Format("alignas(0x{:02X}) ", entry.alignment);
+    }
+    out += prefixedName;
+    if (entry.isFinal)
+    {
+        out += " final";
     }
-    out += prefixedName + finalStr;
     if (!prefixedSuper.empty())
     {
-        out += " : public " + prefixedSuper;
+        out += " : public ";
+        out += prefixedSuper;
     }
     // 预定义 typedef（如 FVector 的 UnderlayingType）
     std::string typedefStr = GetStructPredefinedTypedefs(entry.name);
 
-    auto props = CollectProperties(entry.addr);
-
-    i32 effectiveSuperSize = entry.superSize;
-    auto& lk = GetEntryLookup();
-    if (!entry.superName.empty())
-    {
-        auto superIt = lk.find(entry.superName);
-        if (superIt != lk.end())
-        {
-            if (superIt->second->bHasReusedTrailingPadding)
-            {
-                effectiveSuperSize =
-                    superIt->second->unalignedSize;
-            }
-            else if (superIt->second->bCanSkipTrailingPad)
-            {
-                effectiveSuperSize =
-                    superIt->second->lastMemberEnd;
-            }
-            else
-            {
-                i32 parentAlign2 = superIt->second->alignment > 0
-                    ? superIt->second->alignment : 1;
-                effectiveSuperSize =
-                    (entry.superSize + parentAlign2 - 1)
-                    & ~(parentAlign2 - 1);
-            }
-        }
-    }
-    i32 effectiveSize = entry.unalignedSize > 0
-        ? entry.unalignedSize : entry.size;
-    if (entry.bCanSkipTrailingPad)
-    {
-        effectiveSize = entry.lastMemberEnd;
-    }
-    std::string membersStr2 = GenerateMembers(
-        props, effectiveSuperSize, effectiveSize);
+    const auto& props = CollectProperties(entry.addr);
+    i32 effectiveSuperSize = EffectiveSuperSize(entry);
+    i32 effectiveSize = EffectiveStructSize(entry);
 
     // 预定义函数（如 FVector 的构造函数/运算符）
     std::string predFuncs = GetStructPredefinedFunctions(entry.name);
 
     bool bHasContent = !typedefStr.empty()
-        || !membersStr2.empty() || !predFuncs.empty();
+        || MembersProduceOutput(props, effectiveSuperSize, effectiveSize)
+        || !predFuncs.empty();
 
     out += "\n{\n";
     if (bHasContent)
@@ -734,7 +705,7 @@ inline std::string GenerateStructCode(const StructEntry& entry)
         out += "public:\n";
     }
     out += typedefStr;
-    out += membersStr2;
+    AppendMembers(out, props, effectiveSuperSize, effectiveSize);
     out += predFuncs;
 
     out += "};\n";
@@ -742,10 +713,9 @@ inline std::string GenerateStructCode(const StructEntry& entry)
     {
         out += "#pragma pack(pop)\n";
     }
-    out += std::format("#ifdef DUMPER7_ASSERTS_{}\n", prefixedName);
-    out += std::format("DUMPER7_ASSERTS_{};\n", prefixedName);
+    out.Format("#ifdef DUMPER7_ASSERTS_{}\n", prefixedName);
+    out.Format("DUMPER7_ASSERTS_{};\n", prefixedName);
     out += "#endif\n\n";
-    return out;
 }
 
 } // namespace detail
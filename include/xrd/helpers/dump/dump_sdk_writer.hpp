@@ -1,7 +1,8 @@
 #pragma once
 // Xrd-eXternalrEsolve - SDK 导出：分包文件写入器
-// 负责写入 _classes.hpp / _structs.hpp / _functions.cpp / _parameters.hpp
-// 以及追加断言宏到 Assertions.inl
+// 负责生成 _classes.hpp / _structs.hpp / _functions.cpp / _parameters.hpp / _fwd.hpp
+// 以及 Assertions.inl 的断言宏文本
+// Build* 只生成文本（返回空串表示该文件不需要），可在工作线程中并行调用
 // 包含跨包 #include 依赖追踪
 
 #include "dump_sdk_struct.hpp"
@@ -48,38 +49,62 @@ inline std::wstring Utf8ToWide(const std::string& utf8)
 // 写入文件头（所有 SDK 文件共用）
 // 对标 Rei-Dumper：UTF-8 BOM + #pragma once
 inline void WriteFileHeader(
-    std::ofstream& f,
+    CodeBuilder& f,
     const std::string& pkgName)
 {
     // UTF-8 BOM（对标 Rei-Dumper）
-    f << "\xEF\xBB\xBF";
-    f << "#pragma once\n\n";
-    f << "/*\n";
-    f << "* SDK generated by Xrd-eXternalrEsolve\n";
-    f << "* Based on Dumper-7\n";
-    f << "*\n";
-    f << "* https://github.com/Encryqed/Dumper-7\n";
-    f << "*/\n\n";
-    f << "// Package: " << pkgName << "\n\n";
-    f << "#include \"Basic.hpp\"\n";
+    f += "\xEF\xBB\xBF";
+    f += "#pragma once\n\n";
+    f += "/*\n";
+    f += "* SDK generated by Xrd-eXternalrEsolve\n";
+    f += "* Based on Dumper-7\n";
+    f += "*\n";
+    f += "* https://github.com/Encryqed/Dumper-7\n";
+    f += "*/\n\n";
+    f.Format("// Package: {}\n\n", pkgName);
+    f += "#include \"Basic.hpp\"\n";
+}
+
+// 写入只需前向声明的依赖包的 _fwd.hpp（已完整 include 其 _structs.hpp 的包跳过）
+// fwd 为 std::set，按包索引升序输出
+inline void WriteFwdIncludes(
+    CodeBuilder& f,
+    const PackageDeps& deps,
+    const std::unordered_map<i32, std::string>& pkgIdxToSanitized,
+    const std::unordered_set<i32>* pkgsWithStructs = nullptr)
+{
+    for (i32 depPkgIdx : deps.fwd)
+    {
+        auto dit = deps.deps.find(depPkgIdx);
+        if (dit != deps.deps.end() && dit->second.needStructs
+            && (!pkgsWithStructs || pkgsWithStructs->count(depPkgIdx)))
+        {
+            continue;
+        }
+        auto it = pkgIdxToSanitized.find(depPkgIdx);
+        if (it != pkgIdxToSanitized.end())
+        {
+            f.Format("#include \"{}_fwd.hpp\"\n", it->second);
+        }
+    }
 }
 
 // 写入跨包 #include（对标 Rei-Dumper）
 // deps 的 key 是包的 GObjects 索引
 // 按包索引升序排列，保证输出顺序确定性
 inline void WriteDepsIncludes(
-    std::ofstream& f,
+    CodeBuilder& f,
     const PackageDeps& deps,
     const std::unordered_map<i32, std::string>& pkgIdxToSanitized,
     const std::unordered_set<i32>* pkgsWithStructs = nullptr)
 {
-    if (deps.deps.empty())
+    if (deps.deps.empty() && deps.fwd.empty())
     {
-        f << "\n";
+        f += "\n";
         return;
     }
 
-    f << "\n";
+    f += "\n";
 
     // 按包索引升序排列，保证输出顺序与 Rei-Dumper 一致
     std::vector<std::pair<i32, PackageDeps::DepInfo>> sorted(
@@ -104,23 +129,20 @@ inline void WriteDepsIncludes(
             if (!pkgsWithStructs
                 || pkgsWithStructs->count(depPkgIdx))
             {
-                f << "#include \"" << depSanitized
-                  << "_structs.hpp\"\n";
+                f.Format("#include \"{}_structs.hpp\"\n", depSanitized);
             }
         }
         if (info.needClasses)
         {
-            f << "#include \"" << depSanitized
-              << "_classes.hpp\"\n";
+            f.Format("#include \"{}_classes.hpp\"\n", depSanitized);
         }
     }
-    f << "\n";
+    WriteFwdIncludes(f, deps, pkgIdxToSanitized, pkgsWithStructs);
+    f += "\n";
 }
 
-// 写入 _structs.hpp — 枚举 + 结构体定义
-inline void WriteStructsFile(
-    const std::wstring& sdkDir,
-    const std::string& sanitizedName,
+// 生成 _structs.hpp — 枚举 + 结构体定义
+inline std::string BuildStructsFile(
     const std::string& rawPkgName,
     const std::vector<const StructEntry*>& structs,
     const std::vector<EnumInfo>& enums,
@@ -130,38 +152,30 @@ inline void WriteStructsFile(
 {
     if (structs.empty() && enums.empty())
     {
-        return;
-    }
-
-    std::wstring wName = Utf8ToWide(sanitizedName);
-    std::wstring path = sdkDir + L"/" + wName + L"_structs.hpp";
-    std::ofstream f(path);
-    if (!f.is_open())
-    {
-        return;
+        return {};
     }
 
+    CodeBuilder f;
     WriteFileHeader(f, rawPkgName);
     WriteDepsIncludes(f, deps, pkgIdxMap, pkgsWithStructs);
-    f << "\nnamespace SDK\n{\n\n";
+    f += "\nnamespace SDK\n{\n\n";
 
     for (auto& ei : enums)
     {
-        f << GenerateEnumCode(ei);
+        AppendEnumCode(f, ei);
     }
 
     for (auto* entry : structs)
     {
-        f << GenerateStructCode(*entry);
+        AppendStructCode(f, *entry);
     }
 
-    f << "}\n\n";
-    f.close();
+    f += "}\n\n";
+    return f.ToString();
 }
 
-// 写入 _classes.hpp — 类定义
-inline void WriteClassesFile(
-    const std::wstring& sdkDir,
+// 生成 _classes.hpp — 类定义
+inline std::string BuildClassesFile(
     const std::string& sanitizedName,
     const std::string& rawPkgName,
     const std::vector<const StructEntry*>& classes,
@@ -173,28 +187,22 @@ inline void WriteClassesFile(
 {
     if (classes.empty())
     {
-        return;
-    }
-
-    std::wstring wName = Utf8ToWide(sanitizedName);
-    std::wstring path = sdkDir + L"/" + wName + L"_classes.hpp";
-    std::ofstream f(path);
-    if (!f.is_open())
-    {
-        return;
+        return {};
     }
 
+    CodeBuilder f;
     WriteFileHeader(f, rawPkgName);
 
     // 对标 Rei-Dumper：classes 文件的跨包依赖 include
-    bool hasDeps = !deps.deps.empty() || classesNeedOwnStructs;
+    bool hasDeps = !deps.deps.empty() || !deps.fwd.empty()
+        || classesNeedOwnStructs;
     if (!hasDeps)
     {
-        f << "\n";
+        f += "\n";
     }
     else
     {
-        f << "\n";
+        f += "\n";
 
         // 按包索引升序排列，保证输出顺序确定性
         std::vector<std::pair<i32, PackageDeps::DepInfo>> sorted(
@@ -219,42 +227,42 @@ inline void WriteClassesFile(
                 if (!pkgsWithStructs
                     || pkgsWithStructs->count(depPkgIdx))
                 {
-                    f << "#include \"" << depSanitized
-                      << "_structs.hpp\"\n";
+                    f.Format("#include \"{}_structs.hpp\"\n",
+                        depSanitized);
                 }
             }
             if (info.needClasses)
             {
-                f << "#include \"" << depSanitized
-                  << "_classes.hpp\"\n";
+                f.Format("#include \"{}_classes.hpp\"\n",
+                    depSanitized);
             }
         }
 
         // 自包 structs include（仅当类实际依赖同包结构体时）
         if (classesNeedOwnStructs && hasStructsFile)
         {
-            f << "#include \"" << sanitizedName
-              << "_structs.hpp\"\n";
+            f.Format("#include \"{}_structs.hpp\"\n",
+                sanitizedName);
         }
+        WriteFwdIncludes(f, deps, pkgIdxMap, pkgsWithStructs);
 
-        f << "\n";
+        f += "\n";
     }
 
-    f << "\nnamespace SDK\n{\n\n";
+    f += "\nnamespace SDK\n{\n\n";
 
     for (auto* entry : classes)
     {
-        f << GenerateClassCode(*entry);
+        AppendClassCode(f, *entry);
     }
 
-    f << "}\n\n";
-    f.close();
+    f += "}\n\n";
+    return f.ToString();
 }
 
-// 写入 _functions.cpp — 函数实现（ProcessEvent 调用）
+// 生成 _functions.cpp — 函数实现（ProcessEvent 调用）
 // 对标 Rei-Dumper：预定义函数实现在反射函数之前
-inline void WriteFunctionsFile(
-    const std::wstring& sdkDir,
+inline std::string BuildFunctionsFile(
     const std::string& sanitizedName,
     const std::string& rawPkgName,
     const std::vector<const StructEntry*>& classes)
@@ -265,7 +273,7 @@ inline void WriteFunctionsFile(
     bool hasPredefinedImpls = false;
     for (auto* entry : classes)
     {
-        auto funcs = CollectFunctions(entry->addr);
+        const auto& funcs = CollectFunctions(entry->addr);
         if (!funcs.empty())
         {
             hasFuncs = true;
@@ -276,31 +284,27 @@ inline void WriteFunctionsFile(
         }
     }
 
-    if (!hasFuncs && !hasPredefinedImpls) return;
-
-    std::wstring wName = Utf8ToWide(sanitizedName);
-    std::wstring path = sdkDir + L"/" + wName + L"_functions.cpp";
-    std::ofstream f(path);
-    if (!f.is_open()) return;
+    if (!hasFuncs && !hasPredefinedImpls) return {};
 
     // 文件头（对标 Rei-Dumper 格式，含 BOM）
-    f << "\xEF\xBB\xBF";
-    f << "#pragma once\n\n";
-    f << "/*\n";
-    f << "* SDK generated by Xrd-eXternalrEsolve\n";
-    f << "* Based on Dumper-7\n";
-    f << "*\n";
-    f << "* https://github.com/Encryqed/Dumper-7\n";
-    f << "*/\n\n";
-    f << "// Package: " << rawPkgName << "\n\n";
-    f << "#include \"Basic.hpp\"\n\n";
-    f << "#include \"" << sanitizedName << "_classes.hpp\"\n";
+    CodeBuilder f;
+    f += "\xEF\xBB\xBF";
+    f += "#pragma once\n\n";
+    f += "/*\n";
+    f += "* SDK generated by Xrd-eXternalrEsolve\n";
+    f += "* Based on Dumper-7\n";
+    f += "*\n";
+    f += "* https://github.com/Encryqed/Dumper-7\n";
+    f += "*/\n\n";
+    f.Format("// Package: {}\n\n", rawPkgName);
+    f += "#include \"Basic.hpp\"\n\n";
+    f.Format("#include \"{}_classes.hpp\"\n", sanitizedName);
 
     // 检查是否有参数文件（对标 Rei-Dumper：只有有实际参数的函数才算）
     bool hasParamFile = false;
     for (auto* entry : classes)
     {
-        auto funcs = CollectFunctions(entry->addr);
+        const auto& funcs = CollectFunctions(entry->addr);
         for (auto& func : funcs)
         {
             if (func.paramStructSize > 0 && !func.params.empty())
@@ -313,11 +317,10 @@ inline void WriteFunctionsFile(
     }
     if (hasParamFile)
     {
-        f << "#include \"" << sanitizedName
-          << "_parameters.hpp\"\n";
+        f.Format("#include \"{}_parameters.hpp\"\n", sanitizedName);
     }
 
-    f << "\n\nnamespace SDK\n{\n";
+    f += "\n\nnamespace SDK\n{\n";
 
     // 清理包名用于函数注释
     std::string cleanPkg = rawPkgName;
@@ -325,7 +328,7 @@ inline void WriteFunctionsFile(
     // 对标 Rei-Dumper：反射函数在前，预定义函数实现在后
     for (auto* entry : classes)
     {
-        auto funcs = CollectFunctions(entry->addr);
+        const auto& funcs = CollectFunctions(entry->addr);
         if (funcs.empty()) continue;
 
         std::string prefixed = AddStructPrefix(
@@ -335,21 +338,23 @@ inline void WriteFunctionsFile(
         bool isInterface = entry->isInterfaceChild;
 
         // 收集属性名，用于函数名冲突检测
-        auto fProps = CollectProperties(entry->addr);
-        std::unordered_set<std::string> fPropNames;
+        const auto& fProps = CollectProperties(entry->addr);
+        std::unordered_set<std::string_view> fPropNames;
         for (auto& pi : fProps) fPropNames.insert(pi.name);
 
+        std::string renamed;
         for (auto& func : funcs)
         {
-            FunctionInfo resolved = func;
-            if (fPropNames.count(resolved.name))
+            std::string_view funcName = func.name;
+            if (fPropNames.count(func.name))
             {
-                resolved.name += "_";
+                renamed = func.name + "_";
+                funcName = renamed;
             }
-            f << "\n";
-            f << GenerateFunctionImpl(
+            f += "\n";
+            AppendFunctionImpl(f,
                 cleanPkg, entry->name, prefixed,
-                resolved, isInterface, entry->collisionNs);
+                func, funcName, isInterface, entry->collisionNs);
         }
     }
 
@@ -360,29 +365,76 @@ inline void WriteFunctionsFile(
             entry->name);
         if (!predImpl.empty())
         {
-            f << predImpl;
+            f += predImpl;
         }
     }
 
-    f << "}\n\n";
-    f.close();
+    f += "}\n\n";
+    return f.ToString();
 }
 
-// 写入 _parameters.hpp — 函数参数结构体
-inline void WriteParametersFile(
-    const std::wstring& sdkDir,
-    const std::string& sanitizedName,
+// 生成 _fwd.hpp — 本包全部类型的前向声明
+// 枚举以 opaque 声明给出（固定底层类型，声明后即是完整类型）；名称冲突包的类已在 NameCollisions.inl 中声明
+// 只需类型名的代码（指针、引用、函数声明、模板实参）include 本文件即可，不再拉入完整定义
+inline std::string BuildForwardFile(
+    const std::string& rawPkgName,
+    const std::vector<const StructEntry*>& structs,
+    const std::vector<const StructEntry*>& classes,
+    const std::vector<EnumInfo>& enums)
+{
+    if (structs.empty() && classes.empty() && enums.empty())
+    {
+        return {};
+    }
+
+    CodeBuilder f;
+    WriteFileHeader(f, rawPkgName);
+    f += "\nnamespace SDK\n{\n\n";
+
+    for (auto& ei : enums)
+    {
+        AppendEnumForwardDecl(f, ei);
+    }
+    if (!enums.empty())
+    {
+        f += "\n";
+    }
+    for (auto* entry : structs)
+    {
+        f.Format("struct {};\n", AddStructPrefix(entry->name, false,
+            entry->isActorChild, entry->isInterfaceChild));
+    }
+    if (!structs.empty())
+    {
+        f += "\n";
+    }
+    for (auto* entry : classes)
+    {
+        if (entry->collisionNs.empty())
+        {
+            f.Format("class {};\n", AddStructPrefix(entry->name, true,
+                entry->isActorChild, entry->isInterfaceChild));
+        }
+    }
+
+    f += "\n}\n\n";
+    return f.ToString();
+}
+
+// 生成 _parameters.hpp — 函数参数结构体
+inline std::string BuildParametersFile(
     const std::string& rawPkgName,
     const std::vector<const StructEntry*>& classes,
     const PackageDeps& paramDeps,
-    const std::unordered_map<i32, std::string>& pkgIdxMap)
+    const std::unordered_map<i32, std::string>& pkgIdxMap,
+    const std::unordered_set<i32>* pkgsWithStructs = nullptr)
 {
     // 检查是否有任何函数需要参数结构体
     // 对标 Rei-Dumper：只有真正有 Parm 标记的参数才生成
     bool hasParamStructs = false;
     for (auto* entry : classes)
     {
-        auto funcs = CollectFunctions(entry->addr);
+        const auto& funcs = CollectFunctions(entry->addr);
         for (auto& func : funcs)
         {
             // 只有函数有实际参数（非空 params 列表）才算
@@ -397,49 +449,38 @@ inline void WriteParametersFile(
 
     if (!hasParamStructs)
     {
-        return;
-    }
-
-    std::wstring wName = Utf8ToWide(sanitizedName);
-    std::wstring path = sdkDir + L"/" + wName + L"_parameters.hpp";
-    std::ofstream f(path);
-    if (!f.is_open())
-    {
-        return;
+        return {};
     }
 
+    CodeBuilder f;
     WriteFileHeader(f, rawPkgName);
-    WriteDepsIncludes(f, paramDeps, pkgIdxMap);
-    f << "\nnamespace SDK::Params\n{\n\n";
+    WriteDepsIncludes(f, paramDeps, pkgIdxMap, pkgsWithStructs);
+    f += "\nnamespace SDK::Params\n{\n\n";
 
     for (auto* entry : classes)
     {
-        auto funcs = CollectFunctions(entry->addr);
+        const auto& funcs = CollectFunctions(entry->addr);
         for (auto& func : funcs)
         {
             // 只有有实际参数的函数才生成参数结构体
             if (func.paramStructSize > 0 && !func.params.empty())
             {
-                f << GenerateParamStruct(
+                AppendParamStruct(f,
                     rawPkgName, entry->name, func);
             }
         }
     }
 
-    f << "}\n\n";
-    f.close();
+    f += "}\n\n";
+    return f.ToString();
 }
 
-// 追加断言宏到 Assertions.inl
-inline void AppendAssertions(
-    std::ofstream& assertFile,
+// 生成一个包追加到 Assertions.inl 的断言宏
+inline std::string BuildAssertions(
     const std::vector<const StructEntry*>& structs,
     const std::vector<const StructEntry*>& classes)
 {
-    if (!assertFile.is_open())
-    {
-        return;
-    }
+    CodeBuilder assertFile;
 
     for (auto* entry : structs)
     {
@@ -452,7 +493,7 @@ inline void AppendAssertions(
         i32 aAlign = entry->alignment > 0
             ? entry->alignment : 1;
         i32 alignedSize = (uSize + aAlign - 1) & ~(aAlign - 1);
-        assertFile << GenerateAssertionMacro(
+        AppendAssertionMacro(assertFile,
             prefixed, prefixed, alignedSize,
             entry->alignment);
     }
@@ -489,12 +530,12 @@ inline void AppendAssertions(
             assertAlign = entry->alignment;
         }
 
-        assertFile << GenerateAssertionMacro(
+        AppendAssertionMacro(assertFile,
             assertName, typeName, assertSize,
             assertAlign);
 
         // 参数结构体断言（与 _parameters.hpp 中 struct 名保持一致）
-        auto funcs = CollectFunctions(entry->addr);
+        const auto& funcs = CollectFunctions(entry->addr);
         for (auto& func : funcs)
         {
             if (func.paramStructSize <= 0 || func.params.empty())
@@ -502,13 +543,17 @@ inline void AppendAssertions(
                 continue;
             }
 
-            std::string paramStructName = entry->name + "_" + func.name;
-            assertFile << GenerateParamAssertionMacro(
+            std::string& paramStructName = assertFile.Scratch();
+            paramStructName += entry->name;
+            paramStructName += '_';
+            paramStructName += func.name;
+            AppendParamAssertionMacro(assertFile,
                 paramStructName,
                 paramStructName,
                 func.paramStructSize);
         }
     }
+    return assertFile.ToString();
 }
 
 } // namespace detail
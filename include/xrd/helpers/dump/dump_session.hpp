@@ -0,0 +1,254 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出会话
+// 导出期间的缓存（属性 / 函数 / CastFlags / FFieldClass / 类型描述符 / 类型引用列表 / 驻留字符串 / 条目与依赖查找表）
+// 归属 DumpSession：绑定到线程后 SessionLocal 取会话内的槽，导出工作线程自动继承绑定
+// 会话析构即释放全部缓存；并发导出各自持有会话，互不清空对方的缓存
+// DumpCppSdk 等入口在未绑定会话时自动创建临时会话，结束时汇报缓存规模与命中率并释放
+
+#include "../../core/context.hpp"
+#include "dump_collect.hpp"
+#include "dump_deps.hpp"
+#include "dump_prefix.hpp"
+#include "dump_string_pool.hpp"
+#include "dump_type_desc.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace xrd
+{
+
+// 单个缓存的规模与命中情况（hits / misses 为 0 表示该缓存不计数）
+struct DumpCacheStat
+{
+    const char* name = "";
+    u64 entries = 0;
+    u64 bytes = 0;   // 近似占用：元素与哈希节点，不含分配器开销
+    u64 hits = 0;
+    u64 misses = 0;
+
+    double HitRate() const
+    {
+        u64 total = hits + misses;
+        return total ? static_cast<double>(hits) / total : 0.0;
+    }
+};
+
+struct DumpSessionStats
+{
+    std::vector<DumpCacheStat> caches;
+    u64 totalBytes = 0;
+    double seconds = 0; // 会话创建至今
+};
+
+class DumpSession
+{
+public:
+    DumpSession() : m_start(std::chrono::steady_clock::now()) {}
+
+    DumpSession(const DumpSession&) = delete;
+    DumpSession& operator=(const DumpSession&) = delete;
+
+    ContextCacheStore& Caches() { return m_caches; }
+
+    // 提前释放缓存（之后仍可继续使用，槽按需重建）；调用方保证没有线程持有缓存引用
+    void Release() { m_caches.Release(); }
+
+    DumpSessionStats Stats() const
+    {
+        DumpSessionStats s;
+        constexpr u64 kNode = 2 * sizeof(void*); // 哈希节点的链指针与缓存哈希值
+        if (auto* slot = m_caches.Find<detail::PropertiesCacheSlot>())
+        {
+            std::shared_lock<std::shared_mutex> lock(slot->mtx);
+            DumpCacheStat c = Counted("Properties", slot->counters);
+            for (auto& [addr, props] : slot->cache)
+            {
+                c.entries += props.size();
+                c.bytes += kNode + sizeof(addr) + sizeof(props) + props.capacity() * sizeof(detail::PropertyInfo);
+            }
+            s.caches.push_back(c);
+        }
+        if (auto* slot = m_caches.Find<detail::FunctionsCacheSlot>())
+        {
+            std::shared_lock<std::shared_mutex> lock(slot->mtx);
+            DumpCacheStat c = Counted("Functions", slot->counters);
+            for (auto& [addr, funcs] : slot->cache)
+            {
+                c.entries += funcs.size();
+                c.bytes += kNode + sizeof(addr) + sizeof(funcs) + funcs.capacity() * sizeof(detail::FunctionInfo);
+                for (auto& f : funcs)
+                {
+                    c.bytes += f.params.capacity() * sizeof(detail::FunctionParam);
+                }
+            }
+            s.caches.push_back(c);
+        }
+        if (auto* slot = m_caches.Find<detail::UClassCastFlagsCacheSlot>())
+        {
+            std::shared_lock<std::shared_mutex> lock(slot->mtx);
+            DumpCacheStat c = Counted("UClassCastFlags", slot->counters);
+            c.entries = slot->cache.size();
+            c.bytes = c.entries * (kNode + sizeof(uptr) + sizeof(u64));
+            s.caches.push_back(c);
+        }
+        if (auto* slot = m_caches.Find<detail::FieldClassCacheSlot>())
+        {
+            std::shared_lock<std::shared_mutex> lock(slot->mtx);
+            DumpCacheStat c = Counted("FieldClassCastFlags", slot->counters);
+            c.entries = slot->cache.size();
+            c.bytes = c.entries * (kNode + sizeof(uptr) + sizeof(u64));
+            s.caches.push_back(c);
+        }
+        if (auto* table = m_caches.Find<detail::TypeDescTable>())
+        {
+            DumpCacheStat c;
+            c.name = "TypeDesc";
+            c.entries = table->Size();
+            c.bytes = c.entries * (kNode + sizeof(detail::TypeDescKey) + sizeof(detail::TypeDesc));
+            c.hits = table->Hits();
+            c.misses = table->Misses();
+            s.caches.push_back(c);
+        }
+        if (auto* slot = m_caches.Find<detail::TypeRefListPoolSlot>())
+        {
+            std::shared_lock<std::shared_mutex> lock(slot->mtx);
+            DumpCacheStat c;
+            c.name = "TypeRefLists";
+            c.entries = slot->pool.size();
+            for (auto& refs : slot->pool)
+            {
+                c.bytes += kNode + sizeof(refs) + refs.capacity() * sizeof(detail::TypeRef);
+            }
+            s.caches.push_back(c);
+        }
+        if (auto* pool = m_caches.Find<detail::StringPool>())
+        {
+            DumpCacheStat c;
+            c.name = "StringPool";
+            c.entries = pool->Count();
+            c.bytes = pool->Bytes();
+            s.caches.push_back(c);
+        }
+        if (auto* slot = m_caches.Find<detail::EntryLookupSlot>())
+        {
+            DumpCacheStat c;
+            c.name = "EntryLookup";
+            c.entries = slot->lookup.size();
+            c.bytes = c.entries * (kNode + sizeof(std::string) + sizeof(void*));
+            s.caches.push_back(c);
+        }
+        if (auto* slot = m_caches.Find<detail::DepObjectLookupSlot>())
+        {
+            DumpCacheStat c;
+            c.name = "DepObjectLookup";
+            c.entries = slot->lookup.size();
+            c.bytes = c.entries * (kNode + sizeof(i32) + sizeof(detail::DepObjectInfo));
+            s.caches.push_back(c);
+        }
+        for (auto& c : s.caches)
+        {
+            s.totalBytes += c.bytes;
+        }
+        s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+        return s;
+    }
+
+    // 输出缓存规模与命中率
+    void Report() const
+    {
+        DumpSessionStats s = Stats();
+        std::cerr << std::fixed << std::setprecision(2)
+                  << "[xrd] 导出会话缓存: 约 " << (s.totalBytes >> 10) << " KB ("
+                  << s.seconds << "s)\n";
+        for (auto& c : s.caches)
+        {
+            std::cerr << "[xrd]   " << c.name << ": " << c.entries << " 项, "
+                      << (c.bytes >> 10) << " KB";
+            if (c.hits + c.misses > 0)
+            {
+                std::cerr << std::setprecision(1)
+                          << ", 命中率 " << c.HitRate() * 100.0 << "% ("
+                          << c.hits << "/" << c.hits + c.misses << ")";
+            }
+            std::cerr << "\n";
+        }
+        std::cerr.flush();
+    }
+
+private:
+    static DumpCacheStat Counted(const char* name, const CacheCounters& counters)
+    {
+        DumpCacheStat c;
+        c.name = name;
+        c.hits = counters.hits.load(std::memory_order_relaxed);
+        c.misses = counters.misses.load(std::memory_order_relaxed);
+        return c;
+    }
+
+    ContextCacheStore m_caches;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+// 作用域内将当前线程绑定到会话，析构时恢复之前的绑定
+// 同一会话内依次调用 CaptureReflectionModel / GenerateCppSdk / DumpUsmap 等可复用已采集的缓存
+class ScopedDumpSession
+{
+public:
+    explicit ScopedDumpSession(DumpSession& session)
+        : m_prev(ThreadSessionCaches())
+    {
+        BindThreadSessionCaches(&session.Caches());
+    }
+
+    ~ScopedDumpSession()
+    {
+        BindThreadSessionCaches(m_prev);
+    }
+
+    ScopedDumpSession(const ScopedDumpSession&) = delete;
+    ScopedDumpSession& operator=(const ScopedDumpSession&) = delete;
+
+private:
+    ContextCacheStore* m_prev;
+};
+
+namespace detail
+{
+
+// 导出入口使用：调用线程已绑定会话时沿用；否则创建临时会话，结束时汇报并释放
+class AutoDumpSession
+{
+public:
+    AutoDumpSession()
+    {
+        if (!ThreadSessionCaches())
+        {
+            m_owned = std::make_unique<DumpSession>();
+            m_scope.emplace(*m_owned);
+        }
+    }
+
+    ~AutoDumpSession()
+    {
+        m_scope.reset();
+        if (m_owned)
+        {
+            m_owned->Report();
+        }
+    }
+
+    AutoDumpSession(const AutoDumpSession&) = delete;
+    AutoDumpSession& operator=(const AutoDumpSession&) = delete;
+
+private:
+    std::unique_ptr<DumpSession> m_owned;
+    std::optional<ScopedDumpSession> m_scope;
+};
+
+} // namespace detail
+} // namespace xrd
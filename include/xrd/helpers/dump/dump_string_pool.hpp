@@ -0,0 +1,216 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：字符串驻留池
+// 属性名 / 类型名 / 字段类名在一次导出中大量重复（int32、TArray<class FName>、FloatProperty ...）
+// PropertyInfo / FunctionParam 只保存 4 字节编号，文本在池中只存一份
+// 池随所属导出会话（未绑定会话时为上下文）存在不清空：同一游戏的名称集合有限，重复导出不会持续增长
+// 编号只在创建它的池内有效：越界编号与池溢出直接终止，调试构建还会检查句柄与当前池是否一致
+
+#include "../../core/types.hpp"
+#include "../../core/context.hpp"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <shared_mutex>
+#include <mutex>
+#include <ostream>
+#include <iostream>
+#include <cstdlib>
+#include <format>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 驻留表：编号 → 文本为分块定长数组，已发布的编号可无锁读取
+// 新增条目在独占锁内写入，读取方拿到编号时已经与写入同步（编号经由持锁的缓存传递）
+class StringPool
+{
+public:
+    static constexpr u32 kChunkBits = 14;
+    static constexpr u32 kChunkSize = 1u << kChunkBits;
+    static constexpr u32 kMaxChunks = 4096; // 上限 6700 万个不同字符串
+
+    StringPool()
+    {
+        Intern(std::string_view{}); // 编号 0 固定为空串
+    }
+
+    u32 Intern(std::string_view text)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mtx);
+            auto it = m_ids.find(text);
+            if (it != m_ids.end())
+            {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        auto it = m_ids.find(text);
+        if (it != m_ids.end())
+        {
+            return it->second;
+        }
+        u32 id = m_count.load(std::memory_order_relaxed);
+        u32 chunk = id >> kChunkBits;
+        if (chunk >= kMaxChunks)
+        {
+            // 不能退回编号 0：那会把名称静默替换成空串
+            std::cerr << "[xrd] 字符串池已满: " << id << " 个字符串\n";
+            std::abort();
+        }
+        if (!m_chunks[chunk])
+        {
+            m_chunks[chunk] = std::make_unique<std::string[]>(kChunkSize);
+        }
+        std::string& slot = m_chunks[chunk][id & (kChunkSize - 1)];
+        slot.assign(text);
+        m_ids.emplace(std::string_view(slot), id);
+        m_bytes += slot.capacity() + sizeof(std::string);
+        m_count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // 编号不属于本池（超出已分配范围）时终止，而不是读取空块或其他字符串
+    const std::string& Get(u32 id) const
+    {
+        if (id >= m_count.load(std::memory_order_acquire))
+        {
+            std::cerr << "[xrd] 无效的驻留字符串编号: " << id << " (池中 "
+                      << m_count.load(std::memory_order_relaxed) << " 个)\n";
+            std::abort();
+        }
+        return m_chunks[id >> kChunkBits][id & (kChunkSize - 1)];
+    }
+
+    size_t Count() const
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    size_t Bytes() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return m_bytes;
+    }
+
+private:
+    mutable std::shared_mutex m_mtx;
+    std::unordered_map<std::string_view, u32> m_ids; // 键指向分块中的文本，地址稳定
+    std::unique_ptr<std::string[]> m_chunks[kMaxChunks];
+    std::atomic<u32> m_count{0}; // 槽写完后才发布，Get 据此判断编号是否有效
+    size_t m_bytes = 0;
+};
+
+// 驻留编号只在所属会话（或上下文）内有意义：属性 / 函数缓存与字符串池总在同一处
+inline StringPool& GetStringPool()
+{
+    return SessionLocal<StringPool>();
+}
+
+// 驻留字符串句柄：4 字节编号，按值传递
+// 可隐式转换为 const std::string&，读取侧与原来的 std::string 字段写法一致
+// 非空句柄只能在创建它的会话（池）内读取；调试构建额外记录所属池并在读取时核对
+class InternedString
+{
+public:
+    InternedString() = default;
+    InternedString(std::string_view text)
+    {
+        if (!text.empty())
+        {
+            StringPool& pool = GetStringPool();
+            m_id = pool.Intern(text);
+#ifndef NDEBUG
+            m_pool = &pool;
+#endif
+        }
+    }
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    const std::string& str() const
+    {
+        if (m_id == 0)
+        {
+            static const std::string kEmpty;
+            return kEmpty;
+        }
+        StringPool& pool = GetStringPool();
+#ifndef NDEBUG
+        if (m_pool != &pool)
+        {
+            std::cerr << "[xrd] 驻留字符串在所属会话之外读取: 编号 " << m_id << "\n";
+            std::abort();
+        }
+#endif
+        return pool.Get(m_id);
+    }
+    operator const std::string&() const { return str(); }
+    operator std::string_view() const { return str(); }
+
+    u32 id() const { return m_id; }
+    bool empty() const { return m_id == 0; }
+    size_t size() const { return str().size(); }
+    const char* c_str() const { return str().c_str(); }
+    const char* data() const { return str().data(); }
+    char operator[](size_t i) const { return str()[i]; }
+    char front() const { return str().front(); }
+    char back() const { return str().back(); }
+    size_t find(std::string_view s, size_t pos = 0) const { return str().find(s, pos); }
+    size_t find(char c, size_t pos = 0) const { return str().find(c, pos); }
+    bool starts_with(std::string_view s) const { return str().starts_with(s); }
+    bool ends_with(std::string_view s) const { return str().ends_with(s); }
+    std::string substr(size_t pos, size_t n = std::string::npos) const { return str().substr(pos, n); }
+    auto begin() const { return str().begin(); }
+    auto end() const { return str().end(); }
+
+    // 同一池内编号相同即文本相同
+    friend bool operator==(InternedString a, InternedString b) { return a.m_id == b.m_id; }
+    friend bool operator==(InternedString a, std::string_view b) { return a.str() == b; }
+    friend bool operator==(InternedString a, const std::string& b) { return a.str() == b; }
+    friend bool operator==(InternedString a, const char* b) { return a.str() == b; }
+    friend bool operator<(InternedString a, InternedString b) { return a.str() < b.str(); }
+
+    friend std::string operator+(InternedString a, std::string_view b) { return a.str() + std::string(b); }
+    friend std::string operator+(std::string_view a, InternedString b) { return std::string(a) + b.str(); }
+    friend std::string operator+(InternedString a, char b) { return a.str() + b; }
+    friend std::string operator+(char a, InternedString b) { return a + b.str(); }
+    friend std::string operator+(const std::string& a, InternedString b) { return a + b.str(); }
+    friend std::string operator+(InternedString a, const std::string& b) { return a.str() + b; }
+    friend std::string operator+(const char* a, InternedString b) { return a + b.str(); }
+    friend std::string operator+(InternedString a, const char* b) { return a.str() + b; }
+    friend std::string& operator+=(std::string& a, InternedString b) { return a += b.str(); }
+
+    friend std::ostream& operator<<(std::ostream& os, InternedString s) { return os << s.str(); }
+
+private:
+    u32 m_id = 0;
+#ifndef NDEBUG
+    const StringPool* m_pool = nullptr; // 所属池，仅用于校验
+#endif
+};
+
+} // namespace detail
+} // namespace xrd
+
+template<>
+struct std::formatter<xrd::detail::InternedString> : std::formatter<std::string_view>
+{
+    auto format(const xrd::detail::InternedString& s, std::format_context& ctx) const
+    {
+        return std::formatter<std::string_view>::format(s.str(), ctx);
+    }
+};
+
+template<>
+struct std::hash<xrd::detail::InternedString>
+{
+    size_t operator()(const xrd::detail::InternedString& s) const noexcept
+    {
+        return std::hash<xrd::u32>{}(s.id());
+    }
+};
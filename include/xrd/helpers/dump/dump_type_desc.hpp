@@ -0,0 +1,256 @@
+#pragma once
+// Xrd-eXternalrEsolve - 属性类型描述符（哈希合并）
+// 一个属性类型由 (字段类, 关联对象指针, 内层元素描述符, 附加位) 唯一确定
+// 相同类型共享同一个描述符：名称解析、委托签名与字符串渲染每种类型只做一次
+// 如数千个 TArray<class FName> 属性只解析一次 NameProperty 与一次 TArray
+
+#include "../../core/types.hpp"
+#include "../../core/context.hpp"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <shared_mutex>
+#include <mutex>
+#include <atomic>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 类型引用：属性类型中出现的 UScriptStruct / UEnum
+// 在解析类型时按 GObjects 索引记录，依赖收集直接使用，无需再解析类型字符串
+struct TypeRef
+{
+    i32 index = -1;
+    bool isEnum = false;
+    // 位于容器模板参数内（TArray<struct FX> 等）：结构体只需声明即可
+    bool inTemplate = false;
+};
+
+// 合并一条类型引用：同一对象只保留一条，直接引用优先
+inline void MergeTypeRef(std::vector<TypeRef>& refs, const TypeRef& ref)
+{
+    for (auto& r : refs)
+    {
+        if (r.index == ref.index)
+        {
+            r.inTemplate = r.inTemplate && ref.inTemplate;
+            return;
+        }
+    }
+    refs.push_back(ref);
+}
+
+// 驻留的类型引用列表：内容相同的列表共享一份存储，属性 / 参数只保存一个指针
+// 多数属性没有引用（空列表为 nullptr，不分配）；列表存放在会话槽中，随 DumpSession 释放
+// 不能在会话结束后使用（属性缓存与之同时释放）
+class TypeRefList
+{
+public:
+    TypeRefList() = default;
+    explicit TypeRefList(const std::vector<TypeRef>* list) : m_list(list) {}
+
+    const TypeRef* begin() const { return m_list ? m_list->data() : nullptr; }
+    const TypeRef* end() const { return m_list ? m_list->data() + m_list->size() : nullptr; }
+    size_t size() const { return m_list ? m_list->size() : 0; }
+    bool empty() const { return size() == 0; }
+    const TypeRef& operator[](size_t i) const { return (*m_list)[i]; }
+
+private:
+    const std::vector<TypeRef>* m_list = nullptr;
+};
+
+struct TypeRefListHash
+{
+    size_t operator()(const std::vector<TypeRef>& refs) const
+    {
+        u64 h = 0xCBF29CE484222325ull;
+        for (auto& r : refs)
+        {
+            u64 v = (static_cast<u64>(static_cast<u32>(r.index)) << 2)
+                | (r.isEnum ? 1u : 0u) | (r.inTemplate ? 2u : 0u);
+            h = (h ^ v) * 0x100000001B3ull;
+        }
+        return static_cast<size_t>(h);
+    }
+};
+
+struct TypeRefListEqual
+{
+    bool operator()(const std::vector<TypeRef>& a, const std::vector<TypeRef>& b) const
+    {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+            [](const TypeRef& x, const TypeRef& y)
+            {
+                return x.index == y.index && x.isEnum == y.isEnum && x.inTemplate == y.inTemplate;
+            });
+    }
+};
+
+// 节点式容器：元素地址在插入其他列表后保持不变
+struct TypeRefListPoolSlot
+{
+    std::unordered_set<std::vector<TypeRef>, TypeRefListHash, TypeRefListEqual> pool;
+    std::shared_mutex mtx;
+};
+
+inline TypeRefList InternTypeRefs(const std::vector<TypeRef>& refs)
+{
+    if (refs.empty())
+    {
+        return {};
+    }
+    auto& [pool, mtx] = SessionLocal<TypeRefListPoolSlot>();
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = pool.find(refs);
+        if (it != pool.end())
+        {
+            return TypeRefList(&*it);
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(mtx);
+    auto [it, inserted] = pool.insert(refs);
+    return TypeRefList(&*it);
+}
+
+// 已解析的类型：渲染后的 C++ 类型字符串 + 其中引用的结构体/枚举
+// refs 的 inTemplate 相对本类型（TArray<FX> 中的 FX 为 true）
+// fieldClass/refName/inner 保留类型结构，供 .usmap 等按类型树输出的格式使用
+// 插入描述符表后不再修改，可跨线程只读共享
+struct TypeDesc
+{
+    std::string name;
+    std::vector<TypeRef> refs;
+    std::string fieldClass;        // 原始 FField 类名
+    std::string refName;           // 关联结构体/枚举的原始对象名（无前缀），无关联时为空
+    const TypeDesc* inner[2] = {}; // 同 TypeDescKey::inner；EnumProperty 的 [0] 为底层整数属性
+};
+
+struct TypeDescKey
+{
+    u32 fieldClass = 0;            // 字段类名的驻留编号
+    u32 context = 0;               // 解析上下文（委托签名嵌套深度，影响截断）
+    uptr ref = 0;                  // 关联的 UClass/UScriptStruct/UEnum/UFunction，无效时为 0
+    const TypeDesc* inner[2] = {}; // 元素描述符：TArray/TSet/EnumProperty 用 [0]，TMap 为键/值
+    u64 extra = 0;                 // 影响渲染的附加位（见 TypeDescExtra）
+
+    bool operator==(const TypeDescKey& o) const
+    {
+        return fieldClass == o.fieldClass && context == o.context
+            && ref == o.ref && inner[0] == o.inner[0]
+            && inner[1] == o.inner[1] && extra == o.extra;
+    }
+};
+
+namespace TypeDescExtra
+{
+    constexpr u64 Truncated      = 1ull << 63; // 递归深度超限，直接输出字段类名
+    constexpr u64 ObjectWrapper  = 1ull << 62; // ClassProperty 带 UObjectWrapper 标志
+    constexpr u64 NoBoolInfo     = 1ull << 61; // BoolProperty 偏移未知
+    // BoolProperty：低 8 位为 FieldMask，8..39 位为 ElementSize
+}
+
+struct TypeDescKeyHash
+{
+    size_t operator()(const TypeDescKey& k) const
+    {
+        u64 h = (static_cast<u64>(k.fieldClass) << 32) ^ k.context;
+        auto mix = [&](u64 v)
+        {
+            h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+        };
+        mix(static_cast<u64>(k.ref));
+        mix(reinterpret_cast<uptr>(k.inner[0]));
+        mix(reinterpret_cast<uptr>(k.inner[1]));
+        mix(k.extra);
+        return static_cast<size_t>(h);
+    }
+};
+
+// 描述符表：键 → 描述符（节点式容器，描述符地址在表清空前保持有效）
+// 多线程采集时共享读、独占写；未命中时在锁外渲染，插入冲突时保留先插入者
+class TypeDescTable
+{
+public:
+    // 字段类名驻留编号（从 1 开始）
+    u32 FieldClassId(const std::string& name)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(mtx);
+            auto it = fieldClasses.find(name);
+            if (it != fieldClasses.end())
+            {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        auto [it, inserted] = fieldClasses.try_emplace(
+            name, static_cast<u32>(fieldClasses.size() + 1));
+        return it->second;
+    }
+
+    const TypeDesc* Find(const TypeDescKey& key)
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        auto it = descs.find(key);
+        if (it == descs.end())
+        {
+            return nullptr;
+        }
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return &it->second;
+    }
+
+    const TypeDesc* Insert(const TypeDescKey& key, TypeDesc desc)
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        auto [it, inserted] = descs.try_emplace(key, std::move(desc));
+        if (inserted)
+        {
+            misses.fetch_add(1, std::memory_order_relaxed);
+        }
+        return &it->second;
+    }
+
+    // 清空后之前返回的描述符全部失效；仅在没有并发解析时调用
+    void Clear()
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx);
+        descs.clear();
+        hits = 0;
+        misses = 0;
+    }
+
+    size_t Size() const
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx);
+        return descs.size();
+    }
+    u64 Hits() const { return hits.load(); }
+    u64 Misses() const { return misses.load(); }
+
+private:
+    mutable std::shared_mutex mtx;
+    std::unordered_map<std::string, u32> fieldClasses;
+    std::unordered_map<TypeDescKey, TypeDesc, TypeDescKeyHash> descs;
+    std::atomic<u64> hits{0};
+    std::atomic<u64> misses{0};
+};
+
+inline TypeDescTable& GetTypeDescTable()
+{
+    return SessionLocal<TypeDescTable>();
+}
+
+// 清空描述符表（每次采集开始前调用：前缀名依赖当时的条目查找表）
+inline void ClearTypeDescCache()
+{
+    GetTypeDescTable().Clear();
+}
+
+} // namespace detail
+} // namespace xrd
@@ -2,11 +2,14 @@
 // Xrd-eXternalrEsolve - 属性类型精确解析
 // 通过读取类型化属性的关联指针，解析出精确的 C++ 类型字符串
 // 如 TArray<FVector>、UStaticMeshComponent*、ECollisionChannel 等
+// 同时记录类型中引用的结构体/枚举索引（TypeRef），供依赖收集使用
+// 解析结果按类型描述符哈希合并（dump_type_desc.hpp），相同类型只解析一次
 
 #include "../../core/context.hpp"
 #include "../../engine/objects/objects.hpp"
 #include "../../engine/names.hpp"
 #include "dump_prefix.hpp"
+#include "dump_type_desc.hpp"
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -89,6 +92,27 @@ inline u64 GetFFieldCastFlags(uptr ffield)
     return flags;
 }
 
+// 当前线程的类型引用记录目标（为空时不记录）
+inline thread_local std::vector<TypeRef>* g_typeRefSink = nullptr;
+
+// 作用域内把 ResolvePropertyType 遇到的类型引用写入 out（传 nullptr 暂停记录）
+struct TypeRefCapture
+{
+    explicit TypeRefCapture(std::vector<TypeRef>* out)
+        : prev(g_typeRefSink)
+    {
+        g_typeRefSink = out;
+    }
+    ~TypeRefCapture()
+    {
+        g_typeRefSink = prev;
+    }
+    TypeRefCapture(const TypeRefCapture&) = delete;
+    TypeRefCapture& operator=(const TypeRefCapture&) = delete;
+
+    std::vector<TypeRef>* prev;
+};
+
 // 前向声明，GetDelegateFunctionSignature 需要调用它
 inline std::string ResolvePropertyType(uptr prop, const std::string& fieldClassName);
 
@@ -111,18 +135,22 @@ inline bool IsValidUFunction(uptr ptr)
         || className == "SparseDelegateFunction");
 }
 
+// 当前线程 delegate 签名的嵌套深度（超过 4 层输出 void()）
+inline thread_local int g_delegateDepth = 0;
+
 // 生成 Delegate 签名字符串，对标 Rei-Dumper GetFunctionSignature
 // 格式：RetType(Param1Type Param1Name, ...)
 inline std::string GetDelegateFunctionSignature(uptr funcObj)
 {
     // 防止 delegate 签名无限递归
-    static thread_local int g_delegateDepth = 0;
     if (!funcObj || g_delegateDepth > 4)
     {
         return "void()";
     }
     g_delegateDepth++;
     struct DelegateDepthGuard { ~DelegateDepthGuard() { g_delegateDepth--; } } delegateGuard;
+    // 签名中的参数类型不是属性本身的依赖（与 Rei-Dumper 的包依赖一致）
+    TypeRefCapture noRefs(nullptr);
 
     auto& off = Off();
     std::string retType = "void";
@@ -246,365 +274,386 @@ inline std::string GetDelegateFunctionSignature(uptr funcObj)
 // 递归深度保护：防止 delegate 参数中嵌套 delegate 导致无限递归
 inline thread_local int g_resolveDepth = 0;
 
-// 通过 FField 类名获取精确类型字符串
-// 这是核心函数：根据属性类型读取关联的 UClass/UStruct/UEnum 指针
-inline std::string ResolvePropertyType(uptr prop, const std::string& fieldClassName)
+// 把描述符中的类型引用写入当前记录目标
+// 外层已在解析中（g_resolveDepth > 0）说明本类型位于容器元素内
+inline void NoteTypeRefs(const TypeDesc& desc)
 {
-    // 递归深度保护
-    if (g_resolveDepth > 32)
+    if (!g_typeRefSink)
     {
-        return fieldClassName;
+        return;
     }
-    g_resolveDepth++;
-    struct DepthGuard { ~DepthGuard() { g_resolveDepth--; } } guard;
-    auto& off = Off();
+    bool nested = g_resolveDepth > 0;
+    for (auto& r : desc.refs)
+    {
+        MergeTypeRef(*g_typeRefSink, {r.index, r.isEnum, r.inTemplate || nested});
+    }
+}
 
-    // ─── ObjectProperty / ObjectPropertyBase ───
-    if (fieldClassName == "ObjectProperty" || fieldClassName == "ObjectPropertyBase")
+inline const TypeDesc* ResolveTypeDesc(uptr prop, const std::string& fieldClassName);
+
+// 读取指针，无效时返回 0
+inline uptr ReadTypeOperand(uptr addr, i32 offset)
+{
+    if (offset == -1)
     {
-        if (off.ObjectProperty_Class != -1)
-        {
-            uptr classPtr = 0;
-            GReadPtr(prop + off.ObjectProperty_Class, classPtr);
-            if (IsCanonicalUserPtr(classPtr))
-            {
-                std::string name = GetStructPrefixedName(classPtr);
-                return "class " + name + "*";
-            }
-        }
-        return "class UObject*";
+        return 0;
     }
+    uptr p = 0;
+    GReadPtr(addr + offset, p);
+    return IsCanonicalUserPtr(p) ? p : 0;
+}
 
-    // ─── ClassProperty ───
-    // 对标 Rei-Dumper：有 UObjectWrapper 标志时输出 TSubclassOf<T>，否则 UClass*
-    if (fieldClassName == "ClassProperty")
+// 解析容器内层属性的描述符
+inline const TypeDesc* ResolveInnerTypeDesc(uptr innerProp)
+{
+    if (!innerProp)
+    {
+        return nullptr;
+    }
+    return ResolveTypeDesc(innerProp, GetFFieldClassName(innerProp));
+}
+
+// 读取描述符键的操作数：只读取关联指针与渲染所需的少量字段，不解析名称
+// 容器的内层属性递归解析为描述符
+inline void ReadTypeDescKey(uptr prop, const std::string& fc, TypeDescKey& key)
+{
+    auto& off = Off();
+
+    if (fc == "ObjectProperty" || fc == "ObjectPropertyBase"
+        || fc == "WeakObjectProperty" || fc == "LazyObjectProperty"
+        || fc == "SoftObjectProperty" || fc == "InterfaceProperty")
+    {
+        key.ref = ReadTypeOperand(prop, off.ObjectProperty_Class);
+    }
+    else if (fc == "ClassProperty")
     {
         // UObjectWrapper flag = 0x0004000000000000
-        // 读取 PropertyFlags 判断是否有 UObjectWrapper
         u64 propFlags = 0;
         if (off.Property_PropertyFlags != -1)
         {
             GReadValue(prop + off.Property_PropertyFlags, propFlags);
         }
-        bool hasUObjectWrapper = (propFlags & 0x0004000000000000ULL) != 0;
-        if (hasUObjectWrapper && off.ClassProperty_MetaClass != -1)
+        if ((propFlags & 0x0004000000000000ULL) && off.ClassProperty_MetaClass != -1)
         {
-            uptr metaClass = 0;
-            GReadPtr(prop + off.ClassProperty_MetaClass, metaClass);
-            if (IsCanonicalUserPtr(metaClass))
-            {
-                std::string name = GetStructPrefixedName(metaClass);
-                return "TSubclassOf<class " + name + ">";
-            }
-            return "TSubclassOf<class UObject>";
+            key.extra = TypeDescExtra::ObjectWrapper;
+            key.ref = ReadTypeOperand(prop, off.ClassProperty_MetaClass);
         }
-        return "class UClass*";
     }
-
-    // ─── WeakObjectProperty ───
-    if (fieldClassName == "WeakObjectProperty")
+    else if (fc == "SoftClassProperty")
     {
-        if (off.ObjectProperty_Class != -1)
+        // MetaClass 优先，回退 PropertyClass；两者输出格式相同
+        key.ref = ReadTypeOperand(prop, off.ClassProperty_MetaClass);
+        if (!key.ref)
         {
-            uptr classPtr = 0;
-            GReadPtr(prop + off.ObjectProperty_Class, classPtr);
-            if (IsCanonicalUserPtr(classPtr))
-            {
-                std::string name = GetStructPrefixedName(classPtr);
-                return "TWeakObjectPtr<class " + name + ">";
-            }
+            key.ref = ReadTypeOperand(prop, off.ObjectProperty_Class);
         }
-        return "TWeakObjectPtr<UObject>";
     }
-
-    // ─── LazyObjectProperty ───
-    // 对标 Rei-Dumper：输出 TLazyObjectPtr<class T>
-    if (fieldClassName == "LazyObjectProperty")
+    else if (fc == "StructProperty")
+    {
+        key.ref = ReadTypeOperand(prop, off.StructProperty_Struct);
+    }
+    else if (fc == "ArrayProperty")
+    {
+        key.inner[0] = ResolveInnerTypeDesc(
+            ReadTypeOperand(prop, off.ArrayProperty_Inner));
+    }
+    else if (fc == "SetProperty")
+    {
+        key.inner[0] = ResolveInnerTypeDesc(
+            ReadTypeOperand(prop, off.SetProperty_ElementProp));
+    }
+    else if (fc == "MapProperty")
     {
-        if (off.ObjectProperty_Class != -1)
+        if (off.MapProperty_Base != -1)
         {
-            uptr classPtr = 0;
-            GReadPtr(prop + off.ObjectProperty_Class, classPtr);
-            if (IsCanonicalUserPtr(classPtr))
-            {
-                std::string name = GetStructPrefixedName(classPtr);
-                return "TLazyObjectPtr<class " + name + ">";
-            }
+            key.inner[0] = ResolveInnerTypeDesc(
+                ReadTypeOperand(prop, off.MapProperty_Base));
+            key.inner[1] = ResolveInnerTypeDesc(
+                ReadTypeOperand(prop, off.MapProperty_Base + 8));
         }
-        return "TLazyObjectPtr<class UObject>";
     }
-
-    // ─── SoftObjectProperty ───
-    // 对标 Rei-Dumper：读取 PropertyClass 获取精确类型
-    if (fieldClassName == "SoftObjectProperty")
+    else if (fc == "EnumProperty")
     {
-        if (off.ObjectProperty_Class != -1)
+        // Enum 指针在 Base+8（Base+0 是 UnderlayingProperty）
+        if (off.EnumProperty_Base != -1)
         {
-            uptr classPtr = 0;
-            GReadPtr(prop + off.ObjectProperty_Class, classPtr);
-            if (IsCanonicalUserPtr(classPtr))
-            {
-                std::string name = GetStructPrefixedName(classPtr);
-                return "TSoftObjectPtr<class " + name + ">";
-            }
+            key.inner[0] = ResolveInnerTypeDesc(
+                ReadTypeOperand(prop, off.EnumProperty_Base));
+            key.ref = ReadTypeOperand(prop, off.EnumProperty_Base + 8);
         }
-        return "TSoftObjectPtr<class UObject>";
     }
-
-    // ─── SoftClassProperty ───
-    // 对标 Rei-Dumper：SoftClassProperty 继承自 SoftObjectProperty
-    // MetaClass 在 ClassProperty_MetaClass 偏移处
-    if (fieldClassName == "SoftClassProperty")
+    else if (fc == "ByteProperty")
+    {
+        key.ref = ReadTypeOperand(prop, off.ByteProperty_Enum);
+    }
+    else if (fc == "DelegateProperty" || fc == "MulticastDelegateProperty"
+        || fc == "MulticastInlineDelegateProperty")
+    {
+        key.ref = ReadTypeOperand(prop, off.DelegateProperty_Sig);
+    }
+    else if (fc == "BoolProperty")
     {
-        if (off.ClassProperty_MetaClass != -1)
+        // native bool: FieldMask == 0xFF（整个字节）
+        if (off.BoolProperty_Base == -1)
         {
-            uptr metaClass = 0;
-            GReadPtr(prop + off.ClassProperty_MetaClass, metaClass);
-            if (IsCanonicalUserPtr(metaClass))
-            {
-                std::string name = GetStructPrefixedName(metaClass);
-                return "TSoftClassPtr<class " + name + ">";
-            }
+            key.extra = TypeDescExtra::NoBoolInfo;
+            return;
         }
-        // 回退：尝试 PropertyClass
-        if (off.ObjectProperty_Class != -1)
+        u8 fieldMask = 0;
+        Mem().Read(prop + off.BoolProperty_Base + 3, &fieldMask, 1);
+        i32 propSize = 0;
+        if (fieldMask != 0xFF && off.Property_ElementSize != -1)
         {
-            uptr classPtr = 0;
-            GReadPtr(prop + off.ObjectProperty_Class, classPtr);
-            if (IsCanonicalUserPtr(classPtr))
-            {
-                std::string name = GetStructPrefixedName(classPtr);
-                return "TSoftClassPtr<class " + name + ">";
-            }
+            GReadValue(prop + off.Property_ElementSize, propSize);
         }
-        return "TSoftClassPtr<class UObject>";
+        key.extra = fieldMask | (static_cast<u64>(static_cast<u32>(propSize)) << 8);
     }
+}
 
-    // ─── InterfaceProperty ───
-    if (fieldClassName == "InterfaceProperty")
+// 枚举类型名：对标 Rei-Dumper，枚举名不以 E 开头时加 E 前缀
+inline std::string EnumTypeName(const std::string& rawName)
+{
+    std::string name = rawName;
+    if (!name.empty() && name[0] != 'E')
     {
-        if (off.ObjectProperty_Class != -1)
-        {
-            uptr classPtr = 0;
-            GReadPtr(prop + off.ObjectProperty_Class, classPtr);
-            if (IsCanonicalUserPtr(classPtr))
-            {
-                std::string name = GetObjectName(classPtr);
-                if (!name.empty())
-                {
-                    return "TScriptInterface<class I" + name + ">";
-                }
-            }
-        }
-        return "TScriptInterface<class IInterface>";
+        name = "E" + name;
     }
+    return name;
+}
 
-    // ─── StructProperty ───
-    // 对标 Rei-Dumper：StructProperty 类型始终带 struct 前缀
-    if (fieldClassName == "StructProperty")
+// 记录一个直接引用的结构体/枚举
+inline void AddDescRef(TypeDesc& out, uptr obj, bool isEnum)
+{
+    i32 idx = GetObjectIndex(obj);
+    if (idx > 0)
     {
-        if (off.StructProperty_Struct != -1)
-        {
-            uptr structPtr = 0;
-            GReadPtr(prop + off.StructProperty_Struct, structPtr);
-            if (IsCanonicalUserPtr(structPtr))
-            {
-                return "struct " + GetStructPrefixedName(structPtr);
-            }
-        }
-        return "struct FUnknownStruct";
+        MergeTypeRef(out.refs, {idx, isEnum, false});
     }
+}
 
-    // ─── ArrayProperty ───
-    if (fieldClassName == "ArrayProperty")
+// 合并内层描述符的引用（位于模板参数内）
+inline void AddInnerRefs(TypeDesc& out, const TypeDesc* inner)
+{
+    if (!inner)
     {
-        if (off.ArrayProperty_Inner != -1)
-        {
-            uptr innerProp = 0;
-            GReadPtr(prop + off.ArrayProperty_Inner, innerProp);
-            if (IsCanonicalUserPtr(innerProp))
-            {
-                std::string innerClassName = GetFFieldClassName(innerProp);
-                std::string innerType = ResolvePropertyType(
-                    innerProp, innerClassName);
-                return "TArray<" + innerType + ">";
-            }
-        }
-        return "TArray<uint8>";
+        return;
     }
-
-    // ─── SetProperty ───
-    if (fieldClassName == "SetProperty")
+    for (auto& r : inner->refs)
     {
-        if (off.SetProperty_ElementProp != -1)
-        {
-            uptr elemProp = 0;
-            GReadPtr(prop + off.SetProperty_ElementProp, elemProp);
-            if (IsCanonicalUserPtr(elemProp))
-            {
-                std::string elemClassName = GetFFieldClassName(elemProp);
-                std::string elemType = ResolvePropertyType(
-                    elemProp, elemClassName);
-                return "TSet<" + elemType + ">";
-            }
-        }
-        return "TSet<uint8>";
+        MergeTypeRef(out.refs, {r.index, r.isEnum, true});
     }
+}
 
-    // ─── MapProperty ───
-    if (fieldClassName == "MapProperty")
-    {
-        if (off.MapProperty_Base != -1)
-        {
-            uptr keyProp = 0, valProp = 0;
-            GReadPtr(prop + off.MapProperty_Base, keyProp);
-            GReadPtr(prop + off.MapProperty_Base + 8, valProp);
-
-            std::string keyType = "uint8";
-            std::string valType = "uint8";
+// 由描述符键渲染 C++ 类型字符串
+// 这是核心函数：根据属性类型读取关联的 UClass/UStruct/UEnum 名称
+inline void RenderTypeDesc(const std::string& fc, const TypeDescKey& key, TypeDesc& out)
+{
+    std::string& name = out.name;
+    uptr ref = key.ref;
 
-            if (IsCanonicalUserPtr(keyProp))
-            {
-                keyType = ResolvePropertyType(
-                    keyProp, GetFFieldClassName(keyProp));
-            }
-            if (IsCanonicalUserPtr(valProp))
-            {
-                valType = ResolvePropertyType(
-                    valProp, GetFFieldClassName(valProp));
-            }
-            return "TMap<" + keyType + ", " + valType + ">";
-        }
-        return "TMap<uint8, uint8>";
+    if (key.extra & TypeDescExtra::Truncated)
+    {
+        name = fc;
     }
-
-    // ─── EnumProperty ───
-    if (fieldClassName == "EnumProperty")
+    // ─── ObjectProperty / ObjectPropertyBase ───
+    else if (fc == "ObjectProperty" || fc == "ObjectPropertyBase")
     {
-        if (off.EnumProperty_Base != -1)
-        {
-            uptr enumPtr = 0;
-            // Enum 指针在 Base+8（Base+0 是 UnderlayingProperty）
-            GReadPtr(prop + off.EnumProperty_Base + 8, enumPtr);
-            if (IsCanonicalUserPtr(enumPtr))
-            {
-                std::string name = GetObjectName(enumPtr);
-                if (!name.empty())
-                {
-                    // 对标 Rei-Dumper：枚举名不以 E 开头时加 E 前缀
-                    if (name[0] != 'E')
-                    {
-                        name = "E" + name;
-                    }
-                    return name;
-                }
-            }
-        }
-        return "uint8";
+        name = ref ? "class " + GetStructPrefixedName(ref) + "*" : "class UObject*";
     }
-
-    // ─── ByteProperty（可能关联 Enum） ───
-    if (fieldClassName == "ByteProperty")
+    // ─── ClassProperty ───
+    // 对标 Rei-Dumper：有 UObjectWrapper 标志时输出 TSubclassOf<T>，否则 UClass*
+    else if (fc == "ClassProperty")
     {
-        if (off.ByteProperty_Enum != -1)
+        if (!(key.extra & TypeDescExtra::ObjectWrapper))
         {
-            uptr enumPtr = 0;
-            GReadPtr(prop + off.ByteProperty_Enum, enumPtr);
-            if (IsCanonicalUserPtr(enumPtr))
-            {
-                std::string name = GetObjectName(enumPtr);
-                if (!name.empty())
-                {
-                    // 对标 Rei-Dumper：枚举名不以 E 开头时加 E 前缀
-                    if (name[0] != 'E')
-                    {
-                        name = "E" + name;
-                    }
-                    return name;
-                }
-            }
+            name = "class UClass*";
+        }
+        else
+        {
+            name = ref ? "TSubclassOf<class " + GetStructPrefixedName(ref) + ">"
+                : "TSubclassOf<class UObject>";
         }
-        return "uint8";
     }
-
-    // ─── DelegateProperty ───
-    if (fieldClassName == "DelegateProperty")
+    // ─── WeakObjectProperty ───
+    else if (fc == "WeakObjectProperty")
+    {
+        name = ref ? "TWeakObjectPtr<class " + GetStructPrefixedName(ref) + ">"
+            : "TWeakObjectPtr<UObject>";
+    }
+    // ─── LazyObjectProperty ───
+    // 对标 Rei-Dumper：输出 TLazyObjectPtr<class T>
+    else if (fc == "LazyObjectProperty")
+    {
+        name = ref ? "TLazyObjectPtr<class " + GetStructPrefixedName(ref) + ">"
+            : "TLazyObjectPtr<class UObject>";
+    }
+    // ─── SoftObjectProperty ───
+    // 对标 Rei-Dumper：读取 PropertyClass 获取精确类型
+    else if (fc == "SoftObjectProperty")
+    {
+        name = ref ? "TSoftObjectPtr<class " + GetStructPrefixedName(ref) + ">"
+            : "TSoftObjectPtr<class UObject>";
+    }
+    // ─── SoftClassProperty ───
+    // 对标 Rei-Dumper：SoftClassProperty 继承自 SoftObjectProperty
+    else if (fc == "SoftClassProperty")
+    {
+        name = ref ? "TSoftClassPtr<class " + GetStructPrefixedName(ref) + ">"
+            : "TSoftClassPtr<class UObject>";
+    }
+    // ─── InterfaceProperty ───
+    else if (fc == "InterfaceProperty")
+    {
+        std::string cls = ref ? GetObjectName(ref) : std::string();
+        name = !cls.empty() ? "TScriptInterface<class I" + cls + ">"
+            : "TScriptInterface<class IInterface>";
+    }
+    // ─── StructProperty ───
+    // 对标 Rei-Dumper：StructProperty 类型始终带 struct 前缀
+    else if (fc == "StructProperty")
     {
-        if (off.DelegateProperty_Sig != -1)
+        if (ref)
         {
-            uptr sigFunc = 0;
-            GReadPtr(prop + off.DelegateProperty_Sig, sigFunc);
-            if (IsValidUFunction(sigFunc))
-            {
-                std::string sig = GetDelegateFunctionSignature(sigFunc);
-                return "TDelegate<" + sig + ">";
-            }
+            AddDescRef(out, ref, false);
+            out.refName = GetObjectName(ref);
+            name = "struct " + GetStructPrefixedName(ref);
+        }
+        else
+        {
+            name = "struct FUnknownStruct";
         }
-        return "TDelegate<void()>";
     }
-    if (fieldClassName == "MulticastDelegateProperty" ||
-        fieldClassName == "MulticastInlineDelegateProperty" ||
-        fieldClassName == "MulticastSparseDelegateProperty")
+    // ─── ArrayProperty / SetProperty / MapProperty ───
+    else if (fc == "ArrayProperty" || fc == "SetProperty")
     {
-        // MulticastSparseDelegateProperty 使用特殊类型名
-        // 对标 Rei-Dumper：sparse delegate 输出 FMulticastSparseDelegateProperty_
-        if (fieldClassName == "MulticastSparseDelegateProperty")
+        name = fc == "ArrayProperty" ? "TArray<" : "TSet<";
+        name += key.inner[0] ? key.inner[0]->name : "uint8";
+        name += '>';
+        AddInnerRefs(out, key.inner[0]);
+    }
+    else if (fc == "MapProperty")
+    {
+        name = "TMap<";
+        name += key.inner[0] ? key.inner[0]->name : "uint8";
+        name += ", ";
+        name += key.inner[1] ? key.inner[1]->name : "uint8";
+        name += '>';
+        AddInnerRefs(out, key.inner[0]);
+        AddInnerRefs(out, key.inner[1]);
+    }
+    // ─── EnumProperty / ByteProperty（可能关联 Enum） ───
+    else if (fc == "EnumProperty" || fc == "ByteProperty")
+    {
+        if (ref)
         {
-            return "FMulticastSparseDelegateProperty_";
+            out.refName = GetObjectName(ref);
         }
-
-        if (off.DelegateProperty_Sig != -1)
+        name = EnumTypeName(out.refName);
+        if (name.empty())
         {
-            uptr sigFunc = 0;
-            GReadPtr(prop + off.DelegateProperty_Sig, sigFunc);
-            if (IsValidUFunction(sigFunc))
-            {
-                std::string sig = GetDelegateFunctionSignature(sigFunc);
-                return "TMulticastInlineDelegate<" + sig + ">";
-            }
+            name = "uint8";
+        }
+        else
+        {
+            AddDescRef(out, ref, true);
         }
-        return "TMulticastInlineDelegate<void()>";
     }
-
+    // ─── DelegateProperty ───
+    else if (fc == "DelegateProperty")
+    {
+        name = IsValidUFunction(ref)
+            ? "TDelegate<" + GetDelegateFunctionSignature(ref) + ">"
+            : "TDelegate<void()>";
+    }
+    // 对标 Rei-Dumper：sparse delegate 输出 FMulticastSparseDelegateProperty_
+    else if (fc == "MulticastSparseDelegateProperty")
+    {
+        name = "FMulticastSparseDelegateProperty_";
+    }
+    else if (fc == "MulticastDelegateProperty" || fc == "MulticastInlineDelegateProperty")
+    {
+        name = IsValidUFunction(ref)
+            ? "TMulticastInlineDelegate<" + GetDelegateFunctionSignature(ref) + ">"
+            : "TMulticastInlineDelegate<void()>";
+    }
     // ─── 基础类型直接映射 ───
     // 对标 Rei-Dumper：BoolProperty 非 native 时输出 uint8（BitField 类型）
-    if (fieldClassName == "BoolProperty")
+    else if (fc == "BoolProperty")
     {
-        // 读取 FieldMask 判断是否是 native bool
-        // native bool: FieldMask == 0xFF（整个字节）
-        if (off.BoolProperty_Base != -1)
+        u8 fieldMask = static_cast<u8>(key.extra & 0xFF);
+        i32 propSize = static_cast<i32>((key.extra >> 8) & 0xFFFFFFFF);
+        if ((key.extra & TypeDescExtra::NoBoolInfo) || fieldMask == 0xFF)
+        {
+            name = "bool";
+        }
+        else
         {
-            u8 fieldMask = 0;
-            Mem().Read(prop + off.BoolProperty_Base + 3, &fieldMask, 1);
-            if (fieldMask == 0xFF)
-            {
-                return "bool";
-            }
             // 非 native：返回对应大小的整数类型
-            i32 propSize = 0;
-            if (off.Property_ElementSize != -1)
-            {
-                GReadValue(prop + off.Property_ElementSize, propSize);
-            }
-            return GetTypeFromSize(propSize > 0 ? propSize : 1);
+            name = GetTypeFromSize(propSize > 0 ? propSize : 1);
         }
-        return "bool";
-    }
-    if (fieldClassName == "Int8Property")    return "int8";
-    if (fieldClassName == "Int16Property")   return "int16";
-    if (fieldClassName == "IntProperty")     return "int32";
-    if (fieldClassName == "Int64Property")   return "int64";
-    if (fieldClassName == "UInt16Property")  return "uint16";
-    if (fieldClassName == "UInt32Property")  return "uint32";
-    if (fieldClassName == "UInt64Property")  return "uint64";
-    if (fieldClassName == "FloatProperty")   return "float";
-    if (fieldClassName == "DoubleProperty")  return "double";
-    if (fieldClassName == "NameProperty")    return "class FName";
-    if (fieldClassName == "StrProperty")     return "class FString";
-    if (fieldClassName == "TextProperty")    return "class FText";
-    if (fieldClassName == "FieldPathProperty") return "struct FFieldPath";
-
-    return fieldClassName;
+    }
+    else if (fc == "Int8Property")      name = "int8";
+    else if (fc == "Int16Property")     name = "int16";
+    else if (fc == "IntProperty")       name = "int32";
+    else if (fc == "Int64Property")     name = "int64";
+    else if (fc == "UInt16Property")    name = "uint16";
+    else if (fc == "UInt32Property")    name = "uint32";
+    else if (fc == "UInt64Property")    name = "uint64";
+    else if (fc == "FloatProperty")     name = "float";
+    else if (fc == "DoubleProperty")    name = "double";
+    else if (fc == "NameProperty")      name = "class FName";
+    else if (fc == "StrProperty")       name = "class FString";
+    else if (fc == "TextProperty")      name = "class FText";
+    else if (fc == "FieldPathProperty") name = "struct FFieldPath";
+    else
+    {
+        name = fc;
+    }
+}
+
+// 解析属性类型的描述符：读取键 → 查表 → 未命中时渲染并插入
+// 键包含 delegate 嵌套深度，截断行为不同的上下文不会共享描述符
+inline const TypeDesc* ResolveTypeDesc(uptr prop, const std::string& fieldClassName)
+{
+    auto& table = GetTypeDescTable();
+    TypeDescKey key;
+    key.fieldClass = table.FieldClassId(fieldClassName);
+    key.context = static_cast<u32>(g_delegateDepth);
+
+    // 递归深度保护
+    if (g_resolveDepth > 32)
+    {
+        key.extra = TypeDescExtra::Truncated;
+    }
+    else
+    {
+        g_resolveDepth++;
+        struct DepthGuard { ~DepthGuard() { g_resolveDepth--; } } guard;
+        ReadTypeDescKey(prop, fieldClassName, key);
+    }
+
+    if (const TypeDesc* d = table.Find(key))
+    {
+        return d;
+    }
+    TypeDesc desc;
+    desc.fieldClass = fieldClassName;
+    desc.inner[0] = key.inner[0];
+    desc.inner[1] = key.inner[1];
+    {
+        g_resolveDepth++;
+        struct DepthGuard { ~DepthGuard() { g_resolveDepth--; } } guard;
+        RenderTypeDesc(fieldClassName, key, desc);
+    }
+    return table.Insert(key, std::move(desc));
+}
+
+// 通过 FField 类名获取精确类型字符串，并记录其中的类型引用
+inline std::string ResolvePropertyType(uptr prop, const std::string& fieldClassName)
+{
+    const TypeDesc* desc = ResolveTypeDesc(prop, fieldClassName);
+    NoteTypeRefs(*desc);
+    return desc->name;
 }
 
 } // namespace detail
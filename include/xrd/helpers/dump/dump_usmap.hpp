@@ -0,0 +1,293 @@
+#pragma once
+// Xrd-eXternalrEsolve - SDK 导出：.usmap 类型映射
+// FModel / CUE4Parse 解析无版本属性（unversioned properties）资源所用的二进制映射文件
+// 版本 LargeEnums(3)：名称表、枚举成员表、结构体属性表（属性类型按类型树写出）
+// 类型树取自采集时的类型描述符（dump_type_desc.hpp），不再解析类型字符串
+// 仓库内没有 Oodle/Brotli/Zstd 编解码器，正文只以 None 方式写出
+
+#include "dump_sdk.hpp"
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+
+namespace xrd
+{
+
+// .usmap 正文压缩方式（取值与格式定义一致）
+enum class UsmapCompression : u8
+{
+    None      = 0,
+    Oodle     = 1,
+    Brotli    = 2,
+    ZStandard = 3,
+};
+
+namespace detail
+{
+
+constexpr u16 kUsmapMagic = 0x30C4;
+
+namespace UsmapVersion
+{
+    constexpr u8 Initial           = 0;
+    constexpr u8 PackageVersioning = 1; // 头部带 bHasVersioning
+    constexpr u8 LongFName         = 2; // 名称长度为 u16
+    constexpr u8 LargeEnums        = 3; // 枚举成员数为 u16
+}
+
+// .usmap 属性类型（EPropertyType）
+enum class UsmapPropType : u8
+{
+    ByteProperty = 0, BoolProperty, IntProperty, FloatProperty, ObjectProperty,
+    NameProperty, DelegateProperty, DoubleProperty, ArrayProperty, StructProperty,
+    StrProperty, TextProperty, InterfaceProperty, MulticastDelegateProperty,
+    WeakObjectProperty, LazyObjectProperty, AssetObjectProperty, SoftObjectProperty,
+    UInt64Property, UInt32Property, UInt16Property, Int64Property, Int16Property,
+    Int8Property, MapProperty, SetProperty, EnumProperty, FieldPathProperty,
+    OptionalProperty, Utf8StrProperty, AnsiStrProperty,
+    Unknown = 0xFF,
+};
+
+// FField 类名 → usmap 类型；派生类归到序列化方式相同的基类
+inline UsmapPropType UsmapTypeOf(const std::string& fc)
+{
+    using T = UsmapPropType;
+    static const std::unordered_map<std::string, T> table = {
+        {"ByteProperty", T::ByteProperty},     {"BoolProperty", T::BoolProperty},
+        {"IntProperty", T::IntProperty},       {"FloatProperty", T::FloatProperty},
+        {"ObjectProperty", T::ObjectProperty}, {"ObjectPropertyBase", T::ObjectProperty},
+        {"ClassProperty", T::ObjectProperty},  {"ObjectPtrProperty", T::ObjectProperty},
+        {"ClassPtrProperty", T::ObjectProperty},
+        {"NameProperty", T::NameProperty},     {"DelegateProperty", T::DelegateProperty},
+        {"DoubleProperty", T::DoubleProperty}, {"ArrayProperty", T::ArrayProperty},
+        {"StructProperty", T::StructProperty}, {"StrProperty", T::StrProperty},
+        {"TextProperty", T::TextProperty},     {"InterfaceProperty", T::InterfaceProperty},
+        {"MulticastDelegateProperty", T::MulticastDelegateProperty},
+        {"MulticastInlineDelegateProperty", T::MulticastDelegateProperty},
+        {"MulticastSparseDelegateProperty", T::MulticastDelegateProperty},
+        {"WeakObjectProperty", T::WeakObjectProperty},
+        {"LazyObjectProperty", T::LazyObjectProperty},
+        {"AssetObjectProperty", T::AssetObjectProperty},
+        {"SoftObjectProperty", T::SoftObjectProperty},
+        {"SoftClassProperty", T::SoftObjectProperty},
+        {"UInt64Property", T::UInt64Property}, {"UInt32Property", T::UInt32Property},
+        {"UInt16Property", T::UInt16Property}, {"Int64Property", T::Int64Property},
+        {"Int16Property", T::Int16Property},   {"Int8Property", T::Int8Property},
+        {"MapProperty", T::MapProperty},       {"SetProperty", T::SetProperty},
+        {"EnumProperty", T::EnumProperty},     {"FieldPathProperty", T::FieldPathProperty},
+        {"OptionalProperty", T::OptionalProperty},
+        {"Utf8StrProperty", T::Utf8StrProperty}, {"AnsiStrProperty", T::AnsiStrProperty},
+    };
+    auto it = table.find(fc);
+    return it != table.end() ? it->second : T::Unknown;
+}
+
+// 正文缓冲：小端写入 + 按首次出现顺序编号的名称表
+class UsmapWriter
+{
+public:
+    template<typename T>
+    void Put(T v)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        data.append(bytes, sizeof(T));
+    }
+
+    // 写入名称表下标；空名写 -1（格式中的 None）
+    void PutName(const std::string& name)
+    {
+        if (name.empty())
+        {
+            Put<i32>(-1);
+            return;
+        }
+        auto [it, inserted] = nameIndex.try_emplace(
+            name, static_cast<i32>(names.size()));
+        if (inserted)
+        {
+            names.push_back(name);
+        }
+        Put<i32>(it->second);
+    }
+
+    const std::string& Bytes() const { return data; }
+
+    // 名称表 + 正文，即未压缩的载荷
+    std::string BuildPayload() const
+    {
+        UsmapWriter out;
+        out.Put<u32>(static_cast<u32>(names.size()));
+        for (auto& n : names)
+        {
+            u16 len = static_cast<u16>((std::min)(n.size(), size_t(0xFFFF)));
+            out.Put<u16>(len);
+            out.data.append(n.data(), len);
+        }
+        out.data += data;
+        return std::move(out.data);
+    }
+
+private:
+    std::string data;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, i32> nameIndex;
+};
+
+// 写出一个属性的类型树；desc 为空时只按字段类名输出（容器元素按 uint8 处理）
+inline void WriteUsmapType(UsmapWriter& w, const TypeDesc* desc, const std::string& fieldClass)
+{
+    using T = UsmapPropType;
+    const std::string& fc = desc ? desc->fieldClass : fieldClass;
+    T type = UsmapTypeOf(fc);
+    const TypeDesc* inner0 = desc ? desc->inner[0] : nullptr;
+    const TypeDesc* inner1 = desc ? desc->inner[1] : nullptr;
+    std::string refName = desc ? desc->refName : std::string();
+
+    // 关联枚举的 ByteProperty 与 UE 序列化一致，写成底层为 uint8 的 EnumProperty
+    if (type == T::ByteProperty && desc && !desc->refName.empty())
+    {
+        w.Put<u8>(static_cast<u8>(T::EnumProperty));
+        w.Put<u8>(static_cast<u8>(T::ByteProperty));
+        w.PutName(desc->refName);
+        return;
+    }
+
+    w.Put<u8>(static_cast<u8>(type));
+    switch (type)
+    {
+        case T::EnumProperty:
+            WriteUsmapType(w, inner0, "ByteProperty");
+            w.PutName(refName);
+            break;
+        case T::StructProperty:
+            w.PutName(refName);
+            break;
+        case T::ArrayProperty:
+        case T::SetProperty:
+        case T::OptionalProperty:
+            WriteUsmapType(w, inner0, "ByteProperty");
+            break;
+        case T::MapProperty:
+            WriteUsmapType(w, inner0, "ByteProperty");
+            WriteUsmapType(w, inner1, "ByteProperty");
+            break;
+        default:
+            break;
+    }
+}
+
+// 写出 Mappings.usmap（属性取自 CollectProperties 缓存）
+// 结构体按名称去重（与 Mapping.txt 一致），只写自身属性，父类以名称引用
+// 属性按偏移排列，同一字节内的位域按位序：与声明顺序一致，即无版本序列化的 schema 下标
+inline bool WriteUsmap(
+    const std::wstring& outputPath,
+    const std::vector<StructEntry>& entries,
+    const std::vector<EnumInfo>& enums,
+    UsmapCompression compression)
+{
+    if (compression != UsmapCompression::None)
+    {
+        std::cerr << "[xrd] usmap: 未内置所请求的压缩编解码器，改为不压缩输出\n";
+        compression = UsmapCompression::None;
+    }
+
+    UsmapWriter w;
+
+    // 枚举
+    std::vector<const EnumInfo*> enumList;
+    std::unordered_set<std::string> seenEnums;
+    for (auto& ei : enums)
+    {
+        if (seenEnums.insert(ei.name).second)
+        {
+            enumList.push_back(&ei);
+        }
+    }
+    w.Put<u32>(static_cast<u32>(enumList.size()));
+    for (auto* ei : enumList)
+    {
+        size_t count = (std::min)(ei->members.size(), size_t(0xFFFF));
+        w.PutName(ei->name);
+        w.Put<u16>(static_cast<u16>(count));
+        for (size_t i = 0; i < count; ++i)
+        {
+            w.PutName(ei->members[i].name);
+        }
+    }
+
+    // 结构体
+    std::vector<const StructEntry*> structList;
+    std::unordered_set<std::string> seenStructs;
+    for (auto& e : entries)
+    {
+        if (seenStructs.insert(e.name).second)
+        {
+            structList.push_back(&e);
+        }
+    }
+    w.Put<u32>(static_cast<u32>(structList.size()));
+    for (auto* e : structList)
+    {
+        std::vector<PropertyInfo> props = CollectProperties(e->addr); // 下面排序截断，需要副本
+        std::stable_sort(props.begin(), props.end(),
+            [](const PropertyInfo& a, const PropertyInfo& b)
+            {
+                return a.offset != b.offset ? a.offset < b.offset : a.bitIndex < b.bitIndex;
+            });
+        if (props.size() > 0xFFFF)
+        {
+            props.resize(0xFFFF);
+        }
+
+        u32 slotCount = 0;
+        for (auto& p : props)
+        {
+            slotCount += static_cast<u32>(std::clamp(p.arrayDim, 1, 0xFF));
+        }
+
+        w.PutName(e->name);
+        w.PutName(e->superName);
+        w.Put<u16>(static_cast<u16>((std::min)(slotCount, 0xFFFFu)));
+        w.Put<u16>(static_cast<u16>(props.size()));
+
+        u32 schemaIndex = 0;
+        for (auto& p : props)
+        {
+            u8 arrayDim = static_cast<u8>(std::clamp(p.arrayDim, 1, 0xFF));
+            w.Put<u16>(static_cast<u16>(schemaIndex));
+            w.Put<u8>(arrayDim);
+            w.PutName(p.name);
+            WriteUsmapType(w, p.typeDesc, p.fieldClassName);
+            schemaIndex += arrayDim;
+        }
+    }
+
+    std::string payload = w.BuildPayload();
+
+    namespace fs = std::filesystem;
+    fs::create_directories(outputPath);
+    std::ofstream file(outputPath + L"/Mappings.usmap", std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    UsmapWriter header;
+    header.Put<u16>(kUsmapMagic);
+    header.Put<u8>(UsmapVersion::LargeEnums);
+    header.Put<i32>(0); // bHasVersioning = false
+    header.Put<u8>(static_cast<u8>(compression));
+    header.Put<u32>(static_cast<u32>(payload.size())); // 压缩后大小
+    header.Put<u32>(static_cast<u32>(payload.size())); // 解压后大小
+    file.write(header.Bytes().data(), static_cast<std::streamsize>(header.Bytes().size()));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    if (!file.good()) return false;
+
+    std::cerr << "[xrd] usmap 导出完成: " << enumList.size() << " 个枚举, "
+              << structList.size() << " 个结构体\n";
+    return true;
+}
+
+} // namespace detail
+} // namespace xrd
@@ -1,11 +1,13 @@
 #pragma once
 // Xrd-eXternalrEsolve - SDK 生成：辅助文件
 // 生成 PropertyFixup.hpp / NameCollisions.inl / Assertions.inl（头部）
+// 文件内容整体构建后提交给 SdkFileWriter
 // UnrealContainers.hpp / UtfN.hpp 直接嵌入静态内容
 
 #include "../../../core/context.hpp"
 #include "../dump_prefix.hpp"
-#include <fstream>
+#include "../dump_file_writer.hpp"
+#include <sstream>
 #include <string>
 #include <filesystem>
 #include <map>
@@ -17,11 +19,11 @@ namespace gen
 {
 
 // 生成 PropertyFixup.hpp — 对齐 Rei-Dumper 格式
-inline void GeneratePropertyFixup(const std::wstring& cppSdkDir)
+inline void GeneratePropertyFixup(
+    detail::SdkFileWriter& out,
+    const std::wstring& cppSdkDir)
 {
-    std::wstring path = cppSdkDir + L"/PropertyFixup.hpp";
-    std::ofstream f(path);
-    if (!f.is_open()) return;
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -46,19 +48,18 @@ class alignas(0x01) FMulticastSparseDelegateProperty_
 }
 
 )";
-    f.close();
+    out.Submit(cppSdkDir + L"/PropertyFixup.hpp", f.str());
 }
 
 // 生成 NameCollisions.inl — 对齐 Rei-Dumper 格式
 // 对标 Rei-Dumper：为包名冲突的类生成命名空间前向声明
 inline void GenerateNameCollisions(
+    detail::SdkFileWriter& out,
     const std::wstring& cppSdkDir,
     const std::map<std::string, std::string>& collisionNsMap,
     const std::vector<xrd::detail::StructEntry>& entries)
 {
-    std::wstring path = cppSdkDir + L"/NameCollisions.inl";
-    std::ofstream f(path);
-    if (!f.is_open()) return;
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -101,11 +102,11 @@ inline void GenerateNameCollisions(
     }
 
     f << "\n";
-    f.close();
+    out.Submit(cppSdkDir + L"/NameCollisions.inl", f.str());
 }
 
-// Basic.hpp 中预定义类型的断言宏（必须在 GenerateAssertionsHeader 之前定义）
-inline void WriteBasicAssertions(std::ofstream& f)
+// Basic.hpp 中预定义类型的断言宏（必须在 BuildAssertionsHeader 之前定义）
+inline void WriteBasicAssertions(std::ostream& f)
 {
     auto& ctx = Ctx();
     i32 itemSize = ctx.off.FUObjectItemSize > 0 ? ctx.off.FUObjectItemSize : 0x18;
@@ -283,13 +284,11 @@ static_assert(offsetof(FOptionalProperty, ValueProperty) == 0x000078, "Member 'F
     f << "}\n";
 }
 
-// 生成 Assertions.inl 的头部（基础类型断言宏）
-// 每个包的断言会在包文件生成时追加到此文件
-inline void GenerateAssertionsHeader(const std::wstring& cppSdkDir)
+// 构建 Assertions.inl 的头部（基础类型断言宏）
+// 调用方在其后拼接各包断言与结尾 #endif，整个文件一次提交
+inline std::string BuildAssertionsHeader()
 {
-    std::wstring path = cppSdkDir + L"/Assertions.inl";
-    std::ofstream f(path);
-    if (!f.is_open()) return;
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -312,7 +311,7 @@ namespace SDK
     // 写入 Basic.hpp 中预定义类型的断言宏
     WriteBasicAssertions(f);
 
-    f.close();
+    return f.str();
 }
 
 } // namespace gen
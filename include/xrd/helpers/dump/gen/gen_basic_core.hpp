@@ -4,7 +4,7 @@
 // FText / FWeakObjectPtr / TWeakObjectPtr 等核心运行时类型
 
 #include "../../../core/context.hpp"
-#include <fstream>
+#include <ostream>
 #include <string>
 #include <format>
 
@@ -14,7 +14,7 @@ namespace gen
 {
 
 // 写入 FUObjectItem / TUObjectArray（根据运行时扫描到的偏移动态生成）
-inline void WriteFUObjectItemAndArray(std::ofstream& f)
+inline void WriteFUObjectItemAndArray(std::ostream& f)
 {
     auto& ctx = Ctx();
     i32 itemSize = ctx.off.FUObjectItemSize > 0 ? ctx.off.FUObjectItemSize : 0x18;
@@ -88,7 +88,7 @@ DUMPER7_ASSERTS_TUObjectArray;
 }
 
 // 写入 TUObjectArrayWrapper
-inline void WriteTUObjectArrayWrapper(std::ofstream& f)
+inline void WriteTUObjectArrayWrapper(std::ostream& f)
 {
     f << R"(class TUObjectArrayWrapper
 {
@@ -154,7 +154,7 @@ public:
 }
 
 // 写入 FName 类
-inline void WriteFNameClass(std::ofstream& f)
+inline void WriteFNameClass(std::ostream& f)
 {
     f << R"(// Predefined struct FName
 // 0x0008 (0x0008 - 0x0000)
@@ -3,7 +3,7 @@
 // UE_ENUM_OPERATORS 宏、EObjectFlags、EFunctionFlags、EClassFlags、
 // EClassCastFlags、EPropertyFlags 枚举定义
 
-#include <fstream>
+#include <ostream>
 
 namespace xrd
 {
@@ -11,7 +11,7 @@ namespace gen
 {
 
 // 写入 UE_ENUM_OPERATORS 宏和所有引擎枚举
-inline void WriteEnumOperatorsAndEnums(std::ofstream& f)
+inline void WriteEnumOperatorsAndEnums(std::ostream& f)
 {
     f << R"(#define UE_ENUM_OPERATORS(EEnumClass)																																	\
 																																										\
@@ -150,7 +150,7 @@ enum class EClassFlags : uint32
 }
 
 // 写入 EClassCastFlags 和 EPropertyFlags（拆分出来避免单函数过长）
-inline void WriteCastAndPropertyFlags(std::ofstream& f)
+inline void WriteCastAndPropertyFlags(std::ostream& f)
 {
     f << R"(enum class EClassCastFlags : uint64
 {
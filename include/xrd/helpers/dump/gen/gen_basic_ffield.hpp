@@ -4,7 +4,7 @@
 // CyclicDependencyFixup 模板、命名空间闭合
 
 #include "../../../core/context.hpp"
-#include <fstream>
+#include <ostream>
 #include <format>
 
 namespace xrd
@@ -13,7 +13,7 @@ namespace gen
 {
 
 // 写入 FFieldClass / FFieldVariant / FField / FProperty 及所有子类
-inline void WriteFFieldAndPropertyTypes(std::ofstream& f)
+inline void WriteFFieldAndPropertyTypes(std::ostream& f)
 {
     f << R"(// Predefined struct FFieldClass
 // 0x0028 (0x0028 - 0x0000)
@@ -218,7 +218,7 @@ DUMPER7_ASSERTS_FOptionalProperty;
 }
 
 // 写入 CyclicDependencyFixup 模板和命名空间闭合
-inline void WriteCyclicFixupAndClose(std::ofstream& f)
+inline void WriteCyclicFixupAndClose(std::ostream& f)
 {
     f << R"(namespace CyclicDependencyFixupImpl
 {
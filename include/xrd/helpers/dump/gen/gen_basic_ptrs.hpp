@@ -5,7 +5,7 @@
 // FScriptInterface / TScriptInterface / FFieldPath / TFieldPath
 // TOptional / FScriptDelegate / TDelegate / TMulticastInlineDelegate
 
-#include <fstream>
+#include <ostream>
 
 namespace xrd
 {
@@ -13,7 +13,7 @@ namespace gen
 {
 
 // 写入智能指针和委托类型
-inline void WritePtrAndDelegateTypes(std::ofstream& f)
+inline void WritePtrAndDelegateTypes(std::ostream& f)
 {
     f << R"(// Predefined struct FUniqueObjectGuid
 // 0x0010 (0x0010 - 0x0000)
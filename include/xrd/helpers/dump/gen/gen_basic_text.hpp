@@ -2,7 +2,7 @@
 // Xrd-eXternalrEsolve - SDK 生成：Basic.hpp TSubclassOf/FText/FWeakObjectPtr
 // 从 gen_basic_core.hpp 拆分，保持单文件 300 行以内
 
-#include <fstream>
+#include <ostream>
 
 namespace xrd
 {
@@ -10,7 +10,7 @@ namespace gen
 {
 
 // 写入 TSubclassOf / FTextImpl / FText / FWeakObjectPtr / TWeakObjectPtr
-inline void WriteSubclassAndText(std::ofstream& f)
+inline void WriteSubclassAndText(std::ostream& f)
 {
     f << R"(template<typename ClassType>
 class TSubclassOf
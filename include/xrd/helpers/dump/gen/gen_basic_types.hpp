@@ -4,7 +4,7 @@
 // StaticClass/GetDefaultObj 宏、FUObjectItem/TUObjectArray/FName 等核心类型
 
 #include "../../../core/context.hpp"
-#include <fstream>
+#include <ostream>
 #include <string>
 #include <format>
 
@@ -14,7 +14,7 @@ namespace gen
 {
 
 // 写入 Basic.hpp 文件头（#pragma once、注释、include）
-inline void WriteBasicHeader(std::ofstream& f)
+inline void WriteBasicHeader(std::ostream& f)
 {
     f << R"(#pragma once
 
@@ -49,7 +49,7 @@ using namespace UC;
 }
 
 // 写入 Offsets 命名空间（GObjects/AppendString/GNames/GWorld/ProcessEvent/ProcessEventIdx）
-inline void WriteOffsetsNamespace(std::ofstream& f)
+inline void WriteOffsetsNamespace(std::ostream& f)
 {
     auto& ctx = Ctx();
     uptr base = ctx.mainModule.base;
@@ -80,7 +80,7 @@ namespace Offsets
 }
 
 // 写入 InSDKUtils 命名空间
-inline void WriteInSDKUtils(std::ofstream& f)
+inline void WriteInSDKUtils(std::ostream& f)
 {
     f << R"(namespace InSDKUtils
 {
@@ -106,7 +106,7 @@ inline void WriteInSDKUtils(std::ofstream& f)
 }
 
 // 写入前置声明和 BasicFilesImpleUtils
-inline void WriteForwardDeclarations(std::ofstream& f)
+inline void WriteForwardDeclarations(std::ostream& f)
 {
     f << R"(
 // Forward declarations because in-line forward declarations make the compiler think 'GetStaticClass()' is a class template
@@ -141,7 +141,7 @@ const FName& GetStaticName(const wchar_t* Name, FName& StaticName);
 }
 
 // 写入 GetStaticClassImpl / GetStaticBPGeneratedClass 模板
-inline void WriteStaticClassTemplates(std::ofstream& f)
+inline void WriteStaticClassTemplates(std::ostream& f)
 {
     f << R"(template<bool bIsFullName = false>
 class UClass* GetStaticClassImpl(const char* Name, class UClass*& StaticClass)
@@ -220,7 +220,7 @@ ClassType* GetDefaultObjImpl()
 }
 
 // 写入 STATIC_CLASS_IMPL / BP_STATIC_CLASS_IMPL / STATIC_NAME_IMPL 宏
-inline void WriteStaticClassMacros(std::ofstream& f)
+inline void WriteStaticClassMacros(std::ostream& f)
 {
     f << R"(#define STATIC_CLASS_IMPL(NameString) \
 { \
@@ -5,7 +5,8 @@
 // 精简版保留所有必要的类型定义，确保 SDK 可编译
 
 #include "gen_containers_impl.hpp"
-#include <fstream>
+#include "../dump_file_writer.hpp"
+#include <sstream>
 #include <string>
 #include <filesystem>
 
@@ -15,11 +16,11 @@ namespace gen
 {
 
 // 生成精简版 UtfN.hpp — 只保留 FString::ToString 需要的最小实现
-inline void GenerateUtfN(const std::wstring& cppSdkDir)
+inline void GenerateUtfN(
+    detail::SdkFileWriter& out,
+    const std::wstring& cppSdkDir)
 {
-    std::wstring path = cppSdkDir + L"/UtfN.hpp";
-    std::ofstream f(path);
-    if (!f.is_open()) return;
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -105,16 +106,16 @@ inline std::wstring StringToWString(const StringType& Str)
 }
 
 )";
-    f.close();
+    out.Submit(cppSdkDir + L"/UtfN.hpp", f.str());
 }
 
 // 生成 UnrealContainers.hpp — 包含 TArray / FString / TSet / TMap 等容器
 // 这是 SDK 运行时必需的，直接嵌入完整实现
-inline void GenerateUnrealContainers(const std::wstring& cppSdkDir)
+inline void GenerateUnrealContainers(
+    detail::SdkFileWriter& out,
+    const std::wstring& cppSdkDir)
 {
-    std::wstring path = cppSdkDir + L"/UnrealContainers.hpp";
-    std::ofstream f(path);
-    if (!f.is_open()) return;
+    std::ostringstream f;
 
     f << R"(#pragma once
 
@@ -160,12 +161,10 @@ namespace UC
 	class TPair;
 
 )";
-    f.close();
 
-    // 追加容器实现的核心部分
-    std::ofstream fa(path, std::ios::app);
-    WriteContainerImpl(fa);
-    fa.close();
+    // 容器实现的核心部分
+    WriteContainerImpl(f);
+    out.Submit(cppSdkDir + L"/UnrealContainers.hpp", f.str());
 }
 
 } // namespace gen
@@ -3,7 +3,7 @@
 // 从 gen_containers.hpp 拆分，包含 TArray / FString / TSet / TMap 等
 // 写入到 UnrealContainers.hpp 的 UC 命名空间内
 
-#include <fstream>
+#include <ostream>
 
 namespace xrd
 {
@@ -12,7 +12,7 @@ namespace gen
 
 // 写入容器实现核心（TArray / FString / TSet / TMap 等）
 // 必须在 GenerateUnrealContainers 之前定义，因为后者会调用它
-inline void WriteContainerImpl(std::ofstream& f)
+inline void WriteContainerImpl(std::ostream& f)
 {
     f << R"(
 	namespace ContainerImpl
@@ -0,0 +1,177 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成 UE 映像：引擎核心类型
+// /Script/CoreUObject 的元类与基础结构体、/Script/Engine 的 Actor 体系
+// 名称、继承关系与关键函数标志与真实引擎一致，偏移发现（Class/Struct/Field 继承链、
+// Vector/Color/Guid 大小、PlayerController 函数标志）在合成映像上走与真实进程相同的路径
+
+#include "synthetic_types.hpp"
+
+namespace xrd
+{
+namespace detail
+{
+
+// 核心类型句柄：随机生成的类型以这些为父类或引用目标
+struct SynCoreTypes
+{
+    uptr coreUObject = 0;
+    uptr engine = 0;
+
+    uptr object = 0;
+    uptr actorComponent = 0;
+    uptr sceneComponent = 0;
+    uptr actor = 0;
+    uptr pawn = 0;
+    uptr controller = 0;
+    uptr playerController = 0;
+
+    std::vector<uptr> structs; // Vector / Rotator / Transform / Color / Guid ...
+    std::vector<uptr> enums;
+};
+
+inline SynPropSpec SynP(SynProp type, std::string name, uptr ref = 0)
+{
+    SynPropSpec s;
+    s.type = type;
+    s.name = std::move(name);
+    s.ref = ref;
+    return s;
+}
+
+inline SynPropSpec SynArray(std::string name, SynProp inner, uptr innerRef = 0)
+{
+    SynPropSpec s = SynP(SynProp::Array, std::move(name));
+    s.inner = inner;
+    s.innerRef = innerRef;
+    return s;
+}
+
+inline SynCoreTypes BuildSyntheticCore(SyntheticTypes& t)
+{
+    using P = SynProp;
+    namespace F = SynFlags;
+    SyntheticWriter& w = t.w;
+    auto& layout = w.Layout();
+    SynCoreTypes core;
+
+    // ─── CoreUObject：先建对象，元类就绪后再补写类指针与布局 ───
+    core.coreUObject = w.NewObject(0, w.Name("/Script/CoreUObject"), 0, layout.packageSize, F::RF_Public);
+
+    struct MetaDef
+    {
+        const char* name;
+        i32 superIndex;
+        i32 size;
+        u64 castFlags;
+    };
+    const MetaDef metas[] = {
+        {"Object",       -1, layout.objectSize,       0},
+        {"Field",         0, layout.objectSize + 8,   F::CASTCLASS_UField},
+        {"Struct",        1, layout.structSize,       F::CASTCLASS_UStruct},
+        {"Class",         2, layout.classSize,        F::CASTCLASS_UClass},
+        {"ScriptStruct",  2, layout.scriptStructSize, F::CASTCLASS_UScriptStruct},
+        {"Function",      2, layout.functionSize,     F::CASTCLASS_UFunction},
+        {"DelegateFunction", 5, layout.functionSize + 0x10, F::CASTCLASS_UDelegateFunction},
+        {"Enum",          1, layout.enumSize,         F::CASTCLASS_UEnum},
+        {"Package",       0, layout.packageSize,      F::CASTCLASS_UPackage},
+        {"Interface",     0, layout.objectSize,       0},
+    };
+    constexpr size_t kMetaCount = std::size(metas);
+    uptr metaObj[kMetaCount] = {};
+    for (size_t i = 0; i < kMetaCount; ++i)
+    {
+        metaObj[i] = w.NewObject(0, w.Name(metas[i].name), core.coreUObject,
+            layout.classSize, F::RF_Public | F::RF_Standalone);
+    }
+    t.metaClass            = metaObj[3];
+    t.metaScriptStruct     = metaObj[4];
+    t.metaFunction         = metaObj[5];
+    t.metaDelegateFunction = metaObj[6];
+    t.metaEnum             = metaObj[7];
+    t.metaPackage          = metaObj[8];
+    w.SetObjectClass(core.coreUObject, t.metaPackage);
+    for (size_t i = 0; i < kMetaCount; ++i)
+    {
+        w.SetObjectClass(metaObj[i], t.metaClass);
+        uptr super = metas[i].superIndex >= 0 ? metaObj[metas[i].superIndex] : 0;
+        t.FinishClass(metaObj[i], metas[i].name, super, {}, metas[i].castFlags, metas[i].size);
+    }
+    core.object = metaObj[0];
+
+    // 基础结构体：FVector 等在 UE5 为双精度
+    P real = layout.doublePrecision ? P::Double : P::Float;
+    uptr vec = t.MakeStruct("Vector", core.coreUObject, 0,
+        {SynP(real, "X"), SynP(real, "Y"), SynP(real, "Z")});
+    uptr vec2 = t.MakeStruct("Vector2D", core.coreUObject, 0, {SynP(real, "X"), SynP(real, "Y")});
+    uptr rot = t.MakeStruct("Rotator", core.coreUObject, 0,
+        {SynP(real, "Pitch"), SynP(real, "Yaw"), SynP(real, "Roll")});
+    uptr quat = t.MakeStruct("Quat", core.coreUObject, 0,
+        {SynP(real, "X"), SynP(real, "Y"), SynP(real, "Z"), SynP(real, "W")});
+    w.Space().Put<i16>(quat + layout.UStruct_MinAlignment, 16); // alignas(16)
+    uptr xform = t.MakeStruct("Transform", core.coreUObject, 0,
+        {SynP(P::Struct, "Rotation", quat), SynP(P::Struct, "Translation", vec),
+         SynP(P::Struct, "Scale3D", vec)});
+    uptr color = t.MakeStruct("Color", core.coreUObject, 0,
+        {SynP(P::Byte, "B"), SynP(P::Byte, "G"), SynP(P::Byte, "R"), SynP(P::Byte, "A")});
+    uptr linear = t.MakeStruct("LinearColor", core.coreUObject, 0,
+        {SynP(P::Float, "R"), SynP(P::Float, "G"), SynP(P::Float, "B"), SynP(P::Float, "A")});
+    uptr guid = t.MakeStruct("Guid", core.coreUObject, 0,
+        {SynP(P::Int, "A"), SynP(P::Int, "B"), SynP(P::Int, "C"), SynP(P::Int, "D")});
+    core.structs = {vec, vec2, rot, quat, xform, color, linear, guid};
+
+    // ─── Engine：Actor 体系 ───
+    core.engine = t.MakePackage("/Script/Engine");
+    uptr key = t.MakeStruct("Key", core.engine, 0, {SynP(P::Name, "KeyName")});
+    core.structs.push_back(key);
+    core.enums.push_back(t.MakeEnum("ECollisionChannel", core.engine,
+        {"ECC_WorldStatic", "ECC_WorldDynamic", "ECC_Pawn", "ECC_Visibility", "ECC_Camera"}));
+    core.enums.push_back(t.MakeEnum("ENetRole", core.engine,
+        {"ROLE_None", "ROLE_SimulatedProxy", "ROLE_AutonomousProxy", "ROLE_Authority"}));
+
+    core.actorComponent = t.MakeClass("ActorComponent", core.engine, core.object,
+        {SynP(P::Bool, "bAutoActivate"), SynP(P::Bool, "bIsActive"),
+         SynArray("ComponentTags", P::Name)}, 0, 0xB0);
+    core.sceneComponent = t.MakeClass("SceneComponent", core.engine, core.actorComponent,
+        {SynP(P::Object, "AttachParent", 0), SynP(P::Struct, "RelativeLocation", vec),
+         SynP(P::Struct, "RelativeRotation", rot), SynP(P::Struct, "RelativeScale3D", vec),
+         SynP(P::Bool, "bVisible")}, F::CASTCLASS_SceneComponent);
+    // 自引用：类创建后回填 AttachParent（第一个成员）的 PropertyClass
+    uptr attachParent = w.Space().Get<uptr>(core.sceneComponent + w.Off().UStruct_ChildProperties);
+    w.Space().Put<uptr>(attachParent + w.Off().ObjectProperty_Class, core.sceneComponent);
+
+    core.actor = t.MakeClass("Actor", core.engine, core.object,
+        {SynP(P::Bool, "bHidden"), SynP(P::Bool, "bCanBeDamaged"),
+         SynP(P::Byte, "RemoteRole", core.enums[1]), SynP(P::Float, "InitialLifeSpan"),
+         SynP(P::Object, "Owner", core.object), SynArray("Tags", P::Name),
+         SynP(P::Object, "RootComponent", core.sceneComponent)}, F::CASTCLASS_AActor);
+    const u32 pureFlags = F::FUNC_Final | F::FUNC_Native | F::FUNC_Public
+        | F::FUNC_BlueprintCallable | F::FUNC_BlueprintPure | F::FUNC_Const;
+    SynPropSpec retVector = SynP(P::Struct, "", vec);
+    t.LinkFunctions(core.actor, {
+        t.MakeFunction("K2_GetActorLocation", core.actor, pureFlags, {}, &retVector),
+    });
+
+    core.controller = t.MakeClass("Controller", core.engine, core.actor,
+        {SynP(P::Object, "Pawn", core.actor)});
+    core.pawn = t.MakeClass("Pawn", core.engine, core.actor,
+        {SynP(P::Object, "Controller", core.controller), SynP(P::Float, "BaseEyeHeight")},
+        F::CASTCLASS_APawn);
+    core.playerController = t.MakeClass("PlayerController", core.engine, core.controller,
+        {SynP(P::Object, "PlayerCameraManager", core.actor), SynP(P::Bool, "bShowMouseCursor")},
+        F::CASTCLASS_APlayerController);
+
+    // 偏移发现用的三个已知函数与标志
+    SynPropSpec retBool = SynP(P::Bool, "");
+    u32 execFlags = F::FUNC_Exec | F::FUNC_Native | F::FUNC_Public;
+    t.LinkFunctions(core.playerController, {
+        t.MakeFunction("WasInputKeyJustPressed", core.playerController, pureFlags,
+            {SynP(P::Struct, "Key", key)}, &retBool),
+        t.MakeFunction("ToggleSpeaking", core.playerController, execFlags, {SynP(P::Bool, "bInSpeaking")}),
+        t.MakeFunction("SwitchLevel", core.playerController, execFlags, {SynP(P::Str, "URL")}),
+        t.MakeFunction("FOV", core.playerController, execFlags, {SynP(P::Float, "NewFOV")}),
+    });
+    return core;
+}
+
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,266 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成 UE 映像：随机类型生成
+// 固定种子的伪随机类型图：结构体、枚举、类（多层继承、函数、委托签名）与实例对象
+// 属性引用只指向已生成的类型，对象图无环
+
+#include "synthetic_core.hpp"
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace xrd
+{
+namespace detail
+{
+
+// splitmix64：固定种子下跨平台结果一致
+class SynRandom
+{
+public:
+    explicit SynRandom(u64 seed) : m_state(seed) {}
+
+    u64 Next()
+    {
+        u64 z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    i32 Range(i32 lo, i32 hi) { return lo + static_cast<i32>(Next() % static_cast<u64>(hi - lo + 1)); }
+    bool Chance(i32 percent) { return Range(0, 99) < percent; }
+    template<typename T>
+    const T& Pick(const std::vector<T>& v) { return v[static_cast<size_t>(Next() % v.size())]; }
+
+private:
+    u64 m_state;
+};
+
+inline constexpr const char* kSynWords[] = {
+    "Player", "Weapon", "Inventory", "Ability", "Damage", "Spawn", "Quest", "Vehicle",
+    "Camera", "Team", "Match", "Loot", "Projectile", "Effect", "Widget", "Input",
+    "Animation", "Audio", "Physics", "Movement", "Health", "Armor", "Skill", "Buff",
+    "Item", "Shop", "Map", "Zone", "Objective", "Score", "Save", "Network",
+};
+inline constexpr const char* kSynSuffixes[] = {
+    "Component", "Manager", "Data", "Info", "Settings", "State", "Config", "Subsystem",
+    "Controller", "Handler", "Definition", "Entry", "Instance", "Library", "Proxy", "Row",
+};
+inline constexpr const char* kSynFields[] = {
+    "Value", "Count", "Index", "Owner", "Target", "Location", "Rotation", "Scale",
+    "Speed", "Duration", "Cooldown", "Amount", "Level", "Tag", "Id", "Name",
+    "Radius", "Weight", "Priority", "Timestamp", "Offset", "Limit", "Rate", "Mode",
+};
+
+// 本地化游戏中的对象名用词（含一个扩展平面字符，宽字符条目中为代理对）
+inline constexpr const char16_t* kSynWideWords[] = {
+    u"角色", u"武器", u"背包", u"技能", u"伤害", u"出生点", u"任务", u"载具",
+    u"镜头", u"队伍", u"对局", u"战利品", u"弹道", u"特效", u"界面", u"𠮷祥物",
+};
+
+// 本地化实例名：1~4 个 CJK 词，部分带 ASCII 前缀，末尾为序号（如 "BP_角色武器_123"）
+inline std::u16string MakeSyntheticWideName(SynRandom& rnd, u32 serial)
+{
+    std::u16string name;
+    if (rnd.Chance(30))
+    {
+        name += u"BP_";
+    }
+    for (i32 i = rnd.Range(1, 4); i > 0; --i)
+    {
+        name += kSynWideWords[rnd.Next() % std::size(kSynWideWords)];
+    }
+    name += u'_';
+    for (char c : std::to_string(serial))
+    {
+        name += static_cast<char16_t>(c);
+    }
+    return name;
+}
+
+// 随机类型生成：按权重挑选属性类型，引用只指向已生成的类型（无环）
+class SyntheticGenerator
+{
+public:
+    SyntheticGenerator(SyntheticTypes& types, const SynCoreTypes& core, u64 seed)
+        : t(types), rnd(seed), classes({core.object, core.actor, core.actorComponent,
+            core.sceneComponent, core.pawn}), structs(core.structs), enums(core.enums)
+    {
+    }
+
+    std::string TypeName()
+    {
+        return std::string(kSynWords[rnd.Range(0, 31)]) + kSynSuffixes[rnd.Range(0, 15)]
+            + std::to_string(m_serial++);
+    }
+
+    SynPropSpec RandomProperty(std::string name, bool allowContainers = true)
+    {
+        using P = SynProp;
+        // 权重：数值/对象/结构体为主，容器与委托较少
+        static constexpr std::pair<P, i32> kWeights[] = {
+            {P::Int, 10}, {P::Float, 10}, {P::Bool, 10}, {P::Byte, 5}, {P::Name, 6},
+            {P::Str, 5}, {P::Text, 2}, {P::Object, 10}, {P::Class, 2}, {P::SoftObject, 2},
+            {P::WeakObject, 2}, {P::Struct, 10}, {P::Array, 8}, {P::Map, 2}, {P::Set, 1},
+            {P::Enum, 4}, {P::Double, 3}, {P::Int64, 2}, {P::Delegate, 1},
+            {P::MulticastInlineDelegate, 2}, {P::UInt32, 1}, {P::Int16, 1},
+        };
+        i32 total = 0;
+        for (auto& [p, wgt] : kWeights) total += wgt;
+        i32 roll = rnd.Range(0, total - 1);
+        P type = P::Int;
+        for (auto& [p, wgt] : kWeights)
+        {
+            if (roll < wgt) { type = p; break; }
+            roll -= wgt;
+        }
+        if (!allowContainers && (type == P::Array || type == P::Map || type == P::Set))
+        {
+            type = P::Int;
+        }
+
+        SynPropSpec s;
+        s.type = type;
+        s.name = (type == P::Bool ? "b" : "") + std::move(name);
+        switch (type)
+        {
+            case P::Byte:   s.ref = rnd.Chance(60) ? rnd.Pick(enums) : 0; break;
+            case P::Enum:   s.ref = rnd.Pick(enums); break;
+            case P::Struct: s.ref = rnd.Pick(structs); break;
+            case P::Object: case P::Class: case P::SoftObject: case P::WeakObject:
+                s.ref = rnd.Pick(classes); break;
+            case P::Delegate: case P::MulticastInlineDelegate:
+                s.ref = DelegateSignature(); break;
+            case P::Array: case P::Set:
+            {
+                SynPropSpec in = RandomProperty(s.name, false);
+                s.inner = in.type == P::Bool ? P::Int : in.type;
+                s.innerRef = in.ref;
+                break;
+            }
+            case P::Map:
+            {
+                // 键/值可为结构体（常来自其他包）：TMap 需要元素的完整定义，覆盖跨包依赖
+                static constexpr P kValues[] = {P::Int, P::Int, P::Object, P::Object, P::Struct};
+                s.inner = rnd.Chance(20) ? P::Struct : P::Name;
+                s.innerRef = s.inner == P::Struct ? rnd.Pick(structs) : 0;
+                s.value = kValues[rnd.Range(0, 4)];
+                s.valueRef = s.value == P::Object ? rnd.Pick(classes)
+                    : s.value == P::Struct ? rnd.Pick(structs) : 0;
+                break;
+            }
+            default:
+                break;
+        }
+        if (rnd.Chance(3))
+        {
+            s.arrayDim = rnd.Range(2, 4);
+        }
+        return s;
+    }
+
+    std::vector<SynPropSpec> RandomMembers(i32 count)
+    {
+        std::vector<SynPropSpec> props;
+        for (i32 i = 0; i < count; ++i)
+        {
+            std::string field = kSynFields[rnd.Range(0, 23)];
+            props.push_back(RandomProperty(field + std::to_string(i)));
+        }
+        return props;
+    }
+
+    uptr DelegateSignature()
+    {
+        if (m_signatures.size() < 16 || rnd.Chance(5))
+        {
+            std::string name = "On" + std::string(kSynWords[rnd.Range(0, 31)])
+                + std::to_string(m_serial++) + "__DelegateSignature";
+            u32 flags = SynFlags::FUNC_Public | SynFlags::FUNC_Delegate | SynFlags::FUNC_MulticastDelegate;
+            m_signatures.push_back(t.MakeFunction(name, m_package, flags,
+                {SynPropSpec{SynProp::Object, "Instigator", classes.front()}}, nullptr, true));
+            m_functions++;
+        }
+        return rnd.Pick(m_signatures);
+    }
+
+    void GenerateStruct()
+    {
+        uptr super = rnd.Chance(15) ? rnd.Pick(structs) : 0;
+        structs.push_back(t.MakeStruct(TypeName(), m_package, super, RandomMembers(rnd.Range(1, 10))));
+    }
+
+    void GenerateEnum()
+    {
+        std::vector<std::string> values;
+        i32 n = rnd.Range(2, 12);
+        for (i32 i = 0; i < n; ++i)
+        {
+            values.push_back(std::string(kSynFields[rnd.Range(0, 23)]) + std::to_string(i));
+        }
+        enums.push_back(t.MakeEnum("E" + TypeName(), m_package, values));
+    }
+
+    void GenerateClass()
+    {
+        // 父类：约一半继承已生成的类，形成多层继承链
+        uptr super = rnd.Chance(50) ? rnd.Pick(classes)
+            : classes[static_cast<size_t>(rnd.Range(0, 4))];
+        std::string name = TypeName();
+        uptr cls = t.MakeClass(name, m_package, super, RandomMembers(rnd.Range(0, 12)));
+
+        std::vector<uptr> funcs;
+        i32 funcCount = rnd.Range(0, 4);
+        for (i32 i = 0; i < funcCount; ++i)
+        {
+            std::vector<SynPropSpec> params;
+            i32 pc = rnd.Range(0, 4);
+            for (i32 p = 0; p < pc; ++p)
+            {
+                params.push_back(RandomProperty("In" + std::string(kSynFields[rnd.Range(0, 23)]), false));
+            }
+            SynPropSpec ret = RandomProperty("", false);
+            u32 flags = SynFlags::FUNC_Native | SynFlags::FUNC_Public | SynFlags::FUNC_BlueprintCallable;
+            std::string fn = (rnd.Chance(50) ? "Get" : "Set") + std::string(kSynFields[rnd.Range(0, 23)])
+                + std::to_string(i);
+            funcs.push_back(t.MakeFunction(fn, cls, flags, params, rnd.Chance(60) ? &ret : nullptr));
+        }
+        t.LinkFunctions(cls, funcs);
+        m_functions += funcCount;
+        classes.push_back(cls);
+        m_classNames.push_back(name);
+    }
+
+    // 实例对象：同名不同 Number（Name_0、Name_1 ...），与运行时生成的对象一致
+    // widePercent > 0 时按比例改用各不相同的本地化名称（宽字符条目）
+    void GenerateInstance(uptr outer, i32 widePercent = 0)
+    {
+        size_t k = static_cast<size_t>(rnd.Next() % m_classNames.size());
+        uptr cls = classes[classes.size() - m_classNames.size() + k];
+        i32 size = (std::min)(t.SizeOf(cls), 0x100);
+        FName name = (widePercent > 0 && rnd.Chance(widePercent))
+            ? t.w.WideName(MakeSyntheticWideName(rnd, static_cast<u32>(m_instanceSerial++)))
+            : t.w.Name(m_classNames[k], m_instanceSerial++);
+        t.w.NewObject(cls, name, outer,
+            (std::max)(size, t.w.Layout().objectSize), SynFlags::RF_Transactional);
+    }
+
+    void SetPackage(uptr pkg) { m_package = pkg; }
+    bool HasClasses() const { return !m_classNames.empty(); }
+
+    SyntheticTypes& t;
+    SynRandom rnd;
+    std::vector<uptr> classes;
+    std::vector<uptr> structs;
+    std::vector<uptr> enums;
+    i32 m_functions = 0;
+
+private:
+    uptr m_package = 0;
+    u32 m_serial = 0;
+    i32 m_instanceSerial = 1;
+    std::vector<uptr> m_signatures;
+    std::vector<std::string> m_classNames;
+};
+
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,212 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成 UE 映像
+// 在进程内构建一份假的 UE 进程映像：GObjects（分块/定长）、FNamePool、
+// UClass / UScriptStruct / UFunction / UEnum / FProperty 对象图，可选 UE4 / UE5 布局，对象数可到百万级
+// 通过 SyntheticMemoryAccessor 提供给 xrd 的全部读取路径，用于无游戏进程的基准测试与回归
+//
+// 映像中没有 PE 头与代码段，AutoInit 的进程附加与特征码扫描（GObjects/GNames/GWorld/ProcessEvent）无法覆盖；
+// InstallSyntheticImage 直接装入当前上下文，可选地重跑对象图上的偏移发现并与标准答案比对
+
+#include "synthetic_generator.hpp"
+#include "../../init/init_common.hpp"
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xrd
+{
+
+struct SyntheticImageStats
+{
+    i32 objects = 0;
+    i32 packages = 0;
+    i32 classes = 0;
+    i32 structs = 0;
+    i32 enums = 0;
+    i32 functions = 0;
+    size_t properties = 0;
+    size_t names = 0;
+    size_t committedBytes = 0;
+};
+
+// ─── 合成映像 ───
+class SyntheticUEImage
+{
+public:
+    explicit SyntheticUEImage(const SyntheticImageConfig& config = {})
+        : m_config(config),
+          m_layout(MakeSyntheticLayout(config.engine)),
+          m_offsets(MakeSyntheticOffsets(config))
+    {
+        Build();
+    }
+
+    SyntheticUEImage(const SyntheticUEImage&) = delete;
+    SyntheticUEImage& operator=(const SyntheticUEImage&) = delete;
+
+    const SyntheticImageConfig& Config() const { return m_config; }
+    const SyntheticLayout& Layout() const { return m_layout; }
+    const UEOffsets& Offsets() const { return m_offsets; } // 标准答案（含 GObjects / GNames）
+    const SyntheticAddressSpace& Space() const { return m_space; }
+    const SyntheticImageStats& Stats() const { return m_stats; }
+    uptr ModuleBase() const { return m_moduleBase; }
+    u32 ModuleSize() const { return detail::SyntheticWriter::kModuleSize; }
+
+private:
+    void Build()
+    {
+        detail::SyntheticWriter w(m_space, m_layout, m_offsets);
+        detail::SyntheticTypes types(w);
+        detail::SynCoreTypes core = detail::BuildSyntheticCore(types);
+        detail::SyntheticGenerator gen(types, core, m_config.seed);
+        m_moduleBase = w.ModuleBase();
+
+        i32 target = std::clamp(m_config.objectCount, w.ObjectCount() + 1, 1 << 21);
+        i32 pkgCount = m_config.packageCount > 0
+            ? m_config.packageCount : std::clamp(target / 2500, 1, 4000);
+        i32 coreObjects = w.ObjectCount();
+        i32 coreClasses = static_cast<i32>(gen.classes.size());
+        i32 coreStructs = static_cast<i32>(gen.structs.size());
+        i32 coreEnums = static_cast<i32>(gen.enums.size());
+
+        // 约 45% 为类型相关对象（类、CDO、函数、结构体、枚举），其余为实例
+        i32 typeBudget = coreObjects + (target - coreObjects) * 45 / 100;
+        std::vector<uptr> packages;
+        for (i32 p = 0; p < pkgCount; ++p)
+        {
+            packages.push_back(types.MakePackage("/Script/" + std::string(detail::kSynWords[p % 32])
+                + "Module" + std::to_string(p)));
+        }
+        i32 typeStart = w.ObjectCount();
+        while (w.ObjectCount() < typeBudget)
+        {
+            i64 progress = static_cast<i64>(w.ObjectCount() - typeStart) * pkgCount;
+            size_t pkg = static_cast<size_t>(progress / (std::max)(typeBudget - typeStart, 1));
+            gen.SetPackage(packages[(std::min)(pkg, packages.size() - 1)]);
+            i32 roll = gen.rnd.Range(0, 99);
+            if (roll < 15) gen.GenerateEnum();
+            else if (roll < 45) gen.GenerateStruct();
+            else gen.GenerateClass();
+        }
+        while (w.ObjectCount() < target && gen.HasClasses())
+        {
+            gen.GenerateInstance(gen.rnd.Pick(packages), m_config.widePercent);
+        }
+        w.Finish();
+
+        m_stats.objects = w.ObjectCount();
+        m_stats.packages = pkgCount + 2;
+        m_stats.classes = static_cast<i32>(gen.classes.size()) - coreClasses;
+        m_stats.structs = static_cast<i32>(gen.structs.size()) - coreStructs;
+        m_stats.enums = static_cast<i32>(gen.enums.size()) - coreEnums;
+        m_stats.functions = gen.m_functions;
+        m_stats.properties = w.PropertyCount();
+        m_stats.names = w.NameCount();
+        m_stats.committedBytes = m_space.CommittedBytes();
+    }
+
+    SyntheticImageConfig m_config;
+    SyntheticLayout m_layout;
+    UEOffsets m_offsets;
+    SyntheticAddressSpace m_space;
+    SyntheticImageStats m_stats;
+    uptr m_moduleBase = 0;
+};
+
+// 装入当前线程的上下文（全局或 ScopedContext 绑定的实例）：内存访问器指向合成地址空间，主模块为伪模块
+// scrubOffsets 为 true 时只保留 GObjects / GNames 及其布局，其余偏移交给 DiscoverObjectGraphOffsets 重新发现
+// 返回的访问器由 Ctx().mem 持有，调用方可读取其读取计数
+inline SyntheticMemoryAccessor* InstallSyntheticImage(const SyntheticUEImage& image, bool scrubOffsets = false)
+{
+    ResetContext();
+    auto& ctx = Ctx();
+    auto accessor = std::make_unique<SyntheticMemoryAccessor>(image.Space());
+    SyntheticMemoryAccessor* raw = accessor.get();
+    ctx.mem = std::move(accessor);
+
+    const UEOffsets& truth = image.Offsets();
+    if (scrubOffsets)
+    {
+        ctx.off = UEOffsets{};
+        ctx.off.GObjects = truth.GObjects;
+        ctx.off.GNames = truth.GNames;
+        ctx.off.bIsChunkedObjArray = truth.bIsChunkedObjArray;
+        ctx.off.bUseNamePool = truth.bUseNamePool;
+    }
+    else
+    {
+        ctx.off = truth;
+    }
+    ctx.mainModule = ModuleInfo{image.ModuleBase(), image.ModuleSize(), L"SyntheticGame.exe"};
+
+    // 伪模块的段：.data 放全局结构，.rdata 放虚表，.text 放原生函数桩
+    using W = detail::SyntheticWriter;
+    struct { const char* name; u32 rva; u32 end; } secs[] = {
+        {".data",  W::kRvaObjectArray,  W::kRvaVTables},
+        {".rdata", W::kRvaVTables,      W::kRvaNativeThunks},
+        {".text",  W::kRvaNativeThunks, W::kModuleSize},
+    };
+    for (auto& s : secs)
+    {
+        SectionCache sec;
+        sec.va = image.ModuleBase() + s.rva;
+        sec.size = s.end - s.rva;
+        sec.name = s.name;
+        const u8* src = image.Space().At(sec.va, sec.size);
+        sec.data.assign(src, src + sec.size);
+        ctx.sections.push_back(std::move(sec));
+    }
+    RefreshReadableRegions();
+    ctx.inited = true;
+    return raw;
+}
+
+// 与标准答案比对 DiscoverObjectGraphOffsets 负责的偏移，返回不一致项（字段名 发现值 != 标准值）
+inline std::vector<std::string> DiffSyntheticOffsets(const UEOffsets& found, const UEOffsets& truth)
+{
+    std::vector<std::string> diff;
+    auto check = [&](const char* name, i32 a, i32 b)
+    {
+        if (a != b)
+        {
+            auto hex = [](i32 v) { return v < 0 ? std::string("-1") : std::format("0x{:X}", v); };
+            diff.push_back(std::format("{} {} != {}", name, hex(a), hex(b)));
+        }
+    };
+#define XRD_SYN_CHECK(field) check(#field, found.field, truth.field)
+    XRD_SYN_CHECK(UObject_Flags);
+    XRD_SYN_CHECK(UObject_Index);
+    XRD_SYN_CHECK(UObject_Class);
+    XRD_SYN_CHECK(UObject_Name);
+    XRD_SYN_CHECK(UObject_Outer);
+    XRD_SYN_CHECK(UField_Next);
+    XRD_SYN_CHECK(UStruct_SuperStruct);
+    XRD_SYN_CHECK(UStruct_Children);
+    XRD_SYN_CHECK(UStruct_ChildProperties);
+    XRD_SYN_CHECK(UStruct_Size);
+    XRD_SYN_CHECK(UFunction_FunctionFlags);
+    XRD_SYN_CHECK(UFunction_ExecFunction);
+    XRD_SYN_CHECK(UClass_CastFlags);
+    XRD_SYN_CHECK(UClass_ClassDefaultObject);
+    XRD_SYN_CHECK(UEnum_Names);
+    XRD_SYN_CHECK(Property_ArrayDim);
+    XRD_SYN_CHECK(Property_ElementSize);
+    XRD_SYN_CHECK(Property_PropertyFlags);
+    XRD_SYN_CHECK(Property_Offset);
+    XRD_SYN_CHECK(ByteProperty_Enum);
+    XRD_SYN_CHECK(BoolProperty_Base);
+    XRD_SYN_CHECK(ObjectProperty_Class);
+    XRD_SYN_CHECK(ClassProperty_MetaClass);
+    XRD_SYN_CHECK(StructProperty_Struct);
+    XRD_SYN_CHECK(ArrayProperty_Inner);
+    XRD_SYN_CHECK(MapProperty_Base);
+    XRD_SYN_CHECK(SetProperty_ElementProp);
+    XRD_SYN_CHECK(EnumProperty_Base);
+    XRD_SYN_CHECK(DelegateProperty_Sig);
+    XRD_SYN_CHECK(FNamePoolBlockBits);
+#undef XRD_SYN_CHECK
+    return diff;
+}
+
+} // namespace xrd
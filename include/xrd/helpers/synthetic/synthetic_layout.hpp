@@ -0,0 +1,229 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成 UE 映像：引擎布局预设
+// 每个预设给出真实引擎版本的对象布局（UObject / UStruct / FField / FProperty 偏移与大小）
+// 同一份布局既用于写出合成映像，也作为偏移发现结果的标准答案
+
+#include "../../core/context.hpp"
+#include <string_view>
+
+namespace xrd
+{
+
+// 布局预设
+enum class SyntheticEngine : u8
+{
+    UE4_27 = 0, // FProperty、FNamePool、float 精度
+    UE5_3  = 1, // 同上，双精度 FVector / FRotator，UClass 布局不同
+};
+
+struct SyntheticImageConfig
+{
+    SyntheticEngine engine = SyntheticEngine::UE4_27;
+    bool chunkedObjects = true; // FChunkedFixedUObjectArray / FFixedUObjectArray
+    i32  objectCount    = 100000; // GObjects 元素总数（含引擎核心对象），上限 1 << 21
+    i32  packageCount   = 0;      // 0 表示按对象数自动取
+    u64  seed           = 0x58524431ull; // 固定种子，同一配置生成的映像逐字节一致
+    i32  widePercent    = 0;      // 实例对象使用本地化（CJK，宽字符条目）名称的百分比
+};
+
+// 引擎布局中 UEOffsets 之外的部分：对象大小与未被读取方读取、但需要写出的字段
+struct SyntheticLayout
+{
+    i32 objectSize   = 0x28;  // sizeof(UObject)
+    i32 structSize   = 0xB0;  // sizeof(UStruct)
+    i32 classSize    = 0x230;
+    i32 scriptStructSize = 0xC0;
+    i32 functionSize = 0xE0;
+    i32 enumSize     = 0x60;
+    i32 packageSize  = 0x80;
+    i32 propertySize = 0x90;  // FProperty + 最大的类型化字段
+    i32 fieldClassSize = 0x40;
+
+    i32 UStruct_MinAlignment  = 0x5C;
+    i32 UClass_ClassFlags     = 0xCC;
+    i32 UFunction_NumParms    = 0xB4;
+    i32 UFunction_ParmsSize   = 0xB6;
+    i32 UFunction_ReturnValueOffset = 0xB8;
+    i32 UEnum_CppForm         = 0x50;
+    i32 FField_Flags          = 0x30;
+    i32 FFieldClass_Id        = 0x08;
+    i32 FFieldClass_SuperClass = 0x20;
+
+    bool doublePrecision = false;
+};
+
+inline SyntheticLayout MakeSyntheticLayout(SyntheticEngine engine)
+{
+    SyntheticLayout l;
+    if (engine == SyntheticEngine::UE5_3)
+    {
+        l.classSize = 0x200;
+        l.doublePrecision = true;
+    }
+    return l;
+}
+
+// 合成映像的标准偏移；GObjects / GNames 由构建器在写出全局结构后填入
+inline UEOffsets MakeSyntheticOffsets(const SyntheticImageConfig& cfg)
+{
+    UEOffsets off;
+    off.UObject_Vft   = 0x00;
+    off.UObject_Flags = 0x08;
+    off.UObject_Index = 0x0C;
+    off.UObject_Class = 0x10;
+    off.UObject_Name  = 0x18;
+    off.UObject_Outer = 0x20;
+    off.UField_Next   = 0x28;
+
+    off.UStruct_SuperStruct     = 0x40;
+    off.UStruct_Children        = 0x48;
+    off.UStruct_ChildProperties = 0x50;
+    off.UStruct_Size            = 0x58;
+
+    off.UFunction_FunctionFlags = 0xB0;
+    off.UFunction_ExecFunction  = 0xD8;
+
+    off.UClass_CastFlags          = 0xD0;
+    off.UClass_ClassDefaultObject = (cfg.engine == SyntheticEngine::UE5_3) ? 0x110 : 0x118;
+    off.UClass_ImplementedInterfaces = (cfg.engine == SyntheticEngine::UE5_3) ? 0x1E0 : 0x1F8;
+
+    off.UEnum_Names = 0x40;
+
+    off.Property_ArrayDim      = 0x38;
+    off.Property_ElementSize   = 0x3C;
+    off.Property_PropertyFlags = 0x40;
+    off.Property_Offset        = 0x4C;
+
+    off.ByteProperty_Enum       = 0x78;
+    off.BoolProperty_Base       = 0x78;
+    off.ObjectProperty_Class    = 0x78;
+    off.ClassProperty_MetaClass = 0x80;
+    off.StructProperty_Struct   = 0x78;
+    off.ArrayProperty_Inner     = 0x78;
+    off.MapProperty_Base        = 0x78;
+    off.SetProperty_ElementProp = 0x78;
+    off.EnumProperty_Base       = 0x78;
+    off.DelegateProperty_Sig    = 0x78;
+
+    off.bIsChunkedObjArray = cfg.chunkedObjects;
+    off.ChunkSize          = 64 * 1024;
+    off.FUObjectItemSize   = 0x18;
+    off.FUObjectItemInitialOffset = 0x00;
+    off.FUObjectItemSerialNumberOffset = 0x10;
+
+    off.bUseNamePool       = true;
+    off.FNamePoolBlockBits = 16;
+    off.FNameEntryStride   = 2;
+    off.bUseFProperty      = true;
+    off.bUseDoublePrecision = (cfg.engine == SyntheticEngine::UE5_3);
+    return off;
+}
+
+namespace detail
+{
+
+// FFieldClass 描述：类名、CastFlags、元素大小与对齐
+struct SyntheticFieldClass
+{
+    std::string_view name;
+    u64 castFlags;
+    i32 size;
+    i32 align;
+};
+
+// 属性类型编号，与 kSyntheticFieldClasses 下标一致
+enum class SynProp : u8
+{
+    Byte, Bool, Int8, Int16, Int, Int64, UInt16, UInt32, UInt64, Float, Double,
+    Name, Str, Text, Object, Class, SoftObject, SoftClass, WeakObject, LazyObject,
+    Interface, Struct, Array, Map, Set, Enum, Delegate, MulticastInlineDelegate,
+    MulticastSparseDelegate, FieldPath,
+    Count
+};
+
+// EClassCastFlags：每项含自身标志与 CASTCLASS_FProperty(0x8000)
+inline constexpr SyntheticFieldClass kSyntheticFieldClasses[] = {
+    {"ByteProperty",      0x0000000000008040ull, 1,    1},
+    {"BoolProperty",      0x0000000000028000ull, 1,    1},
+    {"Int8Property",      0x0000000000008002ull, 1,    1},
+    {"Int16Property",     0x0000000080008000ull, 2,    2},
+    {"IntProperty",       0x0000000000008080ull, 4,    4},
+    {"Int64Property",     0x0000000000408000ull, 8,    8},
+    {"UInt16Property",    0x0000000000048000ull, 2,    2},
+    {"UInt32Property",    0x0000000000008800ull, 4,    4},
+    {"UInt64Property",    0x0000000000008200ull, 8,    8},
+    {"FloatProperty",     0x0000000000008100ull, 4,    4},
+    {"DoubleProperty",    0x0000000100008000ull, 8,    8},
+    {"NameProperty",      0x000000000000A000ull, 8,    4},
+    {"StrProperty",       0x000000000000C000ull, 0x10, 8},
+    {"TextProperty",      0x0000000040008000ull, 0x18, 8},
+    {"ObjectProperty",    0x0000000004018000ull, 8,    8},
+    {"ClassProperty",     0x0000000004018400ull, 8,    8},
+    {"SoftObjectProperty", 0x0000000024008000ull, 0x28, 8},
+    {"SoftClassProperty", 0x0000000224008000ull, 0x28, 8},
+    {"WeakObjectProperty", 0x000000000C008000ull, 8,   4},
+    {"LazyObjectProperty", 0x0000000014008000ull, 0x1C, 4},
+    {"InterfaceProperty", 0x0000000000009000ull, 0x10, 8},
+    {"StructProperty",    0x0000000000108000ull, 0,    0},
+    {"ArrayProperty",     0x0000000000208000ull, 0x10, 8},
+    {"MapProperty",       0x0000400000008000ull, 0x50, 8},
+    {"SetProperty",       0x0000800000008000ull, 0x50, 8},
+    {"EnumProperty",      0x0001000000008000ull, 1,    1},
+    {"DelegateProperty",  0x0000000000808000ull, 0x10, 4},
+    {"MulticastInlineDelegateProperty", 0x0004000002008000ull, 0x10, 8},
+    {"MulticastSparseDelegateProperty", 0x0008000002008000ull, 1, 1},
+    {"FieldPathProperty", 0x0010000000008000ull, 0x20, 8},
+};
+static_assert(std::size(kSyntheticFieldClasses) == static_cast<size_t>(SynProp::Count));
+
+// 常用标志位
+namespace SynFlags
+{
+    constexpr u32 RF_Public        = 0x00000001;
+    constexpr u32 RF_Standalone    = 0x00000002;
+    constexpr u32 RF_Transactional = 0x00000008;
+    constexpr u32 RF_ClassDefaultObject = 0x00000010;
+    constexpr u32 RF_ArchetypeObject    = 0x00000020;
+    constexpr u32 RF_Transient     = 0x00000040;
+    constexpr u32 RF_MarkAsNative  = 0x01000000;
+
+    constexpr u32 CLASS_Native     = 0x00000080;
+
+    constexpr u64 CPF_Edit           = 0x0000000000000001ull;
+    constexpr u64 CPF_BlueprintVisible = 0x0000000000000004ull;
+    constexpr u64 CPF_Parm           = 0x0000000000000080ull;
+    constexpr u64 CPF_OutParm        = 0x0000000000000100ull;
+    constexpr u64 CPF_ReturnParm     = 0x0000000000000400ull;
+    constexpr u64 CPF_ConstParm      = 0x0000000000000002ull;
+    constexpr u64 CPF_ZeroConstructor = 0x0000000000000200ull;
+    constexpr u64 CPF_NativeAccessSpecifierPublic = 0x0010000000000000ull;
+
+    constexpr u32 FUNC_Final       = 0x00000001;
+    constexpr u32 FUNC_Exec        = 0x00000200;
+    constexpr u32 FUNC_Native      = 0x00000400;
+    constexpr u32 FUNC_Event       = 0x00000800;
+    constexpr u32 FUNC_Static      = 0x00002000;
+    constexpr u32 FUNC_Public      = 0x00020000;
+    constexpr u32 FUNC_Delegate    = 0x00100000;
+    constexpr u32 FUNC_MulticastDelegate = 0x00010000;
+    constexpr u32 FUNC_HasOutParms = 0x00400000;
+    constexpr u32 FUNC_BlueprintCallable = 0x04000000;
+    constexpr u32 FUNC_BlueprintPure = 0x10000000;
+    constexpr u32 FUNC_Const       = 0x40000000;
+
+    constexpr u64 CASTCLASS_UField  = 0x0000000000000001ull;
+    constexpr u64 CASTCLASS_UEnum   = 0x0000000000000004ull;
+    constexpr u64 CASTCLASS_UStruct = 0x0000000000000008ull;
+    constexpr u64 CASTCLASS_UScriptStruct = 0x0000000000000010ull;
+    constexpr u64 CASTCLASS_UClass  = 0x0000000000000020ull;
+    constexpr u64 CASTCLASS_UPackage = 0x0000000400000000ull;
+    constexpr u64 CASTCLASS_UFunction = 0x0000000000080000ull;
+    constexpr u64 CASTCLASS_UDelegateFunction = 0x0000100000000000ull;
+    constexpr u64 CASTCLASS_AActor  = 0x0000001000000000ull;
+    constexpr u64 CASTCLASS_APlayerController = 0x0000002000000000ull;
+    constexpr u64 CASTCLASS_APawn   = 0x0000004000000000ull;
+    constexpr u64 CASTCLASS_SceneComponent = 0x0000008000000000ull;
+}
+
+} // namespace detail
+} // namespace xrd
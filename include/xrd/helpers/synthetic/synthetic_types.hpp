@@ -0,0 +1,310 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成 UE 映像：类型构造
+// 在 SyntheticWriter 之上构造包、类、结构体、函数、枚举与各类属性
+// 属性按描述（SynPropSpec）给出，成员偏移、结构体大小与对齐由这里按 UE 规则排布
+
+#include "synthetic_writer.hpp"
+#include <string>
+#include <vector>
+
+namespace xrd
+{
+namespace detail
+{
+
+// 一个属性的描述；ref 按类型解释：结构体 / 类 / 枚举 / 委托签名
+struct SynPropSpec
+{
+    SynProp type = SynProp::Int;
+    std::string name;
+    uptr ref = 0;
+    SynProp inner = SynProp::Int;  // Array / Set 元素、Map 键
+    uptr innerRef = 0;
+    SynProp value = SynProp::Int;  // Map 值
+    uptr valueRef = 0;
+    i32 arrayDim = 1;
+    u64 flags = SynFlags::CPF_Edit | SynFlags::CPF_BlueprintVisible;
+};
+
+class SyntheticTypes
+{
+public:
+    explicit SyntheticTypes(SyntheticWriter& writer) : w(writer) {}
+
+    // 元类：由核心类型构造时设置
+    uptr metaClass = 0;
+    uptr metaScriptStruct = 0;
+    uptr metaFunction = 0;
+    uptr metaDelegateFunction = 0;
+    uptr metaEnum = 0;
+    uptr metaPackage = 0;
+
+    uptr MakePackage(std::string_view name)
+    {
+        return w.NewObject(metaPackage, w.Name(name), 0, w.Layout().packageSize, SynFlags::RF_Public);
+    }
+
+    // 结构体 / 函数的大小与对齐（读取已写出的 UStruct 字段）
+    i32 SizeOf(uptr structObj) const
+    {
+        return w.Space().Get<i32>(structObj + w.Off().UStruct_Size);
+    }
+    i32 AlignOf(uptr structObj) const
+    {
+        i16 a = w.Space().Get<i16>(structObj + w.Layout().UStruct_MinAlignment);
+        return a > 0 ? a : 1;
+    }
+
+    i32 ElementSize(SynProp type, uptr ref) const
+    {
+        if (type == SynProp::Struct)
+        {
+            return SizeOf(ref);
+        }
+        return kSyntheticFieldClasses[static_cast<size_t>(type)].size;
+    }
+    i32 ElementAlign(SynProp type, uptr ref) const
+    {
+        if (type == SynProp::Struct)
+        {
+            return AlignOf(ref);
+        }
+        return kSyntheticFieldClasses[static_cast<size_t>(type)].align;
+    }
+
+    // 写出一个属性（含类型化字段与内部属性）
+    uptr MakeProperty(const SynPropSpec& s, uptr owner, bool ownerIsObject, i32 offset, i32 bit = -1)
+    {
+        const UEOffsets& off = w.Off();
+        auto& space = w.Space();
+        i32 elemSize = ElementSize(s.type, s.ref);
+        uptr prop = w.NewProperty(s.type, w.Name(s.name), owner, ownerIsObject,
+            offset, elemSize, s.arrayDim, s.flags);
+
+        switch (s.type)
+        {
+            case SynProp::Byte:
+                space.Put<uptr>(prop + off.ByteProperty_Enum, s.ref);
+                break;
+            case SynProp::Bool:
+            {
+                // 位域：ByteMask == FieldMask == 1 << bit；原生 bool：FieldMask 为 0xFF
+                u8 mask = bit >= 0 ? static_cast<u8>(1u << bit) : u8(1);
+                space.Put<u8>(prop + off.BoolProperty_Base + 0, 1);    // FieldSize
+                space.Put<u8>(prop + off.BoolProperty_Base + 1, 0);    // ByteOffset
+                space.Put<u8>(prop + off.BoolProperty_Base + 2, mask); // ByteMask
+                space.Put<u8>(prop + off.BoolProperty_Base + 3, bit >= 0 ? mask : u8(0xFF));
+                break;
+            }
+            case SynProp::Object:
+            case SynProp::WeakObject:
+            case SynProp::LazyObject:
+            case SynProp::SoftObject:
+            case SynProp::Interface:
+                space.Put<uptr>(prop + off.ObjectProperty_Class, s.ref);
+                break;
+            case SynProp::Class:
+            case SynProp::SoftClass:
+                space.Put<uptr>(prop + off.ObjectProperty_Class, metaClass);
+                space.Put<uptr>(prop + off.ClassProperty_MetaClass, s.ref);
+                break;
+            case SynProp::Struct:
+                space.Put<uptr>(prop + off.StructProperty_Struct, s.ref);
+                break;
+            case SynProp::Array:
+            case SynProp::Set:
+            {
+                SynPropSpec in{s.inner, s.name, s.innerRef};
+                in.flags = 0;
+                uptr inner = MakeProperty(in, prop, false, 0);
+                space.Put<uptr>(prop + (s.type == SynProp::Array
+                    ? off.ArrayProperty_Inner : off.SetProperty_ElementProp), inner);
+                break;
+            }
+            case SynProp::Map:
+            {
+                SynPropSpec k{s.inner, s.name + "_Key", s.innerRef};
+                SynPropSpec v{s.value, s.name, s.valueRef};
+                k.flags = v.flags = 0;
+                space.Put<uptr>(prop + off.MapProperty_Base, MakeProperty(k, prop, false, 0));
+                space.Put<uptr>(prop + off.MapProperty_Base + 8, MakeProperty(v, prop, false, 0));
+                break;
+            }
+            case SynProp::Enum:
+            {
+                SynPropSpec u{SynProp::Byte, "UnderlyingType"};
+                u.flags = 0;
+                space.Put<uptr>(prop + off.EnumProperty_Base, MakeProperty(u, prop, false, 0));
+                space.Put<uptr>(prop + off.EnumProperty_Base + 8, s.ref);
+                break;
+            }
+            case SynProp::Delegate:
+            case SynProp::MulticastInlineDelegate:
+            case SynProp::MulticastSparseDelegate:
+                space.Put<uptr>(prop + off.DelegateProperty_Sig, s.ref);
+                break;
+            default:
+                break;
+        }
+        return prop;
+    }
+
+    // 排布并写出成员，返回属性列表；cursor 决定起始偏移
+    std::vector<uptr> LayoutMembers(uptr owner, SynLayoutCursor& cursor, const std::vector<SynPropSpec>& props)
+    {
+        std::vector<uptr> out;
+        out.reserve(props.size());
+        for (auto& s : props)
+        {
+            if (s.type == SynProp::Bool && s.arrayDim == 1 && !(s.flags & SynFlags::CPF_Parm))
+            {
+                auto [at, bit] = cursor.PlaceBit();
+                out.push_back(MakeProperty(s, owner, true, at, bit));
+                continue;
+            }
+            i32 size = ElementSize(s.type, s.ref) * s.arrayDim;
+            i32 at = cursor.Place(size, ElementAlign(s.type, s.ref));
+            out.push_back(MakeProperty(s, owner, true, at));
+        }
+        w.LinkChain(owner + w.Off().UStruct_ChildProperties, out, w.Off().FField_Next);
+        return out;
+    }
+
+    // 脚本结构体；super 为 0 时从偏移 0 开始排布
+    uptr MakeStruct(std::string_view name, uptr outer, uptr super, const std::vector<SynPropSpec>& props)
+    {
+        uptr obj = w.NewObject(metaScriptStruct, w.Name(name), outer,
+            w.Layout().scriptStructSize, SynFlags::RF_Public | SynFlags::RF_Standalone);
+        SynLayoutCursor cursor(super ? SizeOf(super) : 0);
+        if (super)
+        {
+            cursor.Place(0, AlignOf(super));
+        }
+        LayoutMembers(obj, cursor, props);
+        w.WriteStruct(obj, super, (std::max)(cursor.AlignedSize(), 1), cursor.MaxAlign());
+        return obj;
+    }
+
+    // 类：成员接在父类实例大小之后；同时创建 CDO（Default__Name）
+    uptr MakeClass(
+        std::string_view name, uptr outer, uptr super,
+        const std::vector<SynPropSpec>& props, u64 castFlags = 0, i32 nativeSize = 0)
+    {
+        uptr cls = w.NewObject(metaClass, w.Name(name), outer,
+            w.Layout().classSize, SynFlags::RF_Public | SynFlags::RF_Standalone);
+        FinishClass(cls, name, super, props, castFlags, nativeSize);
+        return cls;
+    }
+
+    // 核心元类先创建对象再补写内容，因此与 MakeClass 分开
+    // nativeSize：C++ 侧的实例大小（UObject 等没有反射成员的核心类）
+    void FinishClass(
+        uptr cls, std::string_view name, uptr super,
+        const std::vector<SynPropSpec>& props, u64 castFlags, i32 nativeSize = 0)
+    {
+        auto& space = w.Space();
+        const UEOffsets& off = w.Off();
+        i32 superSize = super ? SizeOf(super) : 0;
+        SynLayoutCursor cursor(superSize);
+        cursor.Place(0, super ? AlignOf(super) : 8);
+        LayoutMembers(cls, cursor, props);
+        i32 size = (std::max)({cursor.AlignedSize(), superSize, nativeSize});
+        w.WriteStruct(cls, super, size, cursor.MaxAlign());
+
+        u64 superCast = super ? space.Get<u64>(super + off.UClass_CastFlags) : 0;
+        space.Put<u64>(cls + off.UClass_CastFlags, superCast | castFlags);
+        space.Put<u32>(cls + w.Layout().UClass_ClassFlags, SynFlags::CLASS_Native);
+
+        std::string cdoName = "Default__" + std::string(name);
+        uptr outer = space.Get<uptr>(cls + off.UObject_Outer);
+        i32 cdoSize = (std::max)(SizeOf(cls), w.Layout().objectSize);
+        uptr cdo = w.NewObject(cls, w.Name(cdoName), outer, cdoSize,
+            SynFlags::RF_Public | SynFlags::RF_ClassDefaultObject | SynFlags::RF_ArchetypeObject);
+        space.Put<uptr>(cls + off.UClass_ClassDefaultObject, cdo);
+    }
+
+    // 函数：参数从偏移 0 排布，返回值作为最后一个参数
+    uptr MakeFunction(
+        std::string_view name, uptr outer, u32 flags,
+        std::vector<SynPropSpec> params, const SynPropSpec* ret = nullptr,
+        bool delegateSignature = false)
+    {
+        auto& space = w.Space();
+        const UEOffsets& off = w.Off();
+        auto& layout = w.Layout();
+        uptr fn = w.NewObject(delegateSignature ? metaDelegateFunction : metaFunction,
+            w.Name(name), outer, layout.functionSize, SynFlags::RF_Public);
+
+        for (auto& p : params)
+        {
+            p.flags = SynFlags::CPF_Parm | SynFlags::CPF_ZeroConstructor;
+        }
+        if (ret)
+        {
+            params.push_back(*ret);
+            params.back().name = "ReturnValue";
+            params.back().flags = SynFlags::CPF_Parm | SynFlags::CPF_OutParm
+                | SynFlags::CPF_ReturnParm | SynFlags::CPF_ZeroConstructor;
+        }
+
+        SynLayoutCursor cursor(0);
+        auto props = LayoutMembers(fn, cursor, params);
+        i32 parmsSize = cursor.AlignedSize();
+        w.WriteStruct(fn, 0, parmsSize, cursor.MaxAlign());
+
+        space.Put<u32>(fn + off.UFunction_FunctionFlags, flags);
+        space.Put<u8>(fn + layout.UFunction_NumParms, static_cast<u8>(params.size()));
+        space.Put<u16>(fn + layout.UFunction_ParmsSize, static_cast<u16>(parmsSize));
+        u16 retOffset = 0xFFFF;
+        if (ret && !props.empty())
+        {
+            retOffset = static_cast<u16>(space.Get<i32>(props.back() + off.Property_Offset));
+        }
+        space.Put<u16>(fn + layout.UFunction_ReturnValueOffset, retOffset);
+        if (!delegateSignature)
+        {
+            u32 thunk = SyntheticWriter::kRvaNativeThunks + (m_thunk++ % 0x1000) * 0x10;
+            space.Put<uptr>(fn + off.UFunction_ExecFunction, w.ModuleAddr(thunk));
+        }
+        return fn;
+    }
+
+    // 类的函数挂到 Children（UField 链）
+    void LinkFunctions(uptr cls, const std::vector<uptr>& funcs)
+    {
+        w.LinkChain(cls + w.Off().UStruct_Children, funcs, w.Off().UField_Next);
+    }
+
+    // 枚举：成员名写成 "EName::Value"，最后追加 EName_MAX
+    uptr MakeEnum(std::string_view name, uptr outer, const std::vector<std::string>& values)
+    {
+        auto& space = w.Space();
+        uptr e = w.NewObject(metaEnum, w.Name(name), outer,
+            w.Layout().enumSize, SynFlags::RF_Public | SynFlags::RF_Standalone);
+        i32 count = static_cast<i32>(values.size()) + 1;
+        uptr data = space.Alloc(static_cast<size_t>(count) * 16, 8);
+        std::string prefix = std::string(name) + "::";
+        for (i32 i = 0; i < count; ++i)
+        {
+            std::string member = i + 1 < count
+                ? prefix + values[i]
+                : prefix + std::string(name) + "_MAX";
+            space.Put<FName>(data + i * 16, w.Name(member));
+            space.Put<i64>(data + i * 16 + 8, i);
+        }
+        uptr arr = e + w.Off().UEnum_Names;
+        space.Put<uptr>(arr, data);
+        space.Put<i32>(arr + 8, count);
+        space.Put<i32>(arr + 12, count);
+        space.Put<u8>(e + w.Layout().UEnum_CppForm, 2); // EnumClass
+        return e;
+    }
+
+    SyntheticWriter& w;
+
+private:
+    u32 m_thunk = 0;
+};
+
+} // namespace detail
+} // namespace xrd
@@ -0,0 +1,298 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成 UE 映像：底层写出器
+// 在合成地址空间中按引擎布局写出 FNamePool、UObject、UStruct、FField/FProperty 与 GObjects
+// 只负责"怎么写"，生成哪些类型由 synthetic_image.hpp 决定
+//
+// 伪模块（代替主模块的 .data/.text）：
+//   +0x01000  FUObjectArray（ObjObjects 位于 +0x10，即 GObjects）
+//   +0x10000  FNamePool（Lock / CurrentBlock / CurrentByteCursor / Blocks[8192]）
+//   +0x30000  虚表    +0x40000  原生函数桩（UFunction::ExecFunction 指向这里）
+
+#include "../../core/utf.hpp"
+#include "../../memory/memory_synthetic.hpp"
+#include "synthetic_layout.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+namespace xrd
+{
+namespace detail
+{
+
+class SyntheticWriter
+{
+public:
+    static constexpr u32 kModuleSize       = 0x100000;
+    static constexpr u32 kRvaObjectArray   = 0x1000;
+    static constexpr u32 kRvaNamePool      = 0x10000;
+    static constexpr u32 kRvaVTables       = 0x30000;
+    static constexpr u32 kRvaNativeThunks  = 0x40000;
+    static constexpr u32 kNamePoolMaxBlocks = 8192;
+    static constexpr u32 kNameBlockBytes   = 2u << 16; // 16 位块内偏移 × 2 字节步长
+
+    SyntheticWriter(SyntheticAddressSpace& space, const SyntheticLayout& layout, UEOffsets& off)
+        : m_space(space), m_layout(layout), m_off(off)
+    {
+        m_module = m_space.Alloc(kModuleSize, 0x10000);
+        m_off.GObjects = m_module + kRvaObjectArray + 0x10;
+        m_off.GNames = m_module + kRvaNamePool;
+        // 虚表：每项指向原生函数桩区域
+        for (u32 i = 0; i < 0x80; ++i)
+        {
+            m_space.Put<uptr>(ModuleAddr(kRvaVTables + i * 8), ModuleAddr(kRvaNativeThunks + i * 0x10));
+        }
+        Name("None"); // FNamePool 第一个条目固定为 None
+    }
+
+    uptr ModuleBase() const { return m_module; }
+    uptr ModuleAddr(u32 rva) const { return m_module + rva; }
+
+    // ─── FNamePool ───
+    FName Name(std::string_view text, i32 number = 0)
+    {
+        auto it = m_names.find(std::string(text));
+        if (it != m_names.end())
+        {
+            return {it->second, number};
+        }
+
+        u32 len = static_cast<u32>((std::min)(text.size(), size_t(1023)));
+        u32 bytes = (2 + len + 1) & ~1u; // 头部 + ANSI 字符，按步长对齐
+        if (m_nameBlock == 0 || m_nameCursor + bytes > kNameBlockBytes)
+        {
+            m_nameBlock = m_space.Alloc(kNameBlockBytes, 8);
+            m_space.Put<uptr>(m_off.GNames + 0x10 + m_nameBlockCount * 8, m_nameBlock);
+            m_nameBlockCount++;
+            m_nameCursor = 0;
+        }
+        uptr entry = m_nameBlock + m_nameCursor;
+        m_space.Put<u16>(entry, static_cast<u16>(len << 6));
+        m_space.PutBytes(entry + 2, text.data(), len);
+
+        i32 id = static_cast<i32>(((m_nameBlockCount - 1) << 16) | (m_nameCursor >> 1));
+        m_nameCursor += bytes;
+        m_names.emplace(std::string(text), id);
+        return {id, number};
+    }
+
+    // 宽字符条目（header bit0 = 1，正文为 UTF-16LE）：引擎对含非 ANSI 字符的名称使用此格式
+    FName WideName(std::u16string_view text, i32 number = 0)
+    {
+        std::string key;
+        Utf16ToUtf8(reinterpret_cast<const u16*>(text.data()), text.size(), key);
+        auto it = m_names.find(key);
+        if (it != m_names.end())
+        {
+            return {it->second, number};
+        }
+
+        u32 len = static_cast<u32>((std::min)(text.size(), size_t(1023)));
+        u32 bytes = 2 + len * 2;
+        if (m_nameBlock == 0 || m_nameCursor + bytes > kNameBlockBytes)
+        {
+            m_nameBlock = m_space.Alloc(kNameBlockBytes, 8);
+            m_space.Put<uptr>(m_off.GNames + 0x10 + m_nameBlockCount * 8, m_nameBlock);
+            m_nameBlockCount++;
+            m_nameCursor = 0;
+        }
+        uptr entry = m_nameBlock + m_nameCursor;
+        m_space.Put<u16>(entry, static_cast<u16>((len << 6) | 1));
+        m_space.PutBytes(entry + 2, text.data(), len * 2);
+
+        i32 id = static_cast<i32>(((m_nameBlockCount - 1) << 16) | (m_nameCursor >> 1));
+        m_nameCursor += bytes;
+        m_names.emplace(std::move(key), id);
+        return {id, number};
+    }
+
+    // ─── UObject ───
+    uptr NewObject(uptr cls, FName name, uptr outer, i32 size, u32 flags)
+    {
+        uptr obj = m_space.Alloc(static_cast<size_t>(size), 16);
+        m_space.Put<uptr>(obj + m_off.UObject_Vft, ModuleAddr(kRvaVTables));
+        m_space.Put<u32>(obj + m_off.UObject_Flags, flags);
+        m_space.Put<i32>(obj + m_off.UObject_Index, static_cast<i32>(m_objects.size()));
+        m_space.Put<uptr>(obj + m_off.UObject_Class, cls);
+        m_space.Put<FName>(obj + m_off.UObject_Name, name);
+        m_space.Put<uptr>(obj + m_off.UObject_Outer, outer);
+        m_objects.push_back(obj);
+        return obj;
+    }
+
+    void SetObjectClass(uptr obj, uptr cls)
+    {
+        m_space.Put<uptr>(obj + m_off.UObject_Class, cls);
+    }
+
+    // UStruct 公共字段；MinAlignment 紧跟 Size
+    void WriteStruct(uptr obj, uptr super, i32 size, i32 minAlign)
+    {
+        m_space.Put<uptr>(obj + m_off.UStruct_SuperStruct, super);
+        m_space.Put<i32>(obj + m_off.UStruct_Size, size);
+        m_space.Put<i16>(obj + m_layout.UStruct_MinAlignment, static_cast<i16>(minAlign));
+    }
+
+    // 单链表：headSlot 写第一个元素，其余元素以 nextOffset 相连
+    void LinkChain(uptr headSlot, const std::vector<uptr>& items, i32 nextOffset)
+    {
+        m_space.Put<uptr>(headSlot, items.empty() ? 0 : items.front());
+        for (size_t i = 0; i + 1 < items.size(); ++i)
+        {
+            m_space.Put<uptr>(items[i] + nextOffset, items[i + 1]);
+        }
+    }
+
+    // ─── FFieldClass / FProperty ───
+    uptr FieldClass(SynProp type)
+    {
+        size_t idx = static_cast<size_t>(type);
+        if (m_fieldClasses.empty())
+        {
+            m_fieldClasses.assign(static_cast<size_t>(SynProp::Count), 0);
+        }
+        if (!m_fieldClasses[idx])
+        {
+            auto& fc = kSyntheticFieldClasses[idx];
+            uptr cls = m_space.Alloc(static_cast<size_t>(m_layout.fieldClassSize), 8);
+            m_space.Put<FName>(cls + m_off.FFieldClass_Name, Name(fc.name));
+            m_space.Put<u64>(cls + m_layout.FFieldClass_Id, static_cast<u64>(idx + 1));
+            m_space.Put<u64>(cls + m_off.FFieldClass_CastFlags, fc.castFlags);
+            m_fieldClasses[idx] = cls;
+        }
+        return m_fieldClasses[idx];
+    }
+
+    // 写出 FField + FProperty 公共部分；类型化字段由调用方按 Off() 写入
+    uptr NewProperty(
+        SynProp type, FName name, uptr owner, bool ownerIsObject,
+        i32 offset, i32 elemSize, i32 arrayDim, u64 flags)
+    {
+        uptr prop = m_space.Alloc(static_cast<size_t>(m_layout.propertySize), 8);
+        m_space.Put<uptr>(prop, ModuleAddr(kRvaVTables));
+        m_space.Put<uptr>(prop + m_off.FField_Class, FieldClass(type));
+        m_space.Put<uptr>(prop + m_off.FField_Owner, owner);
+        m_space.Put<u8>(prop + m_off.FField_Owner + 8, ownerIsObject ? 1 : 0);
+        m_space.Put<FName>(prop + m_off.FField_Name, name);
+        m_space.Put<u32>(prop + m_layout.FField_Flags,
+            SynFlags::RF_Public | SynFlags::RF_Transient | SynFlags::RF_MarkAsNative); // 原生属性的标志
+        m_space.Put<i32>(prop + m_off.Property_ArrayDim, arrayDim);
+        m_space.Put<i32>(prop + m_off.Property_ElementSize, elemSize);
+        m_space.Put<u64>(prop + m_off.Property_PropertyFlags, flags);
+        m_space.Put<i32>(prop + m_off.Property_Offset, offset);
+        m_propertyCount++;
+        return prop;
+    }
+
+    // ─── 收尾：写出 GObjects 与 NamePool 头部 ───
+    void Finish()
+    {
+        i32 count = static_cast<i32>(m_objects.size());
+        i32 itemSize = m_off.FUObjectItemSize;
+        uptr header = m_off.GObjects;
+        if (m_off.bIsChunkedObjArray)
+        {
+            i32 chunkSize = m_off.ChunkSize;
+            i32 numChunks = (count + chunkSize - 1) / chunkSize;
+            i32 maxChunks = numChunks + 1;
+            uptr chunks = m_space.Alloc(static_cast<size_t>(maxChunks) * 8, 8);
+            for (i32 c = 0; c < numChunks; ++c)
+            {
+                uptr chunk = m_space.Alloc(static_cast<size_t>(chunkSize) * itemSize, 16);
+                m_space.Put<uptr>(chunks + c * 8, chunk);
+                i32 end = (std::min)(count, (c + 1) * chunkSize);
+                for (i32 i = c * chunkSize; i < end; ++i)
+                {
+                    uptr item = chunk + static_cast<uptr>(i - c * chunkSize) * itemSize;
+                    m_space.Put<uptr>(item + m_off.FUObjectItemInitialOffset, m_objects[i]);
+                }
+            }
+            m_space.Put<uptr>(header + 0x00, chunks);
+            m_space.Put<i32>(header + 0x10, maxChunks * chunkSize); // MaxElements
+            m_space.Put<i32>(header + 0x14, count);                 // NumElements
+            m_space.Put<i32>(header + 0x18, maxChunks);
+            m_space.Put<i32>(header + 0x1C, numChunks);
+        }
+        else
+        {
+            uptr items = m_space.Alloc(static_cast<size_t>(count) * itemSize, 16);
+            for (i32 i = 0; i < count; ++i)
+            {
+                m_space.Put<uptr>(items + static_cast<uptr>(i) * itemSize
+                    + m_off.FUObjectItemInitialOffset, m_objects[i]);
+            }
+            m_space.Put<uptr>(header + 0x00, items);
+            m_space.Put<i32>(header + 0x08, count); // MaxElements
+            m_space.Put<i32>(header + 0x0C, count); // NumElements
+        }
+
+        m_space.Put<u32>(m_off.GNames + 0x08, m_nameBlockCount - 1); // CurrentBlock
+        m_space.Put<u32>(m_off.GNames + 0x0C, m_nameCursor);         // CurrentByteCursor
+    }
+
+    SyntheticAddressSpace& Space() { return m_space; }
+    const SyntheticLayout& Layout() const { return m_layout; }
+    const UEOffsets& Off() const { return m_off; }
+    i32 ObjectCount() const { return static_cast<i32>(m_objects.size()); }
+    size_t NameCount() const { return m_names.size(); }
+    size_t PropertyCount() const { return m_propertyCount; }
+
+private:
+    SyntheticAddressSpace& m_space;
+    const SyntheticLayout& m_layout;
+    UEOffsets& m_off;
+    uptr m_module = 0;
+
+    std::unordered_map<std::string, i32> m_names;
+    uptr m_nameBlock = 0;
+    u32  m_nameBlockCount = 0;
+    u32  m_nameCursor = 0;
+
+    std::vector<uptr> m_objects;
+    std::vector<uptr> m_fieldClasses;
+    size_t m_propertyCount = 0;
+};
+
+// 结构体成员排布：按对齐追加，连续的 bool 位域共用一个字节
+class SynLayoutCursor
+{
+public:
+    explicit SynLayoutCursor(i32 start) : m_cursor(start) {}
+
+    i32 Place(i32 size, i32 align)
+    {
+        m_bitByte = -1;
+        align = (std::max)(align, 1);
+        m_maxAlign = (std::max)(m_maxAlign, align);
+        i32 at = (m_cursor + align - 1) / align * align;
+        m_cursor = at + size;
+        return at;
+    }
+
+    // 返回 {字节偏移, 位序号}
+    std::pair<i32, i32> PlaceBit()
+    {
+        if (m_bitByte < 0 || m_bit == 7)
+        {
+            i32 at = Place(1, 1);
+            m_bitByte = at;
+            m_bit = 0;
+            return {at, 0};
+        }
+        return {m_bitByte, ++m_bit};
+    }
+
+    i32 MaxAlign() const { return m_maxAlign; }
+    i32 AlignedSize() const { return (m_cursor + m_maxAlign - 1) / m_maxAlign * m_maxAlign; }
+
+private:
+    i32 m_cursor;
+    i32 m_maxAlign = 1;
+    i32 m_bitByte = -1;
+    i32 m_bit = 0;
+};
+
+} // namespace detail
+} // namespace xrd
@@ -114,44 +114,11 @@ inline void LogSlowInitPhase(const char* phaseName, ULONGLONG startTick, ULONGLO
     }
 }
 
-// 公共扫描逻辑
-// 前置条件：ctx.mem / ctx.mainModule / ctx.pid 已设置
-inline bool DoCommonScanAndDiscover()
+// 对象图上的偏移发现：UObject / UStruct / FProperty / UFunction / UClass / UEnum
+// 前置条件：ctx.off 的 GObjects / GNames / bIsChunkedObjArray / bUseNamePool 已设置
+// 只读取对象图，不依赖 PE 段，合成映像基准测试直接调用
+inline bool DiscoverObjectGraphOffsets(Context& ctx)
 {
-    auto& ctx = Ctx();
-
-    // 缓存 PE 段
-    if (!EnsureSectionCacheReady(ctx))
-    {
-        std::cerr << "[xrd] 缓存 PE 段失败\n";
-        return false;
-    }
-
-    std::cerr << "[xrd] 缓存了 " << ctx.sections.size() << " 个段: ";
-    for (auto& s : ctx.sections)
-    {
-        std::cerr << s.name << " ";
-    }
-    std::cerr << "\n";
-
-    // GObjects
-    bool chunked = false;
-    if (!resolve::ScanGObjects(ctx.sections, *ctx.mem, ctx.off.GObjects, chunked))
-    {
-        std::cerr << "[xrd] GObjects 未找到\n";
-        return false;
-    }
-    ctx.off.bIsChunkedObjArray = chunked;
-
-    // GNames
-    bool isNamePool = false;
-    if (!resolve::ScanGNames(ctx.sections, *ctx.mem, ctx.off.GNames, isNamePool))
-    {
-        std::cerr << "[xrd] GNames 未找到\n";
-        return false;
-    }
-    ctx.off.bUseNamePool = isNamePool;
-
     // UObject 偏移发现
     if (!resolve::DiscoverUObjectOffsets(*ctx.mem, ctx.off))
     {
@@ -247,6 +214,56 @@ inline bool DoCommonScanAndDiscover()
         ctx.off.UField_Next = ctx.off.UObject_Outer + 8;
     }
 
+    return true;
+}
+
+// 公共扫描逻辑
+// 前置条件：ctx.mem / ctx.mainModule / ctx.pid 已设置
+inline bool DoCommonScanAndDiscover()
+{
+    auto& ctx = Ctx();
+
+    // 缓存 PE 段
+    if (!EnsureSectionCacheReady(ctx))
+    {
+        std::cerr << "[xrd] 缓存 PE 段失败\n";
+        return false;
+    }
+
+    std::cerr << "[xrd] 缓存了 " << ctx.sections.size() << " 个段: ";
+    for (auto& s : ctx.sections)
+    {
+        std::cerr << s.name << " ";
+    }
+    std::cerr << "\n";
+
+    // 可读区域表：每次扫描尝试前重建，候选指针据此在本地过滤
+    RefreshReadableRegions();
+
+    // GObjects
+    bool chunked = false;
+    if (!resolve::ScanGObjects(ctx.sections, *ctx.mem, ctx.off.GObjects, chunked))
+    {
+        std::cerr << "[xrd] GObjects 未找到\n";
+        return false;
+    }
+    ctx.off.bIsChunkedObjArray = chunked;
+
+    // GNames
+    bool isNamePool = false;
+    if (!resolve::ScanGNames(ctx.sections, *ctx.mem, ctx.off.GNames, isNamePool))
+    {
+        std::cerr << "[xrd] GNames 未找到\n";
+        return false;
+    }
+    ctx.off.bUseNamePool = isNamePool;
+
+    // 对象图上的偏移发现
+    if (!DiscoverObjectGraphOffsets(ctx))
+    {
+        return false;
+    }
+
     // 运行时扫描
     {
         ULONGLONG phaseTick = GetTickCount64();
@@ -51,15 +51,13 @@ inline void DiscoverWorldChainOffsets(Context& ctx)
             // LocalPlayers[0] -> PlayerController
             if (off.UGameInstance_LocalPlayers != -1)
             {
-                uptr lpData = 0;
-                i32 lpCount = 0;
-                ReadPtr(mem, gi + off.UGameInstance_LocalPlayers, lpData);
-                ReadI32(mem, gi + off.UGameInstance_LocalPlayers + 8, lpCount);
+                std::vector<uptr> localPlayers;
+                ReadRemoteArray(mem, gi + off.UGameInstance_LocalPlayers, localPlayers);
 
-                if (IsCanonicalUserPtr(lpData) && lpCount > 0)
+                if (!localPlayers.empty())
                 {
-                    uptr lp0 = 0;
-                    if (ReadPtr(mem, lpData, lp0) && IsCanonicalUserPtr(lp0))
+                    uptr lp0 = localPlayers[0];
+                    if (IsCanonicalUserPtr(lp0))
                     {
                         uptr lpClass = GetObjectClass(lp0);
                         if (lpClass && off.ULocalPlayer_PlayerController == -1)
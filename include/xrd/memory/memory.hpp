@@ -7,6 +7,7 @@
 #include <string>
 #include <vector>
 #include <cstring>
+#include <type_traits>
 
 namespace xrd
 {
@@ -19,6 +20,36 @@ struct ReadBatchDesc
     u32   size    = 0;    // 读取字节数
 };
 
+// 已提交且可读的地址区间 [base, base + size)
+struct MemoryRegion
+{
+    uptr base = 0;
+    uptr size = 0;
+};
+
+// 页保护属性是否可读（排除 PAGE_NOACCESS / PAGE_GUARD）
+inline bool IsReadableProtect(DWORD protect)
+{
+    if (protect & (PAGE_GUARD | PAGE_NOACCESS))
+    {
+        return false;
+    }
+    constexpr DWORD kReadable = PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY
+        | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+    return (protect & kReadable) != 0;
+}
+
+// 追加区间，与上一个区间首尾相接时合并
+inline void AppendMemoryRegion(std::vector<MemoryRegion>& out, uptr base, uptr size)
+{
+    if (!out.empty() && out.back().base + out.back().size == base)
+    {
+        out.back().size += size;
+        return;
+    }
+    out.push_back({base, size});
+}
+
 // ─── 抽象内存访问接口，方便后续扩展驱动模式 ───
 class IMemoryAccessor
 {
@@ -49,6 +80,14 @@ public:
         }
         return allOk;
     }
+
+    // 可选能力：枚举目标进程已提交、可读的区域（按地址升序，相邻区间已合并）
+    // 默认不支持，返回 false；ReadableRegionMap 据此退化为只做地址范围检查
+    virtual bool QueryRegions(std::vector<MemoryRegion>& out) const
+    {
+        out.clear();
+        return false;
+    }
 };
 
 // ─── 基于 ReadProcessMemory 的标准实现 ───
@@ -90,6 +129,36 @@ public:
         return ok != 0 && bytesWritten == size;
     }
 
+    // VirtualQueryEx 逐段遍历用户态地址空间
+    bool QueryRegions(std::vector<MemoryRegion>& out) const override
+    {
+        out.clear();
+        if (!m_process)
+        {
+            return false;
+        }
+        constexpr uptr kUserMax = 0x00007FFFFFFFFFFFull;
+        uptr addr = 0x10000;
+        MEMORY_BASIC_INFORMATION mbi{};
+        while (addr < kUserMax
+            && VirtualQueryEx(m_process, reinterpret_cast<LPCVOID>(addr),
+                &mbi, sizeof(mbi)) == sizeof(mbi))
+        {
+            uptr base = reinterpret_cast<uptr>(mbi.BaseAddress);
+            uptr next = base + mbi.RegionSize;
+            if (mbi.State == MEM_COMMIT && IsReadableProtect(mbi.Protect))
+            {
+                AppendMemoryRegion(out, base, mbi.RegionSize);
+            }
+            if (next <= addr)
+            {
+                break;
+            }
+            addr = next;
+        }
+        return !out.empty();
+    }
+
     HANDLE GetProcessHandle() const { return m_process; }
 
 private:
@@ -202,6 +271,73 @@ inline bool WriteValue(const IMemoryAccessor& mem, uptr address, const T& value)
     return mem.Write(address, &value, sizeof(T));
 }
 
+// ─── 远程 TArray 整块读取 ───
+
+// TArray 头部布局: +0x00 Data*, +0x08 Num (i32), +0x0C Max (i32)
+struct RemoteArrayHeader
+{
+    uptr data = 0;
+    i32  num  = 0;
+    i32  max  = 0;
+};
+
+// 单次远程数组读取的字节上限：头部损坏时避免巨量分配（不限制正常数组的元素个数）
+inline constexpr std::size_t kMaxRemoteArrayBytes = 256ull * 1024 * 1024;
+
+// 一次读取 TArray 头部并校验：0 <= Num <= Max，非空时 Data 为用户态地址
+inline bool ReadRemoteArrayHeader(
+    const IMemoryAccessor& mem,
+    uptr arrayAddr,
+    RemoteArrayHeader& out)
+{
+    out = {};
+    if (!arrayAddr || !mem.Read(arrayAddr, &out, sizeof(out)))
+    {
+        out = {};
+        return false;
+    }
+    if (out.num < 0 || out.num > out.max
+        || (out.num > 0 && !IsCanonicalUserPtr(out.data)))
+    {
+        out = {};
+        return false;
+    }
+    return true;
+}
+
+// 读取 TArray 的全部元素：头部一次、载荷一次，元素在本地解码
+// 空数组返回 true 且 out 为空；头部无效、超过字节上限或载荷读取失败返回 false
+// 适用于 UEnum::Names、UClass::Interfaces、LocalPlayers、UFunction 脚本字节等
+template<typename T>
+inline bool ReadRemoteArray(
+    const IMemoryAccessor& mem,
+    uptr arrayAddr,
+    std::vector<T>& out)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.clear();
+    RemoteArrayHeader h;
+    if (!ReadRemoteArrayHeader(mem, arrayAddr, h))
+    {
+        return false;
+    }
+    if (h.num == 0)
+    {
+        return true;
+    }
+    if (static_cast<std::size_t>(h.num) > kMaxRemoteArrayBytes / sizeof(T))
+    {
+        return false;
+    }
+    out.resize(h.num);
+    if (!mem.Read(h.data, out.data(), out.size() * sizeof(T)))
+    {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
 // ─── 统一批量读辅助：读 N 个同类型值（WinAPI 逐个读 / 驱动走 IOCTL） ───
 
 template<typename T>
@@ -0,0 +1,133 @@
+#pragma once
+// Xrd-eXternalrEsolve - 可读区域表
+// 由 IMemoryAccessor::QueryRegions 枚举目标进程已提交、可读的区域，按地址排序保存
+// 候选指针校验改为本地二分查找：落在未提交 / 不可读区域的垃圾指针不再触发一次失败的远程读取
+// 访问器不支持 QueryRegions 时表保持未就绪，校验退化为 IsCanonicalUserPtr
+
+#include "memory.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+namespace xrd
+{
+
+class ReadableRegionMap
+{
+public:
+    // 从访问器重建；返回 false 表示访问器不支持或枚举失败（表清空并标记未就绪）
+    bool Refresh(const IMemoryAccessor& mem)
+    {
+        std::vector<MemoryRegion> regions;
+        bool ok = mem.QueryRegions(regions);
+        if (ok)
+        {
+            std::sort(regions.begin(), regions.end(),
+                [](const MemoryRegion& a, const MemoryRegion& b) { return a.base < b.base; });
+        }
+        else
+        {
+            regions.clear();
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(m_mtx);
+            m_regions.swap(regions);
+        }
+        m_ready.store(ok, std::memory_order_release);
+        m_refreshedAt.store(NowMs(), std::memory_order_relaxed);
+        m_refreshes.fetch_add(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    void Clear()
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mtx);
+        m_regions.clear();
+        m_ready.store(false, std::memory_order_release);
+        m_rejected.store(0, std::memory_order_relaxed);
+    }
+
+    bool Ready() const { return m_ready.load(std::memory_order_acquire); }
+
+    // [address, address + size) 是否完整落在某个可读区域内
+    // 表未就绪时无法判断，返回 true 交给远程读取
+    bool MaybeReadable(uptr address, std::size_t size = 1) const
+    {
+        if (!Ready())
+        {
+            return true;
+        }
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        // 第一个 base > address 的区间的前一个即候选区间
+        auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address,
+            [](uptr a, const MemoryRegion& r) { return a < r.base; });
+        if (it != m_regions.begin())
+        {
+            const MemoryRegion& r = *(it - 1);
+            if (address - r.base <= r.size && size <= r.size - (address - r.base))
+            {
+                return true;
+            }
+        }
+        m_rejected.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 距上次刷新超过 maxAgeMs（或从未刷新）
+    bool IsStale(u32 maxAgeMs) const
+    {
+        return NowMs() - m_refreshedAt.load(std::memory_order_relaxed) > maxAgeMs;
+    }
+
+    // 抢占刷新权：同一时刻只有一个线程执行过期刷新
+    bool TryBeginRefresh()
+    {
+        bool expected = false;
+        return m_refreshing.compare_exchange_strong(expected, true);
+    }
+
+    void EndRefresh()
+    {
+        m_refreshing.store(false);
+    }
+
+    std::size_t RegionCount() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        return m_regions.size();
+    }
+
+    u64 ReadableBytes() const
+    {
+        std::shared_lock<std::shared_mutex> lock(m_mtx);
+        u64 total = 0;
+        for (auto& r : m_regions)
+        {
+            total += r.size;
+        }
+        return total;
+    }
+
+    u64 Rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+    u64 Refreshes() const { return m_refreshes.load(std::memory_order_relaxed); }
+
+private:
+    static i64 NowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    mutable std::shared_mutex m_mtx;
+    std::vector<MemoryRegion> m_regions;
+    std::atomic<bool> m_ready{false};
+    std::atomic<bool> m_refreshing{false};
+    std::atomic<i64> m_refreshedAt{0};
+    std::atomic<u64> m_refreshes{0};
+    mutable std::atomic<u64> m_rejected{0};
+};
+
+} // namespace xrd
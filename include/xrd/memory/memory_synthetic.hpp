@@ -0,0 +1,253 @@
+#pragma once
+// Xrd-eXternalrEsolve - 合成地址空间 + 进程内访问器
+// 不依赖目标进程：在本进程内模拟一段稀疏的 64 位用户态地址空间，读写直接 memcpy
+// 由 helpers/synthetic 构建合成 UE 映像，供基准测试与离线验证使用
+//
+// 地址空间按 16MB 槽位管理：小分配在当前槽位内顺序切分，超过一个槽位的分配占用连续多个槽位
+// 地址 → 本地指针只需一次移位和一次数组下标，不做区间查找
+
+#include "memory.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+namespace xrd
+{
+
+class SyntheticAddressSpace
+{
+public:
+    static constexpr uptr kBase     = 0x0000010000000000ull; // 合成地址起点（用户态范围内）
+    static constexpr int  kSlotBits = 24;
+    static constexpr uptr kSlotSize = uptr(1) << kSlotBits;
+
+    SyntheticAddressSpace() = default;
+    SyntheticAddressSpace(const SyntheticAddressSpace&) = delete;
+    SyntheticAddressSpace& operator=(const SyntheticAddressSpace&) = delete;
+
+    // 分配一段清零的内存，返回合成地址；align 必须是 2 的幂
+    uptr Alloc(std::size_t size, std::size_t align = 16)
+    {
+        if (size == 0)
+        {
+            size = 1;
+        }
+        uptr addr = (m_cursor + (align - 1)) & ~uptr(align - 1);
+        if (m_cursor != 0 && addr + size <= m_slotEnd)
+        {
+            m_cursor = addr + size;
+            return addr;
+        }
+
+        // 新开槽位：小分配开一个槽位，大分配按槽位数向上取整
+        std::size_t slotCount = (size + kSlotSize - 1) >> kSlotBits;
+        std::size_t bytes = slotCount << kSlotBits;
+        u8* block = static_cast<u8*>(std::calloc(bytes, 1)); // 大块 calloc 按页惰性清零
+        if (!block)
+        {
+            return 0;
+        }
+        m_blocks.emplace_back(block);
+        m_committed += bytes;
+
+        addr = kBase + (static_cast<uptr>(m_slots.size()) << kSlotBits);
+        for (std::size_t i = 0; i < slotCount; ++i)
+        {
+            m_slots.push_back(block + (i << kSlotBits));
+        }
+        m_cursor = addr + size;
+        m_slotEnd = addr + bytes;
+        return addr;
+    }
+
+    // 合成地址 → 本地指针；[address, address + size) 必须位于同一次分配的槽位内
+    u8* At(uptr address, std::size_t size = 1) const
+    {
+        if (address < kBase)
+        {
+            return nullptr;
+        }
+        uptr rel = address - kBase;
+        std::size_t slot = static_cast<std::size_t>(rel >> kSlotBits);
+        std::size_t last = static_cast<std::size_t>((rel + size - 1) >> kSlotBits);
+        if (last >= m_slots.size())
+        {
+            return nullptr;
+        }
+        u8* p = m_slots[slot] + (rel & (kSlotSize - 1));
+        // 跨槽位时要求槽位连续（同一块大分配）
+        if (last != slot && m_slots[last] != m_slots[slot] + ((last - slot) << kSlotBits))
+        {
+            return nullptr;
+        }
+        return p;
+    }
+
+    template<typename T>
+    void Put(uptr address, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (u8* p = At(address, sizeof(T)))
+        {
+            std::memcpy(p, &value, sizeof(T));
+        }
+    }
+
+    void PutBytes(uptr address, const void* data, std::size_t size)
+    {
+        if (u8* p = At(address, size))
+        {
+            std::memcpy(p, data, size);
+        }
+    }
+
+    template<typename T>
+    T Get(uptr address) const
+    {
+        T value{};
+        if (const u8* p = At(address, sizeof(T)))
+        {
+            std::memcpy(&value, p, sizeof(T));
+        }
+        return value;
+    }
+
+    // 已提交（calloc）的字节数；实际常驻内存取决于写入过的页
+    std::size_t CommittedBytes() const { return m_committed; }
+    // 已分配的合成地址范围（不含当前槽位未用的尾部）
+    uptr Begin() const { return kBase; }
+    uptr End() const { return m_cursor; }
+    // 已映射槽位的末尾：[kBase, MappedEnd()) 全部可读
+    uptr MappedEnd() const { return kBase + (static_cast<uptr>(m_slots.size()) << kSlotBits); }
+
+private:
+    struct FreeDeleter
+    {
+        void operator()(u8* p) const { std::free(p); }
+    };
+
+    std::vector<std::unique_ptr<u8, FreeDeleter>> m_blocks;
+    std::vector<u8*> m_slots;
+    uptr m_cursor = 0;
+    uptr m_slotEnd = 0;
+    std::size_t m_committed = 0;
+};
+
+// 读统计：调用次数（Read / ReadBatch）、描述符数与字节数
+struct SyntheticReadStats
+{
+    u64 reads      = 0; // Read 调用次数（不含 ReadBatch 内部展开）
+    u64 batchCalls = 0; // ReadBatch 调用次数（驱动后端的一次往返）
+    u64 batchItems = 0; // ReadBatch 描述符总数
+    u64 bytes      = 0; // 读取字节数
+    u64 failed     = 0; // 越界失败次数
+};
+
+// ─── 基于合成地址空间的访问器 ───
+// 构建完成后地址空间只读，多线程并发读安全；计数器为 relaxed 原子量
+class SyntheticMemoryAccessor : public IMemoryAccessor
+{
+public:
+    explicit SyntheticMemoryAccessor(const SyntheticAddressSpace& space)
+        : m_space(space)
+    {
+    }
+
+    bool Read(uptr address, void* buffer, std::size_t size) const override
+    {
+        m_reads.fetch_add(1, std::memory_order_relaxed);
+        return Copy(address, buffer, size);
+    }
+
+    bool Write(uptr address, const void* buffer, std::size_t size) const override
+    {
+        if (!buffer || size == 0)
+        {
+            return false;
+        }
+        u8* p = m_space.At(address, size);
+        if (!p)
+        {
+            return false;
+        }
+        std::memcpy(p, buffer, size);
+        return true;
+    }
+
+    // 与驱动后端一致：一次调用完成整批，只计一次往返
+    bool ReadBatch(ReadBatchDesc* descs, u32 count) const override
+    {
+        if (!descs || count == 0)
+        {
+            return false;
+        }
+        m_batchCalls.fetch_add(1, std::memory_order_relaxed);
+        m_batchItems.fetch_add(count, std::memory_order_relaxed);
+        bool allOk = true;
+        for (u32 i = 0; i < count; ++i)
+        {
+            auto& d = descs[i];
+            if (d.address && d.buffer && d.size > 0 && !Copy(d.address, d.buffer, d.size))
+            {
+                allOk = false;
+            }
+        }
+        return allOk;
+    }
+
+    // 槽位连续分配，整个已映射范围是一个区域
+    bool QueryRegions(std::vector<MemoryRegion>& out) const override
+    {
+        out.clear();
+        if (m_space.MappedEnd() > m_space.Begin())
+        {
+            out.push_back({m_space.Begin(), m_space.MappedEnd() - m_space.Begin()});
+        }
+        return !out.empty();
+    }
+
+    SyntheticReadStats Stats() const
+    {
+        SyntheticReadStats s;
+        s.reads      = m_reads.load(std::memory_order_relaxed);
+        s.batchCalls = m_batchCalls.load(std::memory_order_relaxed);
+        s.batchItems = m_batchItems.load(std::memory_order_relaxed);
+        s.bytes      = m_bytes.load(std::memory_order_relaxed);
+        s.failed     = m_failed.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void ResetStats()
+    {
+        m_reads = 0;
+        m_batchCalls = 0;
+        m_batchItems = 0;
+        m_bytes = 0;
+        m_failed = 0;
+    }
+
+private:
+    bool Copy(uptr address, void* buffer, std::size_t size) const
+    {
+        const u8* p = (buffer && size) ? m_space.At(address, size) : nullptr;
+        if (!p)
+        {
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::memcpy(buffer, p, size);
+        m_bytes.fetch_add(size, std::memory_order_relaxed);
+        return true;
+    }
+
+    const SyntheticAddressSpace& m_space;
+    mutable std::atomic<u64> m_reads{0};
+    mutable std::atomic<u64> m_batchCalls{0};
+    mutable std::atomic<u64> m_batchItems{0};
+    mutable std::atomic<u64> m_bytes{0};
+    mutable std::atomic<u64> m_failed{0};
+};
+
+} // namespace xrd
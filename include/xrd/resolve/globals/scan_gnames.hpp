@@ -247,7 +247,7 @@ inline bool ValidateNamePoolCandidateFast(
     }
 
     uptr block0 = 0;
-    if (!ReadPtr(mem, candidate + 0x10, block0) || !IsCanonicalUserPtr(block0))
+    if (!ReadPtr(mem, candidate + 0x10, block0) || !IsReadablePtr(block0, 0x600))
     {
         return false;
     }
@@ -276,7 +276,7 @@ inline bool ValidateNameArrayCandidateFast(
     uptr candidate)
 {
     uptr chunksPtr = 0;
-    if (!ReadPtr(mem, candidate, chunksPtr) || !IsCanonicalUserPtr(chunksPtr))
+    if (!ReadPtr(mem, candidate, chunksPtr) || !IsReadablePtr(chunksPtr))
     {
         return false;
     }
@@ -289,13 +289,13 @@ inline bool ValidateNameArrayCandidateFast(
     }
 
     uptr chunk0 = 0;
-    if (!ReadPtr(mem, chunksPtr, chunk0) || !IsCanonicalUserPtr(chunk0))
+    if (!ReadPtr(mem, chunksPtr, chunk0) || !IsReadablePtr(chunk0))
     {
         return false;
     }
 
     uptr entry0 = 0;
-    if (!ReadPtr(mem, chunk0, entry0) || !IsCanonicalUserPtr(entry0))
+    if (!ReadPtr(mem, chunk0, entry0) || !IsReadablePtr(entry0))
     {
         return false;
     }
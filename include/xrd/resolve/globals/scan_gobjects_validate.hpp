@@ -4,6 +4,7 @@
 #include <cstring>
 #include <iostream>
 #include <algorithm>
+#include <vector>
 
 namespace xrd
 {
@@ -32,6 +33,41 @@ inline bool ReadCandidateFieldCached(
     return true;
 }
 
+// 探测 SerialNumber 位置：Object(8) 之后
+//   UE4 ~ UE5.4: Flags(4) ClusterRootIndex(4) SerialNumber(4) [对齐填充 4]
+//   UE5.5+:      FlagsAndRefCount(8) ClusterRootIndex(4) SerialNumber(4)
+// 0x18 的条目两种布局大小相同；+0x14 在旧布局中是始终为 0 的填充，
+// 采样条目中该位置出现非 0 值即为新布局
+inline i32 ProbeSerialNumberOffset(
+    const IMemoryAccessor& mem,
+    uptr firstItemPtr,
+    i32 initialOffset,
+    i32 itemSize)
+{
+    constexpr i32 kOldOffset = 0x10;
+    constexpr i32 kNewOffset = 0x14;
+    if (initialOffset + kNewOffset + 4 > itemSize)
+    {
+        return kOldOffset;
+    }
+    constexpr i32 kSamples = 4096;
+    std::vector<u8> buf(static_cast<size_t>(itemSize) * kSamples);
+    if (!mem.Read(firstItemPtr, buf.data(), buf.size()))
+    {
+        return kOldOffset;
+    }
+    for (i32 i = 0; i < kSamples; ++i)
+    {
+        i32 value = 0;
+        std::memcpy(&value, &buf[static_cast<size_t>(i) * itemSize + initialOffset + kNewOffset], 4);
+        if (value != 0)
+        {
+            return kNewOffset;
+        }
+    }
+    return kOldOffset;
+}
+
 inline bool ProbeItemLayout(
     const IMemoryAccessor& mem,
     uptr firstItemPtr,
@@ -59,9 +95,12 @@ inline bool ProbeItemLayout(
         {
             off.FUObjectItemSize = itemSize;
             off.FUObjectItemInitialOffset = initialOffset;
+            off.FUObjectItemSerialNumberOffset = ProbeSerialNumberOffset(
+                mem, firstItemPtr, initialOffset, itemSize);
             std::cerr << "[xrd] FUObjectItem: size=0x"
                       << std::hex << itemSize
                       << " initialOffset=0x" << initialOffset
+                      << " serialNumber=0x" << off.FUObjectItemSerialNumberOffset
                       << std::dec << "\n";
             return true;
         }
@@ -84,7 +123,8 @@ inline bool ValidateChunked(
         return false;
     }
 
-    if (!IsCanonicalUserPtr(objectsPtr))
+    // 候选多为段内的垃圾数据：先查本地可读区域表，不可读的直接拒绝，省去一次失败的远程读取
+    if (!IsReadablePtr(objectsPtr))
     {
         return false;
     }
@@ -155,7 +195,7 @@ inline bool ValidateChunked(
     {
         uptr chunk = 0;
         if (!ReadPtr(mem, objectsPtr + i * sizeof(uptr), chunk) ||
-            !IsCanonicalUserPtr(chunk))
+            !IsReadablePtr(chunk))
         {
             return false;
         }
@@ -188,7 +228,7 @@ inline bool ValidateFixed(
         return false;
     }
 
-    if (!IsCanonicalUserPtr(objectsPtr))
+    if (!IsReadablePtr(objectsPtr))
     {
         return false;
     }
@@ -62,6 +62,7 @@ inline i32 EstimateBasePropertySize(const IMemoryAccessor& /*mem*/, const UEOffs
 }
 
 // 在指定偏移范围内搜索指向合法 UObject 的指针
+// 指针须落在可读区域内（区域表未就绪时只检查地址范围）
 inline i32 FindPointerFieldInRange(
     const IMemoryAccessor& mem,
     uptr obj,
@@ -74,11 +75,11 @@ inline i32 FindPointerFieldInRange(
         uptr ptr = 0;
         if (ReadPtr(mem, obj + off, ptr))
         {
-            if (mustBeValid && IsCanonicalUserPtr(ptr))
+            if (mustBeValid && IsReadablePtr(ptr))
             {
                 return off;
             }
-            if (!mustBeValid && (ptr == 0 || IsCanonicalUserPtr(ptr)))
+            if (!mustBeValid && (ptr == 0 || IsReadablePtr(ptr)))
             {
                 return off;
             }
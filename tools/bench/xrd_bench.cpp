@@ -0,0 +1,688 @@
+// Xrd-eXternalrEsolve - 合成映像基准测试
+// 在进程内构建合成 UE 映像，逐阶段报告墙钟时间、读取次数 / 字节数与内存占用（工作集 / 峰值）
+//
+// 编译（x64 Developer Command Prompt）：
+//   cl /std:c++20 /EHsc /O2 /MT /utf-8 /I"include" /Fe:xrd_bench.exe tools\bench\xrd_bench.cpp
+// 用法：
+//   xrd_bench [--objects N] [--ue5] [--fixed] [--workers N] [--out 目录] [--skip-sdk] [--budget MB] [--contexts N] [--compile 编译器] [--wide P]
+// --compile 分别以 Rei-Dumper 布局与前向声明布局生成 SDK，逐包编译（clang++ -fsyntax-only）并对比耗时；
+// 传 "-" 时只统计每个包传递 include 的头文件数与字节数；否则另外编译 DumpOffsetsSdk 生成的 Offsets.hpp
+// --wide 让 P% 的实例对象使用本地化（CJK）宽字符名称，并对比 UTF-16 → UTF-8 转码的几种实现
+
+#include <xrd.hpp>
+#include <xrd/helpers/synthetic/synthetic_image.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace xrd;
+
+namespace
+{
+
+struct BenchArgs
+{
+    SyntheticImageConfig image;
+    u32 workers = 1;
+    std::string outDir = "xrd_bench_sdk";
+    bool skipSdk = false;
+    u32 budgetMB = 0;
+    u32 contexts = 0; // >0 时额外测量多个独立上下文并行处理（每个上下文一份不同种子的映像）
+    std::string compiler; // 非空时对比两种 SDK 布局的编译代价；"-" 只统计 include
+};
+
+bool ParseArgs(int argc, char** argv, BenchArgs& args)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (a == "--objects" && hasValue)      args.image.objectCount = std::atoi(argv[++i]);
+        else if (a == "--ue5")                 args.image.engine = SyntheticEngine::UE5_3;
+        else if (a == "--fixed")               args.image.chunkedObjects = false;
+        else if (a == "--workers" && hasValue) args.workers = static_cast<u32>(std::atoi(argv[++i]));
+        else if (a == "--out" && hasValue)     args.outDir = argv[++i];
+        else if (a == "--skip-sdk")            args.skipSdk = true;
+        else if (a == "--budget" && hasValue)  args.budgetMB = static_cast<u32>(std::atoi(argv[++i]));
+        else if (a == "--contexts" && hasValue) args.contexts = static_cast<u32>(std::atoi(argv[++i]));
+        else if (a == "--compile" && hasValue) args.compiler = argv[++i];
+        else if (a == "--wide" && hasValue)    args.image.widePercent = std::atoi(argv[++i]);
+        else
+        {
+            std::cerr << "用法: xrd_bench [--objects N] [--ue5] [--fixed] [--workers N] [--out 目录] [--skip-sdk] [--budget MB] [--contexts N] [--compile 编译器] [--wide P]\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+struct MemorySample
+{
+    size_t workingSet = 0;
+    size_t peakWorkingSet = 0;
+};
+
+MemorySample SampleMemory()
+{
+    MemorySample m;
+    PROCESS_MEMORY_COUNTERS pmc{};
+    pmc.cb = sizeof(pmc);
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+        m.workingSet = pmc.WorkingSetSize;
+        m.peakWorkingSet = pmc.PeakWorkingSetSize;
+    }
+    return m;
+}
+
+// 单个阶段：计时并统计该阶段内的访问器读取增量
+// accessor 在阶段内可能被替换（AutoInit 阶段重装上下文），因此按引用取当前值
+void RunStage(const char* name, SyntheticMemoryAccessor*& accessor, const std::function<std::string()>& body)
+{
+    SyntheticReadStats before = accessor ? accessor->Stats() : SyntheticReadStats{};
+    SyntheticMemoryAccessor* startAccessor = accessor;
+    auto t0 = std::chrono::steady_clock::now();
+    std::string summary = body();
+    auto t1 = std::chrono::steady_clock::now();
+    SyntheticReadStats after = accessor ? accessor->Stats() : SyntheticReadStats{};
+    if (accessor != startAccessor)
+    {
+        before = SyntheticReadStats{};
+    }
+    MemorySample mem = SampleMemory();
+
+    double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << std::format(
+        "{:<22} {:>10.1f} ms  reads {:>10}  batch {:>7}/{:>9}  bytes {:>8} KB  ws {:>6} MB  peak {:>6} MB  {}\n",
+        name, ms,
+        after.reads - before.reads,
+        after.batchCalls - before.batchCalls,
+        after.batchItems - before.batchItems,
+        (after.bytes - before.bytes) >> 10,
+        mem.workingSet >> 20, mem.peakWorkingSet >> 20,
+        summary);
+}
+
+// 转码前的实现：两次 WideCharToMultiByte（先求长度再转换）
+#ifdef _WIN32
+size_t Utf16ToUtf8WinApi(const std::u16string& w, std::string& out)
+{
+    const wchar_t* wbuf = reinterpret_cast<const wchar_t*>(w.data());
+    int len = static_cast<int>(w.size());
+    int needed = WideCharToMultiByte(CP_UTF8, 0, wbuf, len, nullptr, 0, nullptr, nullptr);
+    out.resize(needed > 0 ? needed : 0);
+    if (needed > 0)
+    {
+        WideCharToMultiByte(CP_UTF8, 0, wbuf, len, out.data(), needed, nullptr, nullptr);
+    }
+    return out.size();
+}
+#endif
+
+// 宽字符名称语料上的转码吞吐：每种实现转码全部语料若干遍，与 SIMD 路径的结果逐条对比
+void RunTranscodeStages(SyntheticMemoryAccessor*& accessor, i32 widePercent)
+{
+    detail::SynRandom rnd(0x55544638ull);
+    std::vector<std::u16string> corpus(100000);
+    size_t units = 0;
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        corpus[i] = detail::MakeSyntheticWideName(rnd, static_cast<u32>(i));
+        units += corpus[i].size();
+    }
+    std::vector<std::string> expected(corpus.size());
+    for (size_t i = 0; i < corpus.size(); ++i)
+    {
+        Utf16ToUtf8(reinterpret_cast<const u16*>(corpus[i].data()), corpus[i].size(), expected[i]);
+    }
+
+    constexpr int kPasses = 20;
+    auto run = [&](const char* name, const std::function<size_t(const std::u16string&, std::string&)>& fn)
+    {
+        RunStage(name, accessor, [&]
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            size_t bytes = 0;
+            size_t mismatches = 0;
+            std::string out;
+            for (int pass = 0; pass < kPasses; ++pass)
+            {
+                for (size_t i = 0; i < corpus.size(); ++i)
+                {
+                    bytes += fn(corpus[i], out);
+                    if (pass == 0 && out != expected[i])
+                    {
+                        ++mismatches;
+                    }
+                }
+            }
+            double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            return std::format("wide {}% names {} units {} out {:.1f} MB/s mismatches {}",
+                widePercent, corpus.size(), units,
+                static_cast<double>(bytes) / (1 << 20) / (s > 0 ? s : 1), mismatches);
+        });
+    };
+#ifdef _WIN32
+    run("Utf16ToUtf8(WinApi)", Utf16ToUtf8WinApi);
+#endif
+    run("Utf16ToUtf8(scalar)", [](const std::u16string& w, std::string& out)
+    {
+        out.resize(Utf8Capacity(w.size()));
+        out.resize(detail::Utf16ToUtf8Scalar(
+            reinterpret_cast<const u16*>(w.data()), w.size(), out.data()));
+        return out.size();
+    });
+    run("Utf16ToUtf8(simd)", [](const std::u16string& w, std::string& out)
+    {
+        Utf16ToUtf8(reinterpret_cast<const u16*>(w.data()), w.size(), out);
+        return out.size();
+    });
+}
+
+bool IsTypeObject(uptr obj)
+{
+    std::string cls = GetObjectClassName(obj);
+    return cls == "Class" || cls == "ScriptStruct";
+}
+
+// 在当前线程绑定的上下文中处理一份映像：装入、遍历对象、采集属性与函数
+struct ContextResult
+{
+    i32 objects = 0;
+    size_t types = 0;
+    size_t properties = 0;
+    size_t functions = 0;
+
+    bool operator==(const ContextResult&) const = default;
+};
+
+ContextResult ProcessImage(const SyntheticUEImage& image)
+{
+    ContextResult r;
+    InstallSyntheticImage(image);
+    ForEachObject([&](uptr obj, i32)
+    {
+        r.objects++;
+        if (IsTypeObject(obj))
+        {
+            r.types++;
+            r.properties += detail::CollectProperties(obj).size();
+            r.functions += detail::CollectFunctions(obj).size();
+        }
+        return true;
+    });
+    return r;
+}
+
+// 生成的 SDK 的编译代价：每个包一个翻译单元，只 include 该包的 _classes.hpp（无类时 _structs.hpp），
+// 模拟只用到单个包的下游源文件；另测 include SDK.hpp 的单个翻译单元
+struct SdkCompileStats
+{
+    u32 units = 0;
+    u32 failed = 0;
+    u64 headers = 0;        // 各翻译单元传递 include 的 SDK 头文件数之和
+    u64 headerBytes = 0;    // 同上，字节数
+    double unitSeconds = 0;
+    double umbrellaSeconds = 0;
+    bool umbrellaOk = false;
+};
+
+// 沿引号 include 递归收集 SDK 头文件（相对所在目录解析）
+void CollectSdkIncludes(const std::filesystem::path& file, std::unordered_set<std::string>& seen, u64& bytes)
+{
+    std::ifstream f(file, std::ios::binary);
+    if (!f.is_open())
+    {
+        return;
+    }
+    std::vector<std::filesystem::path> next;
+    std::string line;
+    while (std::getline(f, line))
+    {
+        bytes += line.size() + 1;
+        if (line.rfind("#include \"", 0) != 0)
+        {
+            continue;
+        }
+        size_t end = line.find('"', 10);
+        if (end == std::string::npos)
+        {
+            continue;
+        }
+        auto inc = (file.parent_path() / line.substr(10, end - 10)).lexically_normal();
+        if (seen.insert(inc.string()).second)
+        {
+            next.push_back(inc);
+        }
+    }
+    for (auto& p : next)
+    {
+        CollectSdkIncludes(p, seen, bytes);
+    }
+}
+
+// 编译单个翻译单元（只做语法与语义检查），输出写入同名 .log
+bool CompileUnit(const std::string& compiler, const std::filesystem::path& sdkRoot,
+    const std::filesystem::path& unit, double& seconds)
+{
+    std::string cmd = std::format("\"{}\" -std=c++20 -fsyntax-only -w -I\"{}\" \"{}\" > \"{}.log\" 2>&1",
+        compiler, sdkRoot.string(), unit.string(), unit.string());
+#ifdef _WIN32
+    cmd = "\"" + cmd + "\""; // cmd /c 会剥掉最外层引号
+#endif
+    auto t0 = std::chrono::steady_clock::now();
+    int rc = std::system(cmd.c_str());
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return rc == 0;
+}
+
+SdkCompileStats MeasureSdkCompile(const std::string& compiler, const std::filesystem::path& out)
+{
+    namespace fs = std::filesystem;
+    SdkCompileStats st;
+    fs::path root = out / "CppSDK";
+    fs::path unitDir = out / "compile_bench";
+    fs::create_directories(unitDir);
+    bool compile = compiler != "-";
+
+    auto endsWith = [](const std::string& s, const char* suffix)
+    {
+        size_t n = std::strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    };
+    std::vector<std::string> entryHeaders;
+    for (auto& e : fs::directory_iterator(root / "SDK"))
+    {
+        std::string name = e.path().filename().string();
+        if (endsWith(name, "_classes.hpp"))
+        {
+            entryHeaders.push_back(name);
+        }
+        else if (endsWith(name, "_structs.hpp")
+            && !fs::exists(root / "SDK" / (name.substr(0, name.size() - 12) + "_classes.hpp")))
+        {
+            entryHeaders.push_back(name);
+        }
+    }
+    std::sort(entryHeaders.begin(), entryHeaders.end());
+
+    for (auto& h : entryHeaders)
+    {
+        std::unordered_set<std::string> seen;
+        seen.insert((root / "SDK" / h).lexically_normal().string());
+        u64 bytes = 0;
+        CollectSdkIncludes(root / "SDK" / h, seen, bytes);
+        st.units++;
+        st.headers += seen.size();
+        st.headerBytes += bytes;
+        if (compile)
+        {
+            fs::path unit = unitDir / (h.substr(0, h.size() - 4) + ".cpp");
+            std::ofstream(unit) << "#include \"SDK/" << h << "\"\n";
+            double seconds = 0;
+            st.failed += CompileUnit(compiler, root, unit, seconds) ? 0 : 1;
+            st.unitSeconds += seconds;
+        }
+    }
+    if (compile)
+    {
+        fs::path unit = unitDir / "SDK.cpp";
+        std::ofstream(unit) << "#include \"SDK.hpp\"\n";
+        st.umbrellaOk = CompileUnit(compiler, root, unit, st.umbrellaSeconds);
+    }
+    return st;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BenchArgs args;
+    if (!ParseArgs(argc, argv, args))
+    {
+        return 1;
+    }
+
+    SyntheticMemoryAccessor* accessor = nullptr;
+    std::unique_ptr<SyntheticUEImage> image;
+
+    RunStage("BuildImage", accessor, [&]
+    {
+        image = std::make_unique<SyntheticUEImage>(args.image);
+        auto& s = image->Stats();
+        return std::format("objects {} classes {} structs {} enums {} functions {} properties {} names {} ({} MB)",
+            s.objects, s.classes, s.structs, s.enums, s.functions, s.properties, s.names,
+            s.committedBytes >> 20);
+    });
+
+    // 对象图偏移发现：与 AutoInit 相同的代码路径；PE 段特征码扫描不在合成映像覆盖范围内
+    RunStage("AutoInit(discovery)", accessor, [&]
+    {
+        accessor = InstallSyntheticImage(*image, true);
+        bool ok = detail::DiscoverObjectGraphOffsets(Ctx());
+        auto diff = DiffSyntheticOffsets(Ctx().off, image->Offsets());
+        std::string summary = std::format("ok={} mismatches={}", ok, diff.size());
+        for (auto& d : diff)
+        {
+            summary += " [" + d + "]";
+        }
+        return summary;
+    });
+
+    // 后续阶段使用标准偏移，避免发现误差影响测量
+    accessor = InstallSyntheticImage(*image);
+    ClearResolvedNameCache();
+    ClearNameCaches();
+    detail::ClearPropertiesCache();
+    detail::ClearFunctionsCache();
+
+    std::vector<i32> nameIds;
+    {
+        std::unordered_set<i32> seen;
+        i32 total = GetTotalObjectCount();
+        for (i32 i = 0; i < total; ++i)
+        {
+            FName fn{};
+            uptr obj = GetObjectByIndex(i);
+            if (obj && GReadValue(obj + Off().UObject_Name, fn) && seen.insert(fn.ComparisonIndex).second)
+            {
+                nameIds.push_back(fn.ComparisonIndex);
+            }
+        }
+    }
+    accessor->ResetStats();
+
+    for (const char* pass : {"ResolveName(cold)", "ResolveName(warm)"})
+    {
+        RunStage(pass, accessor, [&]
+        {
+            size_t chars = 0;
+            std::string out;
+            for (i32 id : nameIds)
+            {
+                if (ResolveNameCached(Mem(), Off(), id, out))
+                {
+                    chars += out.size();
+                }
+            }
+            return std::format("ids {} chars {}", nameIds.size(), chars);
+        });
+    }
+
+    // 名称池镜像：首次全量同步，之后的同步只读取新增部分；镜像命中时解析不再远程读取
+    RunStage("SyncNamePool(full)", accessor, [&]
+    {
+        ClearResolvedNameCache();
+        auto s = SyncNamePool();
+        return std::format("ok={} names {} fetched {} KB blocks {}",
+            s.ok, GetNamePoolMirror().Count(), s.bytesFetched >> 10, s.blocks);
+    });
+    RunStage("SyncNamePool(again)", accessor, [&]
+    {
+        auto s = SyncNamePool();
+        return std::format("ok={} new {} fetched {} B", s.ok, s.newNames, s.bytesFetched);
+    });
+    RunStage("ResolveName(mirror)", accessor, [&]
+    {
+        size_t chars = 0;
+        std::string out;
+        for (i32 id : nameIds)
+        {
+            if (ResolveNameCached(Mem(), Off(), id, out))
+            {
+                chars += out.size();
+            }
+        }
+        return std::format("ids {} chars {}", nameIds.size(), chars);
+    });
+    ClearResolvedNameCache();
+
+    if (args.image.widePercent > 0)
+    {
+        RunTranscodeStages(accessor, args.image.widePercent);
+    }
+
+    std::vector<uptr> typeObjects;
+    RunStage("ForEachObject", accessor, [&]
+    {
+        i32 visited = 0;
+        ForEachObject([&](uptr obj, i32)
+        {
+            visited++;
+            if (IsTypeObject(obj))
+            {
+                typeObjects.push_back(obj);
+            }
+            return true;
+        });
+        return std::format("visited {} types {}", visited, typeObjects.size());
+    });
+
+    // 对象表镜像：首次整表同步；随后模拟运行期变化（销毁 / 复用槽），增量同步只解码变化的槽
+    RunStage("SyncObjectTable(full)", accessor, [&]
+    {
+        auto d = SyncObjectTable();
+        return std::format("ok={} slots {} live {} fetched {} KB",
+            d.ok, d.count, GetObjectTableMirror().LiveCount(), d.bytesFetched >> 10);
+    });
+    {
+        // 每 97 个槽销毁一个、每 89 个槽换成另一个对象（复用），测量增量同步后恢复原状
+        const UEOffsets& off = Off();
+        auto itemAddr = [&](i32 index)
+        {
+            uptr table = 0, chunk = 0;
+            GReadPtr(off.GObjects, table);
+            if (!off.bIsChunkedObjArray)
+            {
+                return table + static_cast<uptr>(index) * off.FUObjectItemSize;
+            }
+            GReadPtr(table + (index / off.ChunkSize) * sizeof(uptr), chunk);
+            return chunk + static_cast<uptr>(index % off.ChunkSize) * off.FUObjectItemSize;
+        };
+        struct Saved { uptr item; uptr obj; i32 serial; };
+        std::vector<Saved> saved;
+        i32 total = GetTotalObjectCount();
+        for (i32 i = 1; i < total; ++i)
+        {
+            if (i % 97 != 0 && i % 89 != 0)
+            {
+                continue;
+            }
+            uptr item = itemAddr(i) + off.FUObjectItemInitialOffset;
+            Saved sv{item, 0, 0};
+            GReadPtr(item, sv.obj);
+            GReadI32(item + off.FUObjectItemSerialNumberOffset, sv.serial);
+            saved.push_back(sv);
+            if (i % 97 == 0)
+            {
+                uptr zero = 0;
+                Mem().Write(item, &zero, sizeof(zero));
+            }
+            else
+            {
+                uptr other = GetObjectByIndex(i - 1);
+                i32 serial = sv.serial + 1;
+                Mem().Write(item, &other, sizeof(other));
+                Mem().Write(item + off.FUObjectItemSerialNumberOffset, &serial, sizeof(serial));
+            }
+        }
+        RunStage("SyncObjectTable(delta)", accessor, [&]
+        {
+            auto d = SyncObjectTable();
+            return std::format("ok={} added {} removed {} reused {} fetched {} KB",
+                d.ok, d.added.size(), d.removed.size(), d.reused.size(), d.bytesFetched >> 10);
+        });
+        for (auto& sv : saved)
+        {
+            Mem().Write(sv.item, &sv.obj, sizeof(sv.obj));
+            Mem().Write(sv.item + off.FUObjectItemSerialNumberOffset, &sv.serial, sizeof(sv.serial));
+        }
+        SyncObjectTable();
+    }
+    RunStage("ForEach(mirror)", accessor, [&]
+    {
+        i32 visited = 0;
+        size_t types = 0;
+        GetObjectTableMirror().ForEach([&](uptr, i32, uptr cls)
+        {
+            visited++;
+            types += cls != 0;
+            return true;
+        });
+        return std::format("visited {} with class {}", visited, types);
+    });
+
+    // 导出缓存归属会话：第二轮全部命中，会话结束后缓存释放
+    {
+        DumpSession session;
+        ScopedDumpSession scope(session);
+        for (const char* pass : {"CollectProps+Funcs", "CollectProps+Funcs(hot)"})
+        {
+            RunStage(pass, accessor, [&]
+            {
+                size_t props = 0, funcs = 0;
+                for (uptr obj : typeObjects)
+                {
+                    props += detail::CollectProperties(obj).size();
+                    funcs += detail::CollectFunctions(obj).size();
+                }
+                return std::format("properties {} functions {}", props, funcs);
+            });
+        }
+        session.Report();
+    }
+
+    // 多目标：每个线程绑定自己的 Context，偏移、访问器与全部缓存互不共享
+    // 并行结果与逐个串行处理的结果逐项比对
+    if (args.contexts > 0)
+    {
+        std::vector<std::unique_ptr<SyntheticUEImage>> images;
+        for (u32 k = 0; k < args.contexts; ++k)
+        {
+            SyntheticImageConfig cfg = args.image;
+            cfg.seed += k + 1;
+            images.push_back(std::make_unique<SyntheticUEImage>(cfg));
+        }
+        std::vector<ContextResult> parallel(args.contexts);
+        RunStage("MultiContext", accessor, [&]
+        {
+            detail::RunWorkers(args.contexts, [&](u32 k)
+            {
+                Context ctx;
+                ScopedContext scope(ctx);
+                parallel[k] = ProcessImage(*images[k]);
+            });
+            size_t props = 0;
+            for (auto& r : parallel)
+            {
+                props += r.properties;
+            }
+            return std::format("contexts {} properties {}", args.contexts, props);
+        });
+        bool match = true;
+        for (u32 k = 0; k < args.contexts; ++k)
+        {
+            Context ctx;
+            ScopedContext scope(ctx);
+            match = match && ProcessImage(*images[k]) == parallel[k];
+        }
+        std::cout << std::format("{:<22} {}\n", "MultiContext(verify)", match ? "match" : "MISMATCH");
+    }
+
+    auto sdkOptions = [&]
+    {
+        SdkDumpOptions options;
+        options.workerCount = args.workers;
+        options.incremental = false;
+        options.memoryBudgetMB = args.budgetMB;
+        // 合成访问器只读且线程安全，采集线程共用全局通道
+        if (args.workers > 1)
+        {
+            options.collectAccessors.assign(args.workers, nullptr);
+        }
+        return options;
+    };
+
+    if (!args.skipSdk)
+    {
+        RunStage("DumpCppSdk", accessor, [&]
+        {
+            std::filesystem::path out = std::filesystem::absolute(args.outDir);
+            bool ok = DumpCppSdk(out.wstring(), sdkOptions());
+            return std::format("ok={} out={}", ok, out.string());
+        });
+        RunStage("DumpOffsetsSdk", accessor, [&]
+        {
+            std::filesystem::path out = std::filesystem::absolute(args.outDir);
+            bool ok = DumpOffsetsSdk(out.wstring());
+            std::error_code ec;
+            auto size = std::filesystem::file_size(out / "OffsetsSDK" / "Offsets.hpp", ec);
+            return std::format("ok={} Offsets.hpp {} KB", ok, ec ? 0 : size >> 10);
+        });
+        // 前面的导出已按对象地址填满名称缓存，清空后观察 JSON 导出自身新增的条目
+        ClearNameCaches();
+        RunStage("DumpJson", accessor, [&]
+        {
+            std::filesystem::path out = std::filesystem::absolute(args.outDir);
+            bool ok = DumpJson(out.wstring());
+            std::error_code ec;
+            auto size = std::filesystem::file_size(out / "Reflection.json", ec);
+            return std::format("ok={} Reflection.json {} KB class-name cache {}", ok,
+                ec ? 0 : size >> 10, detail::GetClassNameCache().size());
+        });
+    }
+
+    // SDK 布局对比：Rei-Dumper 布局（before）与前向声明布局（after）各生成一份，逐包编译
+    if (!args.skipSdk && !args.compiler.empty())
+    {
+        SdkCompileStats stats[2];
+        for (int fwd = 0; fwd < 2; ++fwd)
+        {
+            const char* layout = fwd ? "fwd" : "legacy";
+            std::filesystem::path out = std::filesystem::absolute(args.outDir + "_" + layout);
+            RunStage(fwd ? "DumpCppSdk(fwd)" : "DumpCppSdk(legacy)", accessor, [&]
+            {
+                SdkDumpOptions options = sdkOptions();
+                options.forwardDeclarations = fwd != 0;
+                bool ok = DumpCppSdk(out.wstring(), options);
+                return std::format("ok={} out={}", ok, out.string());
+            });
+            SdkCompileStats& st = stats[fwd];
+            st = MeasureSdkCompile(args.compiler, out);
+            u32 units = st.units ? st.units : 1;
+            std::cout << std::format(
+                "{:<22} units {}  headers/unit {:.1f}  KB/unit {}  compile {:.2f}s (failed {})  SDK.hpp {:.2f}s{}\n",
+                std::string("CompileSdk(") + layout + ")", st.units,
+                static_cast<double>(st.headers) / units, (st.headerBytes / units) >> 10,
+                st.unitSeconds, st.failed, st.umbrellaSeconds, st.umbrellaOk ? "" : " (failed)");
+        }
+        auto ratio = [](double before, double after) { return after > 0 ? before / after : 0.0; };
+        std::cout << std::format("{:<22} headers x{:.2f}  bytes x{:.2f}  compile x{:.2f}\n",
+            "CompileSdk(speedup)",
+            ratio(static_cast<double>(stats[0].headers), static_cast<double>(stats[1].headers)),
+            ratio(static_cast<double>(stats[0].headerBytes), static_cast<double>(stats[1].headerBytes)),
+            ratio(stats[0].unitSeconds, stats[1].unitSeconds));
+
+        // 仅偏移头文件：单个翻译单元 include 全部包
+        if (args.compiler != "-")
+        {
+            std::filesystem::path root = std::filesystem::absolute(args.outDir) / "OffsetsSDK";
+            std::filesystem::path unit = root / "Offsets_bench.cpp";
+            std::ofstream(unit) << "#include \"Offsets.hpp\"\n";
+            double seconds = 0;
+            bool ok = CompileUnit(args.compiler, root, unit, seconds);
+            std::cout << std::format("{:<22} Offsets.hpp {:.2f}s{}\n",
+                "CompileOffsets", seconds, ok ? "" : " (failed)");
+        }
+    }
+    return 0;
+}